@@ -1,8 +1,13 @@
 ﻿#include "AnalysisStep.h"
 #include "DataStructure/Structure/StructureData.h"
 #include "DataStructure/Element/ElementBase.h"
+#include "DataStructure/Element/ElementBatch.h"
 #include "Solver/SolverNewmark.h"
+#include "Solver/SolverEigen.h"
+#include "Solver/SolverModal.h"
+#include "Solver/SolverHarmonic.h"
 #include <Eigen/SparseCholesky>
+#include <thread>
 
 void AnalysisStep::SetStructure(std::shared_ptr<StructureData> pStructure)
 {
@@ -29,7 +34,10 @@ bool AnalysisStep::PrepareData()
 void AnalysisStep::Init()
 {
     if (!PrepareData()) return;
+    // 节点、单元表可能在导入、生成或编辑之后被直接修改过，邻接关系在自由度初始化前重建，不引用已删除的对象
+    m_pData->TopologyChanged();
     Init_DOF();
+    m_pData->GetCompactModel().Build(m_pData);
     Init_Nodevector();
 }
 
@@ -44,19 +52,19 @@ void AnalysisStep::Init_DOF()
         std::fill(pNode->m_DOF.begin(), pNode->m_DOF.end(), -1);
     }
 
-    // 根据单元节点自由度初始化节点DOF数组
-
-    for (auto& elements : m_pData->m_Elements)
+    // 根据单元节点自由度初始化节点DOF数组（取相连单元的最大节点自由度数）
+    const Adjacency& adjacency = m_pData->GetAdjacency();
+    for (int i = 0; i < adjacency.NodeCount(); ++i)
     {
-        auto pelement = elements.second;
-        int NodeDOF = pelement->Get_NodeDOF();
-        for (auto& nodes : pelement->m_pNode)
+        Node* pNode = adjacency.m_NodeView[i];
+        int NodeDOF = 0;
+        for (int e : adjacency.NodeElements(i))
         {
-            auto pNode = nodes.lock();
-            if (pNode && pNode->m_DOF.size() < NodeDOF)
-            {
-                pNode->m_DOF.resize(NodeDOF, -1);
-            }
+            NodeDOF = std::max(NodeDOF, adjacency.m_ElementView[e]->Get_NodeDOF());
+        }
+        if (pNode->m_DOF.size() < NodeDOF)
+        {
+            pNode->m_DOF.resize(NodeDOF, -1);
         }
     }
 
@@ -80,10 +88,11 @@ void AnalysisStep::Init_DOF()
 
     m_nFixed = iStart;
 
-    // 再处理自由自由度
-    for (auto& nodes : m_pData->m_Nodes)
+    // 再处理自由自由度（按求解用的节点顺序编号，与紧凑数组一致）
+    std::vector<Node*> nodeOrder;
+    m_pData->Get_NodeOrder(nodeOrder);
+    for (Node* pNode : nodeOrder)
     {
-        auto pNode = nodes.second;
         for (auto& dofValue : pNode->m_DOF)
         {
             if (-1 == dofValue) dofValue = iStart++;
@@ -95,56 +104,39 @@ void AnalysisStep::Init_DOF()
 
 void AnalysisStep::Init_Nodevector()
 {
-    for (auto& nodePair : m_pData->m_Nodes)
-    {
-        auto pNode = nodePair.second;
-        int numDOF = pNode->m_DOF.size();
-        if (pNode->m_Displacement.size() < numDOF)
-            pNode->m_Displacement.resize(numDOF, 0.0);
-        if (pNode->m_Force.size() < numDOF)
-            pNode->m_Force.resize(numDOF, 0.0);
-        if (pNode->m_Velocity.size() < numDOF)
-            pNode->m_Velocity.resize(numDOF, 0.0);
-        if (pNode->m_Acceleration.size() < numDOF)
-            pNode->m_Acceleration.resize(numDOF, 0.0);
-    }
+    // 全局状态向量按自由度总数分配（保留前序分析步的结果），节点通过视图访问
+    m_pData->GetCompactModel().ResizeState(m_nFixed + m_nFree);
 }
 
 void AnalysisStep::Get_ElementLength()
 {
-    for (auto& ele : m_pData->m_Elements)
-    {
-        auto pElement = ele.second;
-        pElement->Get_L0();
-    }
+    // 初始长度保存在单元常量表中（Init 时建立），材料或截面修改后才需要重新计算
+    CompactModel& model = m_pData->GetCompactModel();
+    if (!model.ConstantsValid()) model.UpdateConstants();
 }
 
 void AnalysisStep::AssembleKs()
 {
-    std::list<Tri> L11, L21, L22;
-
-    m_K11.resize(m_nFixed, m_nFixed);
-    m_K21.resize(m_nFree, m_nFixed);
-    m_K22.resize(m_nFree, m_nFree);
-
-    MatrixXd ke;
-    std::vector<int> DOFs;
-
-    for (auto& element : m_pData->m_Elements)
+    std::vector<double> buffer;
+    CompactModel& model = m_pData->GetCompactModel();
+    const AssemblyPattern& pattern = Get_AssemblyPattern();
+    pattern.Reset(AssemblyPattern::Part::K11, m_K11);
+    pattern.Reset(AssemblyPattern::Part::K21, m_K21);
+    pattern.Reset(AssemblyPattern::Part::K22, m_K22);
+
+    // 按单元块分批计算，每批单元矩阵写入连续缓冲区后按预先建立的位置累加
+    for (const ElementBlock& block : model.m_Blocks)
     {
-        auto pelement = element.second;
-        //pelement->Get_ke(ke);
-        pelement->Get_ke_non(ke);
-        pelement->GetDOFs(DOFs);
-        Assemble(DOFs, ke, L11, L21, L22);
+        for (int begin = block.m_Begin; begin < block.m_End; begin += ElementBatch::ChunkSize)
+        {
+            const int end = std::min(begin + ElementBatch::ChunkSize, block.m_End);
+            ElementBatch::Tangent(model, block, begin, end, buffer);
+            pattern.Scatter(begin, end, buffer, &m_K11, &m_K21, m_K22);
+        }
     }
 
-    m_K11.setFromTriplets(L11.begin(), L11.end());
-    m_K21.setFromTriplets(L21.begin(), L21.end());
-    m_K22.setFromTriplets(L22.begin(), L22.end());
-
     // Fix: 为了防止刚度矩阵奇异（例如竖直杆件受到横向力时初始切线刚度为0），
-    // 在对角线上添加一个极小值 epsilon
+    // 在对角线上添加一个极小值 epsilon（对角元已在组装模式中，不改变非零结构）
     double epsilon = 1e-10;
     for (int i = 0; i < m_nFree; ++i)
     {
@@ -155,34 +147,134 @@ void AnalysisStep::AssembleKs()
     //std::cout << MatrixXd(m_K22);
 }
 
-void AnalysisStep::Assemble(std::vector<int>& DOFs, Eigen::MatrixXd& T, std::list<Tri>& L11, std::list<Tri>& L21, std::list<Tri>& L22)
+void AnalysisStep::AssembleMs()
 {
-    auto nDOF = DOFs.size();
+    std::vector<double> buffer;
+    const CompactModel& model = m_pData->GetCompactModel();
+    const AssemblyPattern& pattern = Get_AssemblyPattern();
+    pattern.Reset(AssemblyPattern::Part::K22, m_M22);
 
-    for (int i = 0; i < nDOF; ++i)
+    for (const ElementBlock& block : model.m_Blocks)
     {
-        int ii = DOFs[i];
-        for (int j = 0; j < nDOF; ++j)
+        for (int begin = block.m_Begin; begin < block.m_End; begin += ElementBatch::ChunkSize)
         {
-            int jj = DOFs[j];
-            auto kij = T(i, j);
+            const int end = std::min(begin + ElementBatch::ChunkSize, block.m_End);
+            ElementBatch::Mass(model, block, begin, end, buffer);
+            pattern.Scatter(begin, end, buffer, nullptr, nullptr, m_M22);
+        }
+    }
+}
 
-            if (ii < m_nFixed && jj < m_nFixed)
-            {
-                L11.push_back(Tri(ii, jj, kij));
-            }
-            else if (ii >= m_nFixed && jj < m_nFixed)
-            {
-                L21.push_back(Tri(ii - m_nFixed, jj, kij));
-            }
-            else if (ii >= m_nFixed && jj >= m_nFixed)
-            {
-                L22.push_back(Tri(ii - m_nFixed, jj - m_nFixed, kij));
-            }
+bool AnalysisStep::Extract_Modes(VectorXd& omega, MatrixXd& Phi)
+{
+    using namespace Dynamics;
+
+    SolverEigen::Parameters eigenParam;
+    eigenParam.n_modes = m_nModes;
+    eigenParam.tol = m_EigenTolerance;
+    eigenParam.max_iter = m_EigenMaxIterations;
+    eigenParam.n_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    // 负移位 σ = -ratio·max(Kii/Mii)：刚度矩阵奇异（无应力的索、自由节点、没有刚度的横向）时
+    // 分解的是 K - σM，有质量的零刚度方向也有正的主元；|σ| 远小于频谱上界，对低阶模态的收敛影响很小
+    const double shiftRatio = 1e-8;
+    double lambdaRef = 0.0;
+    for (int i = 0; i < m_nFree; ++i)
+    {
+        const double m = m_M22.coeff(i, i);
+        if (m > 0.0) lambdaRef = std::max(lambdaRef, m_K22.coeff(i, i) / m);
+    }
+    eigenParam.shift = -shiftRatio * lambdaRef;
+
+    SolverEigen eigenSolver(eigenParam);
+    SolverEigen::Result modes;
+    if (!eigenSolver.solve(m_K22, m_M22, modes))
+    {
+        qDebug().noquote() << QStringLiteral("Error: 模态提取失败（刚度矩阵分解失败或质量矩阵为空）");
+        return false;
+    }
+    if (!modes.converged)
+    {
+        qDebug().noquote() << QStringLiteral("警告: 子空间迭代 %1 次未收敛").arg(modes.iterations);
+    }
+
+    // 刚体模态的特征值只是舍入误差（可能略小于零），这里只截去负值；
+    // 是否按刚体模态处理由 SolverModal 的 rigid_ratio 统一判断
+    omega = modes.values.cwiseMax(0.0).cwiseSqrt();
+    Phi = std::move(modes.vectors);
+
+    for (Eigen::Index j = 0; j < omega.size(); ++j)
+    {
+        qDebug().noquote() << QStringLiteral("模态 %1: f = %2 Hz").arg(j + 1).arg(omega[j] / (2.0 * PI));
+    }
+    return true;
+}
+
+void AnalysisStep::AssembleKg(const VectorXd& x2, SpMat& Kg22)
+{
+    std::vector<double> buffer;
+    const CompactModel& model = m_pData->GetCompactModel();
+    const AssemblyPattern& pattern = Get_AssemblyPattern();
+    pattern.Reset(AssemblyPattern::Part::K22, Kg22);
+
+    // 全局位移增量（约束自由度为零）
+    VectorXd dU = VectorXd::Zero(m_nFixed + m_nFree);
+    dU.segment(m_nFixed, m_nFree) = x2;
+
+    for (const ElementBlock& block : model.m_Blocks)
+    {
+        for (int begin = block.m_Begin; begin < block.m_End; begin += ElementBatch::ChunkSize)
+        {
+            const int end = std::min(begin + ElementBatch::ChunkSize, block.m_End);
+            ElementBatch::GeometricIncrement(model, block, begin, end, dU, buffer);
+            pattern.Scatter(begin, end, buffer, nullptr, nullptr, Kg22);
+        }
+    }
+}
+
+const AssemblyPattern& AnalysisStep::Get_AssemblyPattern()
+{
+    const CompactModel& model = m_pData->GetCompactModel();
+    if (!m_AssemblyPattern.IsValid(model, m_nFixed, m_nFree))
+    {
+        m_AssemblyPattern.Build(model, m_nFixed, m_nFree);
+    }
+    return m_AssemblyPattern;
+}
+
+void AnalysisStep::Get_OutputNodes(std::vector<std::shared_ptr<Node>>& outNodes)
+{
+    outNodes.clear();
+    std::vector<int> requested;
+    if (!m_pData->GetOutputter().GetOutputNodes(requested))
+    {
+        for (auto& nodePair : m_pData->m_Nodes) outNodes.push_back(nodePair.second);
+    }
+    else
+    {
+        for (int idNode : requested)
+        {
+            auto pNode = m_pData->FindNode(idNode);
+            if (pNode) outNodes.push_back(pNode);
         }
     }
 }
 
+void AnalysisStep::Save_ModeShapes(const VectorXd& frameTimes, const MatrixXd& Phi)
+{
+    VectorXd& U = m_pData->GetCompactModel().m_U;
+    VectorXd saved = U;
+
+    for (Eigen::Index j = 0; j < Phi.cols(); ++j)
+    {
+        U.head(m_nFixed).setZero();
+        U.segment(m_nFixed, m_nFree) = Phi.col(j);
+        m_pData->GetOutputter().SaveDataFromNodes(frameTimes[j], m_pData, j == Phi.cols() - 1);
+    }
+
+    U.swap(saved);
+}
+
 void AnalysisStep::Assemble_AllLoads(VectorXd& F1, VectorXd& F2, double& Factor)
 {
     F1.resize(m_nFixed);
@@ -251,84 +343,84 @@ void AnalysisStep::Assemble_AllLoads(VectorXd& F1, VectorXd& F2, double& Factor)
 
 void AnalysisStep::UpData(VectorXd& x1, VectorXd& x2, VectorXd& F1, VectorXd* v2, VectorXd* a2)
 {
-    for (auto& nodePair : m_pData->m_Nodes)
-    {
-        auto pNode = nodePair.second;
-        int numDOF = pNode->m_DOF.size();
-
-        // 确保节点向量大小正确
-        if (pNode->m_Displacement.size() < numDOF)
-            pNode->m_Displacement.resize(numDOF, 0.0);
-        if (pNode->m_Velocity.size() < numDOF)
-            pNode->m_Velocity.resize(numDOF, 0.0);
-        if (pNode->m_Acceleration.size() < numDOF)
-            pNode->m_Acceleration.resize(numDOF, 0.0);
-        if (pNode->m_Force.size() < numDOF)
-            pNode->m_Force.resize(numDOF, 0.0);
-
-        // 更新各自由度方向的数据
-        for (int dofIdx = 0; dofIdx < numDOF; dofIdx++)
-        {
-            int dof = pNode->m_DOF[dofIdx];
+    CompactModel& model = m_pData->GetCompactModel();
 
-            // 约束自由度：位移增量为0（除非是位移控制，那由调用者直接设置）
-            if (dof < m_nFixed)
-            {
-                pNode->m_Displacement[dofIdx] = x1[dof];
-                pNode->m_Force[dofIdx] = F1[dof];
-            }
-            // 自由自由度：从x2向量获取增量
-            else if (dof < m_nFixed + m_nFree)
-            {
-                pNode->m_Displacement[dofIdx] += x2[dof - m_nFixed];
-                if (v2)
-                {
-                    pNode->m_Velocity[dofIdx] += (*v2)[dof - m_nFixed];
-                }
-                if (a2)
-                {
-                    pNode->m_Acceleration[dofIdx] += (*a2)[dof - m_nFixed];
-                }
-            }
-        }
+    // 约束自由度：位移与反力直接取 x1、F1（位移控制由调用者设置 x1）
+    model.m_U.head(m_nFixed) = x1;
+    model.m_F.head(m_nFixed) = F1;
+
+    // 自由自由度：累加增量
+    model.m_U.segment(m_nFixed, m_nFree) += x2;
+    if (v2)
+    {
+        model.m_V.segment(m_nFixed, m_nFree) += *v2;
+    }
+    if (a2)
+    {
+        model.m_A.segment(m_nFixed, m_nFree) += *a2;
     }
 }
 
 void AnalysisStep::Get_CurrentInforce(VectorXd& Inforce)
 {
-    for (auto& elementPair : m_pData->m_Elements)
+    CompactModel& model = m_pData->GetCompactModel();
+    switch (model.UniformNodeDOF())
     {
-        auto pElement = elementPair.second;
-        std::vector<int> elementDOFs;
-        pElement->GetDOFs(elementDOFs);
+    case 3:
+        Get_CurrentInforceFixed<3>(Inforce);
+        return;
+    case 6:
+        Get_CurrentInforceFixed<6>(Inforce);
+        return;
+    default:
+        break;
+    }
+
+    double* F = model.m_F.data();
 
-        // 将单元内力累加到节点
-        auto& nodeWeakPtrs = pElement->m_pNode;
-        int nodeDOF = pElement->Get_NodeDOF();
+    for (int e = 0; e < model.ElementCount(); ++e)
+    {
+        const int dofBegin = model.m_ElemDofPtr[e];
+        const int nDOF = model.m_ElemDofPtr[e + 1] - dofBegin;
+        const int* elementDOFs = model.m_ElemDof.data() + dofBegin;
+        const double* inforce = model.m_ElemForce.data() + dofBegin;
 
-        for (auto nodeIdx = 0; nodeIdx < nodeWeakPtrs.size(); ++nodeIdx)
+        for (int dofIdx = 0; dofIdx < nDOF; ++dofIdx)
         {
-            auto pNode = nodeWeakPtrs[nodeIdx].lock();
-            if (!pNode) continue;
+            int globalDOF = elementDOFs[dofIdx];
+            if (globalDOF < 0) continue;
+
+            // 将单元内力累加到节点力
+            F[globalDOF] += inforce[dofIdx];
 
-            for (auto dofIdx = 0; dofIdx < nodeDOF; ++dofIdx)
+            // 累加自由自由度的内力用于收敛判断
+            if (globalDOF >= m_nFixed)
             {
-                auto localIdx = nodeIdx * nodeDOF + dofIdx;
-                if ((localIdx < pElement->m_inforce.size()) && (dofIdx < pNode->m_Force.size()))
-                {
-                    pNode->m_Force[dofIdx] += pElement->m_inforce[localIdx];
-                }
+                Inforce[globalDOF - m_nFixed] += inforce[dofIdx];
             }
         }
+    }
+}
 
-        // 累加自由自由度的内力用于收敛判断
-        for (size_t dofIdx = 0; dofIdx < elementDOFs.size(); ++dofIdx)
+template <int NDOF>
+void AnalysisStep::Get_CurrentInforceFixed(VectorXd& Inforce)
+{
+    CompactModel& model = m_pData->GetCompactModel();
+    double* F = model.m_F.data();
+    const int* elementDOFs = model.m_ElemDof.data();
+    const double* inforce = model.m_ElemForce.data();
+    const int nTotal = CompactModel::LineElementNodes * NDOF * model.ElementCount();
+
+    // 单元自由度与单元内力都按固定步长连续存放，整体作为一个数组遍历
+    for (int k = 0; k < nTotal; ++k)
+    {
+        const int globalDOF = elementDOFs[k];
+        if (globalDOF < 0) continue;
+
+        F[globalDOF] += inforce[k];
+        if (globalDOF >= m_nFixed)
         {
-            int globalDOF = elementDOFs[dofIdx];
-            if (globalDOF >= m_nFixed)
-            {
-                Inforce[globalDOF - m_nFixed] += pElement->m_inforce[dofIdx];
-            }
+            Inforce[globalDOF - m_nFixed] += inforce[k];
         }
     }
 }
@@ -396,19 +488,18 @@ void AnalysisStep::Assemble_ForceGravity(Force_Gravity* pForceGravity, VectorXd&
 {
     int iDirection = static_cast<int>(pForceGravity->m_Direction);
     double m_g = pForceGravity->m_g;
-    for (auto& pElement : m_pData->m_Elements)
+    const CompactModel& model = m_pData->GetCompactModel();
+    for (int e = 0; e < model.ElementCount(); ++e)
     {
-        auto pele = pElement.second;
-        auto pPorety = pele->m_pProperty.lock();
-        auto m_Density = pPorety->m_pMaterial.lock()->m_Density;
-        auto m_A = pPorety->m_pSection.lock()->m_Area;
-        double m_quality = pele->L0 * m_Density * m_A;
+        if (model.m_ElemProperty[e] < 0) continue;
+        double m_quality = model.m_ElemConst[e].L0 * model.m_ElemConst[e].rhoA;
         double m_G = m_quality * m_g;
 
-        for (auto& NodePtr : pele->m_pNode)
+        for (int k = model.m_ElemNodePtr[e]; k < model.m_ElemNodePtr[e + 1]; ++k)
         {
-            auto pNode = NodePtr.lock();
-            int dof = pNode->m_DOF[iDirection];
+            const int iNode = model.m_ElemNode[k];
+            if (iNode < 0 || iDirection >= model.m_NodeDofPtr[iNode + 1] - model.m_NodeDofPtr[iNode]) continue;
+            int dof = model.m_NodeDof[model.m_NodeDofPtr[iNode] + iDirection];
             if (dof >= 0 && dof < m_nFixed)
             {
                 F1[dof] += 0.;
@@ -437,7 +528,7 @@ void AnalysisStep::Assemble_Constraint(VectorXd& x1)
         if (dof >= 0 && dof < m_nFixed)
         {
             x1[dof] = pConstraint->m_Value;
-            pNode->m_Displacement[iDirection] = pConstraint->m_Value;
+            m_pData->GetCompactModel().m_U[dof] = pConstraint->m_Value;
         }
     }
 }
@@ -449,7 +540,17 @@ void AnalysisStep::Assemble_Constraint(VectorXd& x1)
 void AnalysisStep::Solve()
 {
     if (!PrepareData()) return;
+    if (!m_pData->GetCompactModel().IsBuilt())
+    {
+        m_pData->GetCompactModel().Build(m_pData);
+        Init_Nodevector();
+    }
+    else if (!m_pData->GetCompactModel().ConstantsValid())
+    {// 材料或截面在上次初始化后被修改
+        m_pData->GetCompactModel().UpdateConstants();
+    }
 
+    m_pData->GetOutputter().BeginStep(m_Id, m_Type);
     switch (m_Type)
     {
     case EnumKeyword::StepType::STATIC:
@@ -458,10 +559,25 @@ void AnalysisStep::Solve()
     case EnumKeyword::StepType::DYNAMIC:
         Solve_Dynamic();
         break;
+    case EnumKeyword::StepType::MODAL_DYNAMIC:
+        Solve_ModalDynamic();
+        break;
+    case EnumKeyword::StepType::FREQUENCY:
+        Solve_Frequency();
+        break;
+    case EnumKeyword::StepType::BUCKLE:
+        Solve_Buckle();
+        break;
+    case EnumKeyword::StepType::HARMONIC:
+        Solve_Harmonic();
+        break;
     default:
         break;
         qDebug().noquote() << QStringLiteral("警告: 未知的分析步类型，无法求解");
     }
+
+    // 把紧凑数组中的单元应力和内力写回单元对象
+    m_pData->GetCompactModel().SyncElementsToObjects();
 }
 
 void AnalysisStep::Solve_Static()
@@ -501,10 +617,7 @@ void AnalysisStep::Solve_Static()
             AssembleKs();
 
             // 2. 清零节点内力，然后计算单元内力并累加到节点
-            for (auto& nodePair : m_pData->m_Nodes)
-            {
-                std::fill(nodePair.second->m_Force.begin(), nodePair.second->m_Force.end(), 0.0);
-            }
+            m_pData->GetCompactModel().m_F.setZero();
 
             internalForce.setZero();
             Get_CurrentInforce(internalForce);
@@ -545,11 +658,13 @@ void AnalysisStep::Solve_Static()
                 qDebug().noquote() << QStringLiteral("\n达最大迭代次数\n");
             }
         }
+
+        // 保存结果到输出器（按输出请求的频率，默认只保存最后一个增量步）
+        m_pData->GetOutputter().SaveDataFromNodes(m_Time * currentFactor, m_pData, inc == numIncrements);
     } 
-    // 保存结果到输出器 (直接从节点读取所有数据)
-    if (m_pData)
-    {
-        m_pData->GetOutputter().SaveDataFromNodes(m_Time, m_pData);
+    if (numIncrements < 1)
+    {// 没有增量步时仍输出初始状态
+        m_pData->GetOutputter().SaveDataFromNodes(m_Time, m_pData, true);
     }
     qDebug().noquote() << QStringLiteral("\n静力求解完成 ");
 }
@@ -612,3 +727,316 @@ void AnalysisStep::Solve_Dynamic()
 
     //qDebug().noquote() << QStringLiteral("动力求解完成 (框架已就绪，需要实现质量/阻尼矩阵组装)");
 }
+
+void AnalysisStep::Solve_ModalDynamic()
+{
+    using namespace Dynamics;
+
+    qDebug().noquote() << QStringLiteral("开始模态叠加动力求解...");
+
+    VectorXd F1, F2, x1;
+    Assemble_Constraint(x1);
+    Get_ElementLength();
+
+    // 1. 当前构形下的切线刚度与质量矩阵（同时更新单元内力）
+    AssembleKs();
+    AssembleMs();
+
+    m_pData->GetCompactModel().m_F.setZero();
+    VectorXd internalForce = VectorXd::Zero(m_nFree);
+    Get_CurrentInforce(internalForce);
+
+    // 2. 动力荷载：全部荷载与当前内力之差（前序步已平衡的部分不再重复施加），按阶跃荷载作用
+    double factor = 1.0;
+    Assemble_AllLoads(F1, F2, factor);
+    VectorXd dF = F2 - internalForce;
+
+    // 3. 提取模态（移位求逆子空间迭代，只分解一次），刚体模态在模态积分中按 rigid_ratio 判断
+    SolverModal::Parameters modalParam;
+    modalParam.dt = m_StepSize;
+    modalParam.damping_ratio = m_DampingRatio;
+
+    VectorXd omega;
+    MatrixXd Phi;
+    if (!Extract_Modes(omega, Phi)) return;
+    const Eigen::Index nModes = Phi.cols();
+
+    // 4. 模态力与初始模态速度（位移以当前构形为零点）
+    CompactModel& model = m_pData->GetCompactModel();
+    VectorXd p = Phi.transpose() * dF;
+    VectorXd v0 = model.m_V.segment(m_nFixed, m_nFree);
+    VectorXd q = VectorXd::Zero(nModes);
+    VectorXd qd = Phi.transpose() * (m_M22 * v0);
+
+    // 5. 输出节点上的振型分量（只在这些自由度上恢复物理量）
+    struct OutputDOF
+    {
+        int dof;           ///< 全局自由度编号
+        int row;           ///< 在 Phi 中的行号
+        double u0;         ///< 分析步开始时的位移
+    };
+    std::vector<OutputDOF> outDOFs;
+
+    std::vector<std::shared_ptr<Node>> outNodes;
+    Get_OutputNodes(outNodes);
+
+    for (auto& pNode : outNodes)
+    {
+        for (int dofIdx = 0; dofIdx < pNode->m_DOF.size(); ++dofIdx)
+        {
+            int dof = pNode->m_DOF[dofIdx];
+            if (dof < m_nFixed) continue;
+            outDOFs.push_back({ dof, dof - m_nFixed, model.m_U[dof] });
+        }
+    }
+
+    MatrixXd PhiOut(outDOFs.size(), nModes);
+    for (size_t k = 0; k < outDOFs.size(); ++k)
+    {
+        PhiOut.row(k) = Phi.row(outDOFs[k].row);
+    }
+
+    // 6. 逐阶精确积分模态方程
+    SolverModal modalSolver(modalParam);
+
+    VectorXd uOut(outDOFs.size()), vOut(outDOFs.size()), aOut(outDOFs.size());
+    VectorXd qddEnd = VectorXd::Zero(nModes);
+
+    auto force = [&p](double, Vec& pt) { pt = p; };
+    auto observer = [&](double t, const Vec& qt, const Vec& qdt, const Vec& qddt)
+        {
+            uOut.noalias() = PhiOut * qt;
+            vOut.noalias() = PhiOut * qdt;
+            aOut.noalias() = PhiOut * qddt;
+            for (size_t k = 0; k < outDOFs.size(); ++k)
+            {
+                auto& out = outDOFs[k];
+                model.m_U[out.dof] = out.u0 + uOut[k];
+                model.m_V[out.dof] = vOut[k];
+                model.m_A[out.dof] = aOut[k];
+            }
+            qddEnd = qddt;
+            m_pData->GetOutputter().SaveDataFromNodes(t, m_pData, t >= m_Time);
+        };
+
+    try
+    {
+        modalSolver.solve(omega, q, qd, m_Time, force, observer);
+    }
+    catch (const std::exception& e)
+    {
+        qDebug().noquote() << QStringLiteral("Error: 模态积分失败: ") << e.what();
+        return;
+    }
+
+    // 7. 分析步结束时在全部自由度上恢复一次，供后续分析步使用
+    for (auto& out : outDOFs)
+    {
+        model.m_U[out.dof] = out.u0;
+    }
+
+    VectorXd x2 = Phi * q;
+    model.m_U.segment(m_nFixed, m_nFree) += x2;
+    model.m_V.segment(m_nFixed, m_nFree).noalias() = Phi * qd;
+    model.m_A.segment(m_nFixed, m_nFree).noalias() = Phi * qddEnd;
+
+    qDebug().noquote() << QStringLiteral("\n模态叠加动力求解完成 ");
+}
+
+void AnalysisStep::Solve_Frequency()
+{
+    qDebug().noquote() << QStringLiteral("开始固有频率提取...");
+
+    VectorXd x1;
+    Assemble_Constraint(x1);
+    Get_ElementLength();
+
+    // 当前构形（含前序步预应力）的切线刚度与集中质量
+    AssembleKs();
+    AssembleMs();
+
+    VectorXd omega;
+    MatrixXd Phi;
+    if (!Extract_Modes(omega, Phi)) return;
+
+    // 逐阶振型保存为帧（帧时间为频率 Hz）
+    Save_ModeShapes(omega / (2.0 * PI), Phi);
+
+    qDebug().noquote() << QStringLiteral("\n固有频率提取完成 ");
+}
+
+void AnalysisStep::Solve_Buckle()
+{
+    using namespace Dynamics;
+
+    qDebug().noquote() << QStringLiteral("开始屈曲分析...");
+
+    VectorXd F1, F2, x1;
+    Assemble_Constraint(x1);
+    Get_ElementLength();
+
+    // 1. 基础状态：当前构形的切线刚度（材料刚度 + 前序步预应力的几何刚度）
+    AssembleKs();
+
+    m_pData->GetCompactModel().m_F.setZero();
+    VectorXd internalForce = VectorXd::Zero(m_nFree);
+    Get_CurrentInforce(internalForce);
+
+    // 2. 参考荷载：全部荷载与当前内力之差
+    double factor = 1.0;
+    Assemble_AllLoads(F1, F2, factor);
+    VectorXd dF = F2 - internalForce;
+    if (dF.norm() < m_Tolerance)
+    {
+        qDebug().noquote() << QStringLiteral("Error: 屈曲分析步没有参考荷载");
+        return;
+    }
+
+    // 3. 分解 K（仅此一次），求参考荷载下的线性位移增量
+    Eigen::SimplicialLDLT<SpMat> ldltSolver;
+    ldltSolver.compute(m_K22);
+    if (ldltSolver.info() != Success)
+    {
+        qDebug().noquote() << QStringLiteral("LDLT分解失败!");
+        return;
+    }
+    VectorXd dx2 = ldltSolver.solve(dF);
+
+    // 4. 参考荷载引起的几何刚度增量
+    SpMat Kg22;
+    AssembleKg(dx2, Kg22);
+    SpMat negKg22 = -Kg22;
+
+    // 5. K φ = λ (-ΔKg) φ，复用 K 的分解做移位求逆迭代 (σ = 0)
+    SolverEigen::Parameters eigenParam;
+    eigenParam.n_modes = m_nModes;
+    eigenParam.tol = m_EigenTolerance;
+    eigenParam.max_iter = m_EigenMaxIterations;
+    eigenParam.n_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    SolverEigen eigenSolver(eigenParam);
+    SolverEigen::Result modes;
+    if (!eigenSolver.solve(ldltSolver, m_K22, negKg22, modes))
+    {
+        qDebug().noquote() << QStringLiteral("Error: 屈曲特征值求解失败");
+        return;
+    }
+    if (!modes.converged)
+    {
+        qDebug().noquote() << QStringLiteral("警告: 子空间迭代 %1 次未收敛").arg(modes.iterations);
+    }
+
+    // 屈曲模态按最大分量归一化
+    MatrixXd Phi = modes.vectors;
+    for (Eigen::Index j = 0; j < Phi.cols(); ++j)
+    {
+        double maxAbs = Phi.col(j).cwiseAbs().maxCoeff();
+        if (maxAbs > 0.0) Phi.col(j) /= maxAbs;
+        qDebug().noquote() << QStringLiteral("屈曲模态 %1: 临界荷载系数 = %2").arg(j + 1).arg(modes.values[j]);
+    }
+
+    // 6. 逐阶屈曲模态保存为帧（帧时间为临界荷载系数）
+    Save_ModeShapes(modes.values, Phi);
+
+    qDebug().noquote() << QStringLiteral("\n屈曲分析完成 ");
+}
+
+void AnalysisStep::Solve_Harmonic()
+{
+    using namespace Dynamics;
+
+    qDebug().noquote() << QStringLiteral("开始简谐响应求解...");
+
+    if (m_StepSize <= 0.0 || m_Time < m_StepSize)
+    {
+        qDebug().noquote() << QStringLiteral("Error: 简谐响应分析步的频率范围无效");
+        return;
+    }
+
+    VectorXd F1, F2, x1;
+    Assemble_Constraint(x1);
+    Get_ElementLength();
+
+    // 1. 当前构形下的切线刚度与质量矩阵
+    AssembleKs();
+    AssembleMs();
+
+    m_pData->GetCompactModel().m_F.setZero();
+    VectorXd internalForce = VectorXd::Zero(m_nFree);
+    Get_CurrentInforce(internalForce);
+
+    // 2. 简谐荷载幅值：全部荷载与当前内力之差
+    double factor = 1.0;
+    Assemble_AllLoads(F1, F2, factor);
+    VectorXd dF = F2 - internalForce;
+
+    // 3. 激励频率：StepSize, 2*StepSize, ..., Time (Hz)
+    std::vector<double> omegas;
+    int nFreq = static_cast<int>(std::floor(m_Time / m_StepSize + 1e-9));
+    for (int i = 1; i <= nFreq; ++i)
+    {
+        omegas.push_back(2.0 * PI * i * m_StepSize);
+    }
+
+    // 4. Rayleigh 阻尼 C = αM + βK，在频率范围两端取阻尼比 m_DampingRatio
+    SpMat C22(m_nFree, m_nFree);
+    if (m_DampingRatio > 0.0)
+    {
+        double w1 = omegas.front(), w2 = omegas.back();
+        double alpha = 2.0 * m_DampingRatio * w1 * w2 / (w1 + w2);
+        double beta = 2.0 * m_DampingRatio / (w1 + w2);
+        C22 = alpha * m_M22 + beta * m_K22;
+    }
+
+    // 5. 输出节点：逐频率写入位移幅值，速度、加速度幅值为 ω|u|、ω²|u|
+    std::vector<std::shared_ptr<Node>> outNodes;
+    Get_OutputNodes(outNodes);
+
+    CompactModel& model = m_pData->GetCompactModel();
+    VectorXd savedU = model.m_U, savedV = model.m_V, savedA = model.m_A;
+
+    auto saveFrame = [&](double omega, const CVec& u, bool bLast)
+        {
+            for (auto& pNode : outNodes)
+            {
+                for (int dofIdx = 0; dofIdx < pNode->m_DOF.size(); ++dofIdx)
+                {
+                    int dof = pNode->m_DOF[dofIdx];
+                    double amplitude = (dof >= m_nFixed) ? std::abs(u[dof - m_nFixed]) : 0.0;
+                    pNode->m_Displacement[dofIdx] = amplitude;
+                    pNode->m_Velocity[dofIdx] = omega * amplitude;
+                    pNode->m_Acceleration[dofIdx] = omega * omega * amplitude;
+                }
+            }
+            m_pData->GetOutputter().SaveDataFromNodes(omega / (2.0 * PI), m_pData, bLast);
+        };
+
+    // 最后几个频率可能分解失败，最后一帧要等到求解结束才能确定：每个成功的频率推迟到下一个成功的频率到达时保存
+    double pendingOmega = 0.0;
+    CVec pendingU;
+    bool bPending = false;
+    auto observer = [&](size_t, double omega, const CVec& u)
+        {
+            if (bPending) saveFrame(pendingOmega, pendingU, false);
+            pendingOmega = omega;
+            pendingU = u;
+            bPending = true;
+        };
+
+    // 6. 多线程频率扫描，结果按频率顺序写入输出器
+    SolverHarmonic::Parameters harmonicParam;
+    harmonicParam.n_threads = std::max(1u, std::thread::hardware_concurrency());
+    SolverHarmonic harmonicSolver(harmonicParam);
+
+    if (!harmonicSolver.solve(m_K22, C22, m_M22, dF, omegas, observer))
+    {
+        qDebug().noquote() << QStringLiteral("警告: 部分频率（可能位于无阻尼共振点）分解失败，已跳过");
+    }
+    if (bPending) saveFrame(pendingOmega, pendingU, true);
+
+    model.m_U.swap(savedU);
+    model.m_V.swap(savedV);
+    model.m_A.swap(savedA);
+
+    qDebug().noquote() << QStringLiteral("\n简谐响应求解完成，共 %1 个频率").arg(omegas.size());
+}
@@ -1,11 +1,14 @@
 ﻿#pragma once
 #include "Base/Base.h"
+#include "AssemblyPattern.h"
 #include <memory>
 
 typedef Eigen::SparseMatrix<double> SpMat;
 typedef Eigen::Triplet<double> Tri;
 
 class StructureData;
+class CompactModel;
+class Node;
 class Force_Node;
 class Force_Element;
 class Force_Gravity;
@@ -21,10 +24,15 @@ public:
     double m_StepSize = 0.0;       ///< 每步大小
     double m_Tolerance = 1e-5;     ///< 容差
     int m_MaxIterations = 32;      ///< 最大迭代次数
+    int m_nModes = 10;             ///< 模态个数（模态类分析步）
+    double m_DampingRatio = 0.0;   ///< 模态阻尼比（模态叠加分析步）
+    double m_EigenTolerance = 1e-8;  ///< 特征值迭代容差（模态类、屈曲分析步）
+    int m_EigenMaxIterations = 100;  ///< 特征值迭代最大次数（模态类、屈曲分析步）
 
     int m_nFixed = 0;              ///< 约束自由度个数
     int m_nFree = 0;               ///< 自由自由度个数
     SpMat m_K11, m_K21, m_K22;
+    SpMat m_M22;                   ///< 自由自由度的集中质量矩阵
 
     /**
      * @brief 获取分析步类型名称
@@ -68,9 +76,45 @@ public:
      */
     void Solve_Dynamic();
 
+    /**
+     * @brief 模态叠加动力求解
+     *
+     * 在当前构形的切线刚度上提取前 m_nModes 阶模态，以当前不平衡力为阶跃荷载，
+     * 逐阶精确积分解耦的模态方程，过程中只在输出节点上恢复物理量。
+     * 荷载在分析步内保持不变（模型中没有荷载时程曲线，SolverModal 的时变模态力接口暂未使用）。
+     */
+    void Solve_ModalDynamic();
+
+    /**
+     * @brief 固有频率提取
+     *
+     * 在当前构形的切线刚度 K22 和集中质量 M22 上求前 m_nModes 阶特征对，
+     * 每阶振型作为一帧保存到输出器（帧时间为频率 Hz）。
+     */
+    void Solve_Frequency();
+
+    /**
+     * @brief 线性/预屈曲特征值分析
+     *
+     * 以当前构形的切线刚度 K 为基础，由本步参考荷载的线性位移求几何刚度增量 ΔKg，
+     * 求解 K φ = -λ ΔKg φ 的前 m_nModes 个临界荷载系数（K 只分解一次，静力求解与特征迭代共用）。
+     * 每阶屈曲模态作为一帧保存到输出器（帧时间为临界荷载系数）。
+     */
+    void Solve_Buckle();
+
+    /**
+     * @brief 频域简谐响应求解
+     *
+     * 对 StepSize, 2*StepSize, ..., Time (Hz) 各激励频率求解 (K + iωC - ω²M) u = F，
+     * C 为在频率范围两端取阻尼比 m_DampingRatio 的 Rayleigh 阻尼。频率在多个线程间并行求解，
+     * 每个频率的幅值按频率顺序作为一帧写入输出器（帧时间为频率 Hz）。
+     */
+    void Solve_Harmonic();
+
 private:
     std::weak_ptr<StructureData> m_pStructure;  ///< 结构数据的弱引用
     StructureData* m_pData = nullptr;           ///< 结构数据的缓存指针
+    AssemblyPattern m_AssemblyPattern;          ///< 整体矩阵的组装模式
 
     /**
      * @brief 准备数据，缓存结构指针
@@ -88,6 +132,9 @@ private:
     */
     void Init_Nodevector();
 
+    /**
+     * @brief 确保单元常量表（EA、ρA、初始长度等）有效，失效时重新计算
+     */
     void Get_ElementLength();
 
     /**
@@ -96,14 +143,44 @@ private:
     void AssembleKs();
 
     /**
-     * @brief 将单元刚度矩阵组装到整体刚度矩阵
-     * @param [in] DOFs 单元自由度编号数组
-     * @param [in] T 单元刚度矩阵
-     * @param [in,out] L11 K11 矩阵的三元组列表
-     * @param [in,out] L21 K21 矩阵的三元组列表
-     * @param [in,out] L22 K22 矩阵的三元组列表
+     * @brief 组装自由自由度的集中质量矩阵 m_M22
+     */
+    void AssembleMs();
+
+    /**
+     * @brief 由 m_K22、m_M22 提取前 m_nModes 阶模态（移位求逆子空间迭代，多线程块回代）
+     *
+     * 移位取频谱上界 max(Kii/Mii) 的一个小的负比例，刚度矩阵奇异（零频模态）时分解仍然可行。
+     * @param [out] omega 各阶圆频率（升序，负特征值截为 0；刚体模态由 SolverModal 按 rigid_ratio 判断）
+     * @param [out] Phi 质量归一化振型（按列）
+     * @return 成功返回 true
+     */
+    bool Extract_Modes(VectorXd& omega, MatrixXd& Phi);
+
+    /**
+     * @brief 组装由自由自由度位移增量引起的几何刚度增量
+     * @param [in] x2 自由自由度位移增量
+     * @param [out] Kg22 几何刚度增量矩阵（自由自由度部分）
+     */
+    void AssembleKg(const VectorXd& x2, SpMat& Kg22);
+
+    /**
+     * @brief 将各阶振型依次写入节点位移并保存为帧，完成后恢复节点位移
+     * @param [in] frameTimes 各帧的帧时间（频率或荷载系数）
+     * @param [in] Phi 振型（按列，自由自由度部分）
+     */
+    void Save_ModeShapes(const VectorXd& frameTimes, const MatrixXd& Phi);
+
+    /**
+     * @brief 获取需要输出结果的节点（输出器未指定时为全部节点）
+     * @param [out] outNodes 节点列表
+     */
+    void Get_OutputNodes(std::vector<std::shared_ptr<Node>>& outNodes);
+
+    /**
+     * @brief 获取整体矩阵的组装模式（紧凑模型重建或自由度划分改变后重新建立）
      */
-    void Assemble(std::vector<int>& DOFs, Eigen::MatrixXd& T, std::list<Tri>& L11, std::list<Tri>& L21, std::list<Tri>& L22);
+    const AssemblyPattern& Get_AssemblyPattern();
 
     /**
      * @brief 组装所有荷载到力向量
@@ -121,6 +198,13 @@ private:
 
     void Get_CurrentInforce(VectorXd& Inforce);
 
+    /**
+     * @brief 统一自由度布局下的单元内力累加（单元自由度和内力按固定步长连续存放）
+     * @tparam NDOF 节点自由度数（3 或 6）
+     */
+    template <int NDOF>
+    void Get_CurrentInforceFixed(VectorXd& Inforce);
+
     bool Check_Rhs(Eigen::VectorXd& F2, Eigen::VectorXd& f2, Eigen::VectorXd& Rhs);
     /**
      * @brief 组装节点力荷载
@@ -0,0 +1,217 @@
+﻿#include "AssemblyPattern.h"
+#include "DataStructure/Structure/CompactModel.h"
+#include <algorithm>
+
+namespace
+{
+    typedef Eigen::Triplet<double> Tri;
+
+    // 全局自由度对 (ii, jj) 所在的分块及分块内的行列号；K12 不保存，返回 false
+    bool Classify(int ii, int jj, int nFixed, AssemblyPattern::Part& part, int& row, int& col)
+    {
+        if (ii < 0 || jj < 0) return false;
+        if (jj < nFixed)
+        {
+            part = ii < nFixed ? AssemblyPattern::Part::K11 : AssemblyPattern::Part::K21;
+            row = ii < nFixed ? ii : ii - nFixed;
+            col = jj;
+            return true;
+        }
+        if (ii < nFixed) return false;
+        part = AssemblyPattern::Part::K22;
+        row = ii - nFixed;
+        col = jj - nFixed;
+        return true;
+    }
+
+    // (row, col) 在压缩存储值数组中的位置（列内行号有序，二分查找）
+    int Locate(const AssemblyPattern::SpMat& A, int row, int col)
+    {
+        const int* inner = A.innerIndexPtr();
+        const int* pos = std::lower_bound(inner + A.outerIndexPtr()[col], inner + A.outerIndexPtr()[col + 1], row);
+        return static_cast<int>(pos - inner);
+    }
+
+    // 固定尺寸内核：N×N 单元矩阵按位置累加到 K22 的值数组
+    template <int N>
+    void Scatter_Fixed(const double* T, const int* position, double* values)
+    {
+        const Eigen::Map<const Eigen::Matrix<double, N, N>> ke(T);
+        const Eigen::Map<const Eigen::Matrix<int, N, N>> target(position);
+        for (int j = 0; j < N; ++j)
+        {
+            for (int i = 0; i < N; ++i)
+            {
+                if (target(i, j) >= 0) values[target(i, j)] += ke(i, j);
+            }
+        }
+    }
+
+    void Scatter_Dynamic(int nEntry, const double* T, const int* position, double* values)
+    {
+        for (int k = 0; k < nEntry; ++k)
+        {
+            if (position[k] >= 0) values[position[k]] += T[k];
+        }
+    }
+}
+
+void AssemblyPattern::Build(const CompactModel& model, int nFixed, int nFree)
+{
+    Clear();
+
+    const int nElement = model.ElementCount();
+    std::vector<Tri> list11, list21, list22;
+    list22.reserve(static_cast<size_t>(nFree));
+    for (int i = 0; i < nFree; ++i) list22.push_back(Tri(i, i, 0.0));  // 对角元总是存在（组装后在对角线上加小量）
+
+    // 第一遍：各分块的非零结构
+    m_EntryPtr.reserve(nElement + 1);
+    m_EntryPtr.push_back(0);
+    for (int e = 0; e < nElement; ++e)
+    {
+        const int dofBegin = model.m_ElemDofPtr[e];
+        const int nDOF = model.m_ElemDofPtr[e + 1] - dofBegin;
+        const int* DOFs = model.m_ElemDof.data() + dofBegin;
+        for (int j = 0; j < nDOF; ++j)
+        {
+            for (int i = 0; i < nDOF; ++i)
+            {
+                Part part;
+                int row, col;
+                if (!Classify(DOFs[i], DOFs[j], nFixed, part, row, col)) continue;
+                std::vector<Tri>& list = Part::K11 == part ? list11 : (Part::K21 == part ? list21 : list22);
+                list.push_back(Tri(row, col, 0.0));
+            }
+        }
+        m_EntryPtr.push_back(m_EntryPtr.back() + nDOF * nDOF);
+    }
+
+    m_K11.resize(nFixed, nFixed);
+    m_K21.resize(nFree, nFixed);
+    m_K22.resize(nFree, nFree);
+    m_K11.setFromTriplets(list11.begin(), list11.end());
+    m_K21.setFromTriplets(list21.begin(), list21.end());
+    m_K22.setFromTriplets(list22.begin(), list22.end());
+    std::vector<Tri>().swap(list11);
+    std::vector<Tri>().swap(list21);
+    std::vector<Tri>().swap(list22);
+
+    // 第二遍：单元矩阵各项的写入位置
+    m_Position22.assign(m_EntryPtr.back(), -1);
+    m_FixedPtr.reserve(nElement + 1);
+    m_FixedPtr.push_back(0);
+    for (int e = 0; e < nElement; ++e)
+    {
+        const int dofBegin = model.m_ElemDofPtr[e];
+        const int nDOF = model.m_ElemDofPtr[e + 1] - dofBegin;
+        const int* DOFs = model.m_ElemDof.data() + dofBegin;
+        int* position = m_Position22.data() + m_EntryPtr[e];
+        for (int j = 0; j < nDOF; ++j)
+        {
+            for (int i = 0; i < nDOF; ++i)
+            {
+                Part part;
+                int row, col;
+                if (!Classify(DOFs[i], DOFs[j], nFixed, part, row, col)) continue;
+                if (Part::K22 == part)
+                {
+                    position[i + nDOF * j] = Locate(m_K22, row, col);
+                }
+                else
+                {
+                    m_Fixed.push_back({ i + nDOF * j, Locate(Part::K11 == part ? m_K11 : m_K21, row, col), part });
+                }
+            }
+        }
+        m_FixedPtr.push_back(static_cast<int>(m_Fixed.size()));
+    }
+
+    m_pModel = &model;
+    m_Version = model.BuildVersion();
+    m_nFixed = nFixed;
+    m_nFree = nFree;
+    m_UniformDOF = CompactModel::LineElementNodes * model.UniformNodeDOF();
+}
+
+void AssemblyPattern::Clear()
+{
+    m_pModel = nullptr;
+    m_Version = 0;
+    m_nFixed = 0;
+    m_nFree = 0;
+    m_UniformDOF = 0;
+    m_K11.resize(0, 0);
+    m_K21.resize(0, 0);
+    m_K22.resize(0, 0);
+    m_K11.data().squeeze();
+    m_K21.data().squeeze();
+    m_K22.data().squeeze();
+    m_EntryPtr.clear();
+    m_Position22.clear();
+    m_FixedPtr.clear();
+    m_Fixed.clear();
+}
+
+bool AssemblyPattern::IsValid(const CompactModel& model, int nFixed, int nFree) const
+{
+    return m_pModel == &model && model.IsBuilt() && m_Version == model.BuildVersion() &&
+        m_nFixed == nFixed && m_nFree == nFree;
+}
+
+void AssemblyPattern::Reset(Part part, SpMat& A) const
+{
+    A = Part::K11 == part ? m_K11 : (Part::K21 == part ? m_K21 : m_K22);
+}
+
+void AssemblyPattern::Scatter(int begin, int end, const std::vector<double>& T, SpMat* pK11, SpMat* pK21, SpMat& K22) const
+{
+    double* values22 = K22.valuePtr();
+    double* values11 = pK11 ? pK11->valuePtr() : nullptr;
+    double* values21 = pK21 ? pK21->valuePtr() : nullptr;
+
+    switch (m_UniformDOF)
+    {
+    case 6:  Scatter_Uniform<6>(begin, end, T.data(), values11, values21, values22);  return;  // 桁架
+    case 12: Scatter_Uniform<12>(begin, end, T.data(), values11, values21, values22); return;  // 梁
+    default: break;
+    }
+
+    const int offset = m_EntryPtr[begin];
+    for (int e = begin; e < end; ++e)
+    {
+        const int nEntry = m_EntryPtr[e + 1] - m_EntryPtr[e];
+        const double* ke = T.data() + (m_EntryPtr[e] - offset);
+        const int* position = m_Position22.data() + m_EntryPtr[e];
+        switch (nEntry)
+        {
+        case 36:  Scatter_Fixed<6>(ke, position, values22);  break;  // 桁架
+        case 64:  Scatter_Fixed<8>(ke, position, values22);  break;  // 索
+        case 144: Scatter_Fixed<12>(ke, position, values22); break;  // 梁
+        default:  Scatter_Dynamic(nEntry, ke, position, values22); break;
+        }
+        Scatter_FixedEntries(e, ke, values11, values21);
+    }
+}
+
+template <int N>
+void AssemblyPattern::Scatter_Uniform(int begin, int end, const double* T, double* values11, double* values21, double* values22) const
+{
+    constexpr int nEntry = N * N;
+    const int* position = m_Position22.data() + static_cast<size_t>(nEntry) * begin;
+    for (int e = begin; e < end; ++e, T += nEntry, position += nEntry)
+    {
+        Scatter_Fixed<N>(T, position, values22);
+        Scatter_FixedEntries(e, T, values11, values21);
+    }
+}
+
+void AssemblyPattern::Scatter_FixedEntries(int e, const double* ke, double* values11, double* values21) const
+{
+    for (int f = m_FixedPtr[e]; f < m_FixedPtr[e + 1]; ++f)
+    {
+        const FixedEntry& entry = m_Fixed[f];
+        double* values = Part::K11 == entry.m_Part ? values11 : values21;
+        if (values) values[entry.m_Position] += ke[entry.m_Index];
+    }
+}
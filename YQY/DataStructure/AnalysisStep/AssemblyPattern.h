@@ -0,0 +1,104 @@
+﻿#pragma once
+#include <cstdint>
+#include <vector>
+#include <Eigen/Sparse>
+
+class CompactModel;
+
+/**
+ * @brief 整体矩阵组装模式 - 预先建立 K11、K21、K22 的压缩存储结构，以及单元矩阵每一项在值数组中的位置
+ *
+ * 自由度编号和单元连接不变时整体矩阵的非零结构不变：建立一次后，每次组装只需复制零值的结构，
+ * 再把 ElementBatch 输出的单元矩阵按预先算好的位置逐项累加，不再生成三元组列表、排序和合并重复项。
+ * 6、8、12 个自由度的单元使用固定尺寸的 Eigen::Matrix<double, N, N> 内核；
+ * 自由度布局统一（CompactModel::UniformNodeDOF）时单元矩阵按固定步长寻址，整批只分派一次。
+ * 非零结构与按三元组组装的结果相同（重复项同样按单元顺序累加），K22 另外包含全部对角元。
+ * 紧凑模型重建（Build）或自由度划分改变后需重新建立。
+ */
+class AssemblyPattern
+{
+public:
+    typedef Eigen::SparseMatrix<double> SpMat;
+
+    /**
+     * @brief 整体矩阵的分块
+     */
+    enum class Part
+    {
+        K11,  ///< 约束-约束
+        K21,  ///< 自由-约束
+        K22   ///< 自由-自由
+    };
+
+    /**
+     * @brief 由紧凑模型的单元自由度建立组装模式
+     * @param [in] model 紧凑模型（已建立）
+     * @param [in] nFixed 约束自由度个数（全局编号 [0, nFixed)）
+     * @param [in] nFree 自由自由度个数（全局编号 [nFixed, nFixed + nFree)）
+     */
+    void Build(const CompactModel& model, int nFixed, int nFree);
+
+    /**
+     * @brief 清空
+     */
+    void Clear();
+
+    /**
+     * @brief 是否由当前的紧凑模型和自由度划分建立
+     */
+    bool IsValid(const CompactModel& model, int nFixed, int nFree) const;
+
+    /**
+     * @brief 把矩阵设为该分块的非零结构，值全部为零
+     * @param [in] part 分块
+     * @param [out] A 整体矩阵（尺寸相同时不重新分配内存）
+     */
+    void Reset(Part part, SpMat& A) const;
+
+    /**
+     * @brief 把一批单元矩阵累加到整体矩阵
+     * @param [in] begin, end 单元区间
+     * @param [in] T 单元矩阵缓冲区（ElementBatch 的输出：每个单元 nDOF×nDOF，按列存储）
+     * @param [in,out] pK11 K11，为空时不组装
+     * @param [in,out] pK21 K21，为空时不组装
+     * @param [in,out] K22 K22
+     *
+     * 矩阵须先经 Reset 设为对应分块的结构。
+     */
+    void Scatter(int begin, int end, const std::vector<double>& T, SpMat* pK11, SpMat* pK21, SpMat& K22) const;
+
+private:
+    /**
+     * @brief 统一自由度布局下的批量累加（每个单元 N×N，按固定步长寻址）
+     * @tparam N 单元自由度数（6 或 12）
+     */
+    template <int N>
+    void Scatter_Uniform(int begin, int end, const double* T, double* values11, double* values21, double* values22) const;
+
+    /**
+     * @brief 把单元 e 落在 K11、K21 中的项累加到对应的值数组（为空时跳过）
+     */
+    void Scatter_FixedEntries(int e, const double* ke, double* values11, double* values21) const;
+
+    /**
+     * @brief 单元矩阵中落在 K11 或 K21 的一项
+     */
+    struct FixedEntry
+    {
+        int m_Index;     ///< 单元矩阵中的下标（按列存储）
+        int m_Position;  ///< 整体矩阵值数组中的位置
+        Part m_Part;     ///< 所在分块
+    };
+
+    const CompactModel* m_pModel = nullptr;  ///< 建立时的紧凑模型
+    uint64_t m_Version = 0;                  ///< 建立时紧凑模型的版本（未建立为 0）
+    int m_nFixed = 0;                        ///< 约束自由度个数
+    int m_nFree = 0;                         ///< 自由自由度个数
+    int m_UniformDOF = 0;                    ///< 统一的单元自由度数（6 或 12），布局不统一为 0
+
+    SpMat m_K11, m_K21, m_K22;               ///< 各分块的非零结构（值为零）
+    std::vector<int> m_EntryPtr;             ///< 单元矩阵在缓冲区中的起点（长度 nElement+1）
+    std::vector<int> m_Position22;           ///< 单元矩阵各项在 K22 值数组中的位置，不在 K22 中为 -1
+    std::vector<int> m_FixedPtr;             ///< 单元在 m_Fixed 中的 CSR 行指针（长度 nElement+1）
+    std::vector<FixedEntry> m_Fixed;         ///< 落在 K11、K21 中的项（只有连接约束自由度的单元才有）
+};
@@ -21,3 +21,40 @@ void ElementBase::GetDOFs(std::vector<int>& DOFs)
         }
     }
 }
+
+const ElementConstants& ElementBase::Get_Const()
+{
+    if (m_Const.valid) return m_Const;
+
+    ElementConstants c;
+    if (auto pProperty = m_pProperty.lock()) Compute_PropertyConst(*pProperty, c);
+
+    // 初始长度：前两个节点间的距离
+    auto pNode0 = m_pNode.size() >= 2 ? m_pNode[0].lock() : nullptr;
+    auto pNode1 = m_pNode.size() >= 2 ? m_pNode[1].lock() : nullptr;
+    if (pNode0 && pNode1)
+    {
+        double dx0 = pNode1->m_X - pNode0->m_X;
+        double dy0 = pNode1->m_Y - pNode0->m_Y;
+        double dz0 = pNode1->m_Z - pNode0->m_Z;
+        c.L0 = sqrt(dx0 * dx0 + dy0 * dy0 + dz0 * dz0);
+    }
+
+    c.valid = true;
+    L0 = c.L0;
+    m_Const = c;
+    return m_Const;
+}
+
+bool ElementBase::Compute_PropertyConst(const Property& property, ElementConstants& c)
+{
+    auto pMaterial = property.m_pMaterial.lock();
+    auto pSection = property.m_pSection.lock();
+    if (!pMaterial || !pSection) return false;
+
+    c.E = pMaterial->m_Young;
+    c.EA = pMaterial->m_Young * pSection->m_Area;
+    c.rhoA = pMaterial->m_Density * pSection->m_Area;
+    c.yield = pMaterial->m_MaxStress;
+    return true;
+}
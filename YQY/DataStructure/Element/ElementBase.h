@@ -4,6 +4,7 @@
 #include "DataStructure/Section/SectionBase.h"
 #include "DataStructure/Material/Material.h"
 #include "DataStructure/Node/Node.h"
+#include "ElementConstants.h"
 
 /**
  * @brief 单元基类 - 所有单元类型的公共基类
@@ -22,6 +23,12 @@ public:
      */
     virtual int Get_NodeDOF() const = 0;
 
+    /**
+     * @brief 获取单元类型
+     * @return 单元类型枚举
+     */
+    virtual EnumKeyword::ElementType Get_ElementType() const = 0;
+
     /**
      * @brief 获取单元所有自由度编号
      * @param [out] DOFs 自由度编号数组
@@ -29,6 +36,22 @@ public:
     void GetDOFs(std::vector<int>& DOFs);
 
     double L0;  ///< 单元初始长度
+    ElementConstants m_Const;  ///< 单元常量（由 CompactModel::UpdateConstants 写入，单元计算经 Get_Const 读取，不再访问属性、材料和截面）
+
+    /**
+     * @brief 获取单元常量
+     * @return 单元常量；尚未计算（紧凑模型建立之前，或材料、截面修改之后）时先由属性和节点坐标计算
+     */
+    const ElementConstants& Get_Const();
+
+    /**
+     * @brief 由属性的材料和截面计算单元常量中与几何无关的部分（E、EA、ρA、屈服应力）
+     * @param [in] property 属性
+     * @param [out] c 单元常量
+     * @return 材料或截面不存在时返回 false，对应的量保持不变
+     */
+    static bool Compute_PropertyConst(const Property& property, ElementConstants& c);
+
     Eigen::VectorXd m_inforce;
     /**
      * @brief 获取单元刚度矩阵
@@ -37,4 +60,24 @@ public:
     virtual void Get_ke(MatrixXd& ke) = 0;
     virtual void Get_ke_non(MatrixXd& ke) = 0;
     virtual void Get_L0() = 0;
+
+    /**
+     * @brief 获取当前变形状态下切线刚度的材料部分与几何部分（同时更新单元应力和内力）
+     * @param [out] km 材料刚度矩阵
+     * @param [out] kg 几何刚度矩阵，应力为零时为空矩阵
+     */
+    virtual void Get_ke_split(MatrixXd& km, MatrixXd& kg) = 0;
+
+    /**
+     * @brief 由单元位移增量计算几何刚度增量（屈曲分析的参考荷载状态）
+     * @param [in] due 单元自由度位移增量
+     * @param [out] kg 几何刚度矩阵增量，单元不提供时为空矩阵
+     */
+    virtual void Get_kg_increment(const VectorXd& due, MatrixXd& kg) = 0;
+
+    /**
+     * @brief 获取单元集中质量矩阵（需先调用 Get_L0）
+     * @param [out] me 单元质量矩阵，单元不提供质量时为空矩阵
+     */
+    virtual void Get_me(MatrixXd& me) = 0;
 };
@@ -0,0 +1,215 @@
+﻿#include "ElementBatch.h"
+#include "ElementTruss.h"
+#include "ElementCable.h"
+#include "ElementBeam.h"
+#include <algorithm>
+#include <type_traits>
+
+namespace
+{
+    // 复制单元对象返回的矩阵，尺寸不符（单元未实现）时写入零矩阵
+    void Copy_Matrix(const MatrixXd& src, int nDOF, double* dst)
+    {
+        if (src.rows() == nDOF && src.cols() == nDOF)
+        {
+            std::copy(src.data(), src.data() + nDOF * nDOF, dst);
+        }
+        else
+        {
+            std::fill(dst, dst + nDOF * nDOF, 0.0);
+        }
+    }
+
+    // 通用实现：对具体单元类型做非虚调用（TElement 为抽象基类时退化为虚调用）
+    template <class TElement>
+    struct BlockEval
+    {
+        static constexpr bool bStatic = !std::is_abstract_v<TElement>;
+
+        static void Tangent(CompactModel& model, int e, double* ke, MatrixXd& work)
+        {
+            const int nDOF = model.m_ElemDofPtr[e + 1] - model.m_ElemDofPtr[e];
+            ElementBase* pBase = model.m_ElementView[e];
+            auto* pElement = static_cast<TElement*>(pBase);
+            work.resize(0, 0);
+            if constexpr (bStatic) pElement->TElement::Get_ke_non(work);
+            else pElement->Get_ke_non(work);
+            Copy_Matrix(work, nDOF, ke);
+
+            double* inforce = model.m_ElemForce.data() + model.m_ElemDofPtr[e];
+            for (int i = 0; i < nDOF; ++i)
+            {
+                inforce[i] = i < pBase->m_inforce.size() ? pBase->m_inforce[i] : 0.0;
+            }
+            model.m_ElemStress[e] = pBase->m_Stress;
+        }
+
+        static void Mass(const CompactModel& model, int e, double* me, MatrixXd& work)
+        {
+            const int nDOF = model.m_ElemDofPtr[e + 1] - model.m_ElemDofPtr[e];
+            auto* pElement = static_cast<TElement*>(model.m_ElementView[e]);
+            work.resize(0, 0);
+            if constexpr (bStatic) pElement->TElement::Get_me(work);
+            else pElement->Get_me(work);
+            Copy_Matrix(work, nDOF, me);
+        }
+
+        static void GeometricIncrement(const CompactModel& model, int e, const double* dU, double* kg, MatrixXd& work)
+        {
+            const int nDOF = model.m_ElemDofPtr[e + 1] - model.m_ElemDofPtr[e];
+            const int* dofs = model.m_ElemDof.data() + model.m_ElemDofPtr[e];
+            VectorXd due(nDOF);
+            for (int i = 0; i < nDOF; ++i) due[i] = dofs[i] >= 0 ? dU[dofs[i]] : 0.0;
+
+            auto* pElement = static_cast<TElement*>(model.m_ElementView[e]);
+            work.resize(0, 0);
+            if constexpr (bStatic) pElement->TElement::Get_kg_increment(due, work);
+            else pElement->Get_kg_increment(due, work);
+            Copy_Matrix(work, nDOF, kg);
+        }
+    };
+
+    // 桁架单元：直接读取紧凑数组和单元常量表
+    template <>
+    struct BlockEval<ElementTruss>
+    {
+        // 当前构形下节点 1 相对节点 0 的向量，单元数据不完整时返回 false
+        static bool Current_Vector(const CompactModel& model, int e, double& dx, double& dy, double& dz)
+        {
+            const int* nodes = model.m_ElemNode.data() + model.m_ElemNodePtr[e];
+            if (nodes[0] < 0 || nodes[1] < 0 || model.m_ElemProperty[e] < 0) return false;
+
+            const int* dofs = model.m_ElemDof.data() + model.m_ElemDofPtr[e];
+            const double* U = model.m_U.data();
+            const double* X0 = model.m_NodeCoord.data() + 3 * nodes[0];
+            const double* X1 = model.m_NodeCoord.data() + 3 * nodes[1];
+
+            dx = X1[0] + U[dofs[3]] - X0[0] - U[dofs[0]];
+            dy = X1[1] + U[dofs[4]] - X0[1] - U[dofs[1]];
+            dz = X1[2] + U[dofs[5]] - X0[2] - U[dofs[2]];
+            return true;
+        }
+
+        static void Tangent(CompactModel& model, int e, double* ke, MatrixXd&)
+        {
+            double* inforce = model.m_ElemForce.data() + model.m_ElemDofPtr[e];
+            double dx, dy, dz;
+            if (!Current_Vector(model, e, dx, dy, dz))
+            {
+                std::fill(ke, ke + 36, 0.0);
+                std::fill(inforce, inforce + 6, 0.0);
+                return;
+            }
+
+            const ElementConstants& c = model.m_ElemConst[e];
+            double kg[36];
+            if (ElementTruss::Compute_Tangent(dx, dy, dz, c.E, c.EA, c.L0, ke, kg, inforce, model.m_ElemStress[e]))
+            {
+                for (int k = 0; k < 36; ++k) ke[k] += kg[k];
+            }
+        }
+
+        static void Mass(const CompactModel& model, int e, double* me, MatrixXd&)
+        {// 集中质量：ρAL0/2 分配到两端节点的三个平移自由度
+            std::fill(me, me + 36, 0.0);
+            if (model.m_ElemProperty[e] < 0) return;
+
+            double nodalMass = model.m_ElemConst[e].rhoA * model.m_ElemConst[e].L0 / 2.0;
+            for (int i = 0; i < 6; ++i) me[i + 6 * i] = nodalMass;
+        }
+
+        static void GeometricIncrement(const CompactModel& model, int e, const double* dU, double* kg, MatrixXd&)
+        {
+            double dx, dy, dz;
+            if (!Current_Vector(model, e, dx, dy, dz))
+            {
+                std::fill(kg, kg + 36, 0.0);
+                return;
+            }
+
+            const int* dofs = model.m_ElemDof.data() + model.m_ElemDofPtr[e];
+            double due[6];
+            for (int i = 0; i < 6; ++i) due[i] = dU[dofs[i]];
+
+            const ElementConstants& c = model.m_ElemConst[e];
+            ElementTruss::Compute_kg_increment(dx, dy, dz, c.EA, c.L0, due, kg);
+        }
+    };
+
+    // 缓冲区按区间内各单元 nDOF² 之和分配
+    void Resize_Buffer(const CompactModel& model, int begin, int end, std::vector<double>& buffer)
+    {
+        size_t size = 0;
+        for (int e = begin; e < end; ++e)
+        {
+            size_t nDOF = model.m_ElemDofPtr[e + 1] - model.m_ElemDofPtr[e];
+            size += nDOF * nDOF;
+        }
+        buffer.resize(size);
+    }
+
+    // 按单元块类型静态分派：fn 以具体单元类型的空指针作为类型标记调用
+    template <class Fn>
+    void Dispatch(EnumKeyword::ElementType type, Fn fn)
+    {
+        switch (type)
+        {
+        case EnumKeyword::ElementType::T3D2:  fn(static_cast<ElementTruss*>(nullptr)); break;
+        case EnumKeyword::ElementType::CABLE: fn(static_cast<ElementCable*>(nullptr)); break;
+        case EnumKeyword::ElementType::B31:   fn(static_cast<ElementBeam*>(nullptr));  break;
+        default:                              fn(static_cast<ElementBase*>(nullptr));  break;
+        }
+    }
+}
+
+void ElementBatch::Tangent(CompactModel& model, const ElementBlock& block, int begin, int end, std::vector<double>& ke)
+{
+    Resize_Buffer(model, begin, end, ke);
+    Dispatch(block.m_Type, [&](auto* tag)
+        {
+            using Eval = BlockEval<std::remove_pointer_t<decltype(tag)>>;
+            MatrixXd work;
+            double* p = ke.data();
+            for (int e = begin; e < end; ++e)
+            {
+                const int nDOF = model.m_ElemDofPtr[e + 1] - model.m_ElemDofPtr[e];
+                Eval::Tangent(model, e, p, work);
+                p += nDOF * nDOF;
+            }
+        });
+}
+
+void ElementBatch::Mass(const CompactModel& model, const ElementBlock& block, int begin, int end, std::vector<double>& me)
+{
+    Resize_Buffer(model, begin, end, me);
+    Dispatch(block.m_Type, [&](auto* tag)
+        {
+            using Eval = BlockEval<std::remove_pointer_t<decltype(tag)>>;
+            MatrixXd work;
+            double* p = me.data();
+            for (int e = begin; e < end; ++e)
+            {
+                const int nDOF = model.m_ElemDofPtr[e + 1] - model.m_ElemDofPtr[e];
+                Eval::Mass(model, e, p, work);
+                p += nDOF * nDOF;
+            }
+        });
+}
+
+void ElementBatch::GeometricIncrement(const CompactModel& model, const ElementBlock& block, int begin, int end,
+    const Eigen::VectorXd& dU, std::vector<double>& kg)
+{
+    Resize_Buffer(model, begin, end, kg);
+    Dispatch(block.m_Type, [&](auto* tag)
+        {
+            using Eval = BlockEval<std::remove_pointer_t<decltype(tag)>>;
+            MatrixXd work;
+            double* p = kg.data();
+            for (int e = begin; e < end; ++e)
+            {
+                const int nDOF = model.m_ElemDofPtr[e + 1] - model.m_ElemDofPtr[e];
+                Eval::GeometricIncrement(model, e, dU.data(), p, work);
+                p += nDOF * nDOF;
+            }
+        });
+}
@@ -0,0 +1,46 @@
+﻿#pragma once
+#include <vector>
+#include <Eigen/Dense>
+#include "DataStructure/Structure/CompactModel.h"
+
+/**
+ * @brief 单元块批量计算 - 按单元类型静态分派，内层循环没有虚函数调用
+ *
+ * 每次处理一个单元块中的连续区间 [begin, end)，单元矩阵按单元顺序连续写入输出缓冲区
+ * （每个单元 nDOF×nDOF，按列存储），由调用者组装。桁架单元直接读取紧凑数组和单元常量表，
+ * 索、梁单元对具体类型做非虚调用。
+ */
+class ElementBatch
+{
+public:
+    static const int ChunkSize = 256;  ///< 每批单元个数（缓冲区约 ChunkSize*nDOF² 个双精度数）
+
+    /**
+     * @brief 批量计算切线刚度，同时更新紧凑数组中的单元应力和单元内力
+     * @param [in,out] model 紧凑模型
+     * @param [in] block 单元块
+     * @param [in] begin, end 单元区间（位于 block 内）
+     * @param [out] ke 单元刚度矩阵缓冲区
+     */
+    static void Tangent(CompactModel& model, const ElementBlock& block, int begin, int end, std::vector<double>& ke);
+
+    /**
+     * @brief 批量计算集中质量矩阵，不提供质量的单元写入零矩阵
+     * @param [in] model 紧凑模型
+     * @param [in] block 单元块
+     * @param [in] begin, end 单元区间（位于 block 内）
+     * @param [out] me 单元质量矩阵缓冲区
+     */
+    static void Mass(const CompactModel& model, const ElementBlock& block, int begin, int end, std::vector<double>& me);
+
+    /**
+     * @brief 批量计算由位移增量引起的几何刚度增量
+     * @param [in] model 紧凑模型
+     * @param [in] block 单元块
+     * @param [in] begin, end 单元区间（位于 block 内）
+     * @param [in] dU 全局位移增量（按全局自由度编号，约束自由度为零）
+     * @param [out] kg 几何刚度增量缓冲区
+     */
+    static void GeometricIncrement(const CompactModel& model, const ElementBlock& block, int begin, int end,
+        const Eigen::VectorXd& dU, std::vector<double>& kg);
+};
@@ -17,6 +17,18 @@ void ElementBeam::Get_L0()
 {
 }
 
+void ElementBeam::Get_me(MatrixXd& me)
+{
+}
+
+void ElementBeam::Get_ke_split(MatrixXd& km, MatrixXd& kg)
+{
+}
+
+void ElementBeam::Get_kg_increment(const VectorXd& due, MatrixXd& kg)
+{
+}
+
 //void ElementBeam::GetDOFs(std::vector<int>& DOFs)
 //{
 //}
@@ -18,6 +18,12 @@ public:
      */
     int Get_NodeDOF() const override { return 6; };
 
+    /**
+     * @brief 获取单元类型
+     * @return EnumKeyword::ElementType::B31（梁单元）
+     */
+    EnumKeyword::ElementType Get_ElementType() const override { return EnumKeyword::ElementType::B31; }
+
     /**
      * @brief 计算单元刚度矩阵
      * @param [out] ke 单元刚度矩阵（12x12）
@@ -25,5 +31,8 @@ public:
     void Get_ke(MatrixXd& ke);
     void Get_ke_non(MatrixXd& ke);
     void Get_L0();
+    void Get_ke_split(MatrixXd& km, MatrixXd& kg);
+    void Get_kg_increment(const VectorXd& due, MatrixXd& kg);
+    void Get_me(MatrixXd& me);
 };
 
@@ -19,3 +19,17 @@ void ElementCable::Get_L0()
 
 }
 
+void ElementCable::Get_me(MatrixXd& me)
+{
+
+}
+
+void ElementCable::Get_ke_split(MatrixXd& km, MatrixXd& kg)
+{
+
+}
+
+void ElementCable::Get_kg_increment(const VectorXd& due, MatrixXd& kg)
+{
+
+}
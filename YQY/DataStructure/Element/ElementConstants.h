@@ -0,0 +1,14 @@
+﻿#pragma once
+
+/**
+ * @brief 单元常量 - 单元计算所需的不随迭代变化的量（打包存放，单元计算只读此表）
+ */
+struct ElementConstants
+{
+    double EA = 0.0;     ///< 轴向刚度 E*A
+    double rhoA = 0.0;   ///< 线密度 ρ*A
+    double L0 = 0.0;     ///< 初始长度
+    double E = 0.0;      ///< 弹性模量
+    double yield = 0.0;  ///< 屈服（极限）应力
+    bool valid = false;  ///< 是否已计算（未计算时单元由属性和节点坐标现场计算）
+};
@@ -7,13 +7,6 @@ ElementTruss::ElementTruss()
 
 void ElementTruss::Get_ke(MatrixXd& ke)
 {
-    auto pProperty = m_pProperty.lock();
-    auto pSection = pProperty->m_pSection.lock();
-    auto pMaterial = pProperty->m_pMaterial.lock();
-
-    double E = pMaterial->m_Young;
-    double A = pSection->m_Area;
-
     auto pNode0 = m_pNode[0].lock();
     auto pNode1 = m_pNode[1].lock();
 
@@ -42,21 +35,37 @@ void ElementTruss::Get_ke(MatrixXd& ke)
     B_matrix << -dirCos_x, -dirCos_y, -dirCos_z, dirCos_x, dirCos_y, dirCos_z;
 
     // 材料刚度系数 EA/L
-    double materialStiffness = E * A / length;
+    double materialStiffness = Get_Const().EA / length;
 
     // 单元刚度矩阵 ke = B * B^T * (EA/L)
     ke = B_matrix * B_matrix.transpose() * materialStiffness;
 }
 
-void ElementTruss::Get_ke_non(MatrixXd& ke)
+// 按几何刚度系数和方向余弦填充几何刚度矩阵 kg = c[I-nnᵀ, -(I-nnᵀ); -(I-nnᵀ), I-nnᵀ]（6x6，按列存储）
+static void Fill_kg(double geometricStiffCoeff, const double* directionVector, double* kg)
 {
-    auto pProperty = m_pProperty.lock();
-    auto pSection = pProperty->m_pSection.lock();
-    auto pMaterial = pProperty->m_pMaterial.lock();
+    for (int j = 0; j < 3; ++j)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            double kij = geometricStiffCoeff * ((i == j ? 1.0 : 0.0) - directionVector[i] * directionVector[j]);
+            kg[i + 6 * j] = kij;
+            kg[i + 3 + 6 * j] = -kij;
+            kg[i + 6 * (j + 3)] = -kij;
+            kg[i + 3 + 6 * (j + 3)] = kij;
+        }
+    }
+}
 
-    double E = pMaterial->m_Young;
-    double A = pSection->m_Area;
+void ElementTruss::Get_ke_non(MatrixXd& ke)
+{
+    MatrixXd kg;
+    Get_ke_split(ke, kg);
+    if (0 != kg.size()) ke += kg;
+}
 
+void ElementTruss::Get_ke_split(MatrixXd& km, MatrixXd& kg)
+{
     auto pNode0 = m_pNode[0].lock();
     auto pNode1 = m_pNode[1].lock();
 
@@ -66,17 +75,26 @@ void ElementTruss::Get_ke_non(MatrixXd& ke)
         return;
     }
 
-    //// 计算初始长度 L0
-    //double dx0 = pNode1->m_X - pNode0->m_X;
-    //double dy0 = pNode1->m_Y - pNode0->m_Y;
-    //double dz0 = pNode1->m_Z - pNode0->m_Z;
-    //L0 = sqrt(dx0 * dx0 + dy0 * dy0 + dz0 * dz0);
-
-    // 计算当前变形后的方向向量 (考虑位移)
-    double dx_current = pNode1->m_X + pNode1->m_Displacement[0] - pNode0->m_X - pNode0->m_Displacement[0];
-    double dy_current = pNode1->m_Y + pNode1->m_Displacement[1] - pNode0->m_Y - pNode0->m_Displacement[1];
-    double dz_current = pNode1->m_Z + pNode1->m_Displacement[2] - pNode0->m_Z - pNode0->m_Displacement[2];
+    // 计算当前变形后的方向向量 (考虑位移；状态未绑定时按未变形构形)
+    const NodeVector& u0 = pNode0->m_Displacement;
+    const NodeVector& u1 = pNode1->m_Displacement;
+    double dx_current = pNode1->m_X + u1[0] - pNode0->m_X - u0[0];
+    double dy_current = pNode1->m_Y + u1[1] - pNode0->m_Y - u0[1];
+    double dz_current = pNode1->m_Z + u1[2] - pNode0->m_Z - u0[2];
+
+    km.resize(6, 6);
+    kg.resize(6, 6);
+    m_inforce.resize(6);
+    const ElementConstants& c = Get_Const();
+    if (!Compute_Tangent(dx_current, dy_current, dz_current, c.E, c.EA, L0, km.data(), kg.data(), m_inforce.data(), m_Stress))
+    {
+        kg.resize(0, 0);
+    }
+}
 
+bool ElementTruss::Compute_Tangent(double dx_current, double dy_current, double dz_current, double E, double EA, double L0,
+    double* km, double* kg, double* inforce, double& stress)
+{
     // 当前长度
     double length_current = sqrt(dx_current * dx_current + dy_current * dy_current + dz_current * dz_current);
 
@@ -86,82 +104,95 @@ void ElementTruss::Get_ke_non(MatrixXd& ke)
     double dirCos_z = dz_current / length_current;
 
     // 应变-位移变换矩阵 B = [-l, -m, -n, l, m, n]
-    VectorXd B_matrix = VectorXd::Zero(6);
-    B_matrix << -dirCos_x, -dirCos_y, -dirCos_z, dirCos_x, dirCos_y, dirCos_z;
+    const double B_matrix[6] = { -dirCos_x, -dirCos_y, -dirCos_z, dirCos_x, dirCos_y, dirCos_z };
+    const double directionVector[3] = { dirCos_x, dirCos_y, dirCos_z };
 
     // 选择应变公式: true = 对数应变(体积不变), false = 工程应变
     bool bUseLogStrain = true;  // TODO: 可改为类成员变量 m_bUseLogStrain
 
+    // 当前轴向刚度 E*A_current：工程应变面积不变，对数应变按体积守恒 A_current = A * L0 / L
+    double EA_current = bUseLogStrain ? EA * L0 / length_current : EA;
+
+    // 材料刚度
+    double materialStiffness = EA_current / L0;
+    for (int j = 0; j < 6; ++j)
+    {
+        for (int i = 0; i < 6; ++i)
+        {
+            km[i + 6 * j] = B_matrix[i] * B_matrix[j] * materialStiffness;
+        }
+    }
+
+    double strain = 0.0;
     if (!bUseLogStrain)
     {
         // ===== 工程应变公式 (Engineering Strain) =====
         // ε = (L - L0) / L0
-        double materialStiffness = E * A / L0;
-        ke = B_matrix * B_matrix.transpose() * materialStiffness;
-
-        double strain = (length_current - L0) / L0;
-        m_Stress = E * strain;
-        double axialForce = m_Stress * A;
-
-        m_inforce = B_matrix * axialForce;
-
-        // 几何刚度矩阵
-        if (0.0 != m_Stress)
-        {
-            Matrix3d I = Matrix3d::Identity();
-            Vector3d directionVector;
-            directionVector << dirCos_x, dirCos_y, dirCos_z;
-
-            double geometricStiffCoeff = A * m_Stress / length_current;
-            Matrix3d Kg_block = geometricStiffCoeff * (I - directionVector * directionVector.transpose());
-
-            ke.block<3, 3>(0, 0) += Kg_block;
-            ke.block<3, 3>(3, 0) -= Kg_block;
-            ke.block<3, 3>(0, 3) -= Kg_block;
-            ke.block<3, 3>(3, 3) += Kg_block;
-        }
+        strain = (length_current - L0) / L0;
     }
     else
     {
         // ===== 对数应变公式 (True Strain / Logarithmic Strain, 体积不变) =====
-        // ε = ln(L / L0), 当前面积 A_current = A * L0 / L (体积守恒)
-        double A_current = A * L0 / length_current;
-        double materialStiffness = E * A_current / L0;
-        ke = B_matrix * B_matrix.transpose() * materialStiffness;
+        strain = log(length_current / L0);  // 对数应变
+    }
+    stress = E * strain;                    // 真应力（工程应变时为工程应力）
 
-        double strain = log(length_current / L0);  // 对数应变
-        m_Stress = E * strain;                     // 真应力
-        double axialForce = m_Stress * A_current;
+    double axialForce = EA_current * strain;  // σ * A_current
+    for (int i = 0; i < 6; ++i)
+    {
+        inforce[i] = B_matrix[i] * axialForce;
+    }
 
-        m_inforce = B_matrix * axialForce;
+    // 几何刚度矩阵 kg = c[I-nnᵀ, -(I-nnᵀ); -(I-nnᵀ), I-nnᵀ]
+    if (0.0 == stress) return false;
 
-        // 几何刚度矩阵
-        if (0.0 != m_Stress)
-        {
-            Matrix3d I = Matrix3d::Identity();
-            Vector3d directionVector;
-            directionVector << dirCos_x, dirCos_y, dirCos_z;
+    Fill_kg(axialForce / length_current, directionVector, kg);
+    return true;
+}
 
-            double geometricStiffCoeff = A_current * m_Stress / length_current;
-            Matrix3d Kg_block = geometricStiffCoeff * (I - directionVector * directionVector.transpose());
+void ElementTruss::Get_kg_increment(const VectorXd& due, MatrixXd& kg)
+{
+    auto pNode0 = m_pNode[0].lock();
+    auto pNode1 = m_pNode[1].lock();
 
-            ke.block<3, 3>(0, 0) += Kg_block;
-            ke.block<3, 3>(3, 0) -= Kg_block;
-            ke.block<3, 3>(0, 3) -= Kg_block;
-            ke.block<3, 3>(3, 3) += Kg_block;
-        }
+    if (pNode0 == nullptr || pNode1 == nullptr)
+    {
+        qDebug().noquote() << QStringLiteral("Error: ElementTruss 节点指针为空");
+        return;
     }
+
+    // 当前构形（状态未绑定时按未变形构形）
+    const NodeVector& u0 = pNode0->m_Displacement;
+    const NodeVector& u1 = pNode1->m_Displacement;
+    double dx_current = pNode1->m_X + u1[0] - pNode0->m_X - u0[0];
+    double dy_current = pNode1->m_Y + u1[1] - pNode0->m_Y - u0[1];
+    double dz_current = pNode1->m_Z + u1[2] - pNode0->m_Z - u0[2];
+
+    kg.resize(6, 6);
+    const double EA = Get_Const().EA;// 先取常量（现场计算时同时写入 L0）
+    Compute_kg_increment(dx_current, dy_current, dz_current, EA, L0, due.data(), kg.data());
 }
 
-void ElementTruss::Get_L0()
+void ElementTruss::Compute_kg_increment(double dx_current, double dy_current, double dz_current, double EA, double L0,
+    const double* due, double* kg)
 {
-    auto pProperty = m_pProperty.lock();
-    auto pSection = pProperty->m_pSection.lock();
-    auto pMaterial = pProperty->m_pMaterial.lock();
+    double length_current = sqrt(dx_current * dx_current + dy_current * dy_current + dz_current * dz_current);
+    const double directionVector[3] = { dx_current / length_current, dy_current / length_current, dz_current / length_current };
+
+    // 线性化轴向伸长 ΔL = n·(Δu1 - Δu0)，轴力增量 ΔN = E*A_current/L0 * ΔL（与材料刚度一致）
+    double EA_current = EA * L0 / length_current;
+    double dLength = 0.0;
+    for (int i = 0; i < 3; ++i)
+    {
+        dLength += directionVector[i] * (due[3 + i] - due[i]);
+    }
+    double dAxialForce = EA_current / L0 * dLength;
 
-    double E = pMaterial->m_Young;
-    double A = pSection->m_Area;
+    Fill_kg(dAxialForce / length_current, directionVector, kg);
+}
 
+void ElementTruss::Get_L0()
+{
     auto pNode0 = m_pNode[0].lock();
     auto pNode1 = m_pNode[1].lock();
 
@@ -178,3 +209,11 @@ void ElementTruss::Get_L0()
     L0 = sqrt(dx0 * dx0 + dy0 * dy0 + dz0 * dz0);
 }
 
+
+void ElementTruss::Get_me(MatrixXd& me)
+{
+    // 集中质量：单元质量 ρAL0 平均分配到两端节点的三个平移自由度
+    const double rhoA = Get_Const().rhoA;
+    double nodalMass = rhoA * L0 / 2.0;
+    me = MatrixXd::Identity(6, 6) * nodalMass;
+}
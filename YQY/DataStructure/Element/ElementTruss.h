@@ -3,6 +3,8 @@
 
 /**
  * @brief 桁架单元类 - 只承受轴力的二节点单元
+ *
+ * 刚度、几何刚度和质量只读取单元常量（建立紧凑模型时写入，之前经 Get_Const 现场计算），不访问属性、材料和截面。
  */
 class ElementTruss : public ElementBase
 {
@@ -18,6 +20,12 @@ public:
      */
     int Get_NodeDOF() const override { return 3; };
 
+    /**
+     * @brief 获取单元类型
+     * @return EnumKeyword::ElementType::T3D2（桁架单元）
+     */
+    EnumKeyword::ElementType Get_ElementType() const override { return EnumKeyword::ElementType::T3D2; }
+
     /**
      * @brief 计算单元刚度矩阵
      * @param [out] ke 单元刚度矩阵（6x6）
@@ -25,5 +33,51 @@ public:
     void Get_ke(MatrixXd& ke);
     void Get_ke_non(MatrixXd& ke);
     void Get_L0();
+
+    /**
+     * @brief 计算切线刚度的材料部分与几何部分
+     * @param [out] km 材料刚度矩阵（6x6）
+     * @param [out] kg 几何刚度矩阵（6x6），(Aσ/L)(I - nnᵀ) 分块，应力为零时为空矩阵
+     */
+    void Get_ke_split(MatrixXd& km, MatrixXd& kg);
+
+    /**
+     * @brief 由单元位移增量计算几何刚度增量
+     * @param [in] due 单元位移增量（6）
+     * @param [out] kg 线性化轴力增量对应的几何刚度矩阵（6x6）
+     */
+    void Get_kg_increment(const VectorXd& due, MatrixXd& kg);
+
+    /**
+     * @brief 计算单元集中质量矩阵
+     * @param [out] me 单元质量矩阵（6x6），每个平移自由度分配 ρAL0/2
+     */
+    void Get_me(MatrixXd& me);
+
+    /**
+     * @brief 桁架切线刚度与内力的计算核心（对象接口与紧凑数组组装共用，保证结果一致）
+     * @param [in] dx, dy, dz 当前构形下节点 1 相对节点 0 的向量
+     * @param [in] E 弹性模量
+     * @param [in] EA 初始轴向刚度 E*A
+     * @param [in] L0 初始长度
+     * @param [out] km 材料刚度矩阵（6x6，按列存储）
+     * @param [out] kg 几何刚度矩阵（6x6，按列存储），应力为零时不写入
+     * @param [out] inforce 单元内力（6）
+     * @param [out] stress 单元应力（对数应变）
+     * @return 是否写入了几何刚度（应力不为零）
+     */
+    static bool Compute_Tangent(double dx, double dy, double dz, double E, double EA, double L0,
+        double* km, double* kg, double* inforce, double& stress);
+
+    /**
+     * @brief 由单元位移增量计算几何刚度增量的计算核心（对象接口与紧凑数组组装共用）
+     * @param [in] dx, dy, dz 当前构形下节点 1 相对节点 0 的向量
+     * @param [in] EA 初始轴向刚度 E*A
+     * @param [in] L0 初始长度
+     * @param [in] due 单元位移增量（6）
+     * @param [out] kg 几何刚度矩阵增量（6x6，按列存储）
+     */
+    static void Compute_kg_increment(double dx, double dy, double dz, double EA, double L0,
+        const double* due, double* kg);
 };
 
@@ -3,5 +3,20 @@
 Node::Node() : m_X(0.0), m_Y(0.0), m_Z(0.0)
 {
     m_DOF.resize(3, -1);    //默认3个自由度，均未约束
-    m_Displacement.resize(3, 0.0);
+}
+
+void Node::BindState(Eigen::VectorXd& U, Eigen::VectorXd& V, Eigen::VectorXd& A, Eigen::VectorXd& F)
+{
+    m_Displacement.Bind(&U, &m_DOF);
+    m_Velocity.Bind(&V, &m_DOF);
+    m_Acceleration.Bind(&A, &m_DOF);
+    m_Force.Bind(&F, &m_DOF);
+}
+
+void Node::UnbindState()
+{
+    m_Displacement.Unbind();
+    m_Velocity.Unbind();
+    m_Acceleration.Unbind();
+    m_Force.Unbind();
 }
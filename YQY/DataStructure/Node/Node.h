@@ -1,6 +1,53 @@
 #pragma once
 #include "Base/Base.h"
 
+/**
+ * @brief 节点状态视图 - 按节点自由度编号访问全局状态向量
+ *
+ * 不持有数据：第 i 个分量即全局向量中自由度 m_DOF[i] 处的值。
+ * 未绑定（CompactModel::Build 之前）时 size() 为 0，只读访问返回 0（未变形状态），写入视为错误。
+ */
+class NodeVector
+{
+public:
+    /**
+     * @brief 绑定到全局向量
+     * @param [in] pGlobal 全局状态向量（按全局自由度编号）
+     * @param [in] pDOF 所属节点的自由度编号数组
+     */
+    void Bind(Eigen::VectorXd* pGlobal, const QVector<int>* pDOF) { m_pGlobal = pGlobal; m_pDOF = pDOF; }
+
+    /**
+     * @brief 解除绑定
+     */
+    void Unbind() { m_pGlobal = nullptr; m_pDOF = nullptr; }
+
+    /**
+     * @brief 是否已绑定到全局向量
+     */
+    bool IsBound() const { return nullptr != m_pGlobal; }
+
+    int size() const { return m_pGlobal ? static_cast<int>(m_pDOF->size()) : 0; }
+    double& operator[](int i)
+    {
+        Q_ASSERT(m_pGlobal);  // 写入只能在绑定之后（CompactModel::Build）
+        return (*m_pGlobal)[Index(i)];
+    }
+    double operator[](int i) const { return m_pGlobal ? (*m_pGlobal)[Index(i)] : 0.0; }
+
+private:
+    Eigen::Index Index(int i) const
+    {
+        Q_ASSERT(i >= 0 && i < m_pDOF->size());
+        const int dof = (*m_pDOF)[i];
+        Q_ASSERT(dof >= 0 && dof < m_pGlobal->size());
+        return dof;
+    }
+
+    Eigen::VectorXd* m_pGlobal = nullptr;  ///< 全局状态向量
+    const QVector<int>* m_pDOF = nullptr;  ///< 节点自由度编号
+};
+
 /**
  * @brief 节点类 - 存储有限元节点信息
  */
@@ -11,9 +58,19 @@ public:
 
     double m_X, m_Y, m_Z;  ///< 节点坐标
     QVector<int> m_DOF;    ///< 节点自由度编号数组
-    std::vector<double>  m_Displacement;
-    std::vector<double>  m_Acceleration;
-    std::vector<double>  m_Velocity;
-    std::vector<double>  m_Force;  ///< 节点力 (内力/反力)
+    NodeVector m_Displacement;  ///< 位移（全局位移向量的视图）
+    NodeVector m_Acceleration;  ///< 加速度（全局加速度向量的视图）
+    NodeVector m_Velocity;      ///< 速度（全局速度向量的视图）
+    NodeVector m_Force;         ///< 节点力 (内力/反力，全局节点力向量的视图)
+
+    /**
+     * @brief 将位移、速度、加速度、节点力视图绑定到全局状态向量
+     */
+    void BindState(Eigen::VectorXd& U, Eigen::VectorXd& V, Eigen::VectorXd& A, Eigen::VectorXd& F);
+
+    /**
+     * @brief 解除所有状态视图的绑定
+     */
+    void UnbindState();
 };
 
@@ -0,0 +1,117 @@
+﻿#include "Adjacency.h"
+#include "StructureData.h"
+#include <algorithm>
+
+void Adjacency::Clear()
+{
+    m_NodeId.clear();
+    m_NodeView.clear();
+    m_ElementId.clear();
+    m_ElementView.clear();
+    m_ElemNodePtr.clear();
+    m_ElemNode.clear();
+    m_NodeElemPtr.clear();
+    m_NodeElem.clear();
+    m_NodeNodePtr.clear();
+    m_NodeNode.clear();
+    m_NodeIndexById.clear();
+    m_NodeIdBase = 0;
+    m_Version = 0;
+}
+
+void Adjacency::Build(const StructureData& data, uint64_t version)
+{
+    Clear();
+
+    const int nNode = static_cast<int>(data.m_Nodes.size());
+    const int nElement = static_cast<int>(data.m_Elements.size());
+
+    m_NodeId.reserve(nNode);
+    m_NodeView.reserve(nNode);
+    for (auto& nodePair : data.m_Nodes)
+    {
+        m_NodeId.push_back(nodePair.first);
+        m_NodeView.push_back(nodePair.second.get());
+    }
+
+    // ID 较密集时（重新编号后为 1..N）建立直接下标表，避免逐个二分查找
+    if (nNode > 0 && static_cast<int64_t>(m_NodeId.back()) - m_NodeId.front() < 4 * static_cast<int64_t>(nNode))
+    {
+        m_NodeIdBase = m_NodeId.front();
+        m_NodeIndexById.assign(m_NodeId.back() - m_NodeIdBase + 1, -1);
+        for (int i = 0; i < nNode; ++i) m_NodeIndexById[m_NodeId[i] - m_NodeIdBase] = i;
+    }
+
+    // 单元 -> 节点
+    m_ElementId.reserve(nElement);
+    m_ElementView.reserve(nElement);
+    m_ElemNodePtr.reserve(nElement + 1);
+    m_ElemNode.reserve(2 * static_cast<size_t>(nElement));
+    m_ElemNodePtr.push_back(0);
+    for (auto& elementPair : data.m_Elements)
+    {
+        m_ElementId.push_back(elementPair.first);
+        m_ElementView.push_back(elementPair.second.get());
+        for (auto& node : elementPair.second->m_pNode)
+        {
+            auto pNode = node.lock();
+            int iNode = pNode ? FindNodeIndex(pNode->m_Id) : -1;
+            if (iNode >= 0) m_ElemNode.push_back(iNode);
+        }
+        m_ElemNodePtr.push_back(static_cast<int>(m_ElemNode.size()));
+    }
+
+    // 节点 -> 单元：计数后按单元顺序填入，每行自然升序
+    m_NodeElemPtr.assign(nNode + 1, 0);
+    for (int iNode : m_ElemNode) ++m_NodeElemPtr[iNode + 1];
+    for (int i = 0; i < nNode; ++i) m_NodeElemPtr[i + 1] += m_NodeElemPtr[i];
+    m_NodeElem.resize(m_ElemNode.size());
+    std::vector<int> fill(m_NodeElemPtr.begin(), m_NodeElemPtr.end() - 1);
+    for (int e = 0; e < nElement; ++e)
+    {
+        for (int k = m_ElemNodePtr[e]; k < m_ElemNodePtr[e + 1]; ++k)
+        {
+            m_NodeElem[fill[m_ElemNode[k]]++] = e;
+        }
+    }
+
+    // 节点 -> 节点：经由相连单元收集，用标记数组去重
+    m_NodeNodePtr.reserve(nNode + 1);
+    m_NodeNodePtr.push_back(0);
+    std::vector<int> mark(nNode, -1);
+    for (int i = 0; i < nNode; ++i)
+    {
+        const size_t rowBegin = m_NodeNode.size();
+        mark[i] = i;
+        for (int e : NodeElements(i))
+        {
+            for (int j : ElementNodes(e))
+            {
+                if (mark[j] == i) continue;
+                mark[j] = i;
+                m_NodeNode.push_back(j);
+            }
+        }
+        std::sort(m_NodeNode.begin() + rowBegin, m_NodeNode.end());
+        m_NodeNodePtr.push_back(static_cast<int>(m_NodeNode.size()));
+    }
+
+    m_Version = version;
+}
+
+int Adjacency::FindNodeIndex(int id) const
+{
+    if (!m_NodeIndexById.empty())
+    {
+        const int64_t k = static_cast<int64_t>(id) - m_NodeIdBase;
+        return (k >= 0 && k < static_cast<int64_t>(m_NodeIndexById.size())) ? m_NodeIndexById[k] : -1;
+    }
+    auto it = std::lower_bound(m_NodeId.begin(), m_NodeId.end(), id);
+    return (it != m_NodeId.end() && *it == id) ? static_cast<int>(it - m_NodeId.begin()) : -1;
+}
+
+int Adjacency::FindElementIndex(int id) const
+{
+    auto it = std::lower_bound(m_ElementId.begin(), m_ElementId.end(), id);
+    return (it != m_ElementId.end() && *it == id) ? static_cast<int>(it - m_ElementId.begin()) : -1;
+}
@@ -0,0 +1,105 @@
+﻿#pragma once
+#include <cstdint>
+#include <vector>
+
+class StructureData;
+class Node;
+class ElementBase;
+
+/**
+ * @brief 下标区间 - CSR 数组中一行的只读视图
+ */
+struct IndexRange
+{
+    const int* m_Begin = nullptr;  ///< 起始位置
+    const int* m_End = nullptr;    ///< 结束位置（不含）
+
+    const int* begin() const { return m_Begin; }
+    const int* end() const { return m_End; }
+    int size() const { return static_cast<int>(m_End - m_Begin); }
+    bool empty() const { return m_Begin == m_End; }
+    int operator[](int i) const { return m_Begin[i]; }
+};
+
+/**
+ * @brief 模型邻接关系 - 单元-节点、节点-单元、节点-节点的 CSR 图
+ *
+ * 节点下标和单元下标按 StructureData 中的 map 顺序（即ID升序）编号。
+ * 由 StructureData::GetAdjacency() 在拓扑版本变化后首次访问时重建，
+ * 孤立节点检查、自由度初始化和 GUI 选择等共用同一份数据，不再各自遍历全部单元。
+ */
+class Adjacency
+{
+public:
+    /**
+     * @brief 由结构数据建立邻接关系
+     * @param [in] data 结构数据
+     * @param [in] version 对应的拓扑版本
+     */
+    void Build(const StructureData& data, uint64_t version);
+
+    /**
+     * @brief 清空
+     */
+    void Clear();
+
+    /**
+     * @brief 建立时的拓扑版本（未建立为 0）
+     */
+    uint64_t Version() const { return m_Version; }
+
+    /**
+     * @brief 节点个数
+     */
+    int NodeCount() const { return static_cast<int>(m_NodeId.size()); }
+
+    /**
+     * @brief 单元个数
+     */
+    int ElementCount() const { return static_cast<int>(m_ElementId.size()); }
+
+    /**
+     * @brief 根据节点ID查找下标（ID 密集时直接查表，否则二分查找）
+     * @return 节点下标，未找到返回 -1
+     */
+    int FindNodeIndex(int id) const;
+
+    /**
+     * @brief 根据单元ID查找下标（二分查找）
+     * @return 单元下标，未找到返回 -1
+     */
+    int FindElementIndex(int id) const;
+
+    /**
+     * @brief 单元 e 的节点下标
+     */
+    IndexRange ElementNodes(int e) const { return Row(m_ElemNodePtr, m_ElemNode, e); }
+
+    /**
+     * @brief 与节点 i 相连的单元下标（升序）
+     */
+    IndexRange NodeElements(int i) const { return Row(m_NodeElemPtr, m_NodeElem, i); }
+
+    /**
+     * @brief 与节点 i 通过单元相连的其他节点下标（升序，不含自身）
+     */
+    IndexRange NodeNeighbors(int i) const { return Row(m_NodeNodePtr, m_NodeNode, i); }
+
+    std::vector<int>          m_NodeId;       ///< 节点ID（升序）
+    std::vector<Node*>        m_NodeView;     ///< 对应的节点对象
+    std::vector<int>          m_ElementId;    ///< 单元ID（升序）
+    std::vector<ElementBase*> m_ElementView;  ///< 对应的单元对象
+
+private:
+    static IndexRange Row(const std::vector<int>& ptr, const std::vector<int>& idx, int i)
+    {
+        return { idx.data() + ptr[i], idx.data() + ptr[i + 1] };
+    }
+
+    std::vector<int> m_ElemNodePtr, m_ElemNode;  ///< 单元 -> 节点（缺失的节点不记录）
+    std::vector<int> m_NodeElemPtr, m_NodeElem;  ///< 节点 -> 单元
+    std::vector<int> m_NodeNodePtr, m_NodeNode;  ///< 节点 -> 节点
+    std::vector<int> m_NodeIndexById;            ///< 节点ID - m_NodeIdBase -> 下标（ID 稀疏时为空）
+    int m_NodeIdBase = 0;                        ///< 直接下标表的起始ID
+    uint64_t m_Version = 0;                      ///< 建立时的拓扑版本
+};
@@ -0,0 +1,162 @@
+﻿#include "CleanupIndex.h"
+#include "StructureData.h"
+#include <algorithm>
+#include <cmath>
+
+void CleanupIndex::Clear()
+{
+    m_NodeMax = 0;
+    m_ElementMax = 0;
+    m_ConstraintMax = 0;
+    m_LoadMax = 0;
+    m_bClean = false;
+    m_bBuilt = false;
+    m_Tolerance = 0.0;
+    m_CellSize = 0.0;
+    m_Cells.clear();
+    m_Topologies.clear();
+}
+
+void CleanupIndex::MarkClean(const StructureData& data, double tolerance)
+{
+    Clear();
+    m_bClean = tolerance > 0.0;
+    m_Tolerance = tolerance;
+    m_CellSize = tolerance * 1.01;
+    UpdateWatermarks(data);
+}
+
+void CleanupIndex::UpdateWatermarks(const StructureData& data)
+{
+    m_NodeMax = data.m_Nodes.empty() ? 0 : data.m_Nodes.rbegin()->first;
+    m_ElementMax = data.m_Elements.empty() ? 0 : data.m_Elements.rbegin()->first;
+    m_ConstraintMax = data.m_Constraint.empty() ? 0 : data.m_Constraint.rbegin()->first;
+    m_LoadMax = data.m_Load.empty() ? 0 : data.m_Load.rbegin()->first;
+}
+
+void CleanupIndex::EnsureBuilt(const StructureData& data)
+{
+    if (m_bBuilt) return;
+
+    m_Cells.reserve(data.m_Nodes.size());
+    for (auto it = data.m_Nodes.begin(); it != data.m_Nodes.end() && it->first <= m_NodeMax; ++it)
+    {
+        InsertNode(it->second);
+    }
+
+    m_Topologies.reserve(data.m_Elements.size());
+    for (auto it = data.m_Elements.begin(); it != data.m_Elements.end() && it->first <= m_ElementMax; ++it)
+    {
+        InsertElement(it->second);
+    }
+    m_bBuilt = true;
+}
+
+uint64_t CleanupIndex::CellKey(double x, double y, double z, int dx, int dy, int dz) const
+{
+    const uint32_t mask = (1u << SpaceFillingCurve::Bits) - 1;
+    const uint32_t cx = static_cast<uint32_t>(static_cast<int64_t>(std::floor(x / m_CellSize)) + dx) & mask;
+    const uint32_t cy = static_cast<uint32_t>(static_cast<int64_t>(std::floor(y / m_CellSize)) + dy) & mask;
+    const uint32_t cz = static_cast<uint32_t>(static_cast<int64_t>(std::floor(z / m_CellSize)) + dz) & mask;
+    return SpaceFillingCurve::Morton(cx, cy, cz);
+}
+
+void CleanupIndex::InsertNode(const std::shared_ptr<Node>& pNode)
+{
+    m_Cells.emplace(CellKey(pNode->m_X, pNode->m_Y, pNode->m_Z), pNode);
+}
+
+std::shared_ptr<Node> CleanupIndex::FindCoincident(const Node& node, const std::unordered_set<const Node*>& skip)
+{
+    std::shared_ptr<Node> pFound;
+    const double tolSq = m_Tolerance * m_Tolerance;
+
+    for (int dx = -1; dx <= 1; ++dx)
+    {
+        for (int dy = -1; dy <= 1; ++dy)
+        {
+            for (int dz = -1; dz <= 1; ++dz)
+            {
+                const uint64_t key = CellKey(node.m_X, node.m_Y, node.m_Z, dx, dy, dz);
+                auto range = m_Cells.equal_range(key);
+                for (auto it = range.first; it != range.second;)
+                {
+                    auto pNode = it->second.lock();
+
+                    // 已删除的节点、节点移动后留在旧单元格中的记录、待查节点自身的记录
+                    if (!pNode || pNode.get() == &node || CellKey(pNode->m_X, pNode->m_Y, pNode->m_Z) != key)
+                    {
+                        it = m_Cells.erase(it);
+                        continue;
+                    }
+                    ++it;
+                    if (skip.count(pNode.get())) continue;
+
+                    const double ddx = pNode->m_X - node.m_X;
+                    const double ddy = pNode->m_Y - node.m_Y;
+                    const double ddz = pNode->m_Z - node.m_Z;
+                    if (ddx * ddx + ddy * ddy + ddz * ddz >= tolSq) continue;
+
+                    if (!pFound || pNode->m_Id < pFound->m_Id) pFound = pNode;
+                }
+            }
+        }
+    }
+    return pFound;
+}
+
+uint64_t CleanupIndex::TopologyKey(const ElementBase& element)
+{
+    std::vector<uintptr_t> nodes;
+    nodes.reserve(element.m_pNode.size());
+    for (auto& node : element.m_pNode)
+    {
+        nodes.push_back(reinterpret_cast<uintptr_t>(node.lock().get()));
+    }
+    std::sort(nodes.begin(), nodes.end());
+
+    uint64_t seed = 0;
+    for (uintptr_t p : nodes)
+    {
+        seed ^= std::hash<uintptr_t>{}(p) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    }
+    return seed;
+}
+
+bool CleanupIndex::SameTopology(const ElementBase& a, const ElementBase& b)
+{
+    if (a.m_pNode.size() != b.m_pNode.size()) return false;
+
+    std::vector<const Node*> nodesA, nodesB;
+    for (auto& node : a.m_pNode) nodesA.push_back(node.lock().get());
+    for (auto& node : b.m_pNode) nodesB.push_back(node.lock().get());
+    std::sort(nodesA.begin(), nodesA.end());
+    std::sort(nodesB.begin(), nodesB.end());
+    return nodesA == nodesB;
+}
+
+void CleanupIndex::InsertElement(const std::shared_ptr<ElementBase>& pElement)
+{
+    m_Topologies.emplace(TopologyKey(*pElement), pElement);
+}
+
+std::shared_ptr<ElementBase> CleanupIndex::FindSameTopology(const ElementBase& element)
+{
+    const uint64_t key = TopologyKey(element);
+    std::shared_ptr<ElementBase> pFound;
+    auto range = m_Topologies.equal_range(key);
+    for (auto it = range.first; it != range.second;)
+    {
+        auto pElement = it->second.lock();
+
+        // 已删除的单元、单元修改后留在旧哈希下的记录、待查单元自身的记录
+        if (!pElement || pElement.get() == &element || TopologyKey(*pElement) != key)
+        {
+            it = m_Topologies.erase(it);
+            continue;
+        }
+        ++it;
+        if ((!pFound || pElement->m_Id < pFound->m_Id) && SameTopology(*pElement, element)) pFound = pElement;
+    }
+    return pFound;
+}
@@ -0,0 +1,110 @@
+﻿#pragma once
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class StructureData;
+class Node;
+class ElementBase;
+
+/**
+ * @brief 模型清理索引 - 增量清理时保留的空间索引和单元拓扑集合
+ *
+ * 空间索引按容差大小的网格单元格保存已清理的节点，拓扑集合按排序后的节点指针保存已清理的单元，
+ * 两者都保存弱引用：节点移动或单元修改后旧记录仍留在原位置，查找时按当前坐标和当前节点重新核对，
+ * 遇到的失效记录（对象已删除，或与当前坐标、当前节点不符）随即从索引中删除。由于保存的是指针而不是ID，重新编号不影响索引。
+ *
+ * 水位记录上次清理后各类对象的最大ID，ID 大于水位的对象即为新增对象。
+ */
+class CleanupIndex
+{
+public:
+    /// @name 上次清理后的最大ID（水位）
+    /// @{
+    int m_NodeMax = 0;        ///< 节点
+    int m_ElementMax = 0;     ///< 单元
+    int m_ConstraintMax = 0;  ///< 约束
+    int m_LoadMax = 0;        ///< 荷载
+    /// @}
+
+    /**
+     * @brief 清空索引，回到未清理状态
+     */
+    void Clear();
+
+    /**
+     * @brief 是否可以对容差 tolerance 做增量清理（上次以同一容差清理过）
+     */
+    bool IsClean(double tolerance) const { return m_bClean && tolerance == m_Tolerance; }
+
+    /**
+     * @brief 记录一次完整清理的结果（索引延迟到第一次增量清理时建立）
+     * @param [in] data 清理后的结构数据
+     * @param [in] tolerance 节点合并容差
+     */
+    void MarkClean(const StructureData& data, double tolerance);
+
+    /**
+     * @brief 更新水位为当前最大ID
+     */
+    void UpdateWatermarks(const StructureData& data);
+
+    /**
+     * @brief 由水位以内的节点和单元建立索引（已建立时直接返回）
+     */
+    void EnsureBuilt(const StructureData& data);
+
+    /**
+     * @brief 将节点按当前坐标加入空间索引
+     */
+    void InsertNode(const std::shared_ptr<Node>& pNode);
+
+    /**
+     * @brief 查找与节点重合（距离小于容差）的ID最小的已索引节点
+     * @param [in] node 待查节点
+     * @param [in] skip 需要跳过的节点（本次已被合并的节点）
+     * @return 重合节点，没有返回 nullptr
+     *
+     * 待查节点自身的记录也一并删除，调用方随后按当前坐标重新加入或删除该节点。
+     */
+    std::shared_ptr<Node> FindCoincident(const Node& node, const std::unordered_set<const Node*>& skip);
+
+    /**
+     * @brief 将单元按当前节点加入拓扑集合
+     */
+    void InsertElement(const std::shared_ptr<ElementBase>& pElement);
+
+    /**
+     * @brief 查找与单元节点集合相同的ID最小的已索引单元（不含自身）
+     * @return 相同拓扑的单元，没有返回 nullptr
+     *
+     * 待查单元自身的记录也一并删除，调用方随后按当前节点重新加入或删除该单元。
+     */
+    std::shared_ptr<ElementBase> FindSameTopology(const ElementBase& element);
+
+private:
+    /**
+     * @brief 坐标所在单元格的编码（各轴 21 位回绕，相距 2^21 个单元格的格子共用编码，由距离核对区分）
+     */
+    uint64_t CellKey(double x, double y, double z, int dx = 0, int dy = 0, int dz = 0) const;
+
+    /**
+     * @brief 单元排序后节点指针的哈希值
+     */
+    static uint64_t TopologyKey(const ElementBase& element);
+
+    /**
+     * @brief 两个单元的节点集合是否相同
+     */
+    static bool SameTopology(const ElementBase& a, const ElementBase& b);
+
+    bool m_bClean = false;     ///< 模型是否处于已清理状态
+    bool m_bBuilt = false;     ///< 索引是否已建立
+    double m_Tolerance = 0.0;  ///< 清理所用容差
+    double m_CellSize = 0.0;   ///< 单元格边长
+
+    std::unordered_multimap<uint64_t, std::weak_ptr<Node>>        m_Cells;       ///< 单元格编码 -> 节点
+    std::unordered_multimap<uint64_t, std::weak_ptr<ElementBase>> m_Topologies;  ///< 拓扑哈希 -> 单元
+};
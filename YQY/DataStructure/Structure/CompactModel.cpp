@@ -0,0 +1,352 @@
+﻿#include "CompactModel.h"
+#include "StructureData.h"
+#include "Utility/SpaceFillingCurve.h"
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+void CompactModel::Clear()
+{
+    for (Node* pNode : m_NodeView)
+    {
+        pNode->UnbindState();
+    }
+    ClearArrays();
+
+    m_U.resize(0);
+    m_V.resize(0);
+    m_A.resize(0);
+    m_F.resize(0);
+    m_StateNodeId.clear();
+    m_StateDofPtr.clear();
+    m_StateDof.clear();
+}
+
+void CompactModel::ClearModel()
+{
+    for (Node* pNode : m_NodeView)
+    {
+        pNode->UnbindState();
+    }
+    ClearArrays();
+}
+
+void CompactModel::ClearArrays()
+{
+    if (m_bBuilt)
+    {// 状态向量按这次的自由度编号保存，留给重建后映射
+        m_StateNodeId.swap(m_NodeId);
+        m_StateDofPtr.swap(m_NodeDofPtr);
+        m_StateDof.swap(m_NodeDof);
+    }
+    m_NodeId.clear();
+    m_NodeCoord.clear();
+    m_NodeDofPtr.clear();
+    m_NodeDof.clear();
+    m_NodeView.clear();
+
+    m_ElementId.clear();
+    m_ElementType.clear();
+    m_ElemNodePtr.clear();
+    m_ElemNode.clear();
+    m_ElemDofPtr.clear();
+    m_ElemDof.clear();
+    m_ElemProperty.clear();
+    m_ElemConst.clear();
+    m_ElemStress.clear();
+    m_ElemForce.clear();
+    for (ElementBase* pElement : m_ElementView)
+    {// 节点坐标、连接或属性可能已改变，单元对象上的常量在重建前改为现场计算
+        pElement->m_Const.valid = false;
+    }
+    m_ElementView.clear();
+    m_Blocks.clear();
+
+    m_PropertyId.clear();
+    m_PropertyView.clear();
+
+    m_NodeIndex.clear();
+    m_ElementIndex.clear();
+    m_bBuilt = false;
+    m_bConstantsValid = false;
+    m_UniformNodeDOF = 0;
+}
+
+void CompactModel::Build(StructureData* pData)
+{
+    ClearArrays();
+    if (!pData) return;
+
+    // 属性表
+    std::unordered_map<int, int> propertyIndex;
+    propertyIndex.reserve(pData->m_Property.size());
+    for (auto& propertyPair : pData->m_Property)
+    {
+        auto pProperty = propertyPair.second;
+        propertyIndex[pProperty->m_Id] = static_cast<int>(m_PropertyId.size());
+        m_PropertyId.push_back(pProperty->m_Id);
+        m_PropertyView.push_back(pProperty.get());
+    }
+
+    // 节点数组
+    const size_t nNode = pData->m_Nodes.size();
+    m_NodeId.reserve(nNode);
+    m_NodeCoord.reserve(3 * nNode);
+    m_NodeDofPtr.reserve(nNode + 1);
+    m_NodeView.reserve(nNode);
+    m_NodeIndex.reserve(nNode);
+
+    m_NodeDofPtr.push_back(0);
+    std::vector<Node*> nodeOrder;
+    pData->Get_NodeOrder(nodeOrder);
+    for (Node* pNode : nodeOrder)
+    {
+        m_NodeIndex[pNode->m_Id] = static_cast<int>(m_NodeId.size());
+        m_NodeId.push_back(pNode->m_Id);
+        m_NodeCoord.push_back(pNode->m_X);
+        m_NodeCoord.push_back(pNode->m_Y);
+        m_NodeCoord.push_back(pNode->m_Z);
+        m_NodeDof.insert(m_NodeDof.end(), pNode->m_DOF.begin(), pNode->m_DOF.end());
+        m_NodeDofPtr.push_back(static_cast<int>(m_NodeDof.size()));
+        m_NodeView.push_back(pNode);
+        pNode->BindState(m_U, m_V, m_A, m_F);
+    }
+
+    // 单元数组
+    const size_t nElement = pData->m_Elements.size();
+    m_ElementId.reserve(nElement);
+    m_ElementType.reserve(nElement);
+    m_ElemNodePtr.reserve(nElement + 1);
+    m_ElemDofPtr.reserve(nElement + 1);
+    m_ElemProperty.reserve(nElement);
+    m_ElemStress.reserve(nElement);
+    m_ElementView.reserve(nElement);
+    m_ElementIndex.reserve(nElement);
+
+    m_ElemNodePtr.push_back(0);
+    m_ElemDofPtr.push_back(0);
+    // 单元按类型分块，块内按最小节点下标排序，使相邻单元访问相邻的节点数据；
+    // 启用空间排序时块内改按形心的曲线编码排序
+    struct ElementOrder
+    {
+        EnumKeyword::ElementType type;
+        uint64_t key;
+        int id;
+        ElementBase* pElement;
+    };
+    const SpaceFillingCurve::Curve curve = pData->GetSpatialOrder();
+    std::vector<ElementOrder> order;
+    std::vector<double> centroids;
+    order.reserve(nElement);
+    if (SpaceFillingCurve::Curve::NONE != curve) centroids.reserve(3 * nElement);
+    for (auto& elementPair : pData->m_Elements)
+    {
+        ElementBase* pElement = elementPair.second.get();
+        int minNode = std::numeric_limits<int>::max();
+        double centroid[3] = { 0.0, 0.0, 0.0 };
+        int nCount = 0;
+        for (auto& node : pElement->m_pNode)
+        {
+            auto pNode = node.lock();
+            int iNode = pNode ? FindNodeIndex(pNode->m_Id) : -1;
+            if (iNode < 0) continue;
+
+            minNode = std::min(minNode, iNode);
+            for (int d = 0; d < 3; ++d) centroid[d] += m_NodeCoord[3 * iNode + d];
+            ++nCount;
+        }
+        if (SpaceFillingCurve::Curve::NONE != curve)
+        {
+            for (int d = 0; d < 3; ++d) centroids.push_back(nCount > 0 ? centroid[d] / nCount : 0.0);
+        }
+        order.push_back({ pElement->Get_ElementType(), static_cast<uint64_t>(minNode), pElement->m_Id, pElement });
+    }
+    if (SpaceFillingCurve::Curve::NONE != curve)
+    {
+        std::vector<uint64_t> keys;
+        SpaceFillingCurve::Compute_Keys(centroids, curve, keys);
+        for (size_t e = 0; e < order.size(); ++e) order[e].key = keys[e];
+    }
+    std::sort(order.begin(), order.end(), [](const ElementOrder& a, const ElementOrder& b)
+        {
+            if (a.type != b.type) return a.type < b.type;
+            if (a.key != b.key) return a.key < b.key;
+            return a.id < b.id;
+        });
+
+    for (const ElementOrder& item : order)
+    {
+        ElementBase* pElement = item.pElement;
+        const int nodeDOF = pElement->Get_NodeDOF();
+
+        for (auto& node : pElement->m_pNode)
+        {
+            auto pNode = node.lock();
+            m_ElemNode.push_back(pNode ? FindNodeIndex(pNode->m_Id) : -1);
+            for (int i = 0; i < nodeDOF; ++i)
+            {// 与 ElementBase::GetDOFs 相同：取节点前 nodeDOF 个自由度
+                m_ElemDof.push_back(pNode && i < pNode->m_DOF.size() ? pNode->m_DOF[i] : -1);
+            }
+        }
+        m_ElemNodePtr.push_back(static_cast<int>(m_ElemNode.size()));
+        m_ElemDofPtr.push_back(static_cast<int>(m_ElemDof.size()));
+
+        auto pProperty = pElement->m_pProperty.lock();
+        auto it = pProperty ? propertyIndex.find(pProperty->m_Id) : propertyIndex.end();
+
+        const int e = static_cast<int>(m_ElementId.size());
+        if (m_Blocks.empty() || m_Blocks.back().m_Type != item.type)
+        {
+            m_Blocks.push_back({ item.type, e, e });
+        }
+        m_Blocks.back().m_End = e + 1;
+
+        m_ElementIndex[pElement->m_Id] = e;
+        m_ElementId.push_back(pElement->m_Id);
+        m_ElementType.push_back(item.type);
+        m_ElemProperty.push_back(it != propertyIndex.end() ? it->second : -1);
+        m_ElemStress.push_back(pElement->m_Stress);
+        m_ElementView.push_back(pElement);
+    }
+    m_ElemForce.assign(m_ElemDof.size(), 0.0);
+
+    RemapState();
+
+    Detect_UniformLayout();
+
+    m_bBuilt = true;
+    ++m_BuildVersion;
+    UpdateConstants();
+}
+
+void CompactModel::Detect_UniformLayout()
+{
+    m_UniformNodeDOF = 0;
+    if (m_ElementId.empty()) return;
+
+    // 以第一个单元确定候选值，再逐个单元、逐个节点核对
+    const int nodeDOF = (m_ElemDofPtr[1] - m_ElemDofPtr[0]) / LineElementNodes;
+    if (3 != nodeDOF && 6 != nodeDOF) return;
+
+    for (int e = 0; e < ElementCount(); ++e)
+    {
+        if (m_ElemNodePtr[e + 1] - m_ElemNodePtr[e] != LineElementNodes) return;
+        if (m_ElemDofPtr[e + 1] - m_ElemDofPtr[e] != LineElementNodes * nodeDOF) return;
+    }
+    for (int i = 0; i < NodeCount(); ++i)
+    {
+        if (m_NodeDofPtr[i + 1] - m_NodeDofPtr[i] != nodeDOF) return;
+    }
+
+    m_UniformNodeDOF = nodeDOF;
+}
+
+void CompactModel::RemapState()
+{
+    const bool bSame = m_StateNodeId == m_NodeId && m_StateDofPtr == m_NodeDofPtr && m_StateDof == m_NodeDof;
+    if (!m_StateNodeId.empty() && !bSame && m_U.size() > 0)
+    {
+        int nDOF = 0;
+        for (int dof : m_NodeDof) nDOF = std::max(nDOF, dof + 1);
+
+        Eigen::VectorXd* states[] = { &m_U, &m_V, &m_A, &m_F };
+        Eigen::VectorXd old[4];
+        for (int k = 0; k < 4; ++k)
+        {
+            old[k].swap(*states[k]);
+            states[k]->setZero(nDOF);
+        }
+
+        // 同一节点同一方向的分量搬到新编号上；新增的节点、自由度为零
+        for (size_t i = 0; i + 1 < m_StateDofPtr.size(); ++i)
+        {
+            const int j = FindNodeIndex(m_StateNodeId[i]);
+            if (j < 0) continue;
+
+            const int nOld = m_StateDofPtr[i + 1] - m_StateDofPtr[i];
+            const int nNew = m_NodeDofPtr[j + 1] - m_NodeDofPtr[j];
+            for (int dir = 0; dir < std::min(nOld, nNew); ++dir)
+            {
+                const int oldDof = m_StateDof[m_StateDofPtr[i] + dir];
+                const int newDof = m_NodeDof[m_NodeDofPtr[j] + dir];
+                if (oldDof < 0 || oldDof >= old[0].size() || newDof < 0) continue;
+                for (int k = 0; k < 4; ++k) (*states[k])[newDof] = old[k][oldDof];
+            }
+        }
+    }
+
+    m_StateNodeId.clear();
+    m_StateDofPtr.clear();
+    m_StateDof.clear();
+}
+
+void CompactModel::ResizeState(int nDOF)
+{
+    for (Eigen::VectorXd* pState : { &m_U, &m_V, &m_A, &m_F })
+    {
+        const Eigen::Index nOld = pState->size();
+        if (nOld == nDOF) continue;
+
+        pState->conservativeResize(nDOF);
+        if (nDOF > nOld) pState->tail(nDOF - nOld).setZero();
+    }
+}
+
+int CompactModel::FindNodeIndex(int id) const
+{
+    auto it = m_NodeIndex.find(id);
+    return it != m_NodeIndex.end() ? it->second : -1;
+}
+
+int CompactModel::FindElementIndex(int id) const
+{
+    auto it = m_ElementIndex.find(id);
+    return it != m_ElementIndex.end() ? it->second : -1;
+}
+
+void CompactModel::UpdateConstants()
+{
+    // 每个属性只访问一次材料和截面
+    std::vector<ElementConstants> propertyConst(m_PropertyView.size());
+    for (size_t p = 0; p < m_PropertyView.size(); ++p)
+    {
+        ElementBase::Compute_PropertyConst(*m_PropertyView[p], propertyConst[p]);
+    }
+
+    m_ElemConst.resize(m_ElementId.size());
+    for (size_t e = 0; e < m_ElementId.size(); ++e)
+    {
+        ElementConstants& c = m_ElemConst[e];
+        c = m_ElemProperty[e] >= 0 ? propertyConst[m_ElemProperty[e]] : ElementConstants();
+
+        // 初始长度：前两个节点间的距离
+        const int* nodes = m_ElemNode.data() + m_ElemNodePtr[e];
+        if (m_ElemNodePtr[e + 1] - m_ElemNodePtr[e] >= 2 && nodes[0] >= 0 && nodes[1] >= 0)
+        {
+            const double* X0 = m_NodeCoord.data() + 3 * nodes[0];
+            const double* X1 = m_NodeCoord.data() + 3 * nodes[1];
+            double dx0 = X1[0] - X0[0];
+            double dy0 = X1[1] - X0[1];
+            double dz0 = X1[2] - X0[2];
+            c.L0 = sqrt(dx0 * dx0 + dy0 * dy0 + dz0 * dz0);
+        }
+        c.valid = true;
+        m_ElementView[e]->L0 = c.L0;
+        m_ElementView[e]->m_Const = c;
+    }
+
+    m_bConstantsValid = true;
+}
+
+void CompactModel::SyncElementsToObjects() const
+{
+    for (size_t e = 0; e < m_ElementView.size(); ++e)
+    {
+        ElementBase* pElement = m_ElementView[e];
+        const int begin = m_ElemDofPtr[e];
+        const int nDOF = m_ElemDofPtr[e + 1] - begin;
+
+        pElement->m_Stress = m_ElemStress[e];
+        pElement->m_inforce = Eigen::Map<const Eigen::VectorXd>(m_ElemForce.data() + begin, nDOF);
+    }
+}
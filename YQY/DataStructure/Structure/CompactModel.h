@@ -0,0 +1,206 @@
+﻿#pragma once
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+#include <Eigen/Dense>
+#include "Utility/EnumKeyword.h"
+#include "DataStructure/Element/ElementConstants.h"
+
+class StructureData;
+class Node;
+class ElementBase;
+class Property;
+
+/**
+ * @brief 单元块 - 元素数组中类型相同的连续单元区间 [m_Begin, m_End)
+ */
+struct ElementBlock
+{
+    EnumKeyword::ElementType m_Type;  ///< 单元类型
+    int m_Begin;                      ///< 起始单元下标
+    int m_End;                        ///< 结束单元下标（不含）
+};
+
+/**
+ * @brief 紧凑模型存储 - 以结构数组（SoA）形式保存求解所需的模型数据
+ *
+ * 节点坐标为连续数组，单元-节点连接与单元自由度为 CSR 格式，单元属性保存为属性表下标，
+ * 另有 ID -> 下标的查找表。刚度组装、内力计算和结果输出直接遍历这些数组；
+ * StructureData 中的对象（Node、ElementBase）仍然保留，作为 GUI 和导入器使用的视图。
+ * 节点顺序由 StructureData::Get_NodeOrder 给出（默认为ID顺序，可选空间填充曲线顺序），
+ * 数组下标与ID的对应关系保存在查找表中，输入输出仍按ID进行。
+ *
+ * 位移、速度、加速度和节点力只保存在按全局自由度编号的状态向量中，
+ * 节点的 m_Displacement 等成员是指向这些向量的视图。状态向量跨分析步保留，
+ * 重建时若自由度编号改变（约束、单元或节点顺序变化），按节点ID把各分量搬到新编号上。
+ *
+ * 单元按类型分成连续的块（T3D2、CABLE、B31），块内按最小节点下标（或形心的曲线编码）排序，
+ * 每个块由 ElementBatch 中按类型静态分派的批量函数计算。
+ * 纯桁架（每节点 3 个自由度）或纯梁（6 个）模型的自由度布局统一（UniformNodeDOF），
+ * 组装和内力累加改用按固定步长寻址的实现。
+ */
+class CompactModel
+{
+public:
+    static const int LineElementNodes = 2;  ///< 线单元节点数（固定步长自由度布局要求所有单元为两节点单元）
+
+    ~CompactModel() { Clear(); }
+
+    /// @name 全局状态向量（按全局自由度编号，约束自由度在前）
+    /// @{
+    Eigen::VectorXd m_U;  ///< 位移
+    Eigen::VectorXd m_V;  ///< 速度
+    Eigen::VectorXd m_A;  ///< 加速度
+    Eigen::VectorXd m_F;  ///< 节点力 (内力/反力)
+    /// @}
+
+    /// @name 节点数组（下标 i 对应第 i 个节点）
+    /// @{
+    std::vector<int>    m_NodeId;      ///< 节点ID
+    std::vector<double> m_NodeCoord;   ///< 节点坐标，3*i+0/1/2 为 X/Y/Z
+    std::vector<int>    m_NodeDofPtr;  ///< 节点自由度 CSR 行指针（长度 nNode+1）
+    std::vector<int>    m_NodeDof;     ///< 节点自由度编号
+    std::vector<Node*>  m_NodeView;    ///< 对应的节点对象
+    /// @}
+
+    /// @name 单元数组（下标 e 对应第 e 个单元）
+    /// @{
+    std::vector<int>                       m_ElementId;     ///< 单元ID
+    std::vector<EnumKeyword::ElementType>  m_ElementType;   ///< 单元类型
+    std::vector<int>                       m_ElemNodePtr;   ///< 单元-节点 CSR 行指针（长度 nElement+1）
+    std::vector<int>                       m_ElemNode;      ///< 单元节点下标（指向节点数组）
+    std::vector<int>                       m_ElemDofPtr;    ///< 单元自由度 CSR 行指针（长度 nElement+1）
+    std::vector<int>                       m_ElemDof;       ///< 单元自由度编号
+    std::vector<int>                       m_ElemProperty;  ///< 单元属性下标（指向属性表），无属性为 -1
+    std::vector<ElementConstants>          m_ElemConst;     ///< 单元常量表
+    std::vector<double>                    m_ElemStress;    ///< 单元应力
+    std::vector<double>                    m_ElemForce;     ///< 单元内力（按 m_ElemDofPtr 分段）
+    std::vector<ElementBase*>              m_ElementView;   ///< 对应的单元对象
+    std::vector<ElementBlock>              m_Blocks;        ///< 按类型划分的单元块
+    /// @}
+
+    /// @name 属性表（下标 p 对应第 p 个属性）
+    /// @{
+    std::vector<int>       m_PropertyId;    ///< 属性ID
+    std::vector<Property*> m_PropertyView;  ///< 对应的属性对象
+    /// @}
+
+    /**
+     * @brief 由结构数据建立紧凑数组并将节点视图绑定到状态向量（需在自由度编号之后调用）
+     * @param [in] pData 结构数据
+     *
+     * 状态向量不随重建清零，前序分析步的结果保留给后续分析步；
+     * 自由度编号与上次建立时不同时，按节点ID和方向重新映射（已删除节点的分量丢弃）。
+     */
+    void Build(StructureData* pData);
+
+    /**
+     * @brief 按自由度总数调整状态向量，新增分量为零
+     * @param [in] nDOF 自由度总数
+     */
+    void ResizeState(int nDOF);
+
+    /**
+     * @brief 清空所有数组和状态向量，并解除节点视图的绑定
+     */
+    void Clear();
+
+    /**
+     * @brief 清空模型数组并解除节点视图的绑定，保留状态向量
+     *
+     * 节点将被合并、删除或重新排序时调用；下次 Build 按节点ID把状态映射到新的自由度编号。
+     */
+    void ClearModel();
+
+    /**
+     * @brief 是否已建立
+     */
+    bool IsBuilt() const { return m_bBuilt; }
+
+    /**
+     * @brief 版本号（每次 Build 加一，未建立过为 0），依赖单元自由度的组装模式据此判断是否需要重建
+     */
+    uint64_t BuildVersion() const { return m_BuildVersion; }
+
+    /**
+     * @brief 节点个数
+     */
+    int NodeCount() const { return static_cast<int>(m_NodeId.size()); }
+
+    /**
+     * @brief 单元个数
+     */
+    int ElementCount() const { return static_cast<int>(m_ElementId.size()); }
+
+    /**
+     * @brief 统一的节点自由度数
+     * @return 所有单元为两节点单元、自由度数相同且每个节点恰有该数目的自由度（3 或 6）时返回该值，否则返回 0
+     *
+     * 非 0（记为 n）时节点 i 的自由度为 m_NodeDof[n*i + dir]，单元 e 的自由度和内力为
+     * m_ElemDof[2*n*e + k]、m_ElemForce[2*n*e + k]，可按固定步长寻址而不读取 CSR 行指针；
+     * 组装和内力累加据此选择以 n 为编译期常量的实现，混合模型使用通用实现。
+     */
+    int UniformNodeDOF() const { return m_UniformNodeDOF; }
+
+    /**
+     * @brief 根据节点ID查找下标
+     * @return 节点下标，未找到返回 -1
+     */
+    int FindNodeIndex(int id) const;
+
+    /**
+     * @brief 根据单元ID查找下标
+     * @return 单元下标，未找到返回 -1
+     */
+    int FindElementIndex(int id) const;
+
+    /**
+     * @brief 由材料、截面和节点坐标重新计算单元常量表，并把初始长度写回单元对象
+     */
+    void UpdateConstants();
+
+    /**
+     * @brief 使单元常量表失效（材料或截面参数修改后调用）
+     */
+    void InvalidateConstants() { m_bConstantsValid = false; }
+
+    /**
+     * @brief 单元常量表是否有效
+     */
+    bool ConstantsValid() const { return m_bConstantsValid; }
+
+    /**
+     * @brief 将单元应力和内力写回单元对象，供 GUI 等对象接口读取
+     */
+    void SyncElementsToObjects() const;
+
+private:
+    /**
+     * @brief 清空模型数组（不含状态向量）
+     */
+    void ClearArrays();
+
+    /**
+     * @brief 把状态向量从 m_StateNodeId 等记录的旧自由度编号映射到当前编号
+     */
+    void RemapState();
+
+    /**
+     * @brief 检查自由度布局是否统一，设置 m_UniformNodeDOF
+     */
+    void Detect_UniformLayout();
+
+    bool m_bBuilt = false;                       ///< 是否已建立
+    uint64_t m_BuildVersion = 0;                 ///< 版本号
+    bool m_bConstantsValid = false;              ///< 单元常量表是否有效
+    int m_UniformNodeDOF = 0;                    ///< 统一的节点自由度数（3 或 6），不统一为 0
+    std::unordered_map<int, int> m_NodeIndex;    ///< 节点ID -> 下标
+    std::unordered_map<int, int> m_ElementIndex; ///< 单元ID -> 下标
+
+    /// @name 状态向量所用的自由度编号（清空数组时从节点数组移入，重建后映射完即清空）
+    /// @{
+    std::vector<int> m_StateNodeId;              ///< 节点ID
+    std::vector<int> m_StateDofPtr;              ///< 节点自由度 CSR 行指针
+    std::vector<int> m_StateDof;                 ///< 节点自由度编号
+    /// @}
+};
@@ -0,0 +1,690 @@
+﻿#include "ModelBinary.h"
+#include "StructureData.h"
+#include <QFile>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    const char s_Magic[8] = { 'Y', 'Q', 'Y', 'M', 'O', 'D', 'E', 'L' };
+    const uint32_t s_ByteOrder = 0x01020304;
+
+    static_assert(sizeof(ModelBinary::FileHeader) == 32, "FileHeader layout");
+    static_assert(sizeof(ModelBinary::SectionEntry) == 24, "SectionEntry layout");
+    static_assert(sizeof(ModelBinary::ElementRecord) == 24, "ElementRecord layout");
+    static_assert(sizeof(ModelBinary::MaterialRecord) == 48, "MaterialRecord layout");
+    static_assert(sizeof(ModelBinary::SectionRecord) == 24, "SectionRecord layout");
+    static_assert(sizeof(ModelBinary::PropertyRecord) == 16, "PropertyRecord layout");
+    static_assert(sizeof(ModelBinary::ConstraintRecord) == 24, "ConstraintRecord layout");
+    static_assert(sizeof(ModelBinary::LoadRecord) == 32, "LoadRecord layout");
+    static_assert(sizeof(ModelBinary::StepRecord) == 64, "StepRecord layout");
+    static_assert(sizeof(ModelBinary::StepRecordV2) == 48, "StepRecordV2 layout");
+    static_assert(sizeof(ModelBinary::SetRecord) == 24, "SetRecord layout");
+    static_assert(sizeof(ModelBinary::OutputRequestRecord) == 48, "OutputRequestRecord layout");
+
+    inline uint64_t AlignUp(uint64_t offset)
+    {
+        return (offset + ModelBinary::Alignment - 1) / ModelBinary::Alignment * ModelBinary::Alignment;
+    }
+
+    /**
+     * @brief 待写出的数据段
+     */
+    struct PendingSection
+    {
+        ModelBinary::SectionType type;
+        uint32_t recordSize;
+        const void* data;
+        uint64_t count;
+    };
+
+    template <class T>
+    PendingSection MakeSection(ModelBinary::SectionType type, const std::vector<T>& records)
+    {
+        return { type, static_cast<uint32_t>(sizeof(T)), records.data(), records.size() };
+    }
+
+    /**
+     * @brief 映射文件中的段表，按类型取出数据段
+     */
+    class SectionTable
+    {
+    public:
+        SectionTable(const uchar* base, uint64_t size) : m_pBase(base), m_Size(size) {}
+
+        /**
+         * @brief 校验文件头和段表
+         */
+        bool Validate()
+        {
+            if (m_Size < sizeof(ModelBinary::FileHeader)) return false;
+            std::memcpy(&m_Header, m_pBase, sizeof(m_Header));
+            if (0 != std::memcmp(m_Header.m_Magic, s_Magic, sizeof(s_Magic))) return false;
+            if (m_Header.m_ByteOrder != s_ByteOrder || m_Header.m_FileSize != m_Size) return false;
+
+            const uint64_t tableEnd = sizeof(ModelBinary::FileHeader) + static_cast<uint64_t>(m_Header.m_nSection) * sizeof(ModelBinary::SectionEntry);
+            if (tableEnd > m_Size) return false;
+            m_pEntry = reinterpret_cast<const ModelBinary::SectionEntry*>(m_pBase + sizeof(ModelBinary::FileHeader));
+
+            for (uint32_t i = 0; i < m_Header.m_nSection; ++i)
+            {
+                const ModelBinary::SectionEntry& entry = m_pEntry[i];
+                if (0 != entry.m_Offset % ModelBinary::Alignment || entry.m_Offset > m_Size) return false;
+                if (0 != entry.m_RecordSize && entry.m_Count > (m_Size - entry.m_Offset) / entry.m_RecordSize) return false;
+            }
+            return true;
+        }
+
+        uint32_t Version() const { return m_Header.m_Version; }
+
+        /**
+         * @brief 取出类型为 type、记录为 T 的数据段；段不存在时 count 为 0，记录大小不符返回 false
+         */
+        template <class T>
+        bool Get(ModelBinary::SectionType type, const T*& records, uint64_t& count) const
+        {
+            records = nullptr;
+            count = 0;
+            for (uint32_t i = 0; i < m_Header.m_nSection; ++i)
+            {
+                const ModelBinary::SectionEntry& entry = m_pEntry[i];
+                if (entry.m_Type != static_cast<uint32_t>(type)) continue;
+                if (entry.m_RecordSize != sizeof(T)) return false;
+
+                records = reinterpret_cast<const T*>(m_pBase + entry.m_Offset);
+                count = entry.m_Count;
+                return true;
+            }
+            return true;
+        }
+
+    private:
+        const uchar* m_pBase;
+        uint64_t m_Size;
+        ModelBinary::FileHeader m_Header = {};
+        const ModelBinary::SectionEntry* m_pEntry = nullptr;
+    };
+
+    inline bool InRange(int32_t index, uint64_t count)
+    {
+        return index >= -1 && index < static_cast<int64_t>(count);
+    }
+
+    /**
+     * @brief [begin, begin+size) 是否在 count 个记录的段内
+     */
+    inline bool InSpan(int32_t begin, int32_t size, uint64_t count)
+    {
+        return begin >= 0 && size >= 0 && static_cast<uint64_t>(begin) + static_cast<uint64_t>(size) <= count;
+    }
+
+    /**
+     * @brief 读取各版本分析步记录共有的字段
+     */
+    template <class TRecord>
+    void Read_StepRecord(const TRecord& record, AnalysisStep& step)
+    {
+        step.m_Id = record.m_Id;
+        step.m_Type = static_cast<EnumKeyword::StepType>(record.m_Type);
+        step.m_Time = record.m_Time;
+        step.m_StepSize = record.m_StepSize;
+        step.m_Tolerance = record.m_Tolerance;
+        step.m_MaxIterations = record.m_MaxIterations;
+        step.m_nModes = record.m_nModes;
+        step.m_DampingRatio = record.m_DampingRatio;
+    }
+
+    /**
+     * @brief 把名称追加到 NAME 段
+     * @param [in,out] names NAME 段
+     * @param [out] begin 名称起点
+     * @param [out] size 名称字节数
+     */
+    inline void AppendName(std::vector<char>& names, const QString& name, int32_t& begin, int32_t& size)
+    {
+        const QByteArray bytes = name.toUtf8();
+        begin = static_cast<int32_t>(names.size());
+        size = static_cast<int32_t>(bytes.size());
+        names.insert(names.end(), bytes.constData(), bytes.constData() + bytes.size());
+    }
+}
+
+bool ModelBinary::IsBinary(const char* begin, int64_t size)
+{
+    return size >= static_cast<int64_t>(sizeof(s_Magic)) && 0 == std::memcmp(begin, s_Magic, sizeof(s_Magic));
+}
+
+bool ModelBinary::Write(const StructureData& data, const QString& FileName)
+{
+    // 1. 整理各段数组，对象之间的引用改为数组下标
+    std::vector<int32_t> nodeId;
+    std::vector<double> nodeCoord;
+    std::unordered_map<const Node*, int32_t> nodeIndex;
+    nodeId.reserve(data.m_Nodes.size());
+    nodeCoord.reserve(3 * data.m_Nodes.size());
+    nodeIndex.reserve(data.m_Nodes.size());
+    for (const auto& nodePair : data.m_Nodes)
+    {
+        const Node* pNode = nodePair.second.get();
+        nodeIndex[pNode] = static_cast<int32_t>(nodeId.size());
+        nodeId.push_back(pNode->m_Id);
+        nodeCoord.push_back(pNode->m_X);
+        nodeCoord.push_back(pNode->m_Y);
+        nodeCoord.push_back(pNode->m_Z);
+    }
+
+    std::vector<MaterialRecord> materials;
+    std::unordered_map<const Material*, int32_t> materialIndex;
+    for (const auto& materialPair : data.m_Material)
+    {
+        const Material* pMaterial = materialPair.second.get();
+        materialIndex[pMaterial] = static_cast<int32_t>(materials.size());
+        materials.push_back({ pMaterial->m_Id, 0, pMaterial->m_Young, pMaterial->m_Poisson,
+            pMaterial->m_Density, pMaterial->m_MaxStress, pMaterial->m_Expansion });
+    }
+
+    std::vector<SectionRecord> sections;
+    std::unordered_map<const SectionBase*, int32_t> sectionIndex;
+    for (const auto& sectionPair : data.m_Section)
+    {
+        const SectionBase* pSection = sectionPair.second.get();
+        auto pCircular = dynamic_cast<const SectionCircular*>(pSection);
+        sectionIndex[pSection] = static_cast<int32_t>(sections.size());
+        sections.push_back({ pSection->m_Id,
+            static_cast<int32_t>(pCircular ? EnumKeyword::SectionType::CIRCULAR : EnumKeyword::SectionType::UNKNOWN),
+            pSection->m_Area, pCircular ? pCircular->m_Radius : 0.0 });
+    }
+
+    std::vector<PropertyRecord> properties;
+    std::unordered_map<const Property*, int32_t> propertyIndex;
+    for (const auto& propertyPair : data.m_Property)
+    {
+        const Property* pProperty = propertyPair.second.get();
+        auto pMaterial = pProperty->m_pMaterial.lock();
+        auto pSection = pProperty->m_pSection.lock();
+        auto itMat = pMaterial ? materialIndex.find(pMaterial.get()) : materialIndex.end();
+        auto itSec = pSection ? sectionIndex.find(pSection.get()) : sectionIndex.end();
+        propertyIndex[pProperty] = static_cast<int32_t>(properties.size());
+        properties.push_back({ pProperty->m_Id,
+            itMat != materialIndex.end() ? itMat->second : -1,
+            itSec != sectionIndex.end() ? itSec->second : -1, 0 });
+    }
+
+    std::vector<ElementRecord> elements;
+    std::vector<int32_t> elemNodePtr(1, 0);
+    std::vector<int32_t> elemNode;
+    std::unordered_map<const ElementBase*, int32_t> elementIndex;
+    elements.reserve(data.m_Elements.size());
+    elemNodePtr.reserve(data.m_Elements.size() + 1);
+    elemNode.reserve(2 * data.m_Elements.size());
+    elementIndex.reserve(data.m_Elements.size());
+    for (const auto& elementPair : data.m_Elements)
+    {
+        const ElementBase* pElement = elementPair.second.get();
+        for (const auto& node : pElement->m_pNode)
+        {
+            auto pNode = node.lock();
+            auto it = pNode ? nodeIndex.find(pNode.get()) : nodeIndex.end();
+            elemNode.push_back(it != nodeIndex.end() ? it->second : -1);
+        }
+        elemNodePtr.push_back(static_cast<int32_t>(elemNode.size()));
+
+        auto pProperty = pElement->m_pProperty.lock();
+        auto it = pProperty ? propertyIndex.find(pProperty.get()) : propertyIndex.end();
+        elementIndex[pElement] = static_cast<int32_t>(elements.size());
+        elements.push_back({ pElement->m_Id, static_cast<int32_t>(pElement->Get_ElementType()),
+            it != propertyIndex.end() ? it->second : -1, 0, pElement->m_Stress });
+    }
+
+    std::vector<ConstraintRecord> constraints;
+    for (const auto& constraintPair : data.m_Constraint)
+    {
+        const Constraint* pConstraint = constraintPair.second.get();
+        auto pNode = pConstraint->m_pNode.lock();
+        auto it = pNode ? nodeIndex.find(pNode.get()) : nodeIndex.end();
+        constraints.push_back({ pConstraint->m_Id, it != nodeIndex.end() ? it->second : -1,
+            static_cast<int32_t>(pConstraint->m_Direction), 0, pConstraint->m_Value });
+    }
+
+    std::vector<LoadRecord> loads;
+    for (const auto& loadPair : data.m_Load)
+    {
+        const LoadBase* pLoad = loadPair.second.get();
+        LoadRecord record = { pLoad->m_Id, static_cast<int32_t>(pLoad->m_LoadType),
+            static_cast<int32_t>(pLoad->m_Direction), pLoad->m_StepId, -1, 0, 0.0 };
+        if (auto pForce = dynamic_cast<const Force_Node*>(pLoad))
+        {
+            auto pNode = pForce->m_pNode.lock();
+            auto it = pNode ? nodeIndex.find(pNode.get()) : nodeIndex.end();
+            record.m_Target = it != nodeIndex.end() ? it->second : -1;
+            record.m_Value = pForce->m_Value;
+        }
+        else if (auto pForce = dynamic_cast<const Force_Element*>(pLoad))
+        {
+            auto pElement = pForce->m_pElement.lock();
+            auto it = pElement ? elementIndex.find(pElement.get()) : elementIndex.end();
+            record.m_Target = it != elementIndex.end() ? it->second : -1;
+            record.m_Value = pForce->m_Value;
+        }
+        else if (auto pGravity = dynamic_cast<const Force_Gravity*>(pLoad))
+        {
+            record.m_Value = pGravity->m_g;
+        }
+        loads.push_back(record);
+    }
+
+    std::vector<StepRecord> steps;
+    for (const auto& stepPair : data.m_AnalysisStep)
+    {
+        const AnalysisStep* pStep = stepPair.second.get();
+        steps.push_back({ pStep->m_Id, static_cast<int32_t>(pStep->m_Type), pStep->m_MaxIterations, pStep->m_nModes,
+            pStep->m_Time, pStep->m_StepSize, pStep->m_Tolerance, pStep->m_DampingRatio,
+            pStep->m_EigenTolerance, pStep->m_EigenMaxIterations, 0 });
+    }
+
+    std::vector<char> names;
+    std::vector<SetRecord> sets;
+    std::vector<int32_t> setIds;
+    const Outputter& outputter = data.m_Outputter;
+    for (int bElement = 0; bElement < 2; ++bElement)
+    {
+        for (const auto& setPair : bElement ? outputter.GetElementSets() : outputter.GetNodeSets())
+        {
+            SetRecord record = { bElement, 0, 0, static_cast<int32_t>(setIds.size()), static_cast<int32_t>(setPair.second.size()), 0 };
+            AppendName(names, setPair.first, record.m_NameBegin, record.m_NameSize);
+            setIds.insert(setIds.end(), setPair.second.begin(), setPair.second.end());
+            sets.push_back(record);
+        }
+    }
+
+    std::vector<OutputRequestRecord> requests;
+    std::vector<int32_t> requestTypes;
+    for (const OutputRequest& request : outputter.GetRequests())
+    {
+        OutputRequestRecord record = { request.m_Id, static_cast<int32_t>(request.m_Kind), request.m_StepId,
+            request.m_bElement ? 1 : 0, 0, 0, static_cast<int32_t>(request.m_Frequency), request.m_Interval,
+            static_cast<int32_t>(requestTypes.size()), static_cast<int32_t>(request.m_Types.size()), request.m_TimeInterval };
+        AppendName(names, request.m_SetName, record.m_NameBegin, record.m_NameSize);
+        for (DataType type : request.m_Types) requestTypes.push_back(static_cast<int32_t>(type));
+        requests.push_back(record);
+    }
+
+    // 2. 段表：各段起始位置按 Alignment 对齐
+    std::vector<PendingSection> pending = {
+        MakeSection(SectionType::NODE_ID, nodeId),
+        { SectionType::NODE_COORD, static_cast<uint32_t>(3 * sizeof(double)), nodeCoord.data(), nodeId.size() },
+        MakeSection(SectionType::ELEMENT, elements),
+        MakeSection(SectionType::ELEMENT_NODE_PTR, elemNodePtr),
+        MakeSection(SectionType::ELEMENT_NODE, elemNode),
+        MakeSection(SectionType::MATERIAL, materials),
+        MakeSection(SectionType::SECTION, sections),
+        MakeSection(SectionType::PROPERTY, properties),
+        MakeSection(SectionType::CONSTRAINT, constraints),
+        MakeSection(SectionType::LOAD, loads),
+        MakeSection(SectionType::ANALYSIS_STEP, steps),
+        MakeSection(SectionType::NAME, names),
+        MakeSection(SectionType::SET, sets),
+        MakeSection(SectionType::SET_ID, setIds),
+        MakeSection(SectionType::OUTPUT_REQUEST, requests),
+        MakeSection(SectionType::OUTPUT_TYPE, requestTypes),
+    };
+
+    std::vector<SectionEntry> table;
+    uint64_t offset = AlignUp(sizeof(FileHeader) + pending.size() * sizeof(SectionEntry));
+    for (const PendingSection& section : pending)
+    {
+        table.push_back({ static_cast<uint32_t>(section.type), section.recordSize, offset, section.count });
+        offset = AlignUp(offset + section.recordSize * section.count);
+    }
+
+    FileHeader header = {};
+    std::memcpy(header.m_Magic, s_Magic, sizeof(s_Magic));
+    header.m_Version = Version;
+    header.m_ByteOrder = s_ByteOrder;
+    header.m_nSection = static_cast<uint32_t>(table.size());
+    header.m_FileSize = offset;
+
+    // 3. 写出
+    QFile file(FileName);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qDebug().noquote() << QStringLiteral("Error: 无法写入文件 ") << FileName;
+        return false;
+    }
+
+    static const char zeros[Alignment] = {};
+    uint64_t written = 0;
+    auto writeBytes = [&](const void* bytes, uint64_t size)
+        {
+            if (0 == size) return true;
+            if (file.write(static_cast<const char*>(bytes), static_cast<qint64>(size)) != static_cast<qint64>(size)) return false;
+            written += size;
+            return true;
+        };
+    auto padTo = [&](uint64_t position) { return writeBytes(zeros, position - written); };
+
+    bool bOk = writeBytes(&header, sizeof(header)) && writeBytes(table.data(), table.size() * sizeof(SectionEntry));
+    for (size_t i = 0; bOk && i < pending.size(); ++i)
+    {
+        bOk = padTo(table[i].m_Offset) && writeBytes(pending[i].data, pending[i].recordSize * pending[i].count);
+    }
+    bOk = bOk && padTo(header.m_FileSize);
+    file.close();
+
+    if (!bOk)
+    {
+        qDebug().noquote() << QStringLiteral("Error: 写入文件失败 ") << FileName;
+        return false;
+    }
+    return true;
+}
+
+bool ModelBinary::Read(StructureData& data, const QString& FileName)
+{
+    data.Clear();
+
+    QFile file(FileName);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qDebug().noquote() << QStringLiteral("Error: 文件 ") << FileName << QStringLiteral(" 不存在");
+        return false;
+    }
+    const qint64 size = file.size();
+    uchar* pMap = size > 0 ? file.map(0, size) : nullptr;
+    if (!pMap)
+    {
+        qDebug().noquote() << QStringLiteral("Error: 文件映射失败: ") << FileName;
+        return false;
+    }
+
+    auto fail = [&](const QString& message)
+        {
+            qDebug().noquote() << QStringLiteral("Error: 二进制模型文件 ") << FileName << QStringLiteral(" ") << message;
+            file.unmap(pMap);
+            data.Clear();
+            return false;
+        };
+
+    SectionTable table(pMap, static_cast<uint64_t>(size));
+    if (!table.Validate()) return fail(QStringLiteral("文件头或段表损坏"));
+    if (table.Version() < 1 || table.Version() > Version)
+    {
+        return fail(QStringLiteral("版本 %1 不受支持").arg(static_cast<int>(table.Version())));
+    }
+    const bool bLegacyStep = table.Version() < 3;
+
+    struct Coord3 { double x[3]; };
+
+    const int32_t* nodeId = nullptr;
+    const Coord3* nodeCoord = nullptr;
+    const ElementRecord* elementRecords = nullptr;
+    const int32_t* elemNodePtr = nullptr;
+    const int32_t* elemNode = nullptr;
+    const MaterialRecord* materialRecords = nullptr;
+    const SectionRecord* sectionRecords = nullptr;
+    const PropertyRecord* propertyRecords = nullptr;
+    const ConstraintRecord* constraintRecords = nullptr;
+    const LoadRecord* loadRecords = nullptr;
+    const StepRecord* stepRecords = nullptr;
+    const StepRecordV2* legacyStepRecords = nullptr;
+    const char* names = nullptr;
+    const SetRecord* setRecords = nullptr;
+    const int32_t* setIds = nullptr;
+    const OutputRequestRecord* requestRecords = nullptr;
+    const int32_t* requestTypes = nullptr;
+    uint64_t nNode = 0, nCoord = 0, nElement = 0, nPtr = 0, nElemNode = 0, nMaterial = 0, nSection = 0,
+        nProperty = 0, nConstraint = 0, nLoad = 0, nStep = 0, nName = 0, nSet = 0, nSetId = 0, nRequest = 0, nRequestType = 0;
+    bool bOk = table.Get(SectionType::NODE_ID, nodeId, nNode)
+        && table.Get(SectionType::NODE_COORD, nodeCoord, nCoord)
+        && table.Get(SectionType::ELEMENT, elementRecords, nElement)
+        && table.Get(SectionType::ELEMENT_NODE_PTR, elemNodePtr, nPtr)
+        && table.Get(SectionType::ELEMENT_NODE, elemNode, nElemNode)
+        && table.Get(SectionType::MATERIAL, materialRecords, nMaterial)
+        && table.Get(SectionType::SECTION, sectionRecords, nSection)
+        && table.Get(SectionType::PROPERTY, propertyRecords, nProperty)
+        && table.Get(SectionType::CONSTRAINT, constraintRecords, nConstraint)
+        && table.Get(SectionType::LOAD, loadRecords, nLoad)
+        && (bLegacyStep ? table.Get(SectionType::ANALYSIS_STEP, legacyStepRecords, nStep)
+                        : table.Get(SectionType::ANALYSIS_STEP, stepRecords, nStep))
+        && table.Get(SectionType::NAME, names, nName)
+        && table.Get(SectionType::SET, setRecords, nSet)
+        && table.Get(SectionType::SET_ID, setIds, nSetId)
+        && table.Get(SectionType::OUTPUT_REQUEST, requestRecords, nRequest)
+        && table.Get(SectionType::OUTPUT_TYPE, requestTypes, nRequestType);
+    if (!bOk) return fail(QStringLiteral("记录大小不符"));
+    if (nCoord != nNode || nPtr != nElement + 1 || (nElement > 0 && !elemNodePtr))
+    {
+        return fail(QStringLiteral("节点或单元段不完整"));
+    }
+
+    // 节点
+    std::vector<std::shared_ptr<Node>> nodes(nNode);
+    for (uint64_t i = 0; i < nNode; ++i)
+    {
+        auto pNode = data.Create_Object<Node>();
+        pNode->m_Id = nodeId[i];
+        pNode->m_X = nodeCoord[i].x[0];
+        pNode->m_Y = nodeCoord[i].x[1];
+        pNode->m_Z = nodeCoord[i].x[2];
+        data.m_Nodes.emplace_hint(data.m_Nodes.end(), pNode->m_Id, pNode);
+        nodes[i] = pNode;
+    }
+
+    // 材料、截面、属性
+    std::vector<std::shared_ptr<Material>> materials(nMaterial);
+    for (uint64_t i = 0; i < nMaterial; ++i)
+    {
+        const MaterialRecord& record = materialRecords[i];
+        auto pMaterial = data.Create_Object<Material>();
+        pMaterial->m_Id = record.m_Id;
+        pMaterial->m_Young = record.m_Young;
+        pMaterial->m_Poisson = record.m_Poisson;
+        pMaterial->m_Density = record.m_Density;
+        pMaterial->m_MaxStress = record.m_MaxStress;
+        pMaterial->m_Expansion = record.m_Expansion;
+        data.m_Material.emplace_hint(data.m_Material.end(), record.m_Id, pMaterial);
+        materials[i] = pMaterial;
+    }
+
+    std::vector<std::shared_ptr<SectionBase>> sections(nSection);
+    for (uint64_t i = 0; i < nSection; ++i)
+    {
+        const SectionRecord& record = sectionRecords[i];
+        if (static_cast<int32_t>(EnumKeyword::SectionType::CIRCULAR) != record.m_Type)
+        {
+            return fail(QStringLiteral("不支持的截面类型"));
+        }
+        auto pSection = data.Create_Object<SectionCircular>();
+        pSection->m_Id = record.m_Id;
+        pSection->m_Radius = record.m_Radius;
+        pSection->m_Area = record.m_Area;
+        data.m_Section.emplace_hint(data.m_Section.end(), record.m_Id, pSection);
+        sections[i] = pSection;
+    }
+
+    std::vector<std::shared_ptr<Property>> properties(nProperty);
+    for (uint64_t i = 0; i < nProperty; ++i)
+    {
+        const PropertyRecord& record = propertyRecords[i];
+        if (!InRange(record.m_Material, nMaterial) || !InRange(record.m_Section, nSection))
+        {
+            return fail(QStringLiteral("属性引用越界"));
+        }
+        auto pProperty = data.Create_Object<Property>();
+        pProperty->m_Id = record.m_Id;
+        if (record.m_Material >= 0) pProperty->m_pMaterial = materials[record.m_Material];
+        if (record.m_Section >= 0) pProperty->m_pSection = sections[record.m_Section];
+        data.m_Property.emplace_hint(data.m_Property.end(), record.m_Id, pProperty);
+        properties[i] = pProperty;
+    }
+
+    // 单元
+    std::vector<std::shared_ptr<ElementBase>> elements(nElement);
+    for (uint64_t e = 0; e < nElement; ++e)
+    {
+        const ElementRecord& record = elementRecords[e];
+        const int32_t begin = elemNodePtr[e];
+        const int32_t end = elemNodePtr[e + 1];
+        if (begin < 0 || end < begin || static_cast<uint64_t>(end) > nElemNode || !InRange(record.m_Property, nProperty))
+        {
+            return fail(QStringLiteral("单元数据越界"));
+        }
+
+        std::shared_ptr<ElementBase> pElement;
+        switch (static_cast<EnumKeyword::ElementType>(record.m_Type))
+        {
+        case EnumKeyword::ElementType::T3D2:
+            pElement = data.Create_Object<ElementTruss>();
+            break;
+        case EnumKeyword::ElementType::CABLE:
+            pElement = data.Create_Object<ElementCable>();
+            break;
+        case EnumKeyword::ElementType::B31:
+            pElement = data.Create_Object<ElementBeam>();
+            break;
+        default:
+            return fail(QStringLiteral("未知的单元类型"));
+        }
+
+        pElement->m_Id = record.m_Id;
+        pElement->m_Stress = record.m_Stress;
+        pElement->m_pNode.resize(end - begin);
+        for (int32_t k = begin; k < end; ++k)
+        {
+            if (!InRange(elemNode[k], nNode)) return fail(QStringLiteral("单元节点越界"));
+            if (elemNode[k] >= 0) pElement->m_pNode[k - begin] = nodes[elemNode[k]];
+        }
+        if (record.m_Property >= 0) pElement->m_pProperty = properties[record.m_Property];
+
+        data.m_Elements.emplace_hint(data.m_Elements.end(), record.m_Id, pElement);
+        elements[e] = pElement;
+    }
+
+    // 约束
+    for (uint64_t i = 0; i < nConstraint; ++i)
+    {
+        const ConstraintRecord& record = constraintRecords[i];
+        if (!InRange(record.m_Node, nNode)) return fail(QStringLiteral("约束节点越界"));
+
+        auto pConstraint = data.Create_Object<Constraint>();
+        pConstraint->m_Id = record.m_Id;
+        if (record.m_Node >= 0) pConstraint->m_pNode = nodes[record.m_Node];
+        pConstraint->m_Direction = static_cast<EnumKeyword::Direction>(record.m_Direction);
+        pConstraint->m_Value = record.m_Value;
+        data.m_Constraint.emplace_hint(data.m_Constraint.end(), record.m_Id, pConstraint);
+    }
+
+    // 荷载
+    for (uint64_t i = 0; i < nLoad; ++i)
+    {
+        const LoadRecord& record = loadRecords[i];
+        std::shared_ptr<LoadBase> pLoad;
+        switch (static_cast<EnumKeyword::LoadType>(record.m_Type))
+        {
+        case EnumKeyword::LoadType::FORCE_NODE:
+        {
+            if (!InRange(record.m_Target, nNode)) return fail(QStringLiteral("荷载节点越界"));
+            auto pForce = data.Create_Object<Force_Node>();
+            if (record.m_Target >= 0) pForce->m_pNode = nodes[record.m_Target];
+            pForce->m_Value = record.m_Value;
+            pLoad = pForce;
+            break;
+        }
+        case EnumKeyword::LoadType::FORCE_ELEMENT:
+        {
+            if (!InRange(record.m_Target, nElement)) return fail(QStringLiteral("荷载单元越界"));
+            auto pForce = data.Create_Object<Force_Element>();
+            if (record.m_Target >= 0) pForce->m_pElement = elements[record.m_Target];
+            pForce->m_Value = record.m_Value;
+            pLoad = pForce;
+            break;
+        }
+        case EnumKeyword::LoadType::FORCE_GRAVITY:
+        {
+            auto pGravity = data.Create_Object<Force_Gravity>();
+            pGravity->m_g = record.m_Value;
+            pLoad = pGravity;
+            break;
+        }
+        default:
+            return fail(QStringLiteral("未知的荷载类型"));
+        }
+
+        pLoad->m_Id = record.m_Id;
+        pLoad->m_Direction = static_cast<EnumKeyword::Direction>(record.m_Direction);
+        pLoad->m_StepId = record.m_StepId;
+        data.m_Load.emplace_hint(data.m_Load.end(), record.m_Id, pLoad);
+    }
+
+    // 分析步
+    for (uint64_t i = 0; i < nStep; ++i)
+    {
+        auto pStep = data.Create_Object<AnalysisStep>();
+        if (bLegacyStep)
+        {// 旧版本没有特征值迭代参数，保持默认值
+            Read_StepRecord(legacyStepRecords[i], *pStep);
+        }
+        else
+        {
+            const StepRecord& record = stepRecords[i];
+            Read_StepRecord(record, *pStep);
+            pStep->m_EigenTolerance = record.m_EigenTolerance;
+            pStep->m_EigenMaxIterations = record.m_EigenMaxIterations;
+        }
+        data.m_AnalysisStep.emplace_hint(data.m_AnalysisStep.end(), pStep->m_Id, pStep);
+    }
+
+    // 集合、输出请求
+    for (uint64_t i = 0; i < nSet; ++i)
+    {
+        const SetRecord& record = setRecords[i];
+        if (!InSpan(record.m_NameBegin, record.m_NameSize, nName) || !InSpan(record.m_IdBegin, record.m_IdCount, nSetId))
+        {
+            return fail(QStringLiteral("集合数据越界"));
+        }
+        const QString name = QString::fromUtf8(names + record.m_NameBegin, record.m_NameSize);
+        const std::vector<int> ids(setIds + record.m_IdBegin, setIds + record.m_IdBegin + record.m_IdCount);
+        if (record.m_bElement) data.m_Outputter.AddElementSet(name, ids);
+        else data.m_Outputter.AddNodeSet(name, ids);
+    }
+
+    for (uint64_t i = 0; i < nRequest; ++i)
+    {
+        const OutputRequestRecord& record = requestRecords[i];
+        if (!InSpan(record.m_NameBegin, record.m_NameSize, nName) || !InSpan(record.m_TypeBegin, record.m_TypeCount, nRequestType))
+        {
+            return fail(QStringLiteral("输出请求数据越界"));
+        }
+
+        OutputRequest request;
+        request.m_Id = record.m_Id;
+        request.m_Kind = static_cast<OutputRequest::Kind>(record.m_Kind);
+        request.m_StepId = record.m_StepId;
+        request.m_SetName = QString::fromUtf8(names + record.m_NameBegin, record.m_NameSize);
+        request.m_bElement = 0 != record.m_bElement;
+        request.m_Frequency = static_cast<OutputRequest::Frequency>(record.m_Frequency);
+        request.m_Interval = record.m_Interval;
+        request.m_TimeInterval = record.m_TimeInterval;
+        for (int32_t k = 0; k < record.m_TypeCount; ++k)
+        {
+            const int32_t type = requestTypes[record.m_TypeBegin + k];
+            if (type < 0 || type >= DataTypeCount) return fail(QStringLiteral("未知的输出数据类型"));
+            request.m_Types.push_back(static_cast<DataType>(type));
+        }
+        data.m_Outputter.AddRequest(request);
+    }
+
+    file.unmap(pMap);
+    file.close();
+
+    if (data.m_Nodes.size() != nNode || data.m_Elements.size() != nElement)
+    {
+        qDebug().noquote() << QStringLiteral("Error: 二进制模型文件 ") << FileName << QStringLiteral(" 中有重复的ID");
+        data.Clear();
+        return false;
+    }
+
+    data.TopologyChanged();
+    return true;
+}
@@ -0,0 +1,205 @@
+﻿#pragma once
+#include <QString>
+#include <cstdint>
+
+class StructureData;
+
+/**
+ * @brief 二进制模型文件 - 保存清理后的模型，读取时不再解析文本和清理模型
+ *
+ * 文件由文件头、段表和若干数据段组成。每个数据段是定长记录的数组，起始位置按 Alignment 字节对齐，
+ * 映射到内存后可以直接按记录类型访问。节点坐标为 3*i+0/1/2 的连续数组，单元-节点连接为 CSR 格式，
+ * 连接中存放节点数组下标，单元属性存放属性表下标，与 CompactModel 的数组布局相同。
+ * 节点、单元、约束、荷载在文件中按ID升序排列。
+ * 输出用的节点/单元集合和 *OUTPUT 输出请求也写入文件；集合中存放ID（集合可以引用模型中不存在的对象），
+ * 集合名称存放在 NAME 段中（UTF-8，不以 0 结尾），记录中给出在 NAME 段中的起点和字节数。
+ *
+ * 版本号在格式不兼容时增加；读取时跳过不认识的段，缺少必需的段时报错。
+ * 旧版本的文件仍可读取：版本 1 没有集合和输出请求段，读取后二者为空；
+ * 版本 1、2 的分析步记录不含特征值迭代参数（StepRecordV2），读取后这两项取默认值。
+ *
+ * 已知限制：读取时仍逐个创建节点、单元等对象（分析步初始化、输出等都使用对象），CompactModel 在分析步
+ * 初始化时由对象建立。读取耗时主要是创建单元对象，约 200 万单元的模型单核约 1.0~1.4 s，未达到 1 s 以内；
+ * 要进一步缩短需要把数据段直接作为 CompactModel 的数组，不再为每个单元创建对象。
+ */
+class ModelBinary
+{
+public:
+    static const uint32_t Version = 3;     ///< 当前格式版本（2：增加集合和输出请求；3：分析步增加特征值迭代参数）
+    static const uint32_t Alignment = 64;  ///< 数据段对齐字节数
+
+    /**
+     * @brief 数据段类型
+     */
+    enum class SectionType : uint32_t
+    {
+        NODE_ID = 1,       ///< int32[nNode] 节点ID
+        NODE_COORD,        ///< double[3*nNode] 节点坐标
+        ELEMENT,           ///< ElementRecord[nElement]
+        ELEMENT_NODE_PTR,  ///< int32[nElement+1] 单元-节点 CSR 行指针
+        ELEMENT_NODE,      ///< int32[] 单元节点下标
+        MATERIAL,          ///< MaterialRecord[]
+        SECTION,           ///< SectionRecord[]
+        PROPERTY,          ///< PropertyRecord[]
+        CONSTRAINT,        ///< ConstraintRecord[]
+        LOAD,              ///< LoadRecord[]
+        ANALYSIS_STEP,     ///< StepRecord[]
+        NAME,              ///< char[] 集合名称
+        SET,               ///< SetRecord[]
+        SET_ID,            ///< int32[] 集合中的节点或单元ID
+        OUTPUT_REQUEST,    ///< OutputRequestRecord[]
+        OUTPUT_TYPE        ///< int32[] 输出请求的数据类型（DataType）
+    };
+
+    /// @name 文件记录（小端、定长）
+    /// @{
+    struct FileHeader
+    {
+        char     m_Magic[8];     ///< "YQYMODEL"
+        uint32_t m_Version;      ///< 格式版本
+        uint32_t m_ByteOrder;    ///< 字节序标记 0x01020304
+        uint32_t m_nSection;     ///< 段数
+        uint32_t m_Reserved;
+        uint64_t m_FileSize;     ///< 文件总字节数
+    };
+
+    struct SectionEntry
+    {
+        uint32_t m_Type;         ///< SectionType
+        uint32_t m_RecordSize;   ///< 记录字节数
+        uint64_t m_Offset;       ///< 段起始位置（按 Alignment 对齐）
+        uint64_t m_Count;        ///< 记录个数
+    };
+
+    struct ElementRecord
+    {
+        int32_t m_Id;
+        int32_t m_Type;          ///< EnumKeyword::ElementType
+        int32_t m_Property;      ///< 属性表下标，无属性为 -1
+        int32_t m_Reserved;
+        double  m_Stress;        ///< 单元应力
+    };
+
+    struct MaterialRecord
+    {
+        int32_t m_Id;
+        int32_t m_Reserved;
+        double  m_Young;
+        double  m_Poisson;
+        double  m_Density;
+        double  m_MaxStress;
+        double  m_Expansion;
+    };
+
+    struct SectionRecord
+    {
+        int32_t m_Id;
+        int32_t m_Type;          ///< EnumKeyword::SectionType
+        double  m_Area;
+        double  m_Radius;        ///< 圆截面半径
+    };
+
+    struct PropertyRecord
+    {
+        int32_t m_Id;
+        int32_t m_Material;      ///< 材料表下标，无材料为 -1
+        int32_t m_Section;       ///< 截面表下标，无截面为 -1
+        int32_t m_Reserved;
+    };
+
+    struct ConstraintRecord
+    {
+        int32_t m_Id;
+        int32_t m_Node;          ///< 节点下标，无节点为 -1
+        int32_t m_Direction;     ///< EnumKeyword::Direction
+        int32_t m_Reserved;
+        double  m_Value;
+    };
+
+    struct LoadRecord
+    {
+        int32_t m_Id;
+        int32_t m_Type;          ///< EnumKeyword::LoadType
+        int32_t m_Direction;     ///< EnumKeyword::Direction
+        int32_t m_StepId;
+        int32_t m_Target;        ///< 节点力为节点下标，单元荷载为单元下标，重力为 -1
+        int32_t m_Reserved;
+        double  m_Value;         ///< 荷载值（重力为 g）
+    };
+
+    struct StepRecord
+    {
+        int32_t m_Id;
+        int32_t m_Type;          ///< EnumKeyword::StepType
+        int32_t m_MaxIterations;
+        int32_t m_nModes;
+        double  m_Time;
+        double  m_StepSize;
+        double  m_Tolerance;
+        double  m_DampingRatio;
+        double  m_EigenTolerance;      ///< 特征值迭代容差
+        int32_t m_EigenMaxIterations;  ///< 特征值迭代最大次数
+        int32_t m_Reserved;
+    };
+
+    struct StepRecordV2          ///< 版本 1、2 的分析步记录
+    {
+        int32_t m_Id;
+        int32_t m_Type;          ///< EnumKeyword::StepType
+        int32_t m_MaxIterations;
+        int32_t m_nModes;
+        double  m_Time;
+        double  m_StepSize;
+        double  m_Tolerance;
+        double  m_DampingRatio;
+    };
+
+    struct SetRecord
+    {
+        int32_t m_bElement;      ///< 0 为节点集合，1 为单元集合
+        int32_t m_NameBegin;     ///< 名称在 NAME 段中的起点
+        int32_t m_NameSize;      ///< 名称字节数
+        int32_t m_IdBegin;       ///< ID 在 SET_ID 段中的起点
+        int32_t m_IdCount;       ///< ID 个数
+        int32_t m_Reserved;
+    };
+
+    struct OutputRequestRecord
+    {
+        int32_t m_Id;
+        int32_t m_Kind;          ///< OutputRequest::Kind
+        int32_t m_StepId;        ///< 分析步ID，0 为全部分析步
+        int32_t m_bElement;      ///< 是否为单元输出
+        int32_t m_NameBegin;     ///< 集合名称在 NAME 段中的起点
+        int32_t m_NameSize;      ///< 集合名称字节数，0 为全部节点或单元
+        int32_t m_Frequency;     ///< OutputRequest::Frequency
+        int32_t m_Interval;      ///< 增量步间隔
+        int32_t m_TypeBegin;     ///< 数据类型在 OUTPUT_TYPE 段中的起点
+        int32_t m_TypeCount;     ///< 数据类型个数
+        double  m_TimeInterval;  ///< 时间间隔
+    };
+    /// @}
+
+    /**
+     * @brief 写出模型
+     * @param [in] data 结构数据（应已清理）
+     * @param [in] FileName 文件路径
+     * @return 成功返回 true
+     */
+    static bool Write(const StructureData& data, const QString& FileName);
+
+    /**
+     * @brief 读取模型（先清空 data，包括输出请求和集合）
+     * @param [out] data 结构数据
+     * @param [in] FileName 文件路径
+     * @return 成功返回 true；文件格式或版本不符时返回 false，data 为空
+     */
+    static bool Read(StructureData& data, const QString& FileName);
+
+    /**
+     * @brief 内容是否以二进制模型文件头开始
+     * @param [in] begin 内容起点
+     * @param [in] size 内容字节数
+     */
+    static bool IsBinary(const char* begin, int64_t size);
+};
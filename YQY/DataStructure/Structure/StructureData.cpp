@@ -1,4 +1,5 @@
 ﻿#include "StructureData.h"
+#include "ModelBinary.h"
 #include <set>
 #include <cmath>
 #include <vector>
@@ -8,6 +9,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <algorithm>
+#include <thread>
 
 StructureData::~StructureData()
 {
@@ -15,6 +17,7 @@ StructureData::~StructureData()
 
 void StructureData::Clear()
 {
+    m_CompactModel.Clear();// 先解除节点视图的绑定
     m_Nodes.clear();
     m_Elements.clear();
     m_Material.clear();
@@ -23,6 +26,74 @@ void StructureData::Clear()
     m_Constraint.clear();
     m_Load.clear();
     m_AnalysisStep.clear();
+    m_Outputter.ClearRequests();
+    m_Adjacency.Clear();
+    m_CleanupIndex.Clear();
+    m_ChangedNodes.clear();
+    m_ChangedElements.clear();
+    m_PropertyIndex.clear();
+    m_PropertyIndexCount = 0;
+    TopologyChanged();
+
+    // 之后的对象使用新的内存池；旧内存池在仍被外部持有的对象全部释放后析构，内存整体归还
+    m_pPool = std::make_shared<std::pmr::synchronized_pool_resource>();
+}
+
+bool StructureData::WriteBinary(const QString& FileName) const
+{
+    return ModelBinary::Write(*this, FileName);
+}
+
+bool StructureData::ReadBinary(const QString& FileName)
+{
+    return ModelBinary::Read(*this, FileName);
+}
+
+void StructureData::SetSpatialOrder(SpaceFillingCurve::Curve curve)
+{
+    if (curve == m_SpatialOrder) return;
+    m_SpatialOrder = curve;
+    m_CompactModel.ClearModel();// 顺序改变后需重新编号和建立数组（状态重建时按节点映射）
+}
+
+void StructureData::Get_NodeOrder(std::vector<Node*>& order) const
+{
+    order.clear();
+    order.reserve(m_Nodes.size());
+    for (auto& nodePair : m_Nodes)
+    {
+        order.push_back(nodePair.second.get());
+    }
+    if (SpaceFillingCurve::Curve::NONE == m_SpatialOrder) return;
+
+    std::vector<double> coords;
+    coords.reserve(3 * order.size());
+    for (Node* pNode : order)
+    {
+        coords.push_back(pNode->m_X);
+        coords.push_back(pNode->m_Y);
+        coords.push_back(pNode->m_Z);
+    }
+    std::vector<uint64_t> keys;
+    SpaceFillingCurve::Compute_Keys(coords, m_SpatialOrder, keys);
+
+    // 编码相同时保持ID顺序，结果确定
+    std::vector<int> perm(order.size());
+    for (size_t i = 0; i < perm.size(); ++i) perm[i] = static_cast<int>(i);
+    std::stable_sort(perm.begin(), perm.end(), [&keys](int a, int b) { return keys[a] < keys[b]; });
+
+    std::vector<Node*> sorted(order.size());
+    for (size_t i = 0; i < perm.size(); ++i) sorted[i] = order[perm[i]];
+    order.swap(sorted);
+}
+
+const Adjacency& StructureData::GetAdjacency()
+{
+    if (m_Adjacency.Version() != m_TopologyVersion)
+    {
+        m_Adjacency.Build(*this, m_TopologyVersion);
+    }
+    return m_Adjacency;
 }
 
 std::shared_ptr<Node> StructureData::FindNode(int id)
@@ -78,64 +149,106 @@ std::shared_ptr<Property> StructureData::FindProperty(int id)
     return nullptr;
 }
 
+namespace
+{
+    inline uint64_t PropertyKey(int id_material, int id_section)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(id_material)) << 32) | static_cast<uint32_t>(id_section);
+    }
+}
+
 std::shared_ptr<Property> StructureData::Create_Property(int id_material, int id_section)
 {
+    // 属性表在此函数之外被修改过（如读取二进制模型文件）时重建索引
+    if (m_PropertyIndexCount != m_Property.size()) Rebuild_PropertyIndex();
+
     // 检查是否已存在相同材料+截面组合的 Property
-    for (const auto& pair : m_Property)
+    const uint64_t key = PropertyKey(id_material, id_section);
+    for (int pass = 0; pass < 2; ++pass)
     {
-        auto existingProp = pair.second;
-        auto existingMat = existingProp->m_pMaterial.lock();
-        auto existingSec = existingProp->m_pSection.lock();
-
-        if (existingMat && existingSec &&
-            existingMat->m_Id == id_material && existingSec->m_Id == id_section)
+        auto iterIndex = m_PropertyIndex.find(key);
+        if (iterIndex == m_PropertyIndex.end()) break;
+
+        auto existingProp = iterIndex->second.lock();
+        auto existingMat = existingProp ? existingProp->m_pMaterial.lock() : nullptr;
+        auto existingSec = existingProp ? existingProp->m_pSection.lock() : nullptr;
+        auto iterProp = existingProp ? m_Property.find(existingProp->m_Id) : m_Property.end();
+        if (existingMat && existingSec && existingMat->m_Id == id_material && existingSec->m_Id == id_section &&
+            iterProp != m_Property.end() && iterProp->second == existingProp)
         {
             // 已存在相同组合，直接返回
             return existingProp;
         }
-    }
 
-    // 不存在，创建新的 Property
-    int property_id = static_cast<int>(m_Property.size()) + 1;
-    auto property = std::make_shared<Property>();
+        // 索引项已失效（属性被删除或其材料、截面被修改），重建后再查一次
+        Rebuild_PropertyIndex();
+    }
 
     auto iterMat = m_Material.find(id_material);
-    if (iterMat != m_Material.end())
-    {
-        property->m_pMaterial = iterMat->second;
-    }
-    else
+    if (iterMat == m_Material.end())
     {
         qDebug().noquote() << QStringLiteral("Error: Create_Property 未找到材料 id=") << id_material;
-        exit(1);
+        return nullptr;
     }
 
     auto iterSec = m_Section.find(id_section);
-    if (iterSec != m_Section.end())
-    {
-        property->m_pSection = iterSec->second;
-    }
-    else
+    if (iterSec == m_Section.end())
     {
         qDebug().noquote() << QStringLiteral("Error: Create_Property 未找到截面 id=") << id_section;
-        exit(1);
+        return nullptr;
     }
 
+    // 不存在，创建新的 Property
+    int property_id = static_cast<int>(m_Property.size()) + 1;
+    auto property = Create_Object<Property>();
+    property->m_pMaterial = iterMat->second;
+    property->m_pSection = iterSec->second;
     property->m_Id = property_id;
     m_Property.insert(std::make_pair(property_id, property));
+
+    m_PropertyIndex.emplace(key, property);
+    m_PropertyIndexCount = m_Property.size();
     return property;
 }
 
+void StructureData::Rebuild_PropertyIndex()
+{
+    m_PropertyIndex.clear();
+    m_PropertyIndex.reserve(m_Property.size());
+    for (const auto& pair : m_Property)
+    {
+        auto pMaterial = pair.second->m_pMaterial.lock();
+        auto pSection = pair.second->m_pSection.lock();
+        if (!pMaterial || !pSection) continue;
+
+        // 相同组合有多个属性时保留ID最小的，与按ID顺序查找的结果相同
+        m_PropertyIndex.emplace(PropertyKey(pMaterial->m_Id, pSection->m_Id), pair.second);
+    }
+    m_PropertyIndexCount = m_Property.size();
+}
+
 // ===== 模型检查函数 =====
-void StructureData::CleanupModel(double tolerance)
+void StructureData::CleanupModel(double tolerance, bool bIncremental)
 {
     int nodesBefore = static_cast<int>(m_Nodes.size());
     int elementsBefore = static_cast<int>(m_Elements.size());
 
-    MergeDuplicateNodes(tolerance);
-    RemoveDuplicateElements();
-    RemoveOrphanNodes();
-    RenumberAll();
+    m_CompactModel.ClearModel();// 对象将被合并、删除和重新编号，紧凑数组失效（状态重建时按节点映射）
+    TopologyChanged();     // 导入或编辑后新增的对象
+    if (bIncremental && m_CleanupIndex.IsClean(tolerance))
+    {
+        CleanupIncremental();
+    }
+    else
+    {
+        MergeDuplicateNodes(tolerance);
+        RemoveDuplicateElements();
+        RemoveOrphanNodes();
+        RenumberAll();
+        m_CleanupIndex.MarkClean(*this, tolerance);
+    }
+    m_ChangedNodes.clear();
+    m_ChangedElements.clear();
 
     int nodesAfter = static_cast<int>(m_Nodes.size());
     int elementsAfter = static_cast<int>(m_Elements.size());
@@ -149,164 +262,575 @@ void StructureData::CleanupModel(double tolerance)
     qDebug().noquote() << QStringLiteral("===== 模型检查完成 =====\n");
 }
 
-//数据优化-----不用看这些代码-------------------
-// 临时节点结构（用于扁平化数据，提升缓存效率）
-struct TempNode
+bool StructureData::MoveNode(int id, double x, double y, double z)
 {
-    int id;
-    double x, y, z;
-};
+    auto pNode = FindNode(id);
+    if (!pNode)
+    {
+        qDebug().noquote() << QStringLiteral("错误：节点 ") << id << QStringLiteral(" 不存在");
+        return false;
+    }
+    pNode->m_X = x;
+    pNode->m_Y = y;
+    pNode->m_Z = z;
+    MarkNodeChanged(id);
+    m_CompactModel.ClearModel();// 节点坐标数组和单元常量失效
+    return true;
+}
 
-void StructureData::MergeDuplicateNodes(double tolerance)
+bool StructureData::SetElementNodes(int id, const std::vector<int>& nodeIds)
 {
-    if (m_Nodes.empty()) return;
+    auto pElement = FindElement(id);
+    if (!pElement)
+    {
+        qDebug().noquote() << QStringLiteral("错误：单元 ") << id << QStringLiteral(" 不存在");
+        return false;
+    }
+    if (static_cast<int>(nodeIds.size()) != pElement->m_pNode.size())
+    {
+        qDebug().noquote() << QStringLiteral("错误：单元 ") << id << QStringLiteral(" 的节点个数应为 ") << pElement->m_pNode.size();
+        return false;
+    }
 
-    // 1. 预处理：计算边界并扁平化数据
-    std::vector<TempNode> linearNodes;
-    linearNodes.reserve(m_Nodes.size());
+    QVector<std::weak_ptr<Node>> nodes(pElement->m_pNode.size());
+    for (int i = 0; i < nodes.size(); ++i)
+    {
+        nodes[i] = FindNode(nodeIds[i]);
+        if (nodes[i].expired())
+        {
+            qDebug().noquote() << QStringLiteral("错误：单元 ") << id << QStringLiteral(" 引用的节点 ") << nodeIds[i] << QStringLiteral(" 不存在");
+            return false;
+        }
+    }
+    pElement->m_pNode = nodes;
+    MarkElementChanged(id);
+    m_CompactModel.ClearModel();// 单元-节点连接失效
+    TopologyChanged();
+    return true;
+}
 
-    double minX = std::numeric_limits<double>::max();
-    double minY = minX, minZ = minX;
+bool StructureData::SetMaterial(int id, double young, double poisson, double density, double maxStress, double expansion)
+{
+    auto pMaterial = FindMaterial(id);
+    if (!pMaterial)
+    {
+        qDebug().noquote() << QStringLiteral("错误：材料 ") << id << QStringLiteral(" 不存在");
+        return false;
+    }
+    pMaterial->m_Young = young;
+    pMaterial->m_Poisson = poisson;
+    pMaterial->m_Density = density;
+    pMaterial->m_MaxStress = maxStress;
+    pMaterial->m_Expansion = expansion;
+    InvalidateElementConstants();
+    return true;
+}
 
-    for (const auto& pair : m_Nodes)
+bool StructureData::SetSectionRadius(int id, double radius)
+{
+    auto pSection = std::dynamic_pointer_cast<SectionCircular>(FindSection(id));
+    if (!pSection)
     {
-        auto node = pair.second;
-        // 计算最小坐标，用于防止哈希溢出
-        if (node->m_X < minX) minX = node->m_X;
-        if (node->m_Y < minY) minY = node->m_Y;
-        if (node->m_Z < minZ) minZ = node->m_Z;
+        qDebug().noquote() << QStringLiteral("错误：截面 ") << id << QStringLiteral(" 不存在或不是圆形截面");
+        return false;
+    }
+    pSection->m_Radius = radius;
+    pSection->Calculate_Area();
+    InvalidateElementConstants();
+    return true;
+}
 
-        linearNodes.push_back({ pair.first, node->m_X, node->m_Y, node->m_Z });
+bool StructureData::SetElementProperty(int id, int id_material, int id_section)
+{
+    auto pElement = FindElement(id);
+    if (!pElement)
+    {
+        qDebug().noquote() << QStringLiteral("错误：单元 ") << id << QStringLiteral(" 不存在");
+        return false;
     }
+    auto pProperty = Create_Property(id_material, id_section);
+    if (!pProperty) return false;
 
-    // 2. 计算 CellSize
-    double cellSize = tolerance * 1.01;
+    pElement->m_pProperty = pProperty;
+    pElement->m_Const.valid = false;
+    m_CompactModel.ClearModel();// 属性表和单元-属性对应关系失效
+    return true;
+}
 
-    // 3. 空间哈希定义
-    using HashKey = std::tuple<long long, long long, long long>;
+void StructureData::InvalidateElementConstants()
+{
+    m_CompactModel.InvalidateConstants();
+    for (auto& elementPair : m_Elements)
+    {
+        elementPair.second->m_Const.valid = false;
+    }
+}
 
-    struct SpaceHash
+namespace
+{
+    /**
+     * @brief 将ID大于 watermark 的对象依次编号，紧接在其余对象的最大ID之后
+     */
+    template <class T>
+    void RenumberTail(std::map<int, std::shared_ptr<T>>& items, int watermark)
     {
-        std::size_t operator()(const HashKey& k) const
+        auto it = items.upper_bound(watermark);
+        int newId = (it == items.begin()) ? 1 : std::prev(it)->first + 1;
+        while (it != items.end())
         {
-            auto [x, y, z] = k;
-            // 更加离散的哈希组合
-            size_t h1 = std::hash<long long>{}(x);
-            size_t h2 = std::hash<long long>{}(y);
-            size_t h3 = std::hash<long long>{}(z);
-            return h1 ^ (h2 << 1) ^ (h3 << 2);
+            auto next = std::next(it);
+            if (it->first != newId)
+            {// 新ID小于原ID且大于前面所有ID，重新插入不会冲突
+                auto handle = items.extract(it);
+                handle.key() = newId;
+                items.insert(std::move(handle));
+            }
+            items[newId]->m_Id = newId;
+            ++newId;
+            it = next;
         }
-    };
+    }
+
+    /**
+     * @brief ID 是否为 1..N 连续编号
+     */
+    template <class T>
+    bool IsContiguous(const std::map<int, std::shared_ptr<T>>& items)
+    {
+        return items.empty() || (items.begin()->first == 1 && items.rbegin()->first == static_cast<int>(items.size()));
+    }
+}
+
+void StructureData::CleanupIncremental()
+{
+    CleanupIndex& index = m_CleanupIndex;
+    index.EnsureBuilt(*this);
+
+    // 1. 待检查的节点：标记为修改的已有节点，然后是新增节点（均按ID升序）
+    std::vector<std::shared_ptr<Node>> nodes;
+    for (int id : m_ChangedNodes)
+    {
+        if (id > index.m_NodeMax) break;
+        auto it = m_Nodes.find(id);
+        if (it != m_Nodes.end()) nodes.push_back(it->second);
+    }
+    for (auto it = m_Nodes.upper_bound(index.m_NodeMax); it != m_Nodes.end(); ++it)
+    {
+        nodes.push_back(it->second);
+    }
+
+    // 2. 合并重复节点：与已索引节点重合时并入其中ID最小者，否则加入索引
+    std::unordered_map<const Node*, std::shared_ptr<Node>> nodeMapping;
+    std::unordered_set<const Node*> mergedNodes;
+    bool bOldNodeMerged = false;
+    for (auto& pNode : nodes)
+    {
+        auto pTarget = index.FindCoincident(*pNode, mergedNodes);
+        if (pTarget)
+        {
+            nodeMapping[pNode.get()] = pTarget;
+            mergedNodes.insert(pNode.get());
+            if (pNode->m_Id <= index.m_NodeMax) bOldNodeMerged = true;
+        }
+        else
+        {
+            index.InsertNode(pNode);
+        }
+    }
+
+    // 3. 重定向被合并节点的引用。已有节点被合并时，未修改的单元也可能引用它，需遍历全部单元，
+    //    引用被重定向的已有单元拓扑改变，与标记为修改的单元一起重新检查
+    std::set<int> changedElements = m_ChangedElements;
+    if (!nodeMapping.empty())
+    {
+        auto redirect = [&nodeMapping](std::weak_ptr<Node>& ref)
+            {
+                auto ptr = ref.lock();
+                if (!ptr) return false;
+                auto it = nodeMapping.find(ptr.get());
+                if (it == nodeMapping.end()) return false;
+                ref = it->second;
+                return true;
+            };
+
+        if (bOldNodeMerged)
+        {
+            for (auto& elemPair : m_Elements)
+            {
+                bool bRedirected = false;
+                for (auto& node : elemPair.second->m_pNode) bRedirected |= redirect(node);
+                if (bRedirected && elemPair.first <= index.m_ElementMax) changedElements.insert(elemPair.first);
+            }
+        }
+        else
+        {
+            for (int id : changedElements)
+            {
+                if (id > index.m_ElementMax) break;
+                auto it = m_Elements.find(id);
+                if (it == m_Elements.end()) continue;
+                for (auto& node : it->second->m_pNode) redirect(node);
+            }
+            for (auto it = m_Elements.upper_bound(index.m_ElementMax); it != m_Elements.end(); ++it)
+            {
+                for (auto& node : it->second->m_pNode) redirect(node);
+            }
+        }
+        for (auto& conPair : m_Constraint)
+        {
+            redirect(conPair.second->m_pNode);
+        }
+        for (auto& loadPair : m_Load)
+        {
+            auto forceNode = std::dynamic_pointer_cast<Force_Node>(loadPair.second);
+            if (forceNode) redirect(forceNode->m_pNode);
+        }
+    }
 
-    // 4. 分桶
-    std::unordered_map<HashKey, std::vector<int>, SpaceHash> buckets;
-    buckets.reserve(linearNodes.size());
+    // 待检查的单元：修改过的已有单元和新增单元（均按ID升序）
+    std::vector<std::shared_ptr<ElementBase>> elements;
+    for (int id : changedElements)
+    {
+        if (id > index.m_ElementMax) break;
+        auto it = m_Elements.find(id);
+        if (it != m_Elements.end()) elements.push_back(it->second);
+    }
+    for (auto it = m_Elements.upper_bound(index.m_ElementMax); it != m_Elements.end(); ++it)
+    {
+        elements.push_back(it->second);
+    }
 
-    for (int i = 0; i < static_cast<int>(linearNodes.size()); ++i)
+    // 4. 删除重复单元和节点缺失的单元，其余加入拓扑集合。
+    //    与完整清理相同，重复单元保留ID较小者：已索引的重复单元ID较大时（未修改的已有单元）删除该单元
+    for (auto& pElement : elements)
     {
-        const auto& node = linearNodes[i];
-        // 关键优化：减去 minX，确保从 0 开始计数，大大降低溢出风险
-        long long kx = static_cast<long long>(std::floor((node.x - minX) / cellSize));
-        long long ky = static_cast<long long>(std::floor((node.y - minY) / cellSize));
-        long long kz = static_cast<long long>(std::floor((node.z - minZ) / cellSize));
+        if (!pElement) continue;
+        if (!m_Elements.count(pElement->m_Id))
+        {// 已作为前面单元的重复单元删除
+            pElement.reset();
+            continue;
+        }
+
+        bool isValid = !pElement->m_pNode.isEmpty();
+        for (auto& node : pElement->m_pNode)
+        {
+            if (node.expired()) isValid = false;
+        }
+
+        auto pSame = isValid ? index.FindSameTopology(*pElement) : nullptr;
+        if (!isValid || (pSame && pSame->m_Id < pElement->m_Id))
+        {
+            m_Elements.erase(pElement->m_Id);
+            pElement.reset();
+            continue;
+        }
+        if (pSame)
+        {
+            m_Elements.erase(pSame->m_Id);
+        }
+        index.InsertElement(pElement);
+    }
 
-        buckets[std::make_tuple(kx, ky, kz)].push_back(i);
+    // 5. 孤立节点：新增节点中未被待检查单元、约束或荷载引用的节点
+    std::unordered_set<const Node*> usedNodes;
+    for (auto& pElement : elements)
+    {
+        if (!pElement) continue;
+        for (auto& node : pElement->m_pNode) usedNodes.insert(node.lock().get());
+    }
+    for (auto& conPair : m_Constraint)
+    {
+        usedNodes.insert(conPair.second->m_pNode.lock().get());
+    }
+    for (auto& loadPair : m_Load)
+    {
+        auto forceNode = std::dynamic_pointer_cast<Force_Node>(loadPair.second);
+        if (forceNode) usedNodes.insert(forceNode->m_pNode.lock().get());
     }
 
-    // 5. 查找重复
-    std::map<int, int> nodeIdMapping;
     std::vector<int> nodesToRemove;
-    double tolSq = tolerance * tolerance;
+    for (auto& pNode : nodes)
+    {
+        if (mergedNodes.count(pNode.get()) ||
+            (pNode->m_Id > index.m_NodeMax && !usedNodes.count(pNode.get())))
+        {
+            nodesToRemove.push_back(pNode->m_Id);
+        }
+    }
+    nodes.clear();
+    for (int id : nodesToRemove)
+    {
+        m_Nodes.erase(id);
+    }
 
-    for (const auto& bucketPair : buckets)
+    // 6. 新增部分接续编号；已有部分出现空缺（已有节点被合并或单元被删除）时整体重新编号
+    RenumberTail(m_Nodes, index.m_NodeMax);
+    RenumberTail(m_Elements, index.m_ElementMax);
+    RenumberTail(m_Constraint, index.m_ConstraintMax);
+    RenumberTail(m_Load, index.m_LoadMax);
+    if (!IsContiguous(m_Nodes) || !IsContiguous(m_Elements) || !IsContiguous(m_Constraint) || !IsContiguous(m_Load))
     {
-        const auto& key = bucketPair.first;
-        const auto& indices = bucketPair.second;
+        RenumberAll();
+    }
 
-        long long kx = std::get<0>(key);
-        long long ky = std::get<1>(key);
-        long long kz = std::get<2>(key);
+    index.UpdateWatermarks(*this);
+    TopologyChanged();
+}
 
-        for (int idx1 : indices)
+//数据优化-----不用看这些代码-------------------
+namespace
+{
+    /**
+     * @brief 把 [0, n) 均分为 nChunks 个连续区间，并行执行 func(chunk, begin, end)
+     *
+     * 区间划分只取决于 n 和 nChunks，与线程调度无关。
+     */
+    template <class Func>
+    void ParallelChunks(int n, int nChunks, Func func)
+    {
+        if (nChunks <= 1)
+        {
+            func(0, 0, n);
+            return;
+        }
+        std::vector<std::thread> workers;
+        workers.reserve(nChunks);
+        for (int c = 0; c < nChunks; ++c)
         {
-            int originalId1 = linearNodes[idx1].id;
+            const int begin = static_cast<int>(static_cast<long long>(n) * c / nChunks);
+            const int end = static_cast<int>(static_cast<long long>(n) * (c + 1) / nChunks);
+            workers.emplace_back(func, c, begin, end);
+        }
+        for (auto& worker : workers) worker.join();
+    }
 
-            // 如果这个节点已经被合并了，跳过
-            if (nodeIdMapping.count(originalId1)) continue;
+    /**
+     * @brief 网格单元格项：单元格的 Morton 编码与节点下标
+     */
+    struct CellEntry
+    {
+        uint64_t key;
+        int index;
 
-            const auto& n1 = linearNodes[idx1];
+        bool operator<(const CellEntry& other) const
+        {
+            return key != other.key ? key < other.key : index < other.index;
+        }
+    };
+}
+
+void StructureData::MergeDuplicateNodes(double tolerance)
+{
+    if (m_Nodes.empty()) return;
+
+    // 1. 扁平化节点数据（按ID升序，下标越小ID越小）
+    const int nNode = static_cast<int>(m_Nodes.size());
+    std::vector<int> ids;
+    std::vector<double> coords;
+    ids.reserve(nNode);
+    coords.reserve(3 * static_cast<size_t>(nNode));
+
+    double lower[3], upper[3];
+    for (int d = 0; d < 3; ++d)
+    {
+        lower[d] = std::numeric_limits<double>::max();
+        upper[d] = std::numeric_limits<double>::lowest();
+    }
+    for (const auto& pair : m_Nodes)
+    {
+        const double xyz[3] = { pair.second->m_X, pair.second->m_Y, pair.second->m_Z };
+        for (int d = 0; d < 3; ++d)
+        {
+            lower[d] = std::min(lower[d], xyz[d]);
+            upper[d] = std::max(upper[d], xyz[d]);
+            coords.push_back(xyz[d]);
+        }
+        ids.push_back(pair.first);
+    }
 
-            // 搜索 3x3x3 邻域
-            for (long long dx = -1; dx <= 1; ++dx)
+    // 2. 单元格边长略大于容差；单元格数超过 21 位编码范围时放大单元格（只增加候选对，不影响结果）
+    const double maxCell = static_cast<double>((1u << SpaceFillingCurve::Bits) - 2);// 留出 +1 邻居
+    const double extent = std::max({ upper[0] - lower[0], upper[1] - lower[1], upper[2] - lower[2] });
+    double cellSize = tolerance * 1.01;
+    if (!(cellSize > 0.0) || extent / cellSize > maxCell)
+    {
+        cellSize = extent > 0.0 ? extent / maxCell : 1.0;
+    }
+
+    const int nThreads = m_nThreads > 0 ? std::min(m_nThreads, nNode)
+        : std::max(1, std::min(static_cast<int>(std::thread::hardware_concurrency()), nNode / 16384));
+
+    // 3. 并行计算单元格坐标和 Morton 编码，分块排序后归并
+    std::vector<uint32_t> cellCoord(3 * static_cast<size_t>(nNode));
+    std::vector<CellEntry> cells(nNode);
+    ParallelChunks(nNode, nThreads, [&](int, int begin, int end)
+        {
+            for (int i = begin; i < end; ++i)
             {
-                for (long long dy = -1; dy <= 1; ++dy)
+                uint32_t* c = cellCoord.data() + 3 * static_cast<size_t>(i);
+                for (int d = 0; d < 3; ++d)
                 {
-                    for (long long dz = -1; dz <= 1; ++dz)
-                    {
-
-                        HashKey neighborKey = std::make_tuple(kx + dx, ky + dy, kz + dz);
-                        auto it = buckets.find(neighborKey);
-                        if (it == buckets.end()) continue;
+                    c[d] = static_cast<uint32_t>(std::clamp(std::floor((coords[3 * i + d] - lower[d]) / cellSize), 0.0, maxCell));
+                }
+                cells[i] = { SpaceFillingCurve::Morton(c[0], c[1], c[2]), i };
+            }
+        });
 
-                        for (int idx2 : it->second)
-                        {
-                            int originalId2 = linearNodes[idx2].id;
+    std::vector<int> chunkBegin(nThreads + 1);
+    for (int c = 0; c <= nThreads; ++c) chunkBegin[c] = static_cast<int>(static_cast<long long>(nNode) * c / nThreads);
+    ParallelChunks(nNode, nThreads, [&](int, int begin, int end)
+        {
+            std::sort(cells.begin() + begin, cells.begin() + end);
+        });
+    for (int width = 1; width < nThreads; width *= 2)
+    {
+        for (int c = 0; c + width < nThreads; c += 2 * width)
+        {
+            const int mid = chunkBegin[c + width];
+            const int last = chunkBegin[std::min(c + 2 * width, nThreads)];
+            std::inplace_merge(cells.begin() + chunkBegin[c], cells.begin() + mid, cells.begin() + last);
+        }
+    }
 
-                            // 确保 id2 > id1，且避免自身比较
-                            if (originalId2 <= originalId1) continue;
+    // 4. 同一单元格的节点连续存放，记录每个单元格的起始位置
+    std::vector<int> runBegin;
+    for (int p = 0; p < nNode; ++p)
+    {
+        if (0 == p || cells[p].key != cells[p - 1].key) runBegin.push_back(p);
+    }
+    const int nRun = static_cast<int>(runBegin.size());
+    runBegin.push_back(nNode);
+
+    // 5. 邻域扫描：每个单元格只与编码不小于自身的相邻单元格比较，每对节点只检查一次；
+    //    各线程处理连续的单元格区间，候选对按线程顺序拼接
+    const double tolSq = tolerance * tolerance;
+    std::vector<std::vector<std::pair<int, int>>> localPairs(nThreads);
+    ParallelChunks(nRun, nThreads, [&](int chunk, int begin, int end)
+        {
+            auto& pairs = localPairs[chunk];
+            for (int r = begin; r < end; ++r)
+            {
+                const int p0 = runBegin[r], p1 = runBegin[r + 1];
+                const uint64_t key = cells[p0].key;
+                const uint32_t* c = cellCoord.data() + 3 * static_cast<size_t>(cells[p0].index);
 
-                            // 如果对方已经被合并，跳过
-                            if (nodeIdMapping.count(originalId2)) continue;
+                for (int dx = -1; dx <= 1; ++dx)
+                {
+                    for (int dy = -1; dy <= 1; ++dy)
+                    {
+                        for (int dz = -1; dz <= 1; ++dz)
+                        {
+                            const long long nx = static_cast<long long>(c[0]) + dx;
+                            const long long ny = static_cast<long long>(c[1]) + dy;
+                            const long long nz = static_cast<long long>(c[2]) + dz;
+                            if (nx < 0 || ny < 0 || nz < 0) continue;
 
-                            const auto& n2 = linearNodes[idx2];
+                            const uint64_t neighborKey = SpaceFillingCurve::Morton(
+                                static_cast<uint32_t>(nx), static_cast<uint32_t>(ny), static_cast<uint32_t>(nz));
+                            if (neighborKey < key) continue;
 
-                            // 快速轴比较
-                            double dxx = std::abs(n1.x - n2.x);
-                            if (dxx > tolerance) continue;
-                            double dyy = std::abs(n1.y - n2.y);
-                            if (dyy > tolerance) continue;
-                            double dzz = std::abs(n1.z - n2.z);
-                            if (dzz > tolerance) continue;
+                            int q0, q1;
+                            if (neighborKey == key)
+                            {
+                                q0 = p0;
+                                q1 = p1;
+                            }
+                            else
+                            {
+                                auto it = std::lower_bound(cells.begin() + p1, cells.end(), CellEntry{ neighborKey, -1 });
+                                if (it == cells.end() || it->key != neighborKey) continue;
+                                q0 = static_cast<int>(it - cells.begin());
+                                q1 = q0;
+                                while (q1 < nNode && cells[q1].key == neighborKey) ++q1;
+                            }
 
-                            // 距离平方比较
-                            if (dxx * dxx + dyy * dyy + dzz * dzz < tolSq)
+                            for (int p = p0; p < p1; ++p)
                             {
-                                nodeIdMapping[originalId2] = originalId1;
-                                nodesToRemove.push_back(originalId2);
+                                const int a = cells[p].index;
+                                const double* A = coords.data() + 3 * static_cast<size_t>(a);
+                                for (int q = (neighborKey == key ? p + 1 : q0); q < q1; ++q)
+                                {
+                                    const int b = cells[q].index;
+                                    const double* B = coords.data() + 3 * static_cast<size_t>(b);
+
+                                    // 快速轴比较
+                                    const double dxx = std::abs(A[0] - B[0]);
+                                    if (dxx > tolerance) continue;
+                                    const double dyy = std::abs(A[1] - B[1]);
+                                    if (dyy > tolerance) continue;
+                                    const double dzz = std::abs(A[2] - B[2]);
+                                    if (dzz > tolerance) continue;
+
+                                    // 距离平方比较
+                                    if (dxx * dxx + dyy * dyy + dzz * dzz < tolSq)
+                                    {
+                                        pairs.emplace_back(a, b);
+                                    }
+                                }
                             }
                         }
                     }
                 }
             }
-        }
+        });
+
+    // 6. 候选对按 (较小下标, 较大下标) 排序，与线程划分无关；按下标（即ID）升序贪心合并：
+    //    未被合并的节点保留，并吸收容差范围内下标更大、尚未被合并的节点（不传递）
+    std::vector<std::pair<int, int>> candidates;
+    size_t nCandidate = 0;
+    for (const auto& pairs : localPairs) nCandidate += pairs.size();
+    candidates.reserve(nCandidate);
+    for (auto& pairs : localPairs)
+    {
+        for (const auto& pair : pairs) candidates.emplace_back(std::min(pair.first, pair.second), std::max(pair.first, pair.second));
+        std::vector<std::pair<int, int>>().swap(pairs);
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    std::vector<int> survivor(nNode, -1);// 被合并节点 -> 保留节点下标，未被合并为 -1
+    for (const auto& pair : candidates)
+    {
+        if (survivor[pair.first] < 0 && survivor[pair.second] < 0) survivor[pair.second] = pair.first;
+    }
+
+    std::vector<std::pair<int, int>> nodeIdMapping;// 被合并节点ID -> 保留节点ID（按ID升序）
+    for (int i = 0; i < nNode; ++i)
+    {
+        if (survivor[i] >= 0) nodeIdMapping.emplace_back(ids[i], ids[survivor[i]]);
     }
 
-    if (nodesToRemove.empty()) return;
+    if (nodeIdMapping.empty()) return;
 
-    // 6. 更新引用
+    // 7. 更新引用
     auto getNewId = [&](int oldId) -> int
         {
-            auto it = nodeIdMapping.find(oldId);
-            return (it != nodeIdMapping.end()) ? it->second : oldId;
+            auto it = std::lower_bound(nodeIdMapping.begin(), nodeIdMapping.end(), std::make_pair(oldId, std::numeric_limits<int>::min()));
+            return (it != nodeIdMapping.end() && it->first == oldId) ? it->second : oldId;
         };
 
-    // 更新单元
-    for (auto& elemPair : m_Elements)
-    {
-        auto& elem = elemPair.second;
-        for (int i = 0; i < elem->m_pNode.size(); ++i)
+    // 更新单元（并行，各线程只读 m_Nodes）
+    std::vector<ElementBase*> elements;
+    elements.reserve(m_Elements.size());
+    for (auto& elemPair : m_Elements) elements.push_back(elemPair.second.get());
+
+    ParallelChunks(static_cast<int>(elements.size()), nThreads, [&](int, int begin, int end)
         {
-            auto ptr = elem->m_pNode[i].lock();
-            if (ptr)
+            for (int e = begin; e < end; ++e)
             {
-                int newId = getNewId(ptr->m_Id);
-                if (newId != ptr->m_Id)
+                auto& nodes = elements[e]->m_pNode;
+                for (int i = 0; i < nodes.size(); ++i)
                 {
-                    elem->m_pNode[i] = m_Nodes[newId];
+                    auto ptr = nodes[i].lock();
+                    if (!ptr) continue;
+
+                    int newId = getNewId(ptr->m_Id);
+                    if (newId != ptr->m_Id)
+                    {
+                        nodes[i] = m_Nodes.find(newId)->second;
+                    }
                 }
             }
-        }
-    }
+        });
 
     // 更新约束
     for (auto& conPair : m_Constraint)
@@ -340,11 +864,12 @@ void StructureData::MergeDuplicateNodes(double tolerance)
         }
     }
 
-    // 7. 批量删除
-    for (int id : nodesToRemove)
+    // 8. 批量删除
+    for (const auto& mapping : nodeIdMapping)
     {
-        m_Nodes.erase(id);
+        m_Nodes.erase(mapping.first);
     }
+    TopologyChanged();
 }
 
 struct VectorHash
@@ -411,39 +936,28 @@ void StructureData::RemoveDuplicateElements()
     {
         m_Elements.erase(id);
     }
+    TopologyChanged();
 }
 
 void StructureData::RemoveOrphanNodes()
 {
     if (m_Nodes.empty()) return;
 
-    // 1. 找出当前最大的节点 ID，确定 vector 大小
-    int maxNodeId = m_Nodes.rbegin()->first;
-
-    // 2. 创建标记数组 (比 set 快几十倍)
-    std::vector<bool> isNodeUsed(maxNodeId + 1, false);
-
-    // 3. 遍历所有单元，标记用到的节点
-    for (const auto& elemPair : m_Elements)
+    // 1. 有单元相连的节点（由邻接关系直接得到，按节点下标标记）
+    const Adjacency& adjacency = GetAdjacency();
+    const int nNode = adjacency.NodeCount();
+    std::vector<char> isNodeUsed(nNode, 0);
+    for (int i = 0; i < nNode; ++i)
     {
-        for (const auto& nodeWeak : elemPair.second->m_pNode)
-        {
-            auto node = nodeWeak.lock();
-            if (node && node->m_Id <= maxNodeId)
-            {
-                isNodeUsed[node->m_Id] = true;
-            }
-        }
+        isNodeUsed[i] = !adjacency.NodeElements(i).empty();
     }
 
     // 约束引用的节点也不能删
     for (const auto& conPair : m_Constraint)
     {
         auto node = conPair.second->m_pNode.lock();
-        if (node && node->m_Id <= maxNodeId)
-        {
-            isNodeUsed[node->m_Id] = true;
-        }
+        int iNode = node ? adjacency.FindNodeIndex(node->m_Id) : -1;
+        if (iNode >= 0) isNodeUsed[iNode] = 1;
     }
 
     // 荷载引用的节点也不能删
@@ -453,24 +967,16 @@ void StructureData::RemoveOrphanNodes()
         if (forceNode)
         {
             auto node = forceNode->m_pNode.lock();
-            if (node && node->m_Id <= maxNodeId)
-            {
-                isNodeUsed[node->m_Id] = true;
-            }
+            int iNode = node ? adjacency.FindNodeIndex(node->m_Id) : -1;
+            if (iNode >= 0) isNodeUsed[iNode] = 1;
         }
     }
 
-    // 4. 收集孤立节点
+    // 2. 收集孤立节点
     std::vector<int> orphanNodes;
-    orphanNodes.reserve(m_Nodes.size() / 10);
-
-    for (const auto& nodePair : m_Nodes)
+    for (int i = 0; i < nNode; ++i)
     {
-        int id = nodePair.first;
-        if (id > maxNodeId || !isNodeUsed[id])
-        {
-            orphanNodes.push_back(id);
-        }
+        if (!isNodeUsed[i]) orphanNodes.push_back(adjacency.m_NodeId[i]);
     }
 
     if (orphanNodes.empty()) return;
@@ -479,6 +985,7 @@ void StructureData::RemoveOrphanNodes()
     {
         m_Nodes.erase(id);
     }
+    TopologyChanged();
 }
 
 void StructureData::RenumberAll()
@@ -529,4 +1036,5 @@ void StructureData::RenumberAll()
         newId++;
     }
     m_Load = std::move(newLoads);
+    TopologyChanged();// ID 改变
 }
@@ -16,6 +16,13 @@
 #include "DataStructure/Load/Force_Gravity.h"
 #include "DataStructure/AnalysisStep/AnalysisStep.h"
 #include "Export/Outputter.h"
+#include "DataStructure/Structure/CompactModel.h"
+#include "DataStructure/Structure/Adjacency.h"
+#include "DataStructure/Structure/CleanupIndex.h"
+#include <set>
+#include <unordered_map>
+#include "Utility/SpaceFillingCurve.h"
+#include "Utility/PoolAllocator.h"
 
 /**
  * @brief 结构数据类 - 存储和管理整个有限元模型的所有数据
@@ -76,28 +83,164 @@ public:
 	/// @}
 
 	/**
-	 * @brief 创建属性对象
+	 * @brief 在模型内存池中创建对象（对象与控制块一次分配）
+	 * @tparam T 对象类型
+	 * @return 对象的共享指针
+	 *
+	 * 内存池按对象大小分档，对象释放（删除、合并、Clear()）后其内存由同档的新对象重复使用。
+	 * 每个对象持有内存池的引用，Clear() 或模型析构后仍被外部持有的对象继续有效。
+	 */
+	template <class T, class... Args>
+	std::shared_ptr<T> Create_Object(Args&&... args)
+	{
+		return std::allocate_shared<T>(PoolAllocator<T>(m_pPool), std::forward<Args>(args)...);
+	}
+
+	/**
+	 * @brief 创建属性对象（已有相同材料+截面组合的属性时直接返回该属性）
 	 * @param [in] id_material 材料ID
 	 * @param [in] id_section 截面ID
-	 * @return 创建的属性对象
+	 * @return 属性对象；材料或截面不存在时输出错误信息并返回 nullptr
+	 *
+	 * 组合经 (材料ID, 截面ID) 哈希索引查找，与已有属性个数无关。
 	 */
 	std::shared_ptr<Property> Create_Property(int id_material, int id_section);
 
 	/**
 	 * @brief 模型清理（合并重复节点、删除重复单元、删除孤立节点、重新编号）
 	 * @param [in] tolerance 节点合并容差
+	 * @param [in] bIncremental 是否允许增量清理
+	 *
+	 * 模型上次已用同一容差清理过时，增量清理只检查此后新增（ID 大于上次清理后的最大ID）
+	 * 和经 MoveNode/SetElementNodes 修改过的节点、单元，耗时与改动量成正比；
+	 * 否则（或 bIncremental 为 false）对整个模型做完整清理。
+	 */
+	void CleanupModel(double tolerance = 1e-6, bool bIncremental = true);
+
+	/**
+	 * @brief 设置完整清理中合并重复节点的线程数
+	 * @param [in] nThreads 线程数，0 为按节点数和硬件线程数自动选择，1 为串行；结果与线程数无关
+	 */
+	void SetThreadCount(int nThreads) { m_nThreads = nThreads; }
+
+	/// @name 模型编辑（修改后调用 CleanupModel 合并重合节点、删除重复单元）
+	/// @{
+	/**
+	 * @brief 移动节点
+	 * @param [in] id 节点ID
+	 * @param [in] x,y,z 新坐标
+	 * @return 节点不存在时输出错误信息并返回 false
 	 */
-	void CleanupModel(double tolerance = 1e-6);
+	bool MoveNode(int id, double x, double y, double z);
 
 	/**
-	 * @brief 清空所有数据
+	 * @brief 修改单元的节点
+	 * @param [in] id 单元ID
+	 * @param [in] nodeIds 新的节点ID（个数与单元原有节点数相同）
+	 * @return 单元或节点不存在、节点个数不符时输出错误信息并返回 false
+	 */
+	bool SetElementNodes(int id, const std::vector<int>& nodeIds);
+	/// @}
+
+	/// @name 材料、截面和属性修改（单元常量随之失效，下次求解前或单元计算时重新计算）
+	/// @{
+	/**
+	 * @brief 修改材料参数
+	 * @param [in] id 材料ID
+	 * @param [in] young,poisson,density,maxStress,expansion 弹性模量、泊松比、密度、极限应力、热膨胀系数
+	 * @return 材料不存在时输出错误信息并返回 false
+	 */
+	bool SetMaterial(int id, double young, double poisson, double density, double maxStress, double expansion);
+
+	/**
+	 * @brief 修改圆形截面的半径（同时重新计算面积）
+	 * @param [in] id 截面ID
+	 * @param [in] radius 半径
+	 * @return 截面不存在或不是圆形截面时输出错误信息并返回 false
+	 */
+	bool SetSectionRadius(int id, double radius);
+
+	/**
+	 * @brief 修改单元的材料和截面（经 Create_Property 取得对应属性）
+	 * @param [in] id 单元ID
+	 * @param [in] id_material 材料ID
+	 * @param [in] id_section 截面ID
+	 * @return 单元、材料或截面不存在时输出错误信息并返回 false
+	 */
+	bool SetElementProperty(int id, int id_material, int id_section);
+
+	/**
+	 * @brief 使单元常量失效（直接修改材料、截面或属性对象的成员后调用）
+	 */
+	void InvalidateElementConstants();
+	/// @}
+
+	/**
+	 * @brief 清空所有数据，并整体释放模型对象的内存池
 	 */
 	void Clear();
 
+	/// @name 二进制模型文件（格式见 ModelBinary）
+	/// @{
+	/**
+	 * @brief 将模型写出为二进制模型文件（应在清理之后调用）
+	 * @param [in] FileName 文件路径
+	 * @return 成功返回 true
+	 */
+	bool WriteBinary(const QString& FileName) const;
+
+	/**
+	 * @brief 从二进制模型文件读取模型（先清空当前数据，读取后不需要再清理）
+	 * @param [in] FileName 文件路径
+	 * @return 成功返回 true
+	 */
+	bool ReadBinary(const QString& FileName);
+	/// @}
+
+	/**
+	 * @brief 设置求解时节点和单元的空间排序方式（只改变内部数组和自由度顺序，不改变ID）
+	 * @param [in] curve 空间填充曲线类型，NONE 为按ID顺序
+	 */
+	void SetSpatialOrder(SpaceFillingCurve::Curve curve);
+
+	/**
+	 * @brief 获取空间排序方式
+	 */
+	SpaceFillingCurve::Curve GetSpatialOrder() const { return m_SpatialOrder; }
+
+	/**
+	 * @brief 获取求解用的节点顺序（未启用空间排序时为ID顺序，否则按节点坐标的曲线编码排序）
+	 * @param [out] order 节点指针序列
+	 */
+	void Get_NodeOrder(std::vector<Node*>& order) const;
+
+	/// @name 拓扑版本与邻接关系
+	/// @{
+	/**
+	 * @brief 通知拓扑已改变（增删节点、单元或修改单元节点后调用），使邻接关系失效
+	 */
+	void TopologyChanged() { ++m_TopologyVersion; }
+
+	/**
+	 * @brief 获取拓扑版本
+	 */
+	uint64_t GetTopologyVersion() const { return m_TopologyVersion; }
+
+	/**
+	 * @brief 获取邻接关系（拓扑版本变化后首次调用时重建）
+	 */
+	const Adjacency& GetAdjacency();
+	/// @}
+
 private:
 	/**
 	 * @brief 合并重复节点
 	 * @param [in] tolerance 合并容差
+	 *
+	 * 节点按网格单元格的 Morton 编码并行排序，扫描相邻单元格得到距离小于容差的节点对。
+	 * 然后按ID升序逐个处理：尚未被合并的节点保留，并吸收与它距离小于容差、ID更大且尚未被合并的节点。
+	 * 被合并的节点都在保留节点的容差范围内，不传递：一串相邻间距小于容差的节点不会因此并成一个
+	 * （与增量清理并入ID最小的重合节点一致）。候选对排序后再处理，结果与线程数无关。
 	 */
 	void MergeDuplicateNodes(double tolerance);
 
@@ -116,6 +259,33 @@ private:
 	 */
 	void RenumberAll();
 
+	/**
+	 * @brief 标记节点已修改（如坐标改变），下次增量清理时重新检查
+	 * @param [in] id 节点ID
+	 */
+	void MarkNodeChanged(int id) { m_ChangedNodes.insert(id); }
+
+	/**
+	 * @brief 标记单元已修改（如节点改变），下次增量清理时重新检查
+	 * @param [in] id 单元ID
+	 */
+	void MarkElementChanged(int id) { m_ChangedElements.insert(id); }
+
+	/**
+	 * @brief 增量清理：只检查新增和标记为修改的节点、单元
+	 *
+	 * 节点合并容差即清理索引所用的容差（调用前已由 CleanupIndex::IsClean 确认与本次请求的容差相同）。
+	 * 已有节点被合并时，引用它的已有单元也重新检查重复；重复单元保留ID较小者（与完整清理相同）。
+	 * 与完整清理的区别：新节点与已有节点重合时并入其中ID最小者（不做传递合并）；
+	 * 已有节点不做孤立检查（删除单元后需完整清理才能去除孤立节点）。
+	 */
+	void CleanupIncremental();
+
+	/**
+	 * @brief 由属性表重建 (材料ID, 截面ID) -> 属性 索引
+	 */
+	void Rebuild_PropertyIndex();
+
 public:
 	Outputter m_Outputter;          // 分析结果输出
 
@@ -123,5 +293,28 @@ public:
 	 * @brief 获取输出
 	 */
 	Outputter& GetOutputter() { return m_Outputter; }
+
+	CompactModel m_CompactModel;    // 求解用紧凑数组（分析步初始化时建立）
+
+	/**
+	 * @brief 获取紧凑模型
+	 */
+	CompactModel& GetCompactModel() { return m_CompactModel; }
+
+private:
+	SpaceFillingCurve::Curve m_SpatialOrder = SpaceFillingCurve::Curve::NONE;  ///< 空间排序方式
+	int m_nThreads = 0;              ///< 合并重复节点的线程数（0 为自动）
+	uint64_t m_TopologyVersion = 1;  ///< 拓扑版本
+	Adjacency m_Adjacency;           ///< 邻接关系（版本与 m_TopologyVersion 不同时需重建）
+
+	CleanupIndex m_CleanupIndex;     ///< 增量清理用的空间索引和拓扑集合
+	std::set<int> m_ChangedNodes;    ///< 上次清理后标记为修改的节点ID
+	std::set<int> m_ChangedElements; ///< 上次清理后标记为修改的单元ID
+
+	std::unordered_map<uint64_t, std::weak_ptr<Property>> m_PropertyIndex;  ///< (材料ID, 截面ID) -> 属性
+	size_t m_PropertyIndexCount = 0; ///< 建立索引时的属性个数，与属性表大小不同时重建
+
+	/// 模型对象的内存池（按大小分档、释放的内存可重复使用；加锁，对象可在任意线程中创建和释放）
+	std::shared_ptr<std::pmr::memory_resource> m_pPool = std::make_shared<std::pmr::synchronized_pool_resource>();
 };
 
@@ -0,0 +1,69 @@
+﻿#include "OutputRequest.h"
+#include <QMap>
+#include <cmath>
+
+void OutputRequest::BeginStep(int stepId)
+{
+    m_bActive = (0 == m_StepId || stepId == m_StepId);
+    m_nIncrement = 0;
+    m_NextTime = m_TimeInterval;
+}
+
+bool OutputRequest::ShouldSave(double time, bool bLast)
+{
+    if (!m_bActive) return false;
+    ++m_nIncrement;
+    if (bLast) return true;
+
+    switch (m_Frequency)
+    {
+    case Frequency::INCREMENT:
+        return m_Interval > 0 && 0 == m_nIncrement % m_Interval;
+    case Frequency::TIME:
+    {
+        // 容许舍入误差，避免 0.1 的整数倍因累加误差错过输出
+        const double tolerance = 1e-9 * m_TimeInterval;
+        if (m_TimeInterval <= 0.0 || time < m_NextTime - tolerance) return false;
+        m_NextTime = (std::floor(time / m_TimeInterval + 1e-9) + 1.0) * m_TimeInterval;
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+bool OutputRequest::ParseVariable(const QString& name, std::vector<DataType>& types)
+{
+    static const QMap<QString, std::vector<DataType>> s_Variables =
+    {
+        { "U",   { DataType::U1, DataType::U2, DataType::U3 } },
+        { "U1",  { DataType::U1 } },
+        { "U2",  { DataType::U2 } },
+        { "U3",  { DataType::U3 } },
+        { "UMAG",{ DataType::MagnitudeU } },
+        { "UR",  { DataType::UR1, DataType::UR2, DataType::UR3 } },
+        { "UR1", { DataType::UR1 } },
+        { "UR2", { DataType::UR2 } },
+        { "UR3", { DataType::UR3 } },
+        { "V",   { DataType::V1, DataType::V2, DataType::V3 } },
+        { "V1",  { DataType::V1 } },
+        { "V2",  { DataType::V2 } },
+        { "V3",  { DataType::V3 } },
+        { "A",   { DataType::A1, DataType::A2, DataType::A3 } },
+        { "A1",  { DataType::A1 } },
+        { "A2",  { DataType::A2 } },
+        { "A3",  { DataType::A3 } },
+        { "RF",  { DataType::F1, DataType::F2, DataType::F3 } },
+        { "RF1", { DataType::F1 } },
+        { "RF2", { DataType::F2 } },
+        { "RF3", { DataType::F3 } },
+        { "S",   { DataType::S } },
+        { "NF",  { DataType::NF } },
+    };
+
+    auto it = s_Variables.find(name.toUpper());
+    if (it == s_Variables.end()) return false;
+
+    types.insert(types.end(), it->second.begin(), it->second.end());
+    return true;
+}
@@ -0,0 +1,76 @@
+﻿#pragma once
+/**
+ * @file OutputRequest.h
+ * @brief 输出请求 - *OUTPUT 关键字定义的场输出/历史输出
+ */
+
+#include <QString>
+#include <vector>
+#include "ResultStore.h"
+
+/**
+ * @brief 输出请求 - 指定分析步、集合、输出量和输出频率，结果保存在自己的列式存储中
+ *
+ * 分析步每完成一个增量步（荷载步、时间步、频率点或一阶模态）调用一次 ShouldSave，
+ * 按频率决定是否保存；分析步的最后一个增量步总是保存。
+ */
+class OutputRequest
+{
+public:
+    /**
+     * @brief 输出类别
+     */
+    enum class Kind
+    {
+        FIELD,    ///< 场输出：按帧导出集合中全部对象
+        HISTORY   ///< 历史输出：按时间导出集合中各对象的时程
+    };
+
+    /**
+     * @brief 输出频率
+     */
+    enum class Frequency
+    {
+        INCREMENT,  ///< 每 m_Interval 个增量步
+        TIME,       ///< 每隔 m_TimeInterval 时间
+        LAST        ///< 只保存最后一个增量步
+    };
+
+    int m_Id = 0;                           ///< 请求ID
+    Kind m_Kind = Kind::FIELD;              ///< 输出类别
+    int m_StepId = 0;                       ///< 分析步ID，0 为全部分析步
+    QString m_SetName;                      ///< 集合名称，空为全部节点或单元
+    bool m_bElement = false;                ///< 是否为单元输出
+    std::vector<DataType> m_Types;          ///< 输出的数据类型
+    Frequency m_Frequency = Frequency::LAST;///< 输出频率
+    int m_Interval = 1;                     ///< 增量步间隔
+    double m_TimeInterval = 0.0;            ///< 时间间隔
+    ResultStore m_Store;                    ///< 结果
+
+    /**
+     * @brief 分析步开始，重置计数
+     * @param [in] stepId 分析步ID
+     */
+    void BeginStep(int stepId);
+
+    /**
+     * @brief 一个增量步完成，判断是否保存
+     * @param [in] time 增量步时间
+     * @param [in] bLast 是否为分析步的最后一个增量步
+     * @return 需要保存返回 true
+     */
+    bool ShouldSave(double time, bool bLast);
+
+    /**
+     * @brief 将输出量名称展开为数据类型
+     * @param [in] name 输出量名称（U、UR、V、A、RF、S、NF 或分量名 U1、RF2 等，不区分大小写）
+     * @param [out] types 追加展开的数据类型
+     * @return 名称有效返回 true
+     */
+    static bool ParseVariable(const QString& name, std::vector<DataType>& types);
+
+private:
+    bool m_bActive = false;   ///< 当前分析步是否输出
+    int m_nIncrement = 0;     ///< 本分析步已完成的增量步数
+    double m_NextTime = 0.0;  ///< 下一次按时间输出的时刻
+};
@@ -1,6 +1,7 @@
 #include "Outputter.h"
 #include "DataStructure/Structure/StructureData.h"
 #include "DataStructure/Node/Node.h"
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 
@@ -62,44 +63,300 @@ double NodeData::GetValue(DataType type) const
     }
 }
 
-double DataFrame::GetNodeData(int idNode, DataType type) const
+void Outputter::ConfigureStore(ResultStore& store, StructureData* pData, const std::vector<int>* pIds, bool bElement,
+    const std::vector<DataType>& types)
 {
-    auto it = m_nodeDatas.find(idNode);
-    if (it != m_nodeDatas.end())
+    std::vector<int> ids;
+    const CompactModel& model = pData->GetCompactModel();
+    if (pIds)
+    {// 只保存指定的节点或单元（不存在的不保存，读取时为 0）
+        for (int id : *pIds)
+        {
+            bool bExists = false;
+            if (bElement) bExists = model.IsBuilt() ? model.FindElementIndex(id) >= 0 : nullptr != pData->FindElement(id);
+            else bExists = model.IsBuilt() ? model.FindNodeIndex(id) >= 0 : nullptr != pData->FindNode(id);
+            if (bExists && std::find(ids.begin(), ids.end(), id) == ids.end()) ids.push_back(id);
+        }
+    }
+    else if (model.IsBuilt())
+    {
+        ids = bElement ? model.m_ElementId : model.m_NodeId;
+    }
+    else if (bElement)
+    {
+        ids.reserve(pData->m_Elements.size());
+        for (const auto& elementPair : pData->m_Elements) ids.push_back(elementPair.first);
+    }
+    else
+    {
+        ids.reserve(pData->m_Nodes.size());
+        for (const auto& nodePair : pData->m_Nodes) ids.push_back(nodePair.first);
+    }
+    store.Reset(ids, types);
+}
+
+void Outputter::ResolveFrameNodes(StructureData* pData, const ResultStore& store)
+{
+    const std::vector<int>& nodeIds = store.GetNodeIds();
+    m_FrameNodes.assign(nodeIds.size(), nullptr);
+
+    const CompactModel& model = pData->GetCompactModel();
+    if (model.IsBuilt())
+    {// 从紧凑数组读取节点；保存全部节点且编号未变时列与紧凑数组一一对应
+        if (model.m_NodeId == nodeIds)
+        {
+            std::copy(model.m_NodeView.begin(), model.m_NodeView.end(), m_FrameNodes.begin());
+            return;
+        }
+        for (size_t i = 0; i < nodeIds.size(); ++i)
+        {
+            int iNode = model.FindNodeIndex(nodeIds[i]);
+            if (iNode >= 0) m_FrameNodes[i] = model.m_NodeView[iNode];
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < nodeIds.size(); ++i)
+    {
+        auto pNode = pData->FindNode(nodeIds[i]);
+        if (pNode) m_FrameNodes[i] = pNode.get();
+    }
+}
+
+void Outputter::ResolveFrameElements(StructureData* pData, const ResultStore& store)
+{
+    const std::vector<int>& elementIds = store.GetNodeIds();
+    m_FrameElements.assign(elementIds.size(), -1);
+    m_FrameElementViews.assign(elementIds.size(), nullptr);
+
+    const CompactModel& model = pData->GetCompactModel();
+    for (size_t i = 0; i < elementIds.size(); ++i)
+    {
+        if (model.IsBuilt())
+        {
+            int e = model.FindElementIndex(elementIds[i]);
+            m_FrameElements[i] = e;
+            if (e >= 0) m_FrameElementViews[i] = model.m_ElementView[e];
+        }
+        else
+        {
+            auto pElement = pData->FindElement(elementIds[i]);
+            if (pElement) m_FrameElementViews[i] = pElement.get();
+        }
+    }
+}
+
+void Outputter::SaveFrame(ResultStore& store, double time, StructureData* pData)
+{
+    const std::vector<DataType>& types = store.GetTypes();
+    const bool bElement = !types.empty() && IsElementDataType(types.front());
+    if (!bElement)
+    {
+        ResolveFrameNodes(pData, store);
+
+        // 追加一行，逐列写入请求的数据类型
+        const size_t frame = store.AppendFrame(time);
+        for (size_t i = 0; i < m_FrameNodes.size(); ++i)
+        {
+            NodeData data;
+            data.ExtractFromNode(m_FrameNodes[i]);  // 节点不存在时为 0
+            for (size_t t = 0; t < types.size(); ++t)
+            {
+                store.Row(frame, static_cast<int>(t))[i] = data.GetValue(types[t]);
+            }
+        }
+        return;
+    }
+
+    // 单元应力：求解过程中在紧凑数组中，分析步结束后写回单元对象；轴力 = 应力 × 截面面积
+    ResolveFrameElements(pData, store);
+    const CompactModel& model = pData->GetCompactModel();
+    const size_t frame = store.AppendFrame(time);
+    for (size_t i = 0; i < m_FrameElementViews.size(); ++i)
+    {
+        double stress = 0.0, area = 0.0;
+        const int e = m_FrameElements[i];
+        ElementBase* pElement = m_FrameElementViews[i];
+        if (e >= 0)
+        {
+            stress = model.m_ElemStress[e];
+            if (model.ConstantsValid() && model.m_ElemConst[e].E != 0.0) area = model.m_ElemConst[e].EA / model.m_ElemConst[e].E;
+        }
+        else if (pElement)
+        {
+            stress = pElement->m_Stress;
+        }
+        if (pElement && 0.0 == area)
+        {
+            auto pProperty = pElement->m_pProperty.lock();
+            auto pSection = pProperty ? pProperty->m_pSection.lock() : nullptr;
+            if (pSection) area = pSection->m_Area;
+        }
+
+        for (size_t t = 0; t < types.size(); ++t)
+        {
+            store.Row(frame, static_cast<int>(t))[i] = (DataType::S == types[t]) ? stress : stress * area;
+        }
+    }
+}
+
+void Outputter::ConfigureRequest(OutputRequest& request, StructureData* pData)
+{
+    const std::vector<int>* pIds = nullptr;
+    if (!request.m_SetName.isEmpty())
     {
-        return it->second.GetValue(type);
+        const auto& sets = request.m_bElement ? m_ElementSets : m_NodeSets;
+        auto it = sets.find(request.m_SetName);
+        if (it != sets.end())
+        {
+            pIds = &it->second;
+        }
+        else
+        {
+            qDebug().noquote() << QStringLiteral("Error: 输出请求 %1 的集合不存在: ").arg(request.m_Id) << request.m_SetName;
+            static const std::vector<int> empty;
+            pIds = &empty;
+        }
     }
-    return 0.0;
+    ConfigureStore(request.m_Store, pData, pIds, request.m_bElement, request.m_Types);
+}
+
+void Outputter::BeginStep(int stepId, EnumKeyword::StepType type)
+{
+    m_bStaticStep = (EnumKeyword::StepType::STATIC == type);
+    for (auto& request : m_Requests) request.BeginStep(stepId);
 }
 
-void Outputter::SaveDataFromNodes(double time, StructureData* pData)
+void Outputter::SaveDataFromNodes(double time, StructureData* pData, bool bLastIncrement)
 {
     if (!pData) return;
 
-    // 创建新帧
-    DataFrame frame;
-    frame.m_currentTime = time;
+    if (!m_Requests.empty())
+    {
+        for (size_t k = 0; k < m_Requests.size(); ++k)
+        {
+            OutputRequest& request = m_Requests[k];
+            if (!request.ShouldSave(time, bLastIncrement)) continue;
+            if (!request.m_Store.IsConfigured()) ConfigureRequest(request, pData);
+            SaveFrame(request.m_Store, time, pData);
+            if (m_pWriter) StreamFrame(static_cast<int>(k) + 1, request.m_Store, time);
+        }
+        return;
+    }
 
-    for (auto& nodePair : pData->m_Nodes)
+    // 默认输出：静力分析步只保存最后一个增量步
+    if (m_bStaticStep && !bLastIncrement) return;
+    if (!m_Store.IsConfigured())
     {
-        auto pNode = nodePair.second;
-        if (!pNode) continue;
+        std::vector<DataType> types = m_RequestedTypes;
+        if (types.empty())
+        {
+            for (int i = 0; i < NodeDataTypeCount; ++i) types.push_back(static_cast<DataType>(i));
+        }
+        ConfigureStore(m_Store, pData, m_RequestedNodes.empty() ? nullptr : &m_RequestedNodes, false, types);
+    }
+    SaveFrame(m_Store, time, pData);
+    if (m_pWriter) StreamFrame(0, m_Store, time);
+}
+
+void Outputter::StartStreaming(const QString& prefix, size_t nBuffer)
+{
+    StopStreaming();
+    Clear();
+    m_StreamPrefix = prefix;
+    m_pWriter = std::make_unique<ResultWriter>(static_cast<int>(m_Requests.size()) + 1, nBuffer);
+}
+
+void Outputter::StopStreaming()
+{
+    if (!m_pWriter) return;
+
+    m_pWriter->Flush();
+    qDebug().noquote() << QStringLiteral("\n流式输出") << m_pWriter->GetWrittenFrames() << QStringLiteral("帧，缓冲区用完等待")
+        << m_pWriter->GetStallCount() << QStringLiteral("次");
+    m_pWriter.reset();  // 析构时关闭文件
+}
 
-        NodeData data;
-        data.ExtractFromNode(pNode.get());  // 直接从节点读取
-        frame.m_nodeDatas[pNode->m_Id] = data;
+void Outputter::StreamFrame(int iFile, ResultStore& store, double time)
+{
+    if (!m_pWriter->HasLayout(iFile))
+    {
+        ResultWriter::Layout layout;
+        if (0 == iFile)
+        {
+            layout.m_FileName = m_StreamPrefix + ".out";
+            layout.m_Style = ResultWriter::Style::TABLE;
+            layout.m_Ids = store.GetNodeIds();
+            layout.m_Types = store.GetTypes();
+        }
+        else
+        {
+            const OutputRequest& request = m_Requests[iFile - 1];
+            layout = RequestLayout(request);
+            layout.m_FileName = RequestFileName(m_StreamPrefix, request);
+        }
+        m_pWriter->SetLayout(iFile, layout);
     }
 
-    m_DataSet.push_back(frame);
+    // 帧已复制到写出器的缓冲区，存储只保留布局，内存不随帧数增长
+    m_pWriter->Push(iFile, time, store);
+    store.ClearFrames();
+}
+
+QString Outputter::RequestFileName(const QString& prefix, const OutputRequest& request)
+{
+    QString kind = (OutputRequest::Kind::FIELD == request.m_Kind) ? "FIELD" : "HISTORY";
+    return QString("%1_%2").arg(prefix).arg(kind) + QString("%1.out").arg(request.m_Id);
+}
+
+ResultWriter::Layout Outputter::RequestLayout(const OutputRequest& request)
+{
+    ResultWriter::Layout layout;
+    layout.m_Style = (OutputRequest::Kind::FIELD == request.m_Kind) ? ResultWriter::Style::FIELD : ResultWriter::Style::HISTORY;
+    layout.m_bElement = request.m_bElement;
+    layout.m_Ids = request.m_Store.GetNodeIds();
+    layout.m_Types = request.m_Store.GetTypes();
+    return layout;
+}
+
+void Outputter::Clear()
+{
+    StopStreaming();
+    m_Store.Clear();
+    for (auto& request : m_Requests) request.m_Store.Clear();
+}
+
+void Outputter::ClearRequests()
+{
+    StopStreaming();  // 文件与请求一一对应
+    m_Requests.clear();
+    m_NodeSets.clear();
+    m_ElementSets.clear();
 }
 
-// 辅助格式化函数：科学计数法，固定宽度，保留6位小数
-static QString FormatValue(double val, int width = 16)
+bool Outputter::GetOutputNodes(std::vector<int>& nodeIds) const
 {
-    char buffer[64];
-    // 使用 %+.6E 确保正负号始终存在，保证对齐
-    snprintf(buffer, sizeof(buffer), "%+.6E", val);
-    return QString(buffer).rightJustified(width, ' ');
+    nodeIds.clear();
+    if (m_Requests.empty())
+    {
+        nodeIds = m_RequestedNodes;
+        return !nodeIds.empty();
+    }
+
+    for (const auto& request : m_Requests)
+    {
+        if (request.m_bElement) continue;
+        if (request.m_SetName.isEmpty())
+        {
+            nodeIds.clear();
+            return false;
+        }
+        auto it = m_NodeSets.find(request.m_SetName);
+        if (it != m_NodeSets.end()) nodeIds.insert(nodeIds.end(), it->second.begin(), it->second.end());
+    }
+    std::sort(nodeIds.begin(), nodeIds.end());
+    nodeIds.erase(std::unique(nodeIds.begin(), nodeIds.end()), nodeIds.end());
+    return true;
 }
 
 void Outputter::ExportNodes(const QString& fileName,
@@ -114,44 +371,36 @@ void Outputter::ExportNodes(const QString& fileName,
     }
 
     QTextStream stream(&file);
-    const int colWidth = 16; 
-    const QChar padChar = ' ';
+    const int colWidth = ResultWriter::ColumnWidth;
 
-    // --- 写表头 ---
-    stream << QString("TIME").rightJustified(colWidth, padChar);
+    // --- 写表头和分隔线（与流式输出相同） ---
+    stream << ResultWriter::FormatHeader(nodeIds, types, false, true);
 
-    for (int nodeId : nodeIds)
+    // 先查好各列在存储中的位置，未保存的节点或类型输出 0
+    std::vector<int> nodeIndex, typeIndex;
+    for (int nodeId : nodeIds) nodeIndex.push_back(m_Store.FindNode(nodeId));
+    for (DataType type : types)
     {
-        for (DataType type : types)
+        typeIndex.push_back(m_Store.FindType(type));
+        if (typeIndex.back() < 0 && m_Store.IsConfigured())
         {
-            QString header = QString("N%1-%2").arg(nodeId).arg(GetTypeName(type));
-            // 确保表头不超长
-            if (header.length() > colWidth) header = header.right(colWidth);
-            stream << header.rightJustified(colWidth, padChar);
+            qDebug().noquote() << QStringLiteral("Warning: 未保存的数据类型按 0 输出: ") << GetTypeName(type);
         }
     }
-    stream << "\n";
-    
-    // 分隔线 (长度自适应)
-    size_t totalWidth = colWidth + types.size() * nodeIds.size() * colWidth;
-    // 简单的重复字符生成分隔线
-    QString line; 
-    line.fill('-', totalWidth);
-    stream << line << "\n";
 
     // --- 写数据 (时间历程) ---
-    for (const auto& frame : m_DataSet)
+    for (size_t frame = 0; frame < m_Store.FrameCount(); ++frame)
     {
         // 时间列
-        stream << FormatValue(frame.m_currentTime, colWidth);
+        stream << ResultWriter::FormatValue(m_Store.GetTime(frame), colWidth);
 
         // 数据列
-        for (int nodeId : nodeIds)
+        for (int iNode : nodeIndex)
         {
-            for (DataType type : types)
+            for (int iType : typeIndex)
             {
-                double val = frame.GetNodeData(nodeId, type);
-                stream << FormatValue(val, colWidth);
+                double val = (iNode >= 0 && iType >= 0) ? m_Store.Row(frame, iType)[iNode] : 0.0;
+                stream << ResultWriter::FormatValue(val, colWidth);
             }
         }
         stream << "\n";
@@ -161,6 +410,43 @@ void Outputter::ExportNodes(const QString& fileName,
     qDebug().noquote() << QStringLiteral("\n输出至") << fileName;
 }
 
+void Outputter::ExportRequests(const QString& prefix) const
+{
+    for (const auto& request : m_Requests) ExportRequest(request, RequestFileName(prefix, request));
+}
+
+void Outputter::ExportRequest(const OutputRequest& request, const QString& fileName) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        qDebug() << "Failed to open file:" << fileName;
+        return;
+    }
+
+    // 与流式输出使用同一套格式
+    QTextStream stream(&file);
+    const ResultStore& store = request.m_Store;
+    const ResultWriter::Layout layout = RequestLayout(request);
+    if (OutputRequest::Kind::HISTORY == request.m_Kind)
+    {
+        stream << ResultWriter::FormatHeader(layout.m_Ids, layout.m_Types, layout.m_bElement, false);
+    }
+
+    QString text;
+    std::vector<const double*> rows(layout.m_Types.size());
+    for (size_t frame = 0; frame < store.FrameCount(); ++frame)
+    {
+        for (size_t t = 0; t < rows.size(); ++t) rows[t] = store.Row(frame, static_cast<int>(t));
+        text.clear();
+        ResultWriter::FormatFrame(layout, frame, store.GetTime(frame), rows.data(), text);
+        stream << text;
+    }
+
+    file.close();
+    qDebug().noquote() << QStringLiteral("\n输出至") << fileName;
+}
+
 QString Outputter::GetTypeName(DataType type)
 {
     switch (type)
@@ -184,6 +470,8 @@ QString Outputter::GetTypeName(DataType type)
     case DataType::M1:         return "M1";
     case DataType::M2:         return "M2";
     case DataType::M3:         return "M3";
+    case DataType::S:          return "S";
+    case DataType::NF:         return "NF";
     default:                   return "UNKNOWN";
     }
 }
@@ -5,28 +5,21 @@
  */
 
 #include <map>
+#include <memory>
 #include <vector>
 #include <QString>
 #include <QFile>
 #include <QTextStream>
 #include <QDebug>
 #include <Eigen/Dense>
+#include "ResultStore.h"
+#include "OutputRequest.h"
+#include "ResultWriter.h"
+#include "Utility/EnumKeyword.h"
 
 class StructureData;
 class Node;
-
-/**
- * @brief 数据类型枚举
- */
-enum class DataType : int 
-{
-    U1, U2, U3, MagnitudeU,       ///< 位移
-    V1, V2, V3,                   ///< 速度
-    A1, A2, A3,                   ///< 加速度
-    UR1, UR2, UR3,                ///< 转角
-    F1, F2, F3,                   ///< 节点力 (内力)
-    M1, M2, M3                    ///< 单元内力
-};
+class ElementBase;
 
 /**
  * @brief 单个节点在某一时刻的数据快照
@@ -60,26 +53,26 @@ private:
 };
 
 /**
- * @brief 单帧数据 (某一时间点所有节点的状态)
+ * @brief 单帧数据 (某一时间点已保存节点的状态，指向列式存储中的一行)
  */
 class DataFrame
 {
-    friend class Outputter;  ///< 允许 Outputter 访问私有成员
-
 public:
+    DataFrame(const ResultStore& store, size_t frame) : m_pStore(&store), m_Frame(frame) {}
+
     /**
      * @brief 获取当前时间
      */
-    double GetTime() const { return m_currentTime; }
+    double GetTime() const { return m_pStore->GetTime(m_Frame); }
 
     /**
-     * @brief 获取指定节点的指定类型数据
+     * @brief 获取指定节点的指定类型数据（未保存的节点或类型返回 0）
      */
-    double GetNodeData(int idNode, DataType type) const;
+    double GetNodeData(int idNode, DataType type) const { return m_pStore->GetValue(m_Frame, idNode, type); }
 
 private:
-    double m_currentTime = 0;                  ///< 当前时间
-    std::map<int, NodeData> m_nodeDatas;       ///< 节点ID -> 节点数据
+    const ResultStore* m_pStore;  ///< 列式存储
+    size_t m_Frame;               ///< 帧序号
 };
 
 /**
@@ -87,6 +80,16 @@ private:
  * 
  * 支持增量式保存：每完成一个时间步/荷载步，调用 SaveDataFromNodes() 保存当前状态。
  * 即使分析未完成，已保存的帧也可以随时导出。
+ *
+ * 结果按列存放在 ResultStore 中，只保存请求的节点和数据类型；
+ * 保存的节点和类型在 Clear() 后的第一帧确定，之后修改请求要在 Clear() 后才生效。
+ *
+ * 输入文件中有 *OUTPUT 请求时，按各请求的分析步、集合、输出量和频率分别保存，不再使用默认存储；
+ * 没有请求时为默认输出：SetRequestedNodes/SetRequestedTypes 选择的节点和类型，
+ * 静力分析步只保存最后一个增量步，其他分析步保存每个增量步。
+ *
+ * 流式输出（StartStreaming）时每帧保存后交给后台 ResultWriter 追加写出，内存中只保留最新一帧，
+ * 内存占用与帧数无关；文件格式与 ExportNodes、ExportRequests 相同。
  */
 class Outputter
 {
@@ -95,14 +98,91 @@ public:
     ~Outputter() { Clear(); }
 
     /**
-     * @brief 保存当前时刻数据 (直接从节点读取)
+     * @brief 分析步开始（重置各请求的增量步计数）
+     * @param [in] stepId 分析步ID
+     * @param [in] type 分析步类型
+     */
+    void BeginStep(int stepId, EnumKeyword::StepType type);
+
+    /**
+     * @brief 一个增量步完成，按输出请求保存当前时刻数据 (直接从节点和单元读取)
      * @param [in] time 当前时间
      * @param [in] pData 结构数据指针
+     * @param [in] bLastIncrement 是否为分析步的最后一个增量步
      * 
      * 直接从节点的 m_Displacement, m_Velocity, m_Acceleration, m_Force 读取数据。
      * 支持输出任意节点(包括约束节点)的数据。
      */
-    void SaveDataFromNodes(double time, StructureData* pData);
+    void SaveDataFromNodes(double time, StructureData* pData, bool bLastIncrement = true);
+
+    /**
+     * @brief 定义节点集合（同名集合被替换）
+     * @param [in] name 集合名称（不区分大小写）
+     * @param [in] ids 节点ID
+     */
+    void AddNodeSet(const QString& name, const std::vector<int>& ids) { m_NodeSets[name.toUpper()] = ids; }
+
+    /**
+     * @brief 定义单元集合（同名集合被替换）
+     * @param [in] name 集合名称（不区分大小写）
+     * @param [in] ids 单元ID
+     */
+    void AddElementSet(const QString& name, const std::vector<int>& ids) { m_ElementSets[name.toUpper()] = ids; }
+
+    /**
+     * @brief 获取节点集合 (只读，名称为大写)
+     */
+    const std::map<QString, std::vector<int>>& GetNodeSets() const { return m_NodeSets; }
+
+    /**
+     * @brief 获取单元集合 (只读，名称为大写)
+     */
+    const std::map<QString, std::vector<int>>& GetElementSets() const { return m_ElementSets; }
+
+    /**
+     * @brief 添加输出请求
+     * @param [in] request 输出请求（集合在第一次保存时按名称查找）
+     */
+    void AddRequest(const OutputRequest& request) { m_Requests.push_back(request); }
+
+    /**
+     * @brief 获取输出请求 (只读)
+     */
+    const std::vector<OutputRequest>& GetRequests() const { return m_Requests; }
+
+    /**
+     * @brief 清除输出请求和集合（保留默认输出的设置）
+     */
+    void ClearRequests();
+
+    /**
+     * @brief 获取需要保存结果的全部节点（默认输出或全部请求涉及的节点）
+     * @param [out] nodeIds 节点ID
+     * @return 需要全部节点时返回 false，nodeIds 为空
+     */
+    bool GetOutputNodes(std::vector<int>& nodeIds) const;
+
+    /**
+     * @brief 设置需要保存结果的节点
+     * @param [in] nodeIds 节点ID列表，为空时保存全部节点
+     */
+    void SetRequestedNodes(const std::vector<int>& nodeIds) { m_RequestedNodes = nodeIds; }
+
+    /**
+     * @brief 获取需要保存结果的节点（为空表示全部节点）
+     */
+    const std::vector<int>& GetRequestedNodes() const { return m_RequestedNodes; }
+
+    /**
+     * @brief 设置需要保存的数据类型
+     * @param [in] types 数据类型列表，为空时保存全部类型
+     */
+    void SetRequestedTypes(const std::vector<DataType>& types) { m_RequestedTypes = types; }
+
+    /**
+     * @brief 获取需要保存的数据类型（为空表示全部类型）
+     */
+    const std::vector<DataType>& GetRequestedTypes() const { return m_RequestedTypes; }
 
     /**
      * @brief 导出指定节点的时程数据到文件
@@ -115,28 +195,118 @@ public:
                      const std::vector<DataType>& types) const;
 
     /**
-     * @brief 获取帧数
+     * @brief 导出全部输出请求的结果，每个请求一个文件：<prefix>_FIELD<ID>.out 或 <prefix>_HISTORY<ID>.out
+     * @param [in] prefix 文件名前缀
+     *
+     * 场输出逐帧列出集合中各对象的数据，历史输出每行为一个时刻、每列为一个对象的一个量。
      */
-    size_t GetFrameCount() const { return m_DataSet.size(); }
+    void ExportRequests(const QString& prefix) const;
 
     /**
-     * @brief 清除所有数据
+     * @brief 开始流式输出（清除已保存的数据，请求要在此之前添加）
+     * @param [in] prefix 文件名前缀：默认输出写入 <prefix>.out，输出请求的文件名同 ExportRequests
+     * @param [in] nBuffer 帧缓冲区个数，写出线程落后这么多帧时求解线程才等待
      */
-    void Clear() { m_DataSet.clear(); }
+    void StartStreaming(const QString& prefix, size_t nBuffer = 64);
 
     /**
-     * @brief 获取数据集 (只读)
+     * @brief 结束流式输出（等待排队的帧全部写出并关闭文件）
      */
+    void StopStreaming();
+
     /**
-     * @brief 获取数据集 (只读)
+     * @brief 是否正在流式输出
      */
-    const std::vector<DataFrame>& GetDataSet() const { return m_DataSet; }
+    bool IsStreaming() const { return nullptr != m_pWriter; }
 
-private:
-    std::vector<DataFrame> m_DataSet;  ///< 帧数据集合
+    /**
+     * @brief 获取帧数（流式输出时内存中只保留最新一帧）
+     */
+    size_t GetFrameCount() const { return m_Store.FrameCount(); }
+
+    /**
+     * @brief 清除所有数据
+     */
+    void Clear();
+
+    /**
+     * @brief 获取第 i 帧 (只读)
+     */
+    DataFrame GetFrame(size_t i) const { return DataFrame(m_Store, i); }
+
+    /**
+     * @brief 获取列式存储 (只读)
+     */
+    const ResultStore& GetStore() const { return m_Store; }
 
     /**
      * @brief 获取数据类型名称
      */
     static QString GetTypeName(DataType type);
+
+private:
+    ResultStore m_Store;                      ///< 列式结果存储
+    std::vector<int> m_RequestedNodes;        ///< 需要保存结果的节点ID（为空表示全部）
+    std::vector<DataType> m_RequestedTypes;   ///< 需要保存的数据类型（为空表示全部）
+    bool m_bStaticStep = false;               ///< 当前分析步是否为静力分析步（默认输出只保存最后一个增量步）
+    std::vector<OutputRequest> m_Requests;    ///< *OUTPUT 输出请求
+    std::map<QString, std::vector<int>> m_NodeSets;     ///< 节点集合
+    std::map<QString, std::vector<int>> m_ElementSets;  ///< 单元集合
+    std::vector<const Node*> m_FrameNodes;    ///< 当前帧各列对应的节点（重复使用，避免每帧分配）
+    std::vector<int> m_FrameElements;         ///< 当前帧各列对应的紧凑数组单元下标（紧凑数组未建立时为 -1）
+    std::vector<ElementBase*> m_FrameElementViews;  ///< 当前帧各列对应的单元（不存在的为 nullptr）
+    std::unique_ptr<ResultWriter> m_pWriter;  ///< 流式输出的写出器（未流式输出时为空）
+    QString m_StreamPrefix;                   ///< 流式输出的文件名前缀
+
+    /**
+     * @brief 按第一帧时的模型确定保存的节点（或单元）和类型
+     * @param [out] store 列式存储
+     * @param [in] pData 结构数据
+     * @param [in] pIds 节点或单元ID，nullptr 为全部；不存在的ID不保存
+     * @param [in] bElement 是否为单元
+     * @param [in] types 数据类型
+     */
+    static void ConfigureStore(ResultStore& store, StructureData* pData, const std::vector<int>* pIds, bool bElement,
+        const std::vector<DataType>& types);
+
+    /**
+     * @brief 找到当前模型中各列对应的节点，写入 m_FrameNodes（不存在的为 nullptr）
+     */
+    void ResolveFrameNodes(StructureData* pData, const ResultStore& store);
+
+    /**
+     * @brief 找到当前模型中各列对应的单元，写入 m_FrameElements 和 m_FrameElementViews
+     */
+    void ResolveFrameElements(StructureData* pData, const ResultStore& store);
+
+    /**
+     * @brief 向存储追加一帧
+     */
+    void SaveFrame(ResultStore& store, double time, StructureData* pData);
+
+    /**
+     * @brief 流式输出时把存储的最新一帧交给写出器，然后清空存储中的帧
+     * @param [in] iFile 文件序号：0 为默认输出，k 为第 k 个输出请求
+     */
+    void StreamFrame(int iFile, ResultStore& store, double time);
+
+    /**
+     * @brief 输出请求的文件名：<prefix>_FIELD<ID>.out 或 <prefix>_HISTORY<ID>.out
+     */
+    static QString RequestFileName(const QString& prefix, const OutputRequest& request);
+
+    /**
+     * @brief 输出请求的文件布局
+     */
+    static ResultWriter::Layout RequestLayout(const OutputRequest& request);
+
+    /**
+     * @brief 为输出请求确定存储布局（按名称查找集合）
+     */
+    void ConfigureRequest(OutputRequest& request, StructureData* pData);
+
+    /**
+     * @brief 导出一个输出请求的结果
+     */
+    void ExportRequest(const OutputRequest& request, const QString& fileName) const;
 };
@@ -0,0 +1,74 @@
+﻿#include "ResultStore.h"
+#include <algorithm>
+
+void ResultStore::Reset(const std::vector<int>& nodeIds, const std::vector<DataType>& types)
+{
+    Clear();
+    m_bConfigured = true;
+
+    m_NodeIds = nodeIds;
+    m_NodeIndex.reserve(m_NodeIds.size());
+    for (size_t i = 0; i < m_NodeIds.size(); ++i)
+    {
+        m_NodeIndex.emplace(m_NodeIds[i], static_cast<int>(i));
+    }
+
+    for (DataType type : types)
+    {
+        int& index = m_TypeIndex[static_cast<int>(type)];
+        if (index >= 0) continue;  // 重复的类型只保存一次
+
+        index = static_cast<int>(m_Types.size());
+        m_Types.push_back(type);
+    }
+    m_Columns.resize(m_Types.size());
+}
+
+void ResultStore::Clear()
+{
+    m_bConfigured = false;
+    m_NodeIds.clear();
+    m_NodeIndex.clear();
+    m_Types.clear();
+    std::fill(std::begin(m_TypeIndex), std::end(m_TypeIndex), -1);
+    m_Times.clear();
+    m_Columns.clear();
+}
+
+void ResultStore::ClearFrames()
+{
+    m_Times.clear();
+    for (auto& column : m_Columns) column.clear();
+}
+
+size_t ResultStore::AppendFrame(double time)
+{
+    const size_t frame = m_Times.size();
+    m_Times.push_back(time);
+
+    // 各列按 vector 的倍增策略扩容，均摊到每帧只有常数次分配
+    const size_t size = m_Times.size() * m_NodeIds.size();
+    for (auto& column : m_Columns) column.resize(size);
+    return frame;
+}
+
+int ResultStore::FindNode(int idNode) const
+{
+    auto it = m_NodeIndex.find(idNode);
+    return it != m_NodeIndex.end() ? it->second : -1;
+}
+
+double ResultStore::GetValue(size_t frame, int idNode, DataType type) const
+{
+    const int iNode = FindNode(idNode);
+    const int iType = FindType(type);
+    if (iNode < 0 || iType < 0 || frame >= FrameCount()) return 0.0;
+    return Row(frame, iType)[iNode];
+}
+
+size_t ResultStore::MemoryBytes() const
+{
+    size_t bytes = m_Times.capacity() * sizeof(double);
+    for (const auto& column : m_Columns) bytes += column.capacity() * sizeof(double);
+    return bytes;
+}
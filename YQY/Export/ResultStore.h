@@ -0,0 +1,128 @@
+﻿#pragma once
+/**
+ * @file ResultStore.h
+ * @brief 列式结果存储 - 每个输出量一个 时间 × 节点 的连续数组
+ */
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 数据类型枚举
+ */
+enum class DataType : int
+{
+    U1, U2, U3, MagnitudeU,       ///< 位移
+    V1, V2, V3,                   ///< 速度
+    A1, A2, A3,                   ///< 加速度
+    UR1, UR2, UR3,                ///< 转角
+    F1, F2, F3,                   ///< 节点力 (内力)
+    M1, M2, M3,                   ///< 单元内力
+    S, NF                         ///< 单元应力、单元轴力（单元数据）
+};
+
+const int NodeDataTypeCount = static_cast<int>(DataType::M3) + 1;  ///< 节点数据类型个数（U1 ~ M3）
+const int DataTypeCount = static_cast<int>(DataType::NF) + 1;      ///< 数据类型个数
+
+/**
+ * @brief 是否为单元数据类型
+ */
+inline bool IsElementDataType(DataType type) { return static_cast<int>(type) >= NodeDataTypeCount; }
+
+/**
+ * @brief 列式结果存储
+ *
+ * 列为节点或单元（由保存的数据类型决定，一个存储只保存一种），下文统称节点。
+ * 布局（保存的节点和数据类型）在第一帧之前确定，之后每帧只在各列末尾追加一行，
+ * 不为单个节点分配内存。第 f 帧、第 i 个节点的某个量位于该量数组的 f * 节点数 + i 处。
+ */
+class ResultStore
+{
+public:
+    ResultStore() { Clear(); }
+
+    /**
+     * @brief 清空数据并设置布局
+     * @param [in] nodeIds 保存的节点ID（列的顺序）
+     * @param [in] types 保存的数据类型
+     */
+    void Reset(const std::vector<int>& nodeIds, const std::vector<DataType>& types);
+
+    /**
+     * @brief 清空数据和布局
+     */
+    void Clear();
+
+    /**
+     * @brief 清空各帧数据，保留布局和已分配的内存（流式输出写出后调用）
+     */
+    void ClearFrames();
+
+    /**
+     * @brief 布局是否已设置
+     */
+    bool IsConfigured() const { return m_bConfigured; }
+
+    /**
+     * @brief 追加一帧（各量的新行未初始化，由调用者经 Row 填写）
+     * @param [in] time 帧时间
+     * @return 新帧的序号
+     */
+    size_t AppendFrame(double time);
+
+    /**
+     * @brief 获取第 frame 帧第 iType 个数据类型的一行（长度为节点数）
+     */
+    double* Row(size_t frame, int iType) { return m_Columns[iType].data() + frame * m_NodeIds.size(); }
+    const double* Row(size_t frame, int iType) const { return m_Columns[iType].data() + frame * m_NodeIds.size(); }
+
+    /**
+     * @brief 帧数
+     */
+    size_t FrameCount() const { return m_Times.size(); }
+
+    /**
+     * @brief 第 frame 帧的时间
+     */
+    double GetTime(size_t frame) const { return m_Times[frame]; }
+
+    /**
+     * @brief 保存的节点ID
+     */
+    const std::vector<int>& GetNodeIds() const { return m_NodeIds; }
+
+    /**
+     * @brief 保存的数据类型
+     */
+    const std::vector<DataType>& GetTypes() const { return m_Types; }
+
+    /**
+     * @brief 节点所在的列，未保存返回 -1
+     */
+    int FindNode(int idNode) const;
+
+    /**
+     * @brief 数据类型的序号，未保存返回 -1
+     */
+    int FindType(DataType type) const { return m_TypeIndex[static_cast<int>(type)]; }
+
+    /**
+     * @brief 获取第 frame 帧指定节点的指定数据，节点或类型未保存时返回 0
+     */
+    double GetValue(size_t frame, int idNode, DataType type) const;
+
+    /**
+     * @brief 数据占用的字节数
+     */
+    size_t MemoryBytes() const;
+
+private:
+    bool m_bConfigured = false;                    ///< 布局是否已设置
+    std::vector<int> m_NodeIds;                    ///< 节点ID（列的顺序）
+    std::unordered_map<int, int> m_NodeIndex;      ///< 节点ID -> 列
+    std::vector<DataType> m_Types;                 ///< 保存的数据类型
+    int m_TypeIndex[DataTypeCount];                ///< 数据类型 -> 序号（未保存为 -1）
+    std::vector<double> m_Times;                   ///< 各帧时间
+    std::vector<std::vector<double>> m_Columns;    ///< 每个数据类型一个 帧数 × 节点数 的数组
+};
@@ -0,0 +1,206 @@
+﻿#include "ResultWriter.h"
+#include "Outputter.h"
+#include <QFile>
+#include <QTextStream>
+#include <QDebug>
+#include <cstring>
+
+ResultWriter::ResultWriter(int nFile, size_t nBuffer)
+    : m_Files(nFile), m_Full(nBuffer), m_Free(nBuffer)
+{
+    // 两个队列容量相同，全部缓冲区先放入空闲队列（写出线程启动前，不存在并发）
+    m_Buffers.resize(m_Free.Capacity());
+    for (size_t i = 0; i < m_Buffers.size(); ++i) m_Free.TryPush(static_cast<int>(i));
+
+    m_Worker = std::thread(&ResultWriter::Run, this);
+}
+
+ResultWriter::~ResultWriter()
+{
+    m_bStop.store(true, std::memory_order_release);
+    Notify(m_Wake);
+    if (m_Worker.joinable()) m_Worker.join();
+}
+
+void ResultWriter::SetLayout(int iFile, const Layout& layout)
+{
+    File& file = m_Files[iFile];
+    if (file.m_bLayout) return;  // 写出线程可能正在读取，不能再修改
+
+    file.m_Layout = layout;
+    file.m_bLayout = true;
+}
+
+void ResultWriter::Push(int iFile, double time, const ResultStore& store)
+{
+    if (0 == store.FrameCount()) return;
+
+    int index = -1;
+    if (!m_Free.TryPop(index))
+    {// 缓冲区全部在排队：写出跟不上，休眠到写出线程归还（只有本线程取出空闲缓冲区，醒来后一定能取到）
+        ++m_nStall;
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Returned.wait(lock, [this] { return !m_Free.Empty(); });
+        lock.unlock();
+        m_Free.TryPop(index);
+    }
+
+    // 缓冲区第一次使用时按帧大小分配，之后重复使用不再分配
+    Frame& frame = m_Buffers[index];
+    const size_t frameIndex = store.FrameCount() - 1;
+    const size_t nId = store.GetNodeIds().size();
+    const size_t nType = store.GetTypes().size();
+    frame.m_iFile = iFile;
+    frame.m_Time = time;
+    frame.m_Values.resize(nId * nType);
+    for (size_t t = 0; t < nType; ++t)
+    {
+        if (nId > 0) std::memcpy(frame.m_Values.data() + t * nId, store.Row(frameIndex, static_cast<int>(t)), nId * sizeof(double));
+    }
+
+    // 布局和帧内容先于下标可见（队列的 release），写出线程取出后才读取
+    m_nPushed.fetch_add(1, std::memory_order_relaxed);
+    m_Full.TryPush(index);  // 与空闲队列容量相同，不会失败
+    Notify(m_Wake);
+}
+
+void ResultWriter::Flush()
+{
+    const int64_t nPushed = m_nPushed.load(std::memory_order_relaxed);
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Returned.wait(lock, [this, nPushed] { return m_nWritten.load(std::memory_order_acquire) >= nPushed; });
+}
+
+void ResultWriter::Notify(std::condition_variable& condition)
+{
+    // 等待方在持有锁时检查条件；状态修改后经过一次加锁，等待方要么已看到新状态，要么已进入等待
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+    }
+    condition.notify_one();
+}
+
+void ResultWriter::Run()
+{
+    QString text;
+    int index = -1;
+    while (true)
+    {
+        if (m_Full.TryPop(index))
+        {
+            Write(m_Buffers[index], text);
+            m_Free.TryPush(index);
+            m_nWritten.fetch_add(1, std::memory_order_release);
+            Notify(m_Returned);
+            continue;
+        }
+
+        // 队列为空：结束请求在最后一帧放入之后发出，此时已全部写出
+        if (m_bStop.load(std::memory_order_acquire) && m_Full.Empty()) break;
+
+        // 休眠到有新帧或结束请求
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Wake.wait(lock, [this] { return !m_Full.Empty() || m_bStop.load(std::memory_order_acquire); });
+    }
+
+    for (File& file : m_Files)
+    {
+        if (file.m_pFile) file.m_pFile->close();
+    }
+}
+
+void ResultWriter::Write(Frame& frame, QString& text)
+{
+    File& file = m_Files[frame.m_iFile];
+    if (file.m_bFailed) return;
+
+    const Layout& layout = file.m_Layout;
+    text.clear();
+    if (!file.m_pFile)
+    {// 第一帧：创建文件并写表头
+        file.m_pFile = std::make_unique<QFile>(layout.m_FileName);
+        if (!file.m_pFile->open(QIODevice::WriteOnly | QIODevice::Text))
+        {
+            qDebug() << "Failed to open file:" << layout.m_FileName;
+            file.m_bFailed = true;
+            return;
+        }
+        file.m_pStream = std::make_unique<QTextStream>(file.m_pFile.get());
+        if (Style::FIELD != layout.m_Style)
+        {
+            text += FormatHeader(layout.m_Ids, layout.m_Types, layout.m_bElement, Style::TABLE == layout.m_Style);
+        }
+    }
+
+    const size_t nId = layout.m_Ids.size();
+    std::vector<const double*> rows(layout.m_Types.size());
+    for (size_t t = 0; t < rows.size(); ++t) rows[t] = frame.m_Values.data() + t * nId;
+    FormatFrame(layout, file.m_nFrame++, frame.m_Time, rows.data(), text);
+
+    // 整帧格式化后一次写入并刷新，已刷新的内容总以完整的一帧结束
+    *file.m_pStream << text;
+    file.m_pStream->flush();
+    file.m_pFile->flush();
+}
+
+QString ResultWriter::FormatValue(double val, int width)
+{
+    char buffer[64];
+    // 使用 %+.6E 确保正负号始终存在，保证对齐
+    snprintf(buffer, sizeof(buffer), "%+.6E", val);
+    return QString(buffer).rightJustified(width, ' ');
+}
+
+QString ResultWriter::FormatHeader(const std::vector<int>& ids, const std::vector<DataType>& types, bool bElement, bool bSeparator)
+{
+    const QChar padChar = ' ';
+    QString text = QString("TIME").rightJustified(ColumnWidth, padChar);
+    for (int id : ids)
+    {
+        for (DataType type : types)
+        {
+            QString header = QString(bElement ? "E%1-" : "N%1-").arg(id) + Outputter::GetTypeName(type);
+            // 确保表头不超长
+            if (header.length() > ColumnWidth) header = header.right(ColumnWidth);
+            text += header.rightJustified(ColumnWidth, padChar);
+        }
+    }
+    text += "\n";
+
+    if (bSeparator)
+    {// 分隔线 (长度自适应)
+        QString line;
+        line.fill('-', ColumnWidth + types.size() * ids.size() * ColumnWidth);
+        text += line + "\n";
+    }
+    return text;
+}
+
+void ResultWriter::FormatFrame(const Layout& layout, size_t frame, double time, const double* const* rows, QString& text)
+{
+    const QChar padChar = ' ';
+    const size_t nType = layout.m_Types.size();
+    if (Style::FIELD != layout.m_Style)
+    {// 每行一个时刻，每列为一个对象的一个量
+        text += FormatValue(time);
+        for (size_t i = 0; i < layout.m_Ids.size(); ++i)
+        {
+            for (size_t t = 0; t < nType; ++t) text += FormatValue(rows[t][i]);
+        }
+        text += "\n";
+        return;
+    }
+
+    // 逐帧列出每个对象的全部量
+    text += QString("FRAME %1").arg(static_cast<int>(frame) + 1) + "   TIME" + FormatValue(time) + "\n";
+    text += QString(layout.m_bElement ? "ELEMENT" : "NODE").rightJustified(ColumnWidth, padChar);
+    for (DataType type : layout.m_Types) text += Outputter::GetTypeName(type).rightJustified(ColumnWidth, padChar);
+    text += "\n";
+    for (size_t i = 0; i < layout.m_Ids.size(); ++i)
+    {
+        text += QString("%1").arg(layout.m_Ids[i]).rightJustified(ColumnWidth, padChar);
+        for (size_t t = 0; t < nType; ++t) text += FormatValue(rows[t][i]);
+        text += "\n";
+    }
+    text += "\n";
+}
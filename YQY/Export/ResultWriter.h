@@ -0,0 +1,182 @@
+﻿#pragma once
+/**
+ * @file ResultWriter.h
+ * @brief 异步结果写出器 - 后台线程逐帧追加写出分析结果
+ */
+
+#include <QString>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ResultStore.h"
+#include "Utility/SpscQueue.h"
+
+class QFile;
+class QTextStream;
+
+/**
+ * @brief 异步结果写出器
+ *
+ * 求解线程把每帧数据复制到预先分配的帧缓冲区，经单生产者单消费者无锁队列交给写出线程；
+ * 写出线程格式化并追加到文件，写完的缓冲区经另一个队列还给求解线程重复使用。
+ * 求解线程只在全部缓冲区都在排队（写出跟不上）时等待，不会因文件读写阻塞。
+ * 缓冲区在第一次使用时按帧大小分配，之后重复使用。
+ * 每个文件在第一帧到达时创建并写入表头，之后每帧格式化后一次追加并刷新，
+ * 文件在分析过程中随时可读：除正在写入的一帧外都是完整的行，程序中断时已写出的帧不会丢失。
+ *
+ * 文件个数在构造时确定；SetLayout、Push 只能在同一个线程（求解线程）中调用。
+ */
+class ResultWriter
+{
+public:
+    /**
+     * @brief 文件格式
+     */
+    enum class Style
+    {
+        TABLE,    ///< 表头、分隔线，每行一个时刻（ExportNodes 格式）
+        HISTORY,  ///< 表头，每行一个时刻（历史输出格式）
+        FIELD     ///< 每帧一段，每行一个对象（场输出格式）
+    };
+
+    /**
+     * @brief 文件布局（列的顺序与 ResultStore 相同）
+     */
+    struct Layout
+    {
+        QString m_FileName;              ///< 文件路径
+        Style m_Style = Style::TABLE;    ///< 文件格式
+        bool m_bElement = false;         ///< 列是否为单元
+        std::vector<int> m_Ids;          ///< 节点或单元ID
+        std::vector<DataType> m_Types;   ///< 数据类型
+    };
+
+    static const int ColumnWidth = 16;   ///< 列宽
+
+    /**
+     * @brief 构造并启动写出线程
+     * @param [in] nFile 文件个数
+     * @param [in] nBuffer 帧缓冲区个数（向上取为 2 的幂）
+     */
+    ResultWriter(int nFile, size_t nBuffer);
+
+    /**
+     * @brief 析构时写完排队的帧并结束写出线程
+     */
+    ~ResultWriter();
+
+    ResultWriter(const ResultWriter&) = delete;
+    ResultWriter& operator=(const ResultWriter&) = delete;
+
+    /**
+     * @brief 设置文件布局（在该文件的第一帧之前调用，之后不能修改）
+     * @param [in] iFile 文件序号
+     * @param [in] layout 文件布局
+     */
+    void SetLayout(int iFile, const Layout& layout);
+
+    /**
+     * @brief 文件布局是否已设置
+     */
+    bool HasLayout(int iFile) const { return m_Files[iFile].m_bLayout; }
+
+    /**
+     * @brief 写出一帧（复制后立即返回，缓冲区全部在排队时等待）
+     * @param [in] iFile 文件序号
+     * @param [in] time 帧时间
+     * @param [in] store 列式存储，写出最后一帧
+     */
+    void Push(int iFile, double time, const ResultStore& store);
+
+    /**
+     * @brief 等待排队的帧全部写出并刷新文件
+     */
+    void Flush();
+
+    /**
+     * @brief 已写出的帧数
+     */
+    int64_t GetWrittenFrames() const { return m_nWritten.load(std::memory_order_acquire); }
+
+    /**
+     * @brief 求解线程因缓冲区用完而等待的次数
+     */
+    int64_t GetStallCount() const { return m_nStall; }
+
+    /**
+     * @brief 格式化表头（TABLE、HISTORY 格式）
+     */
+    static QString FormatHeader(const std::vector<int>& ids, const std::vector<DataType>& types, bool bElement, bool bSeparator);
+
+    /**
+     * @brief 格式化一帧
+     * @param [in] layout 文件布局
+     * @param [in] frame 帧序号（从 0 开始，FIELD 格式的段标题使用）
+     * @param [in] time 帧时间
+     * @param [in] rows 每个数据类型一行，长度为 ID 个数
+     * @param [out] text 追加格式化的文本
+     */
+    static void FormatFrame(const Layout& layout, size_t frame, double time, const double* const* rows, QString& text);
+
+    /**
+     * @brief 格式化数值：科学计数法，固定宽度，保留6位小数
+     */
+    static QString FormatValue(double val, int width = ColumnWidth);
+
+private:
+    /**
+     * @brief 帧缓冲区
+     */
+    struct Frame
+    {
+        int m_iFile = -1;               ///< 文件序号
+        double m_Time = 0.0;            ///< 帧时间
+        std::vector<double> m_Values;   ///< 数据，按数据类型分行：第 t 个类型第 i 个对象位于 t * ID个数 + i
+    };
+
+    /**
+     * @brief 文件状态
+     */
+    struct File
+    {
+        Layout m_Layout;                        ///< 布局（求解线程在第一帧前写入）
+        bool m_bLayout = false;                 ///< 布局是否已设置（仅求解线程访问）
+        std::unique_ptr<QFile> m_pFile;         ///< 文件（仅写出线程访问）
+        std::unique_ptr<QTextStream> m_pStream; ///< 文本流（仅写出线程访问）
+        size_t m_nFrame = 0;                    ///< 已写出的帧数（仅写出线程访问）
+        bool m_bFailed = false;                 ///< 打开失败（仅写出线程访问）
+    };
+
+    /**
+     * @brief 写出线程函数
+     */
+    void Run();
+
+    /**
+     * @brief 写出一帧（写出线程）
+     */
+    void Write(Frame& frame, QString& text);
+
+    /**
+     * @brief 状态（队列、计数）修改后唤醒等待方
+     * @param [in] condition m_Wake 或 m_Returned
+     */
+    void Notify(std::condition_variable& condition);
+
+    std::vector<File> m_Files;          ///< 文件
+    std::vector<Frame> m_Buffers;       ///< 帧缓冲区
+    SpscQueue<int> m_Full;              ///< 待写出的缓冲区（求解线程 -> 写出线程）
+    SpscQueue<int> m_Free;              ///< 空闲的缓冲区（写出线程 -> 求解线程）
+    std::thread m_Worker;               ///< 写出线程
+    std::mutex m_Mutex;                 ///< 休眠等待用：条件在持有锁时检查，状态修改后加锁再通知
+    std::condition_variable m_Wake;     ///< 有新帧或需要结束时唤醒写出线程
+    std::condition_variable m_Returned; ///< 写出一帧、归还缓冲区时唤醒求解线程
+    std::atomic<bool> m_bStop{false};   ///< 结束请求
+    std::atomic<int64_t> m_nPushed{0};  ///< 已放入的帧数
+    std::atomic<int64_t> m_nWritten{0}; ///< 已写出的帧数
+    int64_t m_nStall = 0;               ///< 等待次数（仅求解线程访问）
+};
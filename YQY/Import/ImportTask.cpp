@@ -0,0 +1,103 @@
+﻿#include "ImportTask.h"
+#include "Input_Model.h"
+#include "DataStructure/Structure/StructureData.h"
+#include "Utility/ModelManager.h"
+
+ImportTask::~ImportTask()
+{
+    Cancel();
+    Wait();
+}
+
+bool ImportTask::Start(const QString& FileName, int nThreads)
+{
+    if (IsRunning()) return false;
+    Wait();
+
+    // 丢弃上一次导入未取出的进度（工作线程已结束，此时可以由本线程清空）
+    Progress stale;
+    while (m_Channel.TryPop(stale)) {}
+
+    m_bCancel.store(false, std::memory_order_relaxed);
+    m_ModelId.store(0, std::memory_order_relaxed);
+    m_bFinalPolled = false;
+    m_LastPushState = State::IDLE;
+    m_State.store(static_cast<int>(State::READING), std::memory_order_release);
+    m_Worker = std::thread(&ImportTask::Run, this, FileName, nThreads);
+    return true;
+}
+
+void ImportTask::Wait()
+{
+    if (m_Worker.joinable()) m_Worker.join();
+}
+
+bool ImportTask::PollProgress(Progress& progress)
+{
+    bool bNew = false;
+    while (m_Channel.TryPop(progress)) bNew = true;
+
+    // 队列中的进度取完后再取最终进度，保证最终进度总是最后一个
+    const State state = GetState();
+    if (!m_bFinalPolled && (State::FINISHED == state || State::CANCELLED == state || State::FAILED == state))
+    {
+        while (m_Channel.TryPop(progress)) {}
+        progress = m_Final;
+        m_bFinalPolled = true;
+        bNew = true;
+    }
+    return bNew;
+}
+
+void ImportTask::Push(const Progress& progress)
+{
+    const auto now = std::chrono::steady_clock::now();
+    if (progress.m_State == m_LastPushState && now - m_LastPush < std::chrono::milliseconds(ThrottleMs)) return;
+    if (!m_Channel.TryPush(progress)) return;  // 调用线程没有及时取出，丢弃本次进度
+
+    m_LastPush = now;
+    m_LastPushState = progress.m_State;
+}
+
+void ImportTask::Run(QString FileName, int nThreads)
+{
+    // 模型在加入 ModelManager 之前只由本线程访问
+    auto pModel = std::make_shared<StructureData>();
+    Progress progress;
+
+    Input_Model importer;
+    importer.SetThreadCount(nThreads);
+    importer.SetProgressCallback([&](Input_Model::Stage stage, int64_t bytes, int64_t totalBytes)
+        {
+            progress.m_State = Input_Model::Stage::CLEANUP == stage ? State::CLEANING : State::READING;
+            progress.m_Bytes = bytes;
+            progress.m_TotalBytes = totalBytes;
+            progress.m_nNode = static_cast<int64_t>(pModel->m_Nodes.size());
+            progress.m_nElement = static_cast<int64_t>(pModel->m_Elements.size());
+            if (State::CLEANING == progress.m_State) m_State.store(static_cast<int>(State::CLEANING), std::memory_order_release);
+            Push(progress);
+            return !m_bCancel.load(std::memory_order_relaxed);
+        });
+
+    const bool bOk = importer.InputData(FileName, pModel);
+
+    State final = State::FINISHED;
+    if (m_bCancel.load(std::memory_order_relaxed)) final = State::CANCELLED;
+    else if (!bOk) final = State::FAILED;
+
+    progress.m_State = final;
+    progress.m_nNode = static_cast<int64_t>(pModel->m_Nodes.size());
+    progress.m_nElement = static_cast<int64_t>(pModel->m_Elements.size());
+    if (State::FINISHED == final)
+    {
+        progress.m_Bytes = progress.m_TotalBytes;
+        m_ModelId.store(ModelManager::Instance().AddModel(std::move(pModel)), std::memory_order_release);
+    }
+    else
+    {
+        pModel->Clear();// 未完成的模型不加入，整体释放
+    }
+
+    m_Final = progress;
+    m_State.store(static_cast<int>(final), std::memory_order_release);
+}
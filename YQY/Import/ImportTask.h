@@ -0,0 +1,128 @@
+﻿#pragma once
+#include "Utility/SpscQueue.h"
+#include <QString>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+/**
+ * @brief 后台导入任务 - 在工作线程中读取并清理模型，完成后加入 ModelManager
+ *
+ * 工作线程新建一个 StructureData 独占地读取和清理，完成后通过 ModelManager::AddModel 一次加入并设为活动模型，
+ * 其他线程不会看到读取了一半的模型。进度经单生产者单消费者无锁队列传给调用线程，
+ * 两次进度之间至少间隔 ThrottleMs 毫秒（阶段变化时立即发送），队列满时丢弃中间进度；
+ * 最终状态单独保存，不会丢失。取消是协作式的：读取过程中在下一个进度点停止，清理模型不能中断，
+ * 清理完成后不再加入模型。
+ *
+ * Start、Cancel、PollProgress 等函数只能在同一个线程（通常为 GUI 线程）中调用。
+ */
+class ImportTask
+{
+public:
+    /**
+     * @brief 任务状态
+     */
+    enum class State
+    {
+        IDLE,       ///< 未开始
+        READING,    ///< 读取文件
+        CLEANING,   ///< 清理模型
+        FINISHED,   ///< 完成，模型已加入 ModelManager
+        CANCELLED,  ///< 已取消
+        FAILED      ///< 读取失败
+    };
+
+    /**
+     * @brief 进度
+     */
+    struct Progress
+    {
+        State   m_State = State::IDLE;  ///< 状态
+        int64_t m_Bytes = 0;            ///< 已读取的字节数
+        int64_t m_TotalBytes = 0;       ///< 文件总字节数
+        int64_t m_nNode = 0;            ///< 已创建的节点数
+        int64_t m_nElement = 0;         ///< 已创建的单元数
+    };
+
+    static const int ThrottleMs = 100;  ///< 进度发送的最小间隔（毫秒）
+
+    ImportTask() : m_Channel(64) {}
+
+    /**
+     * @brief 析构时取消并等待工作线程结束
+     */
+    ~ImportTask();
+
+    ImportTask(const ImportTask&) = delete;
+    ImportTask& operator=(const ImportTask&) = delete;
+
+    /**
+     * @brief 开始导入
+     * @param [in] FileName 模型文件路径（格式同 Input_Model::InputData）
+     * @param [in] nThreads 数据块解析线程数（见 Input_Model::SetThreadCount）
+     * @return 上一次导入尚未结束时返回 false
+     */
+    bool Start(const QString& FileName, int nThreads = 0);
+
+    /**
+     * @brief 请求取消（立即返回，任务在下一个进度点停止）
+     */
+    void Cancel() { m_bCancel.store(true, std::memory_order_relaxed); }
+
+    /**
+     * @brief 取出最新进度
+     * @param [out] progress 最新进度
+     * @return 自上次调用以来有新进度返回 true
+     */
+    bool PollProgress(Progress& progress);
+
+    /**
+     * @brief 获取当前状态
+     */
+    State GetState() const { return static_cast<State>(m_State.load(std::memory_order_acquire)); }
+
+    /**
+     * @brief 是否正在导入
+     */
+    bool IsRunning() const { return State::READING == GetState() || State::CLEANING == GetState(); }
+
+    /**
+     * @brief 等待工作线程结束
+     */
+    void Wait();
+
+    /**
+     * @brief 导入完成后模型在 ModelManager 中的ID，未完成为 0
+     */
+    int GetModelId() const { return m_ModelId.load(std::memory_order_acquire); }
+
+private:
+    /**
+     * @brief 工作线程函数
+     */
+    void Run(QString FileName, int nThreads);
+
+    /**
+     * @brief 发送进度（工作线程，按 ThrottleMs 节流）
+     */
+    void Push(const Progress& progress);
+
+    std::thread m_Worker;                       ///< 工作线程
+    std::atomic<bool> m_bCancel{false};         ///< 取消请求
+    std::atomic<int> m_State{0};                ///< 当前状态（State）
+    std::atomic<int> m_ModelId{0};              ///< 加入 ModelManager 后的模型ID
+    SpscQueue<Progress> m_Channel;              ///< 进度队列（工作线程 -> 调用线程）
+    Progress m_Final;                           ///< 最终进度（在 m_State 置为结束状态之前写入）
+
+    /// @name 仅工作线程访问
+    /// @{
+    std::chrono::steady_clock::time_point m_LastPush;  ///< 上次发送时刻
+    State m_LastPushState = State::IDLE;               ///< 上次发送的状态
+    /// @}
+
+    /// @name 仅调用线程访问
+    /// @{
+    bool m_bFinalPolled = false;                ///< 最终进度是否已取出
+    /// @}
+};
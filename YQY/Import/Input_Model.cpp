@@ -1,87 +1,161 @@
 ﻿#include "Input_Model.h"
 #include "DataStructure/Structure/StructureData.h"
-#include <QRegularExpression>
+#include "DataStructure/Structure/ModelBinary.h"
+#include "Input_Nastran.h"
+#include "ModelGenerator.h"
 #include <QElapsedTimer>
+#include <algorithm>
 
-bool Input_Model::ReadLine(QTextStream& flow, QString& str)
+bool Input_Model::InputData(const QString& FileName, std::shared_ptr<StructureData> pStructure)
 {
-    while (!flow.atEnd())
+    m_Structure = pStructure;
+    m_bCancelled = false;
+    TextScanner flow;
+    if (!flow.Open(FileName))
     {
-        str = flow.readLine();
-        if (str.left(2).compare("**") == 0) continue;//注释行，继续读取下一行
-        if (str.left(2).compare("//") == 0) continue;
-
-        str = str.trimmed();                         //去除开头和末尾的空格
-        if (str.isEmpty()) continue;                 //注释行，继续读取下一行
+        qDebug() << "Error: 文件 " << FileName << " 不存在";
+        return false;
+    }
+    m_TotalBytes = flow.End() - flow.Begin();
+
+    if (ModelBinary::IsBinary(flow.Begin(), flow.End() - flow.Begin()))
+    {// 二进制模型文件：直接读取已清理的模型
+        flow.Close();
+        QElapsedTimer timer;
+        timer.start();
+        if (!ReportProgress(Stage::READ, 0)) return false;
+        if (!m_Structure->ReadBinary(FileName)) return false;
+        if (!ReportProgress(Stage::READ, m_TotalBytes)) return false;
+        qDebug().noquote() << QStringLiteral("模型读取耗时: ") << timer.elapsed() << QStringLiteral(" 毫秒");
+
+        PrintSummary();
+        return true;
+    }
 
-        return true;                                 //读取到有效数据，完成一行读取
+    if (Input_Nastran::IsNastran(flow.Begin(), flow.End()))
+    {// Nastran 批量数据文件
+        Input_Nastran nastran;
+        if (!nastran.Read(flow, *m_Structure, [this](int64_t bytes) { return ReportProgress(Stage::READ, bytes); }))
+        {// 错误信息已由 Input_Nastran 输出
+            qDebug().noquote() << (m_bCancelled ? QStringLiteral("导入已取消") : QStringLiteral("Error: Nastran 文件读取失败"));
+            return false;
+        }
+    }
+    else if (!InputKeywords(flow))
+    {
+        qDebug().noquote() << (m_bCancelled ? QStringLiteral("导入已取消") : QStringLiteral("Error: 模型文件读取失败"));
+        return false;
+    }
+    flow.Close();
+    
+    // 合并重复节点、删除重复单元、删除孤立节点、重新编号
+    if (!ReportProgress(Stage::CLEANUP, m_TotalBytes))
+    {
+        qDebug().noquote() << QStringLiteral("导入已取消");
+        return false;
     }
+    QElapsedTimer timer;
+    timer.start();
+    m_Structure->CleanupModel();
+    qint64 elapsedMs = timer.elapsed();
+    if (!ReportProgress(Stage::CLEANUP, m_TotalBytes))
+    {
+        qDebug().noquote() << QStringLiteral("导入已取消");
+        return false;
+    }
+    qDebug().noquote() << QStringLiteral("模型读取耗时: ") << elapsedMs << QStringLiteral(" 毫秒");
 
-    return false;                                    //文件读完，没有得到有效的数据行
+    PrintSummary();
+    return true;
 }
 
-bool Input_Model::InputData(const QString& FileName, std::shared_ptr<StructureData> pStructure)
+bool Input_Model::ReportProgress(Stage stage, int64_t bytes)
 {
-    m_Structure = pStructure;
-    QFile file(FileName);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-    {
-        qDebug() << "Error: 文件 " << FileName << " 不存在";
-        return false;
-    }
+    if (!m_bCancelled && m_Progress && !m_Progress(stage, bytes, m_TotalBytes)) m_bCancelled = true;
+    return !m_bCancelled;
+}
 
-    QTextStream flow(&file);
-    QString str;
-    while (ReadLine(flow, str))
+bool Input_Model::InputKeywords(TextScanner& flow)
+{
+    TextLine line;
+    while (flow.ReadLine(line))
     {
         // 预处理：判断是否是关键字行
-        if (!str.startsWith("*")) continue; // 如果不是以*开头，跳过（或者根据需求处理非关键字行）
+        if (!line.IsKeyword()) continue; // 如果不是以*开头，跳过（或者根据需求处理非关键字行）
 
-        QString cleanStr = str.mid(1); // 去掉开头的*
-        QStringList list_str = cleanStr.split(QRegularExpression("[\t, ]"), Qt::SkipEmptyParts);
+        QStringList list_str = line.KeywordFields(); // 去掉开头的*后切分
         if (list_str.isEmpty()) continue;
 
         QString keyword = list_str[0].trimmed();
         // 使用 Map 进行映射，统一转大写
         auto key = EnumKeyword::MapKeyData.value(keyword.toUpper(), EnumKeyword::KeyData::UNKNOWN);
 
+        bool bOk = true;
         switch (key)
         {
         case EnumKeyword::KeyData::NODE:
-            InputNodes(flow, list_str);
+            bOk = InputNodes(flow, list_str);
             break;
         case EnumKeyword::KeyData::ELEMENT:
-            InputElement(flow, list_str);
+            bOk = InputElement(flow, list_str);
             break;
         case EnumKeyword::KeyData::SECTION:
-            InputSection(flow, list_str);
+            bOk = InputSection(flow, list_str);
             break;
         case EnumKeyword::KeyData::MATERIAL:
-            InputMaterial(flow, list_str);
+            bOk = InputMaterial(flow, list_str);
             break;
         case EnumKeyword::KeyData::CONSTRAINT:
-            InputConstraint(flow, list_str);
+            bOk = InputConstraint(flow, list_str);
             break;
         case EnumKeyword::KeyData::LOAD:
-            InputLoad(flow, list_str);
+            bOk = InputLoad(flow, list_str);
             break;
         case EnumKeyword::KeyData::ANALYSIS_STEP:
-            InputAnalysisStep(flow, list_str);
+            bOk = InputAnalysisStep(flow, list_str);
+            break;
+        case EnumKeyword::KeyData::NGEN:
+            bOk = InputNodeLine(flow, list_str);
+            break;
+        case EnumKeyword::KeyData::GRID:
+            bOk = InputGrid(flow, list_str);
+            break;
+        case EnumKeyword::KeyData::EGEN:
+            bOk = InputElementPattern(flow, list_str);
+            break;
+        case EnumKeyword::KeyData::NSET:
+            bOk = InputSet(flow, list_str, false);
+            break;
+        case EnumKeyword::KeyData::ELSET:
+            bOk = InputSet(flow, list_str, true);
+            break;
+        case EnumKeyword::KeyData::OUTPUT:
+            bOk = InputOutput(flow, list_str);
             break;
 
         default:
             break;
         }
+
+        if (!bOk) return false;  // 错误信息已由各读取函数输出
+        if (!ReportProgress(flow)) return false;
     }
-    file.close();
-    
-    // 合并重复节点、删除重复单元、删除孤立节点、重新编号
-    QElapsedTimer timer;
-    timer.start();
-    m_Structure->CleanupModel();
-    qint64 elapsedMs = timer.elapsed();
-    qDebug().noquote() << QStringLiteral("模型读取耗时: ") << elapsedMs << QStringLiteral(" 毫秒");
+    return true;
+}
+
+bool Input_Model::ConvertToBinary(const QString& FileName, const QString& BinaryName)
+{
+    auto pStructure = std::make_shared<StructureData>();
+    Input_Model importer;
+    if (!importer.InputData(FileName, pStructure)) return false;
+    if (!pStructure->WriteBinary(BinaryName)) return false;
 
+    qDebug().noquote() << QStringLiteral("已转换为二进制模型文件: ") << BinaryName;
+    return true;
+}
+
+void Input_Model::PrintSummary()
+{
     // 输出
     if (0 != m_Structure->m_Nodes.size())
     qDebug().noquote() << QStringLiteral("\n节点数量: ") << m_Structure->m_Nodes.size();
@@ -136,55 +210,66 @@ bool Input_Model::InputData(const QString& FileName, std::shared_ptr<StructureDa
 
     if (0 != m_Structure->m_AnalysisStep.size())
     qDebug().noquote() << QStringLiteral("\n分析步数量: ") << m_Structure->m_AnalysisStep.size();
-
-    return true;
 }
 
 
-bool Input_Model::InputNodes(QTextStream& flow, const QStringList& list_str)
+bool Input_Model::InputNodes(TextScanner& flow, const QStringList& list_str)
 {
     Q_ASSERT(list_str.size() == 2);
 
     int nNode = list_str[1].toInt();
 
-    QString strdata;
-    for (int i = 0; i < nNode; i++)
-    {
-        // 读取下一行有效数据
-        if (!ReadLine(flow, strdata))
+    // 解析坐标到预分配数组（大数据块并行）
+    std::vector<double> coords(3 * static_cast<size_t>(std::max(nNode, 0)));
+    TextLine stop;
+    const int nRead = flow.ParseLines(nNode, m_nThreads, stop, [&](const TextLine& line, int i)
         {
-            qDebug().noquote() << QStringLiteral("Error: 节点数据不足");
-            exit(1);
-        }
-        
-        // 检查是否误读到下一个关键字行
-        if (strdata.startsWith("*"))
-        {
-            qDebug().noquote() << QStringLiteral("Error: 节点数据不足，遇到下一个关键字: ") << strdata;
-            exit(1);
-        }
+            if (line.Count() != 4) return false;
 
-        QStringList strlist_node = strdata.split(QRegularExpression("[\t, ]"), Qt::SkipEmptyParts);
-        if (strlist_node.size() != 4)
-        {
-            qDebug().noquote() << QStringLiteral("Error: 节点数据格式错误，需要4个字段: ") << strdata;
-            exit(1);
-        }
+            double* X = coords.data() + 3 * static_cast<size_t>(i);
+            X[0] = line.ToDouble(1);
+            X[1] = line.ToDouble(2);
+            X[2] = line.ToDouble(3);
+            return true;
+        });
 
-        double xi = strlist_node[1].toDouble();
-        double yi = strlist_node[2].toDouble();
-        double zi = strlist_node[3].toDouble();
+    // 按行的顺序入库
+    for (int i = 0; i < nRead; i++)
+    {
+        double xi = coords[3 * static_cast<size_t>(i)];
+        double yi = coords[3 * static_cast<size_t>(i) + 1];
+        double zi = coords[3 * static_cast<size_t>(i) + 2];
 
         int autoId = static_cast<int>(m_Structure->m_Nodes.size()) + 1;
 
         // 保存到模型数据库
-        auto pNode = std::make_shared<Node>();
+        auto pNode = m_Structure->Create_Object<Node>();
         pNode->m_Id = autoId;
         pNode->m_X = xi;
         pNode->m_Y = yi;
         pNode->m_Z = zi;
 
         m_Structure->m_Nodes.insert(std::make_pair(autoId, pNode));
+        m_Structure->TopologyChanged();
+
+        if (0 == (i + 1) % ProgressInterval && !ReportProgress(flow)) return false;
+    }
+
+    if (nRead < nNode)
+    {
+        if (stop.IsEmpty())
+        {
+            qDebug().noquote() << QStringLiteral("Error: 节点数据不足");
+        }
+        else if (stop.IsKeyword())
+        {// 误读到下一个关键字行
+            qDebug().noquote() << QStringLiteral("Error: 节点数据不足，遇到下一个关键字: ") << stop.ToString();
+        }
+        else
+        {
+            qDebug().noquote() << QStringLiteral("Error: 节点数据格式错误，需要4个字段: ") << stop.ToString();
+        }
+        return false;
     }
 
     //for (auto& a : m_Structure->m_Nodes)
@@ -194,7 +279,128 @@ bool Input_Model::InputNodes(QTextStream& flow, const QStringList& list_str)
     return true;
 }
 
-bool Input_Model::InputElement(QTextStream& flow, const QStringList& list_str)
+bool Input_Model::ReadDataLine(TextScanner& flow, TextLine& line, const QString& name)
+{
+    if (!flow.ReadLine(line))
+    {
+        qDebug().noquote() << QStringLiteral("Error: %1数据不够").arg(name);
+        return false;
+    }
+    if (line.IsKeyword())
+    {// 误读到下一个关键字行
+        qDebug().noquote() << QStringLiteral("Error: %1数据不足，遇到下一个关键字: ").arg(name) << line.ToString();
+        return false;
+    }
+    return true;
+}
+
+bool Input_Model::InputNodeLine(TextScanner& flow, const QStringList& list_str)
+{
+    // *NGEN, N
+    Q_ASSERT(list_str.size() == 2);
+    int nLine = list_str[1].toInt();
+
+    ModelGenerator generator(*m_Structure);
+    TextLine line;
+    for (int i = 0; i < nLine; i++)
+    {
+        if (!ReadDataLine(flow, line, QStringLiteral("*NGEN"))) return false;
+
+        // ID, X, Y, Z, DX, DY, DZ, Count
+        if (line.Count() != 8)
+        {
+            qDebug().noquote() << QStringLiteral("Error: *NGEN 数据格式错误，需要8个字段: ") << line.ToString();
+            return false;
+        }
+
+        const Vector3d X0(line.ToDouble(1), line.ToDouble(2), line.ToDouble(3));
+        const Vector3d dX(line.ToDouble(4), line.ToDouble(5), line.ToDouble(6));
+        if (0 == generator.NodeLine(X0, dX, line.ToInt(7))) return false;
+
+        if (!ReportProgress(flow)) return false;
+    }
+    return true;
+}
+
+bool Input_Model::InputGrid(TextScanner& flow, const QStringList& list_str)
+{
+    // *GRID, N
+    Q_ASSERT(list_str.size() == 2);
+    int nLine = list_str[1].toInt();
+
+    ModelGenerator generator(*m_Structure);
+    TextLine line;
+    for (int i = 0; i < nLine; i++)
+    {
+        if (!ReadDataLine(flow, line, QStringLiteral("*GRID"))) return false;
+
+        // ID, X, Y, Z, 两个或三个方向的 (DX, DY, DZ, Count)
+        const int nDirection = (line.Count() - 4) / 4;
+        if (line.Count() != 12 && line.Count() != 16)
+        {
+            qDebug().noquote() << QStringLiteral("Error: *GRID 数据格式错误，需要12或16个字段: ") << line.ToString();
+            return false;
+        }
+
+        const Vector3d X0(line.ToDouble(1), line.ToDouble(2), line.ToDouble(3));
+        Vector3d d[3] = { Vector3d::Zero(), Vector3d::Zero(), Vector3d::Zero() };
+        int count[3] = { 1, 1, 1 };
+        for (int k = 0; k < nDirection; ++k)
+        {
+            const int f = 4 + 4 * k;
+            d[k] = Vector3d(line.ToDouble(f), line.ToDouble(f + 1), line.ToDouble(f + 2));
+            count[k] = line.ToInt(f + 3);
+        }
+        if (0 == generator.Grid(X0, d, count)) return false;
+
+        if (!ReportProgress(flow)) return false;
+    }
+    return true;
+}
+
+bool Input_Model::InputElementPattern(TextScanner& flow, const QStringList& list_str)
+{
+    // *EGEN, TYPE_NAME, N
+    Q_ASSERT(list_str.size() == 3);
+
+    QString typeStr = list_str[1].trimmed().toUpper();
+    EnumKeyword::ElementType elementType = EnumKeyword::MapElementType.value(typeStr, EnumKeyword::ElementType::UNKNOWN);
+    int nLine = list_str[2].toInt();
+
+    ModelGenerator generator(*m_Structure);
+    bool bOk = true;
+    TextLine line;
+    for (int i = 0; i < nLine; i++)
+    {
+        if (!ReadDataLine(flow, line, QStringLiteral("*EGEN"))) return false;
+
+        // ID, Node1, Node2, Material, Section, 一到三个方向的 (Count, Increment)
+        const int nDirection = (line.Count() - 5) / 2;
+        if (line.Count() != 7 && line.Count() != 9 && line.Count() != 11)
+        {
+            qDebug().noquote() << QStringLiteral("Error: *EGEN 数据格式错误，需要7、9或11个字段: ") << line.ToString();
+            return false;
+        }
+
+        int count[3] = { 1, 1, 1 };
+        int inc[3] = { 0, 0, 0 };
+        for (int k = 0; k < nDirection; ++k)
+        {
+            count[k] = line.ToInt(5 + 2 * k);
+            inc[k] = line.ToInt(6 + 2 * k);
+        }
+        if (!generator.Elements(elementType, line.ToInt(1), line.ToInt(2), line.ToInt(3), line.ToInt(4), count, inc))
+        {
+            qDebug().noquote() << QStringLiteral("Error: *EGEN 单元阵列生成失败: ") << line.ToString();
+            bOk = false;
+        }
+
+        if (!ReportProgress(flow)) return false;
+    }
+    return bOk;
+}
+
+bool Input_Model::InputElement(TextScanner& flow, const QStringList& list_str)
 {
     // *ELEMENT, TYPE_NAME, N
     Q_ASSERT(list_str.size() == 3);
@@ -225,139 +431,126 @@ bool Input_Model::InputElement(QTextStream& flow, const QStringList& list_str)
 // 静态单元处理函数映射表初始化
 const QMap<EnumKeyword::ElementType, Input_Model::ElementHandler> Input_Model::s_ElementHandlers =
 {
-    { EnumKeyword::ElementType::T3D2, [](Input_Model* self, QTextStream& flow, const QStringList& list_str, int nElement) { return self->InputElementTruss(flow, list_str, nElement); } },
-    { EnumKeyword::ElementType::CABLE, [](Input_Model* self, QTextStream& flow, const QStringList& list_str, int nElement) { return self->InputElementCable(flow, list_str, nElement); } },
-    { EnumKeyword::ElementType::B31,  [](Input_Model* self, QTextStream& flow, const QStringList& list_str, int nElement) { return self->InputElementBeam(flow, list_str, nElement); } },
+    { EnumKeyword::ElementType::T3D2, [](Input_Model* self, TextScanner& flow, const QStringList& list_str, int nElement) { return self->InputElementTruss(flow, list_str, nElement); } },
+    { EnumKeyword::ElementType::CABLE, [](Input_Model* self, TextScanner& flow, const QStringList& list_str, int nElement) { return self->InputElementCable(flow, list_str, nElement); } },
+    { EnumKeyword::ElementType::B31,  [](Input_Model* self, TextScanner& flow, const QStringList& list_str, int nElement) { return self->InputElementBeam(flow, list_str, nElement); } },
 };
 
 // 桁架单元处理
-bool Input_Model::InputElementTruss(QTextStream& flow, const QStringList& /*list_str*/, int nElement)
+bool Input_Model::InputElementTruss(TextScanner& flow, const QStringList& /*list_str*/, int nElement)
 {
-    QString strdata;
-    for (int i = 0; i < nElement; i++)
-    {
-        if (!ReadLine(flow, strdata))
-        {
-            qDebug().noquote() << QStringLiteral("Error: 桁架单元数据不够");
-            return false;
-        }
-        
-        if (strdata.startsWith("*"))
-        {
-            qDebug().noquote() << QStringLiteral("Error: 桁架单元数据不足，遇到下一个关键字: ") << strdata;
-            return false;
-        }
+    return InputElementLine<ElementTruss>(flow, nElement, QStringLiteral("桁架单元"));
+}
+
+bool Input_Model::InputElementCable(TextScanner& flow, const QStringList& /*list_str*/, int nElement)
+{
+    return InputElementLine<ElementCable>(flow, nElement, QStringLiteral("索单元"));
+}
 
-        QStringList strlist_ele = strdata.split(QRegularExpression("[\t, ]"), Qt::SkipEmptyParts);
-        // ID, Node1, Node2, Material, Section (5字段)
-        if (strlist_ele.size() != 5)
+template <class T>
+bool Input_Model::InputElementLine(TextScanner& flow, int nElement, const QString& name)
+{
+    // 解析 Node1, Node2, Material, Section 到预分配数组（大数据块并行）
+    std::vector<int> fields(4 * static_cast<size_t>(std::max(nElement, 0)));
+    TextLine stop;
+    const int nRead = flow.ParseLines(nElement, m_nThreads, stop, [&](const TextLine& line, int i)
         {
-            qDebug().noquote() << QStringLiteral("Error: 桁架单元数据格式错误: ") << strdata;
-            return false;
-        }
+            // ID, Node1, Node2, Material, Section (5字段)
+            if (line.Count() != 5) return false;
+
+            int* f = fields.data() + 4 * static_cast<size_t>(i);
+            for (int k = 0; k < 4; ++k) f[k] = line.ToInt(k + 1);
+            return true;
+        });
 
+    // 按行的顺序入库，自动编号与逐行读取相同
+    bool bPropertyOk = true;
+    for (int i = 0; i < nRead; i++)
+    {
+        const int* f = fields.data() + 4 * static_cast<size_t>(i);
         int idElement = static_cast<int>(m_Structure->m_Elements.size()) + 1;
-        int idNode0 = strlist_ele[1].toInt();
-        int idNode1 = strlist_ele[2].toInt();
-        int idMaterial = strlist_ele[3].toInt();
-        int idSection = strlist_ele[4].toInt();
-
-        auto pElement_Truss = std::make_shared<ElementTruss>();
-        pElement_Truss->m_Id = idElement;
-        pElement_Truss->m_pNode[0] = m_Structure->FindNode(idNode0);
-        pElement_Truss->m_pNode[1] = m_Structure->FindNode(idNode1);
+        int idNode0 = f[0];
+        int idNode1 = f[1];
+        int idMaterial = f[2];
+        int idSection = f[3];
+
+        auto pElement = m_Structure->Create_Object<T>();
+        pElement->m_Id = idElement;
+        pElement->m_pNode[0] = m_Structure->FindNode(idNode0);
+        pElement->m_pNode[1] = m_Structure->FindNode(idNode1);
         auto Property = m_Structure->Create_Property(idMaterial, idSection);
-        pElement_Truss->m_pProperty = Property;
+        if (!Property)
+        {// 材料或截面不存在（Create_Property 已输出错误），单元仍然入库以保持编号
+            qDebug().noquote() << QStringLiteral("Error: %1 %2 没有属性").arg(name).arg(idElement);
+            bPropertyOk = false;
+        }
+        pElement->m_pProperty = Property;
 
-        m_Structure->m_Elements.insert(std::make_pair(idElement, pElement_Truss));
+        m_Structure->m_Elements.insert(std::make_pair(idElement, pElement));
+        m_Structure->TopologyChanged();
+
+        if (0 == (i + 1) % ProgressInterval && !ReportProgress(flow)) return false;
     }
-    return true;
-}
 
-bool Input_Model::InputElementCable(QTextStream& flow, const QStringList& list_str, int nElement)
-{
-    QString strdata;
-    for (int i = 0; i < nElement; i++)
+    if (nRead < nElement)
     {
-        if (!ReadLine(flow, strdata))
+        if (stop.IsEmpty())
         {
-            qDebug().noquote() << QStringLiteral("Error: 索单元数据不够");
-            return false;
+            qDebug().noquote() << QStringLiteral("Error: %1数据不够").arg(name);
         }
-
-        if (strdata.startsWith("*"))
+        else if (stop.IsKeyword())
         {
-            qDebug().noquote() << QStringLiteral("Error: 索单元数据不足，遇到下一个关键字: ") << strdata;
-            return false;
+            qDebug().noquote() << QStringLiteral("Error: %1数据不足，遇到下一个关键字: ").arg(name) << stop.ToString();
         }
-
-        QStringList strlist_ele = strdata.split(QRegularExpression("[\t, ]"), Qt::SkipEmptyParts);
-        // ID, Node1, Node2, Material, Section
-        if (strlist_ele.size() != 5)
+        else
         {
-            qDebug().noquote() << QStringLiteral("Error: 索单元数据格式错误: ") << strdata;
-            return false;
+            qDebug().noquote() << QStringLiteral("Error: %1数据格式错误: ").arg(name) << stop.ToString();
         }
-
-        int idElement = static_cast<int>(m_Structure->m_Elements.size()) + 1;
-        int idNode0 = strlist_ele[1].toInt();
-        int idNode1 = strlist_ele[2].toInt();
-        int idMaterial = strlist_ele[3].toInt();
-        int idSection = strlist_ele[4].toInt();
-
-        auto pElement_Truss = std::make_shared<ElementCable>();
-        pElement_Truss->m_Id = idElement;
-        pElement_Truss->m_pNode[0] = m_Structure->FindNode(idNode0);
-        pElement_Truss->m_pNode[1] = m_Structure->FindNode(idNode1);
-        auto Property = m_Structure->Create_Property(idMaterial, idSection);
-        pElement_Truss->m_pProperty = Property;
-
-        m_Structure->m_Elements.insert(std::make_pair(idElement, pElement_Truss));
+        return false;
     }
-    return true;
+    return bPropertyOk;
 }
 
 // 梁单元处理（待实现）
-bool Input_Model::InputElementBeam(QTextStream& flow, const QStringList& /*list_str*/, int nElement)
+bool Input_Model::InputElementBeam(TextScanner& flow, const QStringList& /*list_str*/, int nElement)
 {
     // TODO: 实现梁单元的读取逻辑
-    QString strdata;
+    TextLine line;
     for (int i = 0; i < nElement; i++)
     {
-        if (!ReadLine(flow, strdata))
+        if (!flow.ReadLine(line))
         {
             qDebug().noquote() << QStringLiteral("Error: 梁单元数据不够");
             return false;
         }
         
-        qDebug().noquote() << QStringLiteral("读取梁单元: ") << strdata;
+        qDebug().noquote() << QStringLiteral("读取梁单元: ") << line.ToString();
     }
     return true;
 }
 
-bool Input_Model::InputSection(QTextStream& flow, const QStringList& list_str)
+bool Input_Model::InputSection(TextScanner& flow, const QStringList& list_str)
 {
     Q_ASSERT(list_str.size() == 2);
     int nSection = list_str[1].toInt();
 
-    QString strdata;
+    TextLine line;
     for (int i = 0; i < nSection; i++)
     {
-        if (!ReadLine(flow, strdata))
+        if (!flow.ReadLine(line))
         {
             qDebug() << QStringLiteral("Error: 截面数据不够");
-            exit(1);
+            return false;
         }
 
-        QStringList strlist_pro = strdata.split(QRegularExpression("[\t, ]"), Qt::SkipEmptyParts);
 
-        if (strlist_pro.size() == 2)  //圆截面
+        if (line.Count() == 2)  //圆截面
         {
             int autoId = static_cast<int>(m_Structure->m_Section.size()) + 1;
             
-            auto pSection = std::make_shared<SectionCircular>();
+            auto pSection = m_Structure->Create_Object<SectionCircular>();
             pSection->m_Id = autoId;
-            pSection->m_Radius = strlist_pro[1].toDouble();
+            pSection->m_Radius = line.ToDouble(1);
             pSection->Calculate_Area();
             m_Structure->m_Section.insert(std::make_pair(autoId, pSection));
         }
@@ -367,35 +560,34 @@ bool Input_Model::InputSection(QTextStream& flow, const QStringList& list_str)
     return true;
 }
 
-bool Input_Model::InputMaterial(QTextStream& flow, const QStringList& list_str)
+bool Input_Model::InputMaterial(TextScanner& flow, const QStringList& list_str)
 {
     //读取到材料
     Q_ASSERT(list_str.size() == 2);
     int nMaterial = list_str[1].toInt();
 
-    QString strdata;
+    TextLine line;
     for (int i = 0; i < nMaterial; i++)
     {
         //继续读一行有效数据
-        if (!ReadLine(flow, strdata))
+        if (!flow.ReadLine(line))
         {//没有读取到有效数据，退出
             qDebug() << QStringLiteral("Error: 材料数据不够");
-            exit(1);
+            return false;
         }
 
-        QStringList strlist_mat = strdata.split(QRegularExpression("[\t, ]"), Qt::SkipEmptyParts);//利用空格,分解字符串
-        Q_ASSERT(strlist_mat.size() == 6);
+        Q_ASSERT(line.Count() == 6);
 
-        double  E = strlist_mat[1].toDouble();
-        double  v = strlist_mat[2].toDouble();
-        double  p = strlist_mat[3].toDouble();//密度
-        double  S = strlist_mat[4].toDouble();
-        double  e = strlist_mat[5].toDouble();
+        double  E = line.ToDouble(1);
+        double  v = line.ToDouble(2);
+        double  p = line.ToDouble(3);//密度
+        double  S = line.ToDouble(4);
+        double  e = line.ToDouble(5);
 
         int autoId = static_cast<int>(m_Structure->m_Material.size()) + 1;
 
         //保存到模型数据库
-        auto pMaterial = std::make_shared<Material>();
+        auto pMaterial = m_Structure->Create_Object<Material>();
         pMaterial->m_Id = autoId;
         pMaterial->m_Young = E;
         pMaterial->m_Poisson = v;
@@ -409,7 +601,7 @@ bool Input_Model::InputMaterial(QTextStream& flow, const QStringList& list_str)
     return true;
 }
 
-bool Input_Model::InputLoad(QTextStream& flow, const QStringList& list_str)
+bool Input_Model::InputLoad(TextScanner& flow, const QStringList& list_str)
 {
     // *LOAD, TYPE_NAME, N
     Q_ASSERT(list_str.size() == 3);
@@ -440,47 +632,46 @@ bool Input_Model::InputLoad(QTextStream& flow, const QStringList& list_str)
 // 静态荷载处理函数映射表初始化
 const QMap<EnumKeyword::LoadType, Input_Model::LoadHandler> Input_Model::s_LoadHandlers =
 {
-    { EnumKeyword::LoadType::FORCE_NODE,       [](Input_Model* self, QTextStream& flow, const QStringList& list_str, int nLoad) { return self->InputForceNode(flow, list_str, nLoad); } },
-    { EnumKeyword::LoadType::FORCE_ELEMENT,    [](Input_Model* self, QTextStream& flow, const QStringList& list_str, int nLoad) { return self->InputForceElement(flow, list_str, nLoad); } },
-    { EnumKeyword::LoadType::FORCE_GRAVITY,    [](Input_Model* self, QTextStream& flow, const QStringList& list_str, int nLoad) { return self->InputForceGravity(flow, list_str, nLoad); } },
+    { EnumKeyword::LoadType::FORCE_NODE,       [](Input_Model* self, TextScanner& flow, const QStringList& list_str, int nLoad) { return self->InputForceNode(flow, list_str, nLoad); } },
+    { EnumKeyword::LoadType::FORCE_ELEMENT,    [](Input_Model* self, TextScanner& flow, const QStringList& list_str, int nLoad) { return self->InputForceElement(flow, list_str, nLoad); } },
+    { EnumKeyword::LoadType::FORCE_GRAVITY,    [](Input_Model* self, TextScanner& flow, const QStringList& list_str, int nLoad) { return self->InputForceGravity(flow, list_str, nLoad); } },
     // 新增荷载类型只需在此添加映射
 };
 
 // 节点力荷载处理
-bool Input_Model::InputForceNode(QTextStream& flow, const QStringList& /*list_str*/, int nLoad)
+bool Input_Model::InputForceNode(TextScanner& flow, const QStringList& /*list_str*/, int nLoad)
 {
-    QString strdata;
+    TextLine line;
     for (int i = 0; i < nLoad; i++)
     {
-        if (!ReadLine(flow, strdata))
+        if (!flow.ReadLine(line))
         {
             qDebug().noquote() << QStringLiteral("Error: 节点力荷载数据不够");
             return false;
         }
         
         // 检查是否误读到下一个关键字行
-        if (strdata.startsWith("*"))
+        if (line.IsKeyword())
         {
-            qDebug().noquote() << QStringLiteral("Error: 节点力荷载数据不足，遇到下一个关键字: ") << strdata;
+            qDebug().noquote() << QStringLiteral("Error: 节点力荷载数据不足，遇到下一个关键字: ") << line.ToString();
             return false;
         }
 
-        QStringList strlist_load = strdata.split(QRegularExpression("[\\t, ]"), Qt::SkipEmptyParts);
-        // ID, NodeID, Direction, Value, StepID
-        if (strlist_load.size() != 5)
+        // ID, NodeID, Direction, Value [, StepID]
+        if (line.Count() != 4 && line.Count() != 5)
         {
-            qDebug().noquote() << QStringLiteral("Error: 节点力荷载数据格式错误: ") << strdata;
+            qDebug().noquote() << QStringLiteral("Error: 节点力荷载数据格式错误，需要4或5个字段: ") << line.ToString();
             return false;
         }
 
-        int idNode = strlist_load[1].toInt();
-        int direction = strlist_load[2].toInt();
-        double value = strlist_load[3].toDouble();
-        int stepid = strlist_load[4].toInt();
+        int idNode = line.ToInt(1);
+        int direction = line.ToInt(2);
+        double value = line.ToDouble(3);
+        int stepid = line.Count() > 4 ? line.ToInt(4) : 1;  // 缺省作用于第 1 个分析步
 
         int autoId = static_cast<int>(m_Structure->m_Load.size()) + 1;
 
-        auto pLoad = std::make_shared<Force_Node>();
+        auto pLoad = m_Structure->Create_Object<Force_Node>();
         pLoad->m_Id = autoId;
         pLoad->m_pNode = m_Structure->FindNode(idNode);
         pLoad->m_Direction = static_cast<EnumKeyword::Direction>(direction);
@@ -492,39 +683,38 @@ bool Input_Model::InputForceNode(QTextStream& flow, const QStringList& /*list_st
 }
 
 // 单元压力荷载处理
-bool Input_Model::InputForceElement(QTextStream& flow, const QStringList& /*list_str*/, int nLoad)
+bool Input_Model::InputForceElement(TextScanner& flow, const QStringList& /*list_str*/, int nLoad)
 {
-    QString strdata;
+    TextLine line;
     for (int i = 0; i < nLoad; i++)
     {
-        if (!ReadLine(flow, strdata))
+        if (!flow.ReadLine(line))
         {
             qDebug() << QStringLiteral("Error: 单元压力荷载数据不够");
             return false;
         }
 
         // 检查是否误读到下一个关键字行
-        if (strdata.startsWith("*"))
+        if (line.IsKeyword())
         {
-            qDebug().noquote() << QStringLiteral("Error: 单元力荷载数据不足，遇到下一个关键字: ") << strdata;
+            qDebug().noquote() << QStringLiteral("Error: 单元力荷载数据不足，遇到下一个关键字: ") << line.ToString();
             return false;
         }
 
-        QStringList strlist_load = strdata.split(QRegularExpression("[\\t, ]"), Qt::SkipEmptyParts);
         // ID, EelmentID, Direction, Value
-        if (strlist_load.size() != 4)
+        if (line.Count() != 4)
         {
-            qDebug().noquote() << QStringLiteral("Error: 单元力荷载数据格式错误: ") << strdata;
+            qDebug().noquote() << QStringLiteral("Error: 单元力荷载数据格式错误: ") << line.ToString();
             return false;
         }
 
-        int idElement = strlist_load[1].toInt();
-        int direction = strlist_load[2].toInt();
-        double value = strlist_load[3].toDouble();
+        int idElement = line.ToInt(1);
+        int direction = line.ToInt(2);
+        double value = line.ToDouble(3);
 
         int autoId = static_cast<int>(m_Structure->m_Load.size()) + 1;
 
-        auto pLoad = std::make_shared<Force_Element>();
+        auto pLoad = m_Structure->Create_Object<Force_Element>();
         pLoad->m_Id = autoId;
         pLoad->m_pElement = m_Structure->FindElement(idElement);
 
@@ -535,39 +725,38 @@ bool Input_Model::InputForceElement(QTextStream& flow, const QStringList& /*list
     return true;
 }
 
-bool Input_Model::InputForceGravity(QTextStream& flow, const QStringList& list_str, int nLoad)
+bool Input_Model::InputForceGravity(TextScanner& flow, const QStringList& list_str, int nLoad)
 {
-    QString strdata;
+    TextLine line;
     for (int i = 0; i < nLoad; i++)
     {
-        if (!ReadLine(flow, strdata))
+        if (!flow.ReadLine(line))
         {
             qDebug() << QStringLiteral("Error: 单元重力数据不够");
             return false;
         }
 
         // 检查是否误读到下一个关键字行
-        if (strdata.startsWith("*"))
+        if (line.IsKeyword())
         {
-            qDebug().noquote() << QStringLiteral("Error: 单元重力数据不足，遇到下一个关键字: ") << strdata;
+            qDebug().noquote() << QStringLiteral("Error: 单元重力数据不足，遇到下一个关键字: ") << line.ToString();
             return false;
         }
 
-        QStringList strlist_load = strdata.split(QRegularExpression("[\\t, ]"), Qt::SkipEmptyParts);
         // ID, Direction, Value, StepID
-        if (strlist_load.size() != 4)
+        if (line.Count() != 4)
         {
-            qDebug().noquote() << QStringLiteral("Error: 单元重力数据格式错误: ") << strdata;
+            qDebug().noquote() << QStringLiteral("Error: 单元重力数据格式错误: ") << line.ToString();
             return false;
         }
 
-        g_Direction = strlist_load[1].toInt();
-        double value = strlist_load[2].toDouble();
-        int stepid = strlist_load[3].toInt();
+        g_Direction = line.ToInt(1);
+        double value = line.ToDouble(2);
+        int stepid = line.ToInt(3);
 
         int autoId = static_cast<int>(m_Structure->m_Load.size()) + 1;
 
-        auto pLoad = std::make_shared<Force_Gravity>();
+        auto pLoad = m_Structure->Create_Object<Force_Gravity>();
         pLoad->m_Id = autoId;
 
         pLoad->m_Direction = static_cast<EnumKeyword::Direction>(g_Direction);
@@ -581,30 +770,29 @@ bool Input_Model::InputForceGravity(QTextStream& flow, const QStringList& list_s
     return true;
 }
 
-bool Input_Model::InputConstraint(QTextStream& flow, const QStringList& list_str)
+bool Input_Model::InputConstraint(TextScanner& flow, const QStringList& list_str)
 {
     Q_ASSERT(list_str.size() == 2);
     int nConstraint = list_str[1].toInt();
 
-    QString strdata;
+    TextLine line;
     for (int i = 0; i < nConstraint; i++)
     {
-        if (!ReadLine(flow, strdata))
+        if (!flow.ReadLine(line))
         {//没有读取到有效数据，退出
             qDebug() << QStringLiteral("Error: 约束数据不够");
-            exit(1);
+            return false;
         }
 
-        QStringList strlist_con = strdata.split(QRegularExpression("[\t, ]"), Qt::SkipEmptyParts);//利用空格,分解字符串
-        Q_ASSERT(strlist_con.size() == 4);
+        Q_ASSERT(line.Count() == 4);
 
-        int idNode = strlist_con[1].toInt();
-        auto  direaction = strlist_con[2].toInt();
-        double  value = strlist_con[3].toDouble();
+        int idNode = line.ToInt(1);
+        auto  direaction = line.ToInt(2);
+        double  value = line.ToDouble(3);
 
         int autoId = static_cast<int>(m_Structure->m_Constraint.size()) + 1;
 
-        auto pConstraint = std::make_shared<Constraint>();
+        auto pConstraint = m_Structure->Create_Object<Constraint>();
         pConstraint->m_Id = autoId;
         pConstraint->m_pNode = m_Structure->FindNode(idNode);
         pConstraint->m_Direction = static_cast<EnumKeyword::Direction>(direaction);
@@ -615,25 +803,153 @@ bool Input_Model::InputConstraint(QTextStream& flow, const QStringList& list_str
     return true;
 }
 
-bool Input_Model::InputElement_Stress(QTextStream& flow, const QStringList& list_str)
+bool Input_Model::InputSet(TextScanner& flow, const QStringList& list_str, bool bElement)
+{
+    // *NSET, NAME, N 或 *ELSET, NAME, N
+    const QString keyword = bElement ? QStringLiteral("*ELSET") : QStringLiteral("*NSET");
+    if (list_str.size() != 3)
+    {
+        qDebug().noquote() << QStringLiteral("Error: %1 需要集合名称和行数").arg(keyword);
+        return false;
+    }
+    QString name = list_str[1].trimmed();
+    int nLine = list_str[2].toInt();
+
+    std::vector<int> ids;
+    TextLine line;
+    for (int i = 0; i < nLine; i++)
+    {
+        if (!ReadDataLine(flow, line, keyword)) return false;
+
+        // ID, First [, Last [, Increment]]
+        if (line.Count() < 2 || line.Count() > 4)
+        {
+            qDebug().noquote() << QStringLiteral("Error: %1 数据格式错误，需要2~4个字段: ").arg(keyword) << line.ToString();
+            return false;
+        }
+
+        const int first = line.ToInt(1);
+        const int last = line.Count() > 2 ? line.ToInt(2) : first;
+        const int increment = line.Count() > 3 ? line.ToInt(3) : 1;
+        if (last < first || increment <= 0)
+        {
+            qDebug().noquote() << QStringLiteral("Error: %1 ID范围无效: ").arg(keyword) << line.ToString();
+            return false;
+        }
+        for (int64_t id = first; id <= last; id += increment) ids.push_back(static_cast<int>(id));
+    }
+
+    if (bElement) m_Structure->GetOutputter().AddElementSet(name, ids);
+    else m_Structure->GetOutputter().AddNodeSet(name, ids);
+    return true;
+}
+
+bool Input_Model::InputOutput(TextScanner& flow, const QStringList& list_str)
+{
+    // *OUTPUT, FIELD|HISTORY, N
+    if (list_str.size() != 3)
+    {
+        qDebug().noquote() << QStringLiteral("Error: *OUTPUT 需要输出类别和行数");
+        return false;
+    }
+    QString kindStr = list_str[1].trimmed().toUpper();
+    if (kindStr != "FIELD" && kindStr != "HISTORY")
+    {
+        qDebug().noquote() << QStringLiteral("Error: 未知的输出类别: ") << kindStr;
+        return false;
+    }
+    int nLine = list_str[2].toInt();
+
+    TextLine line;
+    for (int i = 0; i < nLine; i++)
+    {
+        if (!ReadDataLine(flow, line, QStringLiteral("*OUTPUT"))) return false;
+
+        // ID, StepID, Set, Frequency, Interval, Variable...
+        if (line.Count() < 6)
+        {
+            qDebug().noquote() << QStringLiteral("Error: *OUTPUT 数据格式错误，至少需要6个字段: ") << line.ToString();
+            return false;
+        }
+
+        OutputRequest request;
+        request.m_Id = static_cast<int>(m_Structure->GetOutputter().GetRequests().size()) + 1;
+        request.m_Kind = (kindStr == "FIELD") ? OutputRequest::Kind::FIELD : OutputRequest::Kind::HISTORY;
+        request.m_StepId = line.ToInt(1);
+
+        QString setName = line.ToText(2).toUpper();
+        if (setName != "ALL") request.m_SetName = setName;
+
+        QString frequency = line.ToText(3).toUpper();
+        if (frequency == "INC")
+        {
+            request.m_Frequency = OutputRequest::Frequency::INCREMENT;
+            request.m_Interval = line.ToInt(4);
+        }
+        else if (frequency == "TIME")
+        {
+            request.m_Frequency = OutputRequest::Frequency::TIME;
+            request.m_TimeInterval = line.ToDouble(4);
+        }
+        else if (frequency == "LAST")
+        {
+            request.m_Frequency = OutputRequest::Frequency::LAST;
+        }
+        else
+        {
+            qDebug().noquote() << QStringLiteral("Error: 未知的输出频率（INC、TIME、LAST）: ") << line.ToString();
+            return false;
+        }
+        if ((OutputRequest::Frequency::INCREMENT == request.m_Frequency && request.m_Interval <= 0) ||
+            (OutputRequest::Frequency::TIME == request.m_Frequency && request.m_TimeInterval <= 0.0))
+        {
+            qDebug().noquote() << QStringLiteral("Error: 输出间隔必须大于 0: ") << line.ToString();
+            return false;
+        }
+
+        for (int k = 5; k < line.Count(); ++k)
+        {
+            if (!OutputRequest::ParseVariable(line.ToText(k), request.m_Types))
+            {
+                qDebug().noquote() << QStringLiteral("Error: 未知的输出量: ") << line.ToText(k);
+                return false;
+            }
+        }
+
+        // 一个请求只输出节点量或只输出单元量
+        request.m_bElement = IsElementDataType(request.m_Types.front());
+        for (DataType type : request.m_Types)
+        {
+            if (IsElementDataType(type) != request.m_bElement)
+            {
+                qDebug().noquote() << QStringLiteral("Error: 同一输出请求不能同时包含节点量和单元量: ") << line.ToString();
+                return false;
+            }
+        }
+
+        m_Structure->GetOutputter().AddRequest(request);
+    }
+    return true;
+}
+
+bool Input_Model::InputElement_Stress(TextScanner& flow, const QStringList& list_str)
 {
     Q_ASSERT(list_str.size() == 2);
     int nStress = list_str[1].toInt();
 
-    QString strdata;
+    TextLine line;
     for (int i = 0; i < nStress; i++)
     {
-        if (!ReadLine(flow, strdata))
+        if (!flow.ReadLine(line))
         {//没有读取到有效数据，退出
             qDebug() << QStringLiteral("Error: 单元应力数据不够");
-            exit(1);
+            return false;
         }
 
-        QStringList strlist_con = strdata.split(QRegularExpression("[\t, ]"), Qt::SkipEmptyParts);//利用空格,分解字符串
-        Q_ASSERT(strlist_con.size() == 2);
+        Q_ASSERT(line.Count() == 2);
 
-        int idElement = strlist_con[0].toInt();
-        double stress = strlist_con[1].toDouble();
+        int idElement = line.ToInt(0);
+        double stress = line.ToDouble(1);
 
         auto pElement = m_Structure->FindElement(idElement);
         if (pElement)
@@ -645,51 +961,54 @@ bool Input_Model::InputElement_Stress(QTextStream& flow, const QStringList& list
     return true;
 }
 
-bool Input_Model::InputAnalysisStep(QTextStream& flow, const QStringList& list_str)
+bool Input_Model::InputAnalysisStep(TextScanner& flow, const QStringList& list_str)
 {
     // *ANALYSIS_STEP, N
     Q_ASSERT(list_str.size() == 2);
     int nStep = list_str[1].toInt();
 
-    QString strdata;
+    TextLine line;
     for (int i = 0; i < nStep; ++i)
     {
-        if (!ReadLine(flow, strdata))
+        if (!flow.ReadLine(line))
         {
             qDebug().noquote() << QStringLiteral("Error: 分析步数据不够");
-            exit(1);
+            return false;
         }
         
         // 检查是否误读到下一个关键字行
-        if (strdata.startsWith("*"))
+        if (line.IsKeyword())
         {
-            qDebug().noquote() << QStringLiteral("Error: 分析步数据不足，遇到下一个关键字: ") << strdata;
-            exit(1);
+            qDebug().noquote() << QStringLiteral("Error: 分析步数据不足，遇到下一个关键字: ") << line.ToString();
+            return false;
         }
 
-        QStringList strlist_step = strdata.split(QRegularExpression("[\t, ]"), Qt::SkipEmptyParts);
-        // ID, Type, Time, StepSize, Tolerance, MaxIterations 
-        if (strlist_step.size() != 6)
+        // ID, Type, Time, StepSize, Tolerance, MaxIterations [, nModes [, DampingRatio [, EigenTolerance [, EigenMaxIterations]]]]
+        if (line.Count() < 6 || line.Count() > 10)
         {
-            qDebug().noquote() << QStringLiteral("Error: 分析步数据格式错误，需要6个字段: ") << strdata;
-            exit(1);
+            qDebug().noquote() << QStringLiteral("Error: 分析步数据格式错误，需要6~10个字段: ") << line.ToString();
+            return false;
         }
 
-        QString typeStr       = strlist_step[1].toUpper();
-        double  time          = strlist_step[2].toDouble();
-        double  stepSize      = strlist_step[3].toDouble();
-        double  tolerance     = strlist_step[4].toDouble();
-        int     maxIterations = strlist_step[5].toInt();
+        QString typeStr       = line.ToText(1).toUpper();
+        double  time          = line.ToDouble(2);
+        double  stepSize      = line.ToDouble(3);
+        double  tolerance     = line.ToDouble(4);
+        int     maxIterations = line.ToInt(5);
 
         int autoId = static_cast<int>(m_Structure->m_AnalysisStep.size()) + 1;
 
-        auto pStep = std::make_shared<AnalysisStep>();
+        auto pStep = m_Structure->Create_Object<AnalysisStep>();
         pStep->m_Id = autoId;
         pStep->m_Type = EnumKeyword::MapStepType.value(typeStr, EnumKeyword::StepType::UNKNOWN);
         pStep->m_Time = time;
         pStep->m_StepSize = stepSize;
         pStep->m_Tolerance = tolerance;
         pStep->m_MaxIterations = maxIterations;
+        if (line.Count() > 6) pStep->m_nModes = line.ToInt(6);
+        if (line.Count() > 7) pStep->m_DampingRatio = line.ToDouble(7);
+        if (line.Count() > 8) pStep->m_EigenTolerance = line.ToDouble(8);
+        if (line.Count() > 9) pStep->m_EigenMaxIterations = line.ToInt(9);
 
         m_Structure->m_AnalysisStep.insert(std::make_pair(autoId, pStep));
     }
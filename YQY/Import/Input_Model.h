@@ -1,7 +1,6 @@
 ﻿#pragma once
 #include "Base/Base.h"
-#include <QTextStream>
-#include <QFile>
+#include "TextScanner.h"
 #include <functional>
 
 class StructureData;
@@ -15,152 +14,276 @@ private:
 	int g_Direction;
 public:
 	/**
-	 * @brief 读取一行有效数据（跳过注释和空行）
-	 * @param [in] flow 文本流
-	 * @param [out] str 读取到的字符串
-	 * @return 成功返回 true，到达文件末尾返回 false
-	 */
-	bool ReadLine(QTextStream& flow, QString& str);
-
-	/**
-	 * @brief 读取模型数据文件
+	 * @brief 读取模型数据文件（关键字格式、Nastran 批量数据或二进制模型文件，按内容识别）
 	 * @param [in] FileName 文件路径
 	 * @param [in] pStructure 结构数据对象
 	 * @return 读取成功返回 true
 	 */
 	bool InputData(const QString& FileName, std::shared_ptr<StructureData> pStructure);
 
+	/**
+	 * @brief 将文本模型文件读取、清理后转换为二进制模型文件
+	 * @param [in] FileName 文本模型文件路径
+	 * @param [in] BinaryName 二进制模型文件路径
+	 * @return 转换成功返回 true
+	 *
+	 * InputData 遇到二进制模型文件（以文件头识别）时直接读取，不再解析和清理；
+	 * 此时结构数据先被清空，而读取文本文件是追加到已有数据中。
+	 */
+	static bool ConvertToBinary(const QString& FileName, const QString& BinaryName);
+
+	/**
+	 * @brief 设置 *NODE、*ELEMENT 数据块的解析线程数
+	 * @param [in] nThreads 线程数，0 为硬件线程数，1 为逐行串行读取
+	 *
+	 * 数据块足够大时先定位行边界，再分块并行解析到预分配的数组，最后按行的顺序入库，
+	 * 自动编号与串行读取相同。
+	 */
+	void SetThreadCount(int nThreads) { m_nThreads = nThreads; }
+
+	/**
+	 * @brief 导入阶段
+	 */
+	enum class Stage
+	{
+		READ,     ///< 读取文件
+		CLEANUP   ///< 清理模型
+	};
+
+	/**
+	 * @brief 进度回调：参数为阶段、已读取的字节数和文件总字节数，返回 false 表示取消导入
+	 *
+	 * 在调用 InputData 的线程中调用：每个关键字数据块之后、大数据块入库时每 ProgressInterval 个对象、
+	 * 清理模型前后各一次。取消后 InputData 尽快返回 false，结构数据中为已读取的部分；清理模型本身不能中断。
+	 */
+	using ProgressCallback = std::function<bool(Stage stage, int64_t bytes, int64_t totalBytes)>;
+
+	/**
+	 * @brief 设置进度回调（为空时不报告进度）
+	 */
+	void SetProgressCallback(ProgressCallback callback) { m_Progress = std::move(callback); }
+
+	static const int ProgressInterval = 65536;  ///< 大数据块入库时报告进度的间隔（对象个数）
+
 private:
 	std::shared_ptr<StructureData> m_Structure;  ///< 结构数据指针
+	int m_nThreads = 0;                          ///< 数据块解析线程数（0 为硬件线程数）
+	ProgressCallback m_Progress;                 ///< 进度回调
+	bool m_bCancelled = false;                   ///< 是否已取消
+	int64_t m_TotalBytes = 0;                    ///< 文件总字节数
+
+	/**
+	 * @brief 报告进度
+	 * @return 已取消返回 false
+	 */
+	bool ReportProgress(Stage stage, int64_t bytes);
+
+	/**
+	 * @brief 按扫描器的读取位置报告读取进度
+	 * @return 已取消返回 false
+	 */
+	bool ReportProgress(const TextScanner& flow) { return ReportProgress(Stage::READ, flow.Position() - flow.Begin()); }
+
+	/**
+	 * @brief 输出读取结果的统计信息
+	 */
+	void PrintSummary();
+
+	/**
+	 * @brief 读取关键字格式（*NODE、*ELEMENT 等）的文件内容
+	 * @param [in] flow 文本扫描器
+	 * @return 成功返回 true；数据格式错误或被取消时返回 false（停在出错的关键字）
+	 */
+	bool InputKeywords(TextScanner& flow);
 
 	/**
 	 * @brief 读取节点数据
-	 * @param [in] flow 文本流
+	 * @param [in] flow 文本扫描器
 	 * @param [in] list_str 关键字行解析后的字符串列表
 	 * @return 读取成功返回 true
 	 */
-	bool InputNodes(QTextStream& flow, const QStringList& list_str);
+	bool InputNodes(TextScanner& flow, const QStringList& list_str);
 
 	/**
 	 * @brief 读取单元数据（分发到具体单元处理函数）
-	 * @param [in] flow 文本流
+	 * @param [in] flow 文本扫描器
+	 * @param [in] list_str 关键字行解析后的字符串列表
+	 * @return 读取成功返回 true
+	 */
+	bool InputElement(TextScanner& flow, const QStringList& list_str);
+
+	/**
+	 * @brief 读取 *NGEN：每行生成一行等间距节点
+	 * @param [in] flow 文本扫描器
+	 * @param [in] list_str 关键字行解析后的字符串列表
+	 * @return 读取成功返回 true
+	 */
+	bool InputNodeLine(TextScanner& flow, const QStringList& list_str);
+
+	/**
+	 * @brief 读取 *GRID：每行生成一个二维或三维节点网格
+	 * @param [in] flow 文本扫描器
+	 * @param [in] list_str 关键字行解析后的字符串列表
+	 * @return 读取成功返回 true
+	 */
+	bool InputGrid(TextScanner& flow, const QStringList& list_str);
+
+	/**
+	 * @brief 读取 *EGEN：每行生成一个单元阵列
+	 * @param [in] flow 文本扫描器
+	 * @param [in] list_str 关键字行解析后的字符串列表
+	 * @return 读取成功返回 true
+	 */
+	bool InputElementPattern(TextScanner& flow, const QStringList& list_str);
+
+	/**
+	 * @brief 读取 *NSET 或 *ELSET：节点或单元集合
+	 * @param [in] flow 文本扫描器
+	 * @param [in] list_str 关键字行解析后的字符串列表
+	 * @param [in] bElement 是否为单元集合
+	 * @return 读取成功返回 true
+	 */
+	bool InputSet(TextScanner& flow, const QStringList& list_str, bool bElement);
+
+	/**
+	 * @brief 读取 *OUTPUT：场输出或历史输出请求
+	 * @param [in] flow 文本扫描器
 	 * @param [in] list_str 关键字行解析后的字符串列表
 	 * @return 读取成功返回 true
 	 */
-	bool InputElement(QTextStream& flow, const QStringList& list_str);
+	bool InputOutput(TextScanner& flow, const QStringList& list_str);
+
+	/**
+	 * @brief 读取数据块的一行数据
+	 * @param [in] flow 文本扫描器
+	 * @param [out] line 数据行
+	 * @param [in] name 关键字名称（用于错误信息）
+	 * @return 读到数据行返回 true，数据不足或遇到下一个关键字时输出错误信息并返回 false
+	 */
+	bool ReadDataLine(TextScanner& flow, TextLine& line, const QString& name);
 
 	/// @name 单元处理函数映射
 	/// @{
-	using ElementHandler = std::function<bool(Input_Model*, QTextStream&, const QStringList&, int)>;
+	using ElementHandler = std::function<bool(Input_Model*, TextScanner&, const QStringList&, int)>;
 	static const QMap<EnumKeyword::ElementType, ElementHandler> s_ElementHandlers;  ///< 单元类型到处理函数的映射表
 	
 	/**
 	 * @brief 读取桁架单元数据
-	 * @param [in] flow 文本流
+	 * @param [in] flow 文本扫描器
 	 * @param [in] list_str 关键字行解析后的字符串列表
 	 * @param [in] nElement 单元数量
 	 * @return 读取成功返回 true
 	 */
-	bool InputElementTruss(QTextStream& flow, const QStringList& list_str, int nElement);
+	bool InputElementTruss(TextScanner& flow, const QStringList& list_str, int nElement);
 
 	/**
 	 * @brief 读取索单元数据
-	 * @param [in] flow 文本流
+	 * @param [in] flow 文本扫描器
 	 * @param [in] list_str 关键字行解析后的字符串列表
 	 * @param [in] nElement 单元数量
 	 * @return 读取成功返回 true
 	 */
-	bool InputElementCable(QTextStream& flow, const QStringList& list_str, int nElement);
+	bool InputElementCable(TextScanner& flow, const QStringList& list_str, int nElement);
 
 	/**
 	 * @brief 读取梁单元数据
-	 * @param [in] flow 文本流
+	 * @param [in] flow 文本扫描器
 	 * @param [in] list_str 关键字行解析后的字符串列表
 	 * @param [in] nElement 单元数量
 	 * @return 读取成功返回 true
 	 */
-	bool InputElementBeam(QTextStream& flow, const QStringList& list_str, int nElement);
+	bool InputElementBeam(TextScanner& flow, const QStringList& list_str, int nElement);
+
+	/**
+	 * @brief 读取两节点线单元（桁架、索）数据
+	 * @param [in] flow 文本扫描器
+	 * @param [in] nElement 单元数量
+	 * @param [in] name 单元名称（用于错误信息）
+	 * @return 读取成功返回 true
+	 */
+	template <class T>
+	bool InputElementLine(TextScanner& flow, int nElement, const QString& name);
 	/// @}
 
 	/**
 	 * @brief 读取截面数据
-	 * @param [in] flow 文本流
+	 * @param [in] flow 文本扫描器
 	 * @param [in] list_str 关键字行解析后的字符串列表
 	 * @return 读取成功返回 true
 	 */
-	bool InputSection(QTextStream& flow, const QStringList& list_str);
+	bool InputSection(TextScanner& flow, const QStringList& list_str);
 
 	/**
 	 * @brief 读取材料数据
-	 * @param [in] flow 文本流
+	 * @param [in] flow 文本扫描器
 	 * @param [in] list_str 关键字行解析后的字符串列表
 	 * @return 读取成功返回 true
 	 */
-	bool InputMaterial(QTextStream& flow, const QStringList& list_str);
+	bool InputMaterial(TextScanner& flow, const QStringList& list_str);
 
 	/**
 	 * @brief 读取分析步数据
-	 * @param [in] flow 文本流
+	 * @param [in] flow 文本扫描器
 	 * @param [in] list_str 关键字行解析后的字符串列表
 	 * @return 读取成功返回 true
 	 */
-	bool InputAnalysisStep(QTextStream& flow, const QStringList& list_str);
+	bool InputAnalysisStep(TextScanner& flow, const QStringList& list_str);
 
 	/// @name 荷载处理函数映射
 	/// @{
 	/**
 	 * @brief 读取荷载数据（分发到具体荷载处理函数）
-	 * @param [in] flow 文本流
+	 * @param [in] flow 文本扫描器
 	 * @param [in] list_str 关键字行解析后的字符串列表
 	 * @return 读取成功返回 true
 	 */
-	bool InputLoad(QTextStream& flow, const QStringList& list_str);
+	bool InputLoad(TextScanner& flow, const QStringList& list_str);
 
-	using LoadHandler = std::function<bool(Input_Model*, QTextStream&, const QStringList&, int)>;
+	using LoadHandler = std::function<bool(Input_Model*, TextScanner&, const QStringList&, int)>;
 	static const QMap<EnumKeyword::LoadType, LoadHandler> s_LoadHandlers;  ///< 荷载类型到处理函数的映射表
 
 	/**
 	 * @brief 读取节点力荷载数据
-	 * @param [in] flow 文本流
+	 * @param [in] flow 文本扫描器
 	 * @param [in] list_str 关键字行解析后的字符串列表
 	 * @param [in] nLoad 荷载数量
 	 * @return 读取成功返回 true
 	 */
-	bool InputForceNode(QTextStream& flow, const QStringList& list_str, int nLoad);
+	bool InputForceNode(TextScanner& flow, const QStringList& list_str, int nLoad);
 
 	/**
 	 * @brief 读取单元荷载数据
-	 * @param [in] flow 文本流
+	 * @param [in] flow 文本扫描器
 	 * @param [in] list_str 关键字行解析后的字符串列表
 	 * @param [in] nLoad 荷载数量
 	 * @return 读取成功返回 true
 	 */
-	bool InputForceElement(QTextStream& flow, const QStringList& list_str, int nLoad);
+	bool InputForceElement(TextScanner& flow, const QStringList& list_str, int nLoad);
 
 	/**
 	 * @brief 读取重力数据
-	 * @param [in] flow 文本流
+	 * @param [in] flow 文本扫描器
 	 * @param [in] list_str 关键字行解析后的字符串列表
 	 * @param [in] nLoad 荷载数量
 	 * @return 读取成功返回 true
 	 */
-	bool InputForceGravity(QTextStream& flow, const QStringList& list_str, int nLoad);
+	bool InputForceGravity(TextScanner& flow, const QStringList& list_str, int nLoad);
 
 	/**
 	 * @brief 读取约束数据
-	 * @param [in] flow 文本流
+	 * @param [in] flow 文本扫描器
 	 * @param [in] list_str 关键字行解析后的字符串列表
 	 * @return 读取成功返回 true
 	 */
-	bool InputConstraint(QTextStream& flow, const QStringList& list_str);
+	bool InputConstraint(TextScanner& flow, const QStringList& list_str);
 
 	/**
 	 * @brief 读取单元应力
-	 * @param [in] flow 文本流
+	 * @param [in] flow 文本扫描器
 	 * @param [in] list_str 关键字行解析后的字符串列表
 	 * @return 读取成功返回 true
 	 */
-	bool InputElement_Stress(QTextStream& flow, const QStringList& list_str);
+	bool InputElement_Stress(TextScanner& flow, const QStringList& list_str);
 
 
 };
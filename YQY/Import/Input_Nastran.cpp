@@ -0,0 +1,827 @@
+﻿#include "Input_Nastran.h"
+#include "DataStructure/Structure/StructureData.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <unordered_set>
+
+namespace
+{
+    const int SmallWidth = 8;    ///< 小字段宽度
+    const int LargeWidth = 16;   ///< 大字段宽度
+    const int MaxIsNastranLines = 64;  ///< 识别文件格式时最多检查的有效行数
+
+    inline bool IsSpace(char c) { return ' ' == c || ('\t' <= c && c <= '\r'); }
+
+    inline std::string_view Trim(std::string_view text)
+    {
+        while (!text.empty() && IsSpace(text.front())) text.remove_prefix(1);
+        while (!text.empty() && IsSpace(text.back())) text.remove_suffix(1);
+        return text;
+    }
+
+    inline bool StartsWithNoCase(std::string_view text, const char* prefix)
+    {
+        const size_t n = std::strlen(prefix);
+        if (text.size() < n) return false;
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (std::toupper(static_cast<unsigned char>(text[i])) != prefix[i]) return false;
+        }
+        return true;
+    }
+
+    // 去除 $ 注释和行尾空白，返回是否还有内容
+    inline bool StripLine(const char* begin, const char*& end)
+    {
+        const char* dollar = static_cast<const char*>(std::memchr(begin, '$', end - begin));
+        if (dollar) end = dollar;
+        while (end > begin && IsSpace(end[-1])) --end;
+        return begin != end;
+    }
+
+    // 卡片名字段：自由字段为第一个逗号之前，固定字段为第 1~8 列
+    inline std::string_view LineName(const char* begin, const char* end, bool bFree)
+    {
+        if (bFree)
+        {
+            const char* comma = static_cast<const char*>(std::memchr(begin, ',', end - begin));
+            return Trim(std::string_view(begin, comma - begin));
+        }
+        return Trim(std::string_view(begin, std::min<size_t>(end - begin, SmallWidth)));
+    }
+
+    // 续行的名称字段为空或以 +、* 开头
+    inline bool IsContinuation(std::string_view name)
+    {
+        return name.empty() || '+' == name[0] || '*' == name[0];
+    }
+
+    // 大写的卡片名（去掉大字段标记 *）
+    inline std::string CardName(std::string_view name, bool& bLarge)
+    {
+        bLarge = !name.empty() && '*' == name.back();
+        if (bLarge) name.remove_suffix(1);
+
+        std::string upper(name);
+        for (char& c : upper) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        return upper;
+    }
+
+    inline bool ParseInt(std::string_view text, int& value)
+    {
+        if (text.size() > 1 && '+' == text[0]) text.remove_prefix(1);
+        auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+        return result.ec == std::errc() && result.ptr == text.data() + text.size();
+    }
+
+    // Nastran 实数：指数可写作 D，或省略 E（1.0+3、-2.5-4）
+    inline bool ParseReal(std::string_view text, double& value)
+    {
+        char buffer[96];
+        if (text.size() > 40) return false;
+
+        size_t n = 0;
+        for (size_t i = 0; i < text.size(); ++i)
+        {
+            char c = text[i];
+            if ('d' == c || 'D' == c) c = 'E';
+            if (('+' == c || '-' == c) && i > 0)
+            {
+                const char prev = static_cast<char>(std::toupper(static_cast<unsigned char>(text[i - 1])));
+                if ('E' != prev && 'D' != prev) buffer[n++] = 'E';
+            }
+            buffer[n++] = c;
+        }
+
+        const char* first = buffer;
+        if (n > 1 && '+' == buffer[0]) ++first;
+        auto result = std::from_chars(first, buffer + n, value);
+        return result.ec == std::errc() && result.ptr == buffer + n;
+    }
+
+    // 执行控制和文件管理语句（出现在 BEGIN BULK 之前）
+    inline bool IsExecutive(std::string_view line)
+    {
+        static const char* const statements[] = { "SOL ", "SOL,", "CEND", "BEGIN", "ID ", "TIME ", "NASTRAN", "INIT ", "ASSIGN", "DIAG " };
+        for (const char* statement : statements)
+        {
+            if (StartsWithNoCase(line, statement)) return true;
+        }
+        return false;
+    }
+
+    // 记录出现过的集号
+    inline void AddSet(std::vector<int>& sets, int sid)
+    {
+        if (std::find(sets.begin(), sets.end(), sid) == sets.end()) sets.push_back(sid);
+    }
+}
+
+// 静态卡片处理函数映射表初始化
+const std::unordered_map<std::string, Input_Nastran::CardHandler> Input_Nastran::s_CardHandlers =
+{
+    { "GRID",   &Input_Nastran::InputGrid },
+    { "CROD",   &Input_Nastran::InputCrod },
+    { "CONROD", &Input_Nastran::InputConrod },
+    { "CBAR",   &Input_Nastran::InputCbar },
+    { "CBEAM",  &Input_Nastran::InputCbar },
+    { "PROD",   &Input_Nastran::InputProd },
+    { "PBAR",   &Input_Nastran::InputPbar },
+    { "PBEAM",  &Input_Nastran::InputPbar },
+    { "MAT1",   &Input_Nastran::InputMat1 },
+    { "SPC",    &Input_Nastran::InputSpc },
+    { "SPC1",   &Input_Nastran::InputSpc1 },
+    { "FORCE",  &Input_Nastran::InputForce },
+    { "GRAV",   &Input_Nastran::InputGrav },
+};
+
+bool Input_Nastran::Card::Int(int i, int& value, int def) const
+{
+    std::string_view field = Field(i);
+    if (field.empty())
+    {
+        value = def;
+        return true;
+    }
+    return ParseInt(field, value);
+}
+
+bool Input_Nastran::Card::Real(int i, double& value, double def) const
+{
+    std::string_view field = Field(i);
+    if (field.empty())
+    {
+        value = def;
+        return true;
+    }
+    return ParseReal(field, value);
+}
+
+bool Input_Nastran::IsNastran(const char* begin, const char* end)
+{
+    int nLine = 0;
+    const char* pos = begin;
+    while (pos < end && nLine < MaxIsNastranLines)
+    {
+        const char* lineBegin = pos;
+        const char* lineEnd = nullptr;
+        pos = TextScanner::NextLine(pos, end, lineEnd);
+        if (!StripLine(lineBegin, lineEnd)) continue;
+
+        std::string_view line = Trim(std::string_view(lineBegin, lineEnd - lineBegin));
+        if (line.empty() || TextScanner::IsComment(line.data(), line.data() + line.size())) continue;
+        if ('*' == line[0]) return false;  // 关键字格式
+        if (IsExecutive(line)) return true;
+
+        bool bLarge = false;
+        if (s_CardHandlers.count(CardName(line.substr(0, line.find_first_of(" \t,")), bLarge))) return true;
+        ++nLine;
+    }
+    return false;
+}
+
+bool Input_Nastran::Read(TextScanner& flow, StructureData& data, const std::function<bool(int64_t)>& progress)
+{
+    m_Structure = &data;
+    m_bCardOpen = false;
+    m_bOk = true;
+
+    bool bBulk = false;  // 是否已进入批量数据段
+    bool bCancelled = false;
+    int nCard = 0;
+    int lineNo = 0;
+    const char* pos = flow.Position();
+    const char* end = flow.End();
+    while (pos < end)
+    {
+        const char* begin = pos;
+        const char* lineEnd = nullptr;
+        pos = TextScanner::NextLine(pos, end, lineEnd);
+        ++lineNo;
+        if (!StripLine(begin, lineEnd)) continue;
+
+        // Tab 按 8 列制表位展开（自由字段中 Tab 只是空白）
+        bool bFree = std::memchr(begin, ',', lineEnd - begin) != nullptr;
+        if (!bFree && std::memchr(begin, '\t', lineEnd - begin))
+        {
+            m_Expand.clear();
+            for (const char* p = begin; p < lineEnd; ++p)
+            {
+                if ('\t' == *p) m_Expand.append(SmallWidth - m_Expand.size() % SmallWidth, ' ');
+                else m_Expand.push_back(*p);
+            }
+            begin = m_Expand.data();
+            lineEnd = begin + m_Expand.size();
+        }
+        if (!bBulk && ReadCaseControl(Trim(std::string_view(begin, lineEnd - begin)))) continue;
+
+        std::string_view name = LineName(begin, lineEnd, bFree);
+        if (IsContinuation(name))
+        {
+            if (m_bCardOpen) AppendFields(begin, lineEnd, bFree, !name.empty() && '*' == name[0]);
+            continue;
+        }
+
+        FinishCard();
+
+        std::string_view line(begin, lineEnd - begin);
+        if (StartsWithNoCase(line, "BEGIN"))
+        {// BEGIN BULK 之后为批量数据
+            bBulk = true;
+            continue;
+        }
+
+        bool bLarge = false;
+        std::string cardName = CardName(name, bLarge);
+        if (!bBulk)
+        {// 执行控制和工况控制段：遇到支持的卡片时认为没有这两段
+            if (!s_CardHandlers.count(cardName)) continue;
+            bBulk = true;
+        }
+        if ("ENDDATA" == cardName) break;
+
+        if (progress && 0 == ++nCard % ProgressCards && !progress(pos - flow.Begin()))
+        {
+            bCancelled = true;
+            break;
+        }
+
+        m_Card.m_Name = std::move(cardName);
+        m_Card.m_nField = 0;
+        m_Card.m_Line = lineNo;
+        m_bCardOpen = true;
+        AppendFields(begin, lineEnd, bFree, bLarge);
+    }
+    FinishCard();
+
+    if (!bCancelled) Finish();
+
+    m_GridIndex.clear();
+    m_MaterialIndex.clear();
+    m_Properties.clear();
+    m_Elements.clear();
+    m_Spcs.clear();
+    m_Forces.clear();
+    m_Gravities.clear();
+    m_Unsupported.clear();
+    m_LoadSets.clear();
+    m_SpcSets.clear();
+    m_CaseGlobal = CaseControl();
+    m_Subcases.clear();
+    m_nLocalSystem = 0;
+    return m_bOk && !bCancelled;
+}
+
+void Input_Nastran::Finish()
+{
+    int loadSet = 0, spcSet = 0;
+    if (!SelectSet(&CaseControl::m_Load, m_LoadSets, QStringLiteral("荷载"), loadSet)) m_bOk = false;
+    if (!SelectSet(&CaseControl::m_Spc, m_SpcSets, QStringLiteral("约束"), spcSet)) m_bOk = false;
+    Resolve(loadSet, spcSet);
+
+    for (const auto& pair : std::map<std::string, int>(m_Unsupported.begin(), m_Unsupported.end()))
+    {
+        qDebug().noquote() << QStringLiteral("Warning: 不支持的卡片 ") << QString::fromStdString(pair.first)
+                           << QStringLiteral(" 共 ") << pair.second << QStringLiteral(" 张，已跳过");
+    }
+    if (m_nLocalSystem > 0)
+    {
+        qDebug().noquote() << QStringLiteral("Warning: ") << m_nLocalSystem << QStringLiteral(" 张卡片引用了局部坐标系，已按基本坐标系处理");
+    }
+
+    // 批量数据不含分析步，按线性静力分析添加一个
+    if (m_Structure->m_AnalysisStep.empty())
+    {
+        auto pStep = m_Structure->Create_Object<AnalysisStep>();
+        pStep->m_Id = 1;
+        pStep->m_Type = EnumKeyword::StepType::STATIC;
+        pStep->m_Time = 1.0;
+        pStep->m_StepSize = 1.0;
+        m_Structure->m_AnalysisStep.insert(std::make_pair(1, pStep));
+    }
+}
+
+void Input_Nastran::AppendFields(const char* begin, const char* end, bool bFree, bool bLarge)
+{
+    const int perLine = bLarge ? 4 : 8;  // 每行数据字段数
+    auto append = [this](std::string_view field)
+        {
+            if (m_Card.m_nField == static_cast<int>(m_Card.m_Field.size())) m_Card.m_Field.emplace_back();
+            m_Card.m_Field[m_Card.m_nField++].assign(Trim(field));
+        };
+
+    if (bFree)
+    {// 第 0 个为卡片名或续行标记，其后 perLine 个为数据，再后一个为续行标记；更长的行按同样的周期继续
+        const int period = perLine + 2;
+        int j = 0;
+        const char* p = begin;
+        while (true)
+        {
+            const char* comma = static_cast<const char*>(std::memchr(p, ',', end - p));
+            const char* fieldEnd = comma ? comma : end;
+            const int k = j % period;
+            if (0 != k && period - 1 != k) append(std::string_view(p, fieldEnd - p));
+            ++j;
+            if (!comma) break;
+            p = comma + 1;
+        }
+    }
+    else
+    {// 第 1~8 列为卡片名，第 9~72 列为数据
+        const int width = bLarge ? LargeWidth : SmallWidth;
+        const size_t length = end - begin;
+        for (int k = 0; k < perLine; ++k)
+        {
+            const size_t first = SmallWidth + static_cast<size_t>(k) * width;
+            if (first >= length) break;
+            append(std::string_view(begin + first, std::min<size_t>(width, length - first)));
+        }
+    }
+
+    // 不满的行补齐空字段
+    while (0 != m_Card.m_nField % perLine) append(std::string_view());
+}
+
+void Input_Nastran::FinishCard()
+{
+    if (!m_bCardOpen) return;
+    m_bCardOpen = false;
+
+    auto iter = s_CardHandlers.find(m_Card.m_Name);
+    if (iter == s_CardHandlers.end())
+    {
+        ++m_Unsupported[m_Card.m_Name];
+        return;
+    }
+    if (!(this->*(iter->second))(m_Card)) m_bOk = false;
+}
+
+bool Input_Nastran::CardError(const Card& card, const QString& message)
+{
+    qDebug().noquote() << QStringLiteral("Error: 第 %1 行 %2 卡片%3").arg(card.m_Line).arg(QString::fromStdString(card.m_Name)).arg(message);
+    return false;
+}
+
+bool Input_Nastran::ReadCaseControl(std::string_view line)
+{
+    // SUBCASE n、LOAD = n、SPC = n（其余工况控制语句忽略）
+    int* pValue = nullptr;
+    size_t length = 0;
+    if (StartsWithNoCase(line, "SUBCASE"))
+    {
+        m_Subcases.emplace_back();
+        return true;
+    }
+    if (StartsWithNoCase(line, "LOAD"))
+    {
+        pValue = m_Subcases.empty() ? &m_CaseGlobal.m_Load : &m_Subcases.back().m_Load;
+        length = 4;
+    }
+    else if (StartsWithNoCase(line, "SPC"))
+    {
+        pValue = m_Subcases.empty() ? &m_CaseGlobal.m_Spc : &m_Subcases.back().m_Spc;
+        length = 3;
+    }
+    else
+    {
+        return false;
+    }
+
+    std::string_view rest = Trim(line.substr(length));
+    if (rest.empty() || '=' != rest.front()) return false;  // SPCFORCES 等输出请求，或批量数据卡片
+
+    if (!ParseInt(Trim(rest.substr(1)), *pValue) || *pValue <= 0)
+    {
+        qDebug().noquote() << QStringLiteral("Error: 工况控制语句格式错误: ") << QString::fromUtf8(line.data(), static_cast<int>(line.size()));
+        m_bOk = false;
+    }
+    return true;
+}
+
+bool Input_Nastran::SelectSet(int CaseControl::* member, const std::vector<int>& sets, const QString& name, int& sid) const
+{
+    // 各工况的选择，SUBCASE 中未给出时沿用第一个 SUBCASE 之前的选择
+    std::vector<int> selected;
+    if (m_Subcases.empty()) selected.push_back(m_CaseGlobal.*member);
+    for (const CaseControl& subcase : m_Subcases) AddSet(selected, 0 != subcase.*member ? subcase.*member : m_CaseGlobal.*member);
+
+    sid = 0;
+    if (selected.size() > 1)
+    {
+        qDebug().noquote() << QStringLiteral("Error: 各工况选用的%1集不同，分析步的荷载逐步累加，不能表示相互独立的工况，请每个工况单独计算").arg(name);
+        return false;
+    }
+
+    if (0 != selected.front())
+    {
+        sid = selected.front();
+        if (std::find(sets.begin(), sets.end(), sid) != sets.end()) return true;
+        qDebug().noquote() << QStringLiteral("Error: 工况控制选用的%1集 %2 在批量数据中没有支持的卡片").arg(name).arg(sid);
+        return false;
+    }
+
+    if (sets.size() > 1)
+    {
+        qDebug().noquote() << QStringLiteral("Error: 批量数据中有 %1 个%2集，需在工况控制中选择一个").arg(sets.size()).arg(name);
+        return false;
+    }
+    if (!sets.empty()) sid = sets.front();
+    return true;
+}
+
+bool Input_Nastran::AddComponents(const Card& card, int sid, std::string_view components, int gridFirst, int gridLast, double value)
+{
+    int mask = 0;
+    for (char c : components)
+    {
+        if (c < '0' || c > '6') return CardError(card, QStringLiteral("分量格式错误"));
+        if ('0' == c) continue;  // 标量点分量
+        mask |= 1 << (c - '1');
+    }
+    if (0 != mask) m_Spcs.push_back({ sid, gridFirst, gridLast, card.m_Line, mask, value });
+    return true;
+}
+
+bool Input_Nastran::InputGrid(const Card& card)
+{
+    // GRID, ID, CP, X1, X2, X3, CD, PS, SEQ
+    int id = 0, cp = 0, cd = 0;
+    double x = 0.0, y = 0.0, z = 0.0;
+    if (!card.Int(1, id) || !card.Int(2, cp) || !card.Real(3, x) || !card.Real(4, y) || !card.Real(5, z) || !card.Int(6, cd))
+    {
+        return CardError(card, QStringLiteral("格式错误"));
+    }
+    if (0 != cp || 0 != cd) ++m_nLocalSystem;
+
+    int autoId = static_cast<int>(m_Structure->m_Nodes.size()) + 1;
+    if (!m_GridIndex.emplace(id, autoId).second)
+    {
+        return CardError(card, QStringLiteral("ID %1 重复").arg(id));
+    }
+
+    auto pNode = m_Structure->Create_Object<Node>();
+    pNode->m_Id = autoId;
+    pNode->m_X = x;
+    pNode->m_Y = y;
+    pNode->m_Z = z;
+    m_Structure->m_Nodes.insert(std::make_pair(autoId, pNode));
+    m_Structure->TopologyChanged();
+
+    // 永久单点约束
+    return AddComponents(card, 0, card.Field(7), id, id, 0.0);
+}
+
+bool Input_Nastran::InputCrod(const Card& card)
+{
+    // CROD, EID, PID, G1, G2
+    PendingElement element{ 0, card.m_Line, 0, { 0, 0 }, 0, 0.0 };
+    if (!card.Int(1, element.m_Eid) || !card.Int(2, element.m_Pid, element.m_Eid) ||
+        !card.Int(3, element.m_Grid[0]) || !card.Int(4, element.m_Grid[1]))
+    {
+        return CardError(card, QStringLiteral("格式错误"));
+    }
+    m_Elements.push_back(element);
+    return true;
+}
+
+bool Input_Nastran::InputConrod(const Card& card)
+{
+    // CONROD, EID, G1, G2, MID, A, J, C, NSM
+    PendingElement element{ 0, card.m_Line, 0, { 0, 0 }, 0, 0.0 };
+    if (!card.Int(1, element.m_Eid) || !card.Int(2, element.m_Grid[0]) || !card.Int(3, element.m_Grid[1]) ||
+        !card.Int(4, element.m_Mid) || !card.Real(5, element.m_Area))
+    {
+        return CardError(card, QStringLiteral("格式错误"));
+    }
+    m_Elements.push_back(element);
+    return true;
+}
+
+bool Input_Nastran::InputCbar(const Card& card)
+{
+    // CBAR/CBEAM, EID, PID, GA, GB, ...：梁单元（ElementBeam）尚未实现刚度和内力，
+    // 按桁架读入会丢掉弯曲刚度，按梁读入刚度矩阵奇异，因此报错而不是静默改变模型
+    return CardError(card, QStringLiteral("暂不支持（梁单元尚未实现），请改用 CROD 或 CONROD"));
+}
+
+bool Input_Nastran::InputProd(const Card& card)
+{
+    // PROD, PID, MID, A, J, C, NSM
+    int pid = 0;
+    PendingProperty property{ 0, 0.0 };
+    if (!card.Int(1, pid) || !card.Int(2, property.m_Mid) || !card.Real(3, property.m_Area))
+    {
+        return CardError(card, QStringLiteral("格式错误"));
+    }
+    if (!m_Properties.emplace(pid, property).second)
+    {
+        return CardError(card, QStringLiteral("ID %1 重复").arg(pid));
+    }
+    return true;
+}
+
+bool Input_Nastran::InputPbar(const Card& card)
+{
+    // PBAR, PID, MID, A, I1, I2, J, NSM / PBEAM, PID, MID, A(A), ...（只使用面积）
+    return InputProd(card);
+}
+
+bool Input_Nastran::InputMat1(const Card& card)
+{
+    // MAT1, MID, E, G, NU, RHO, A, TREF, GE / ST, SC, SS, MCSID
+    int mid = 0;
+    double E = 0.0, G = 0.0, nu = 0.0, rho = 0.0, a = 0.0, st = 0.0;
+    if (!card.Int(1, mid) || !card.Real(2, E) || !card.Real(3, G) || !card.Real(4, nu) ||
+        !card.Real(5, rho) || !card.Real(6, a) || !card.Real(9, st))
+    {
+        return CardError(card, QStringLiteral("格式错误"));
+    }
+
+    // 泊松比缺省时由 E、G 换算
+    if (card.IsBlank(4) && !card.IsBlank(3) && 0.0 != G) nu = E / (2.0 * G) - 1.0;
+
+    int autoId = static_cast<int>(m_Structure->m_Material.size()) + 1;
+    if (!m_MaterialIndex.emplace(mid, autoId).second)
+    {
+        return CardError(card, QStringLiteral("ID %1 重复").arg(mid));
+    }
+
+    auto pMaterial = m_Structure->Create_Object<Material>();
+    pMaterial->m_Id = autoId;
+    pMaterial->m_Young = E;
+    pMaterial->m_Poisson = nu;
+    pMaterial->m_Density = rho;
+    pMaterial->m_MaxStress = st;
+    pMaterial->m_Expansion = a;
+    m_Structure->m_Material.insert(std::make_pair(autoId, pMaterial));
+    return true;
+}
+
+bool Input_Nastran::InputSpc(const Card& card)
+{
+    // SPC, SID, G1, C1, D1, G2, C2, D2
+    int sid = 0;
+    if (!card.Int(1, sid)) return CardError(card, QStringLiteral("格式错误"));
+    AddSet(m_SpcSets, sid);
+
+    for (int k = 0; k < 2; ++k)
+    {
+        const int first = 2 + 3 * k;
+        if (card.IsBlank(first)) continue;
+
+        int grid = 0;
+        double value = 0.0;
+        if (!card.Int(first, grid) || !card.Real(first + 2, value))
+        {
+            return CardError(card, QStringLiteral("格式错误"));
+        }
+        if (!AddComponents(card, sid, card.Field(first + 1), grid, grid, value)) return false;
+    }
+    return true;
+}
+
+bool Input_Nastran::InputSpc1(const Card& card)
+{
+    // SPC1, SID, C, G1, G2, ... 或 SPC1, SID, C, G1, THRU, G2
+    int sid = 0;
+    if (!card.Int(1, sid)) return CardError(card, QStringLiteral("格式错误"));
+    AddSet(m_SpcSets, sid);
+
+    std::string_view components = card.Field(2);
+    if (StartsWithNoCase(card.Field(4), "THRU"))
+    {
+        int first = 0, last = 0;
+        if (!card.Int(3, first) || !card.Int(5, last) || last < first)
+        {
+            return CardError(card, QStringLiteral("THRU 范围错误"));
+        }
+        return AddComponents(card, sid, components, first, last, 0.0);
+    }
+
+    for (int i = 3; i <= card.m_nField; ++i)
+    {
+        if (card.IsBlank(i)) continue;
+
+        int grid = 0;
+        if (!card.Int(i, grid)) return CardError(card, QStringLiteral("格式错误"));
+        if (!AddComponents(card, sid, components, grid, grid, 0.0)) return false;
+    }
+    return true;
+}
+
+bool Input_Nastran::InputForce(const Card& card)
+{
+    // FORCE, SID, G, CID, F, N1, N2, N3
+    int sid = 0, grid = 0, cid = 0;
+    double F = 0.0, N[3] = { 0.0, 0.0, 0.0 };
+    if (!card.Int(1, sid) || !card.Int(2, grid) || !card.Int(3, cid) || !card.Real(4, F) ||
+        !card.Real(5, N[0]) || !card.Real(6, N[1]) || !card.Real(7, N[2]))
+    {
+        return CardError(card, QStringLiteral("格式错误"));
+    }
+    if (0 != cid) ++m_nLocalSystem;
+    AddSet(m_LoadSets, sid);
+
+    for (int k = 0; k < 3; ++k)
+    {
+        if (0.0 == N[k] || 0.0 == F) continue;
+        m_Forces.push_back({ sid, grid, card.m_Line, static_cast<EnumKeyword::Direction>(k), F * N[k] });
+    }
+    return true;
+}
+
+bool Input_Nastran::InputGrav(const Card& card)
+{
+    // GRAV, SID, CID, A, N1, N2, N3, MB
+    int sid = 0, cid = 0;
+    double A = 0.0, N[3] = { 0.0, 0.0, 0.0 };
+    if (!card.Int(1, sid) || !card.Int(2, cid) || !card.Real(3, A) ||
+        !card.Real(4, N[0]) || !card.Real(5, N[1]) || !card.Real(6, N[2]))
+    {
+        return CardError(card, QStringLiteral("格式错误"));
+    }
+    if (0 != cid) ++m_nLocalSystem;
+    AddSet(m_LoadSets, sid);
+
+    // 重力加速度向量为 A*N，按分量分解为重力荷载
+    for (int k = 0; k < 3; ++k)
+    {
+        if (0.0 == N[k] || 0.0 == A) continue;
+        m_Gravities.push_back({ sid, 0, card.m_Line, static_cast<EnumKeyword::Direction>(k), A * N[k] });
+    }
+    return true;
+}
+
+void Input_Nastran::Resolve(int loadSet, int spcSet)
+{
+    auto findNode = [this](int grid) -> std::shared_ptr<Node>
+        {
+            auto iter = m_GridIndex.find(grid);
+            return iter == m_GridIndex.end() ? nullptr : m_Structure->FindNode(iter->second);
+        };
+    auto error = [this](int line, const QString& message)
+        {
+            qDebug().noquote() << QStringLiteral("Error: 第 %1 行 %2").arg(line).arg(message);
+            m_bOk = false;
+        };
+
+    // 截面按面积取等面积圆截面，面积相同的共用
+    std::map<double, int> sectionByArea;
+    auto sectionOf = [&](double area)
+        {
+            auto iter = sectionByArea.find(area);
+            if (iter != sectionByArea.end()) return iter->second;
+
+            int autoId = static_cast<int>(m_Structure->m_Section.size()) + 1;
+            auto pSection = m_Structure->Create_Object<SectionCircular>();
+            pSection->m_Id = autoId;
+            pSection->m_Radius = std::sqrt(area / PI);
+            pSection->m_Area = area;
+            m_Structure->m_Section.insert(std::make_pair(autoId, pSection));
+            sectionByArea.emplace(area, autoId);
+            return autoId;
+        };
+
+    // 属性按 (材料, 面积) 缓存，避免对每个单元查找属性表
+    std::map<std::pair<int, double>, std::shared_ptr<Property>> propertyCache;
+    for (const PendingElement& element : m_Elements)
+    {
+        int mid = element.m_Mid;
+        double area = element.m_Area;
+        if (0 != element.m_Pid)
+        {
+            auto iter = m_Properties.find(element.m_Pid);
+            if (iter == m_Properties.end())
+            {
+                error(element.m_Line, QStringLiteral("单元 %1 的属性 %2 不存在").arg(element.m_Eid).arg(element.m_Pid));
+                continue;
+            }
+            mid = iter->second.m_Mid;
+            area = iter->second.m_Area;
+        }
+
+        auto iterMat = m_MaterialIndex.find(mid);
+        if (iterMat == m_MaterialIndex.end())
+        {
+            error(element.m_Line, QStringLiteral("单元 %1 的材料 %2 不存在").arg(element.m_Eid).arg(mid));
+            continue;
+        }
+
+        auto pNode0 = findNode(element.m_Grid[0]);
+        auto pNode1 = findNode(element.m_Grid[1]);
+        if (!pNode0 || !pNode1)
+        {
+            error(element.m_Line, QStringLiteral("单元 %1 的节点 %2 不存在").arg(element.m_Eid).arg(pNode0 ? element.m_Grid[1] : element.m_Grid[0]));
+            continue;
+        }
+
+        auto& pProperty = propertyCache[std::make_pair(iterMat->second, area)];
+        if (!pProperty) pProperty = m_Structure->Create_Property(iterMat->second, sectionOf(area));
+        if (!pProperty)
+        {
+            error(element.m_Line, QStringLiteral("单元 %1 无法创建属性").arg(element.m_Eid));
+            continue;
+        }
+
+        auto pElement = m_Structure->Create_Object<ElementTruss>();
+        int idElement = static_cast<int>(m_Structure->m_Elements.size()) + 1;
+        pElement->m_Id = idElement;
+        pElement->m_pNode[0] = pNode0;
+        pElement->m_pNode[1] = pNode1;
+        pElement->m_pProperty = pProperty;
+        m_Structure->m_Elements.insert(std::make_pair(idElement, pElement));
+        m_Structure->TopologyChanged();
+    }
+
+    // 同一节点同一方向的约束只保留第一个
+    std::unordered_set<int64_t> constrained;
+    auto addConstraint = [&](const std::shared_ptr<Node>& pNode, const PendingSpc& spc)
+        {
+            for (int k = 0; k < 6; ++k)
+            {
+                if (0 == (spc.m_Components & (1 << k))) continue;
+                if (!constrained.insert(static_cast<int64_t>(pNode->m_Id) * 8 + k).second) continue;
+
+                int autoId = static_cast<int>(m_Structure->m_Constraint.size()) + 1;
+                auto pConstraint = m_Structure->Create_Object<Constraint>();
+                pConstraint->m_Id = autoId;
+                pConstraint->m_pNode = pNode;
+                pConstraint->m_Direction = static_cast<EnumKeyword::Direction>(k);
+                pConstraint->m_Value = spc.m_Value;
+                m_Structure->m_Constraint.insert(std::make_pair(autoId, pConstraint));
+            }
+        };
+
+    std::vector<int> rangeGrids;
+    for (const PendingSpc& spc : m_Spcs)
+    {
+        if (0 != spc.m_Sid && spc.m_Sid != spcSet) continue;
+        if (spc.m_GridFirst == spc.m_GridLast)
+        {
+            auto pNode = findNode(spc.m_GridFirst);
+            if (!pNode)
+            {
+                error(spc.m_Line, QStringLiteral("约束的节点 %1 不存在").arg(spc.m_GridFirst));
+                continue;
+            }
+            addConstraint(pNode, spc);
+            continue;
+        }
+
+        // THRU 范围：范围比节点数小时逐个ID查找，否则从节点表中挑出范围内的ID，耗时不超过节点数
+        rangeGrids.clear();
+        const int64_t rangeSize = static_cast<int64_t>(spc.m_GridLast) - spc.m_GridFirst + 1;
+        if (rangeSize <= static_cast<int64_t>(m_GridIndex.size()))
+        {
+            for (int64_t grid = spc.m_GridFirst; grid <= spc.m_GridLast; ++grid)
+            {
+                if (m_GridIndex.count(static_cast<int>(grid))) rangeGrids.push_back(static_cast<int>(grid));
+            }
+        }
+        else
+        {
+            for (const auto& pair : m_GridIndex)
+            {
+                if (pair.first >= spc.m_GridFirst && pair.first <= spc.m_GridLast) rangeGrids.push_back(pair.first);
+            }
+            std::sort(rangeGrids.begin(), rangeGrids.end());
+        }
+        for (int grid : rangeGrids) addConstraint(findNode(grid), spc);
+    }
+
+    for (const PendingDof& force : m_Forces)
+    {
+        if (force.m_Sid != loadSet) continue;
+        auto pNode = findNode(force.m_Grid);
+        if (!pNode)
+        {
+            error(force.m_Line, QStringLiteral("节点力的节点 %1 不存在").arg(force.m_Grid));
+            continue;
+        }
+
+        int autoId = static_cast<int>(m_Structure->m_Load.size()) + 1;
+        auto pLoad = m_Structure->Create_Object<Force_Node>();
+        pLoad->m_Id = autoId;
+        pLoad->m_pNode = pNode;
+        pLoad->m_Direction = force.m_Direction;
+        pLoad->m_Value = force.m_Value;
+        pLoad->m_StepId = 1;
+        m_Structure->m_Load.insert(std::make_pair(autoId, pLoad));
+    }
+
+    for (const PendingDof& gravity : m_Gravities)
+    {
+        if (gravity.m_Sid != loadSet) continue;
+
+        int autoId = static_cast<int>(m_Structure->m_Load.size()) + 1;
+        auto pLoad = m_Structure->Create_Object<Force_Gravity>();
+        pLoad->m_Id = autoId;
+        pLoad->m_Direction = gravity.m_Direction;
+        pLoad->m_g = gravity.m_Value;
+        pLoad->m_StepId = 1;
+        m_Structure->m_Load.insert(std::make_pair(autoId, pLoad));
+    }
+}
@@ -0,0 +1,231 @@
+﻿#pragma once
+#include "Base/Base.h"
+#include "TextScanner.h"
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class StructureData;
+
+/**
+ * @brief Nastran 批量数据（BDF）读取类 - 逐行流式读取，一遍完成
+ *
+ * 支持的卡片：GRID、CROD、CONROD、PROD、PBAR、PBEAM、MAT1、SPC、SPC1、FORCE、GRAV；CBAR、CBEAM 能识别但报错。
+ * 支持小字段（8 字符）、大字段（16 字符，卡片名后加 *）和自由字段（逗号分隔）格式，
+ * 以及以 +、* 或空白名称开头的续行（续行须紧跟在所属卡片之后）。$ 之后为注释。
+ *
+ * 文件含执行控制和工况控制段时从 BEGIN BULK 开始读取，否则从第一张支持的卡片开始读取，读到 ENDDATA 为止。
+ * 工况控制段只读取 SUBCASE 和其中的 LOAD=、SPC= 选择。
+ * 节点和材料读到即入库；单元、约束和节点力引用的节点、属性可以在后面定义，先以定长记录暂存，
+ * 读完后统一解析入库。内存只与模型规模有关，与卡片文本无关。
+ *
+ * 映射规则：
+ * - CROD、CONROD 为桁架单元，截面按属性面积取等面积圆截面；CBAR、CBEAM 报错（梁单元尚未实现刚度）；
+ * - SPC、SPC1 和 GRID 的永久约束（PS）为约束，分量 1~6 对应 X、Y、Z、RX、RY、RZ；
+ *   SPC1 的 THRU 范围只约束范围内存在的节点，范围内缺少的ID跳过；
+ * - FORCE 按分量分解为节点力，GRAV 按分量分解为重力荷载，都作用于第 1 个分析步；
+ * - 荷载集和约束集按工况控制的 LOAD=、SPC= 选用，GRID 的永久约束总是保留；没有选择时批量数据中只能有一个集。
+ *   分析步的荷载逐步累加，不能表示相互独立的工况，因此各 SUBCASE 选用的集不同时报错；
+ * - 不支持局部坐标系（CP、CD、CID 非 0 时按基本坐标系处理并给出警告），不支持的卡片跳过并统计。
+ */
+class Input_Nastran : public Base
+{
+public:
+    /**
+     * @brief 从已打开的扫描器当前位置读取批量数据，追加到结构数据中
+     * @param [in] flow 文本扫描器
+     * @param [in] data 结构数据
+     * @param [in] progress 进度回调（参数为已读取的字节数），每 ProgressCards 张卡片调用一次，返回 false 时停止读取
+     * @return 读取成功返回 true；有卡片格式错误或引用缺失、或被取消时返回 false（其余数据仍然入库）
+     *
+     * 模型中没有分析步时添加一个静力分析步（相当于 SOL 101）。
+     */
+    bool Read(TextScanner& flow, StructureData& data, const std::function<bool(int64_t)>& progress = nullptr);
+
+    static const int ProgressCards = 65536;  ///< 报告进度的间隔（卡片张数）
+
+    /**
+     * @brief 内容是否为 Nastran 输入文件（开头的有效行为执行控制语句、BEGIN BULK 或支持的卡片）
+     * @param [in] begin 内容起点
+     * @param [in] end 内容终点
+     */
+    static bool IsNastran(const char* begin, const char* end);
+
+private:
+    /**
+     * @brief 一张卡片 - 卡片名及各行拼接后的数据字段
+     *
+     * 数据字段从 1 开始编号（不含卡片名），每个小字段行占 8 个字段，大字段行占 4 个字段，
+     * 不满的行以空字段补齐，因此续行字段的编号与格式无关。
+     */
+    struct Card
+    {
+        std::string m_Name;               ///< 卡片名（大写，不含 *）
+        std::vector<std::string> m_Field; ///< 数据字段（已去除空白），下标 i-1 为第 i 个字段
+        int m_nField = 0;                 ///< 数据字段个数
+        int m_Line = 0;                   ///< 卡片第一行的行号
+
+        /**
+         * @brief 第 i 个字段，超出范围为空字段
+         */
+        std::string_view Field(int i) const { return i >= 1 && i <= m_nField ? std::string_view(m_Field[i - 1]) : std::string_view(); }
+
+        /**
+         * @brief 第 i 个字段是否为空
+         */
+        bool IsBlank(int i) const { return Field(i).empty(); }
+
+        /**
+         * @brief 第 i 个字段转为整数，空字段取 def
+         * @return 字段不是整数时返回 false
+         */
+        bool Int(int i, int& value, int def = 0) const;
+
+        /**
+         * @brief 第 i 个字段转为实数（支持 1.0+3、1.0D3 等写法），空字段取 def
+         * @return 字段不是数值时返回 false
+         */
+        bool Real(int i, double& value, double def = 0.0) const;
+    };
+
+    /// @name 暂存记录（引用在读完后解析）
+    /// @{
+    struct PendingElement
+    {
+        int m_Eid;                          ///< 单元ID（用于错误信息）
+        int m_Line;                         ///< 卡片行号
+        int m_Pid;                          ///< 属性ID，CONROD 为 0
+        int m_Grid[2];                      ///< 节点ID
+        int m_Mid;                          ///< 材料ID（仅 CONROD）
+        double m_Area;                      ///< 截面面积（仅 CONROD）
+    };
+
+    struct PendingProperty
+    {
+        int m_Mid;                          ///< 材料ID
+        double m_Area;                      ///< 截面面积
+    };
+
+    struct PendingSpc
+    {
+        int m_Sid;                          ///< 约束集号，GRID 的永久约束为 0
+        int m_GridFirst;                    ///< 节点ID
+        int m_GridLast;                     ///< THRU 范围的最后一个节点ID，单个节点时与 m_GridFirst 相同
+        int m_Line;                         ///< 卡片行号
+        int m_Components;                   ///< 约束分量，第 k 位对应方向 k
+        double m_Value;                     ///< 约束位移
+    };
+
+    struct PendingDof
+    {
+        int m_Sid;                          ///< 荷载集号
+        int m_Grid;                         ///< 节点ID，重力荷载为 0
+        int m_Line;                         ///< 卡片行号
+        EnumKeyword::Direction m_Direction; ///< 方向
+        double m_Value;                     ///< 荷载值
+    };
+
+    struct CaseControl
+    {
+        int m_Load = 0;                     ///< LOAD= 选用的荷载集号，0 为未选择
+        int m_Spc = 0;                      ///< SPC= 选用的约束集号，0 为未选择
+    };
+    /// @}
+
+    using CardHandler = bool (Input_Nastran::*)(const Card&);
+    static const std::unordered_map<std::string, CardHandler> s_CardHandlers;  ///< 卡片名到处理函数的映射表
+
+    StructureData* m_Structure = nullptr;  ///< 结构数据
+    Card m_Card;                           ///< 正在拼接的卡片
+    bool m_bCardOpen = false;              ///< 是否有正在拼接的卡片
+    std::string m_Expand;                  ///< 含 Tab 的行展开后的内容
+    bool m_bOk = true;                     ///< 是否没有错误
+
+    std::unordered_map<int, int> m_GridIndex;              ///< GRID ID -> 节点ID
+    std::unordered_map<int, int> m_MaterialIndex;          ///< MAT1 ID -> 材料ID
+    std::unordered_map<int, PendingProperty> m_Properties; ///< PROD/PBAR/PBEAM ID -> 属性
+    std::vector<PendingElement> m_Elements;                ///< 暂存的单元
+    std::vector<PendingSpc> m_Spcs;                        ///< 暂存的约束（THRU 范围为一条记录）
+    std::vector<PendingDof> m_Forces;                      ///< 暂存的节点力
+    std::vector<PendingDof> m_Gravities;                   ///< 暂存的重力荷载
+    std::unordered_map<std::string, int> m_Unsupported;    ///< 跳过的卡片名 -> 张数
+    int m_nLocalSystem = 0;                                ///< 引用局部坐标系的卡片数
+    std::vector<int> m_LoadSets;                           ///< 出现过的荷载集号
+    std::vector<int> m_SpcSets;                            ///< 出现过的约束集号
+    CaseControl m_CaseGlobal;                              ///< 第一个 SUBCASE 之前的选择
+    std::vector<CaseControl> m_Subcases;                   ///< 各 SUBCASE 的选择
+
+    /**
+     * @brief 把一行的数据字段追加到当前卡片
+     * @param [in] begin 行起点（已去除注释和行尾空白）
+     * @param [in] end 行终点
+     * @param [in] bFree 是否为自由字段格式
+     * @param [in] bLarge 是否为大字段格式
+     */
+    void AppendFields(const char* begin, const char* end, bool bFree, bool bLarge);
+
+    /**
+     * @brief 当前卡片拼接完成，分发到处理函数
+     */
+    void FinishCard();
+
+    /**
+     * @brief 报告卡片错误
+     * @return false
+     */
+    bool CardError(const Card& card, const QString& message);
+
+    /**
+     * @brief 读取工况控制语句（SUBCASE、LOAD=、SPC=）
+     * @param [in] line 去除首尾空白的一行
+     * @return 是这几种语句时返回 true
+     */
+    bool ReadCaseControl(std::string_view line);
+
+    /**
+     * @brief 确定选用的荷载集或约束集
+     * @param [in] member 工况控制中的选择（CaseControl::m_Load 或 m_Spc）
+     * @param [in] sets 批量数据中出现过的集号
+     * @param [in] name 集合名称（用于错误信息）
+     * @param [out] sid 选用的集号，没有这类卡片时为 0
+     * @return 各工况选用不同的集、选用的集不存在或未选择而有多个集时返回 false
+     */
+    bool SelectSet(int CaseControl::* member, const std::vector<int>& sets, const QString& name, int& sid) const;
+
+    /**
+     * @brief 由分量字符串（如 123456）添加约束记录
+     * @param [in] sid 约束集号，GRID 的永久约束为 0
+     * @param [in] gridFirst,gridLast 节点ID范围（单个节点时两者相同）
+     * @return 分量字符串无效时返回 false
+     */
+    bool AddComponents(const Card& card, int sid, std::string_view components, int gridFirst, int gridLast, double value);
+
+    /// @name 卡片处理函数
+    /// @{
+    bool InputGrid(const Card& card);
+    bool InputCrod(const Card& card);
+    bool InputConrod(const Card& card);
+    bool InputCbar(const Card& card);  ///< CBAR、CBEAM：报错
+    bool InputProd(const Card& card);
+    bool InputPbar(const Card& card);
+    bool InputMat1(const Card& card);
+    bool InputSpc(const Card& card);
+    bool InputSpc1(const Card& card);
+    bool InputForce(const Card& card);
+    bool InputGrav(const Card& card);
+    /// @}
+
+    /**
+     * @brief 解析暂存记录的引用，创建单元以及选用集中的约束和荷载
+     * @param [in] loadSet 选用的荷载集号
+     * @param [in] spcSet 选用的约束集号
+     */
+    void Resolve(int loadSet, int spcSet);
+
+    /**
+     * @brief 读完全部卡片后入库暂存记录、输出警告并补充缺省的分析步
+     */
+    void Finish();
+};
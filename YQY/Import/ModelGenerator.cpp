@@ -0,0 +1,205 @@
+﻿#include "ModelGenerator.h"
+#include "DataStructure/Structure/StructureData.h"
+#include <QFile>
+#include <QTextStream>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+
+int64_t ModelGenerator::CheckCount(const int count[3], size_t existing, const QString& name) const
+{
+    int64_t total = 1;
+    for (int d = 0; d < 3; ++d)
+    {
+        if (count[d] < 1)
+        {
+            qDebug().noquote() << QStringLiteral("Error: %1数量必须大于 0: ").arg(name) << count[d];
+            return 0;
+        }
+        total *= count[d];
+        if (total > INT_MAX - static_cast<int64_t>(existing))
+        {
+            qDebug().noquote() << QStringLiteral("Error: %1数量超出ID范围").arg(name);
+            return 0;
+        }
+    }
+    return total;
+}
+
+int ModelGenerator::NodeLine(const Vector3d& X0, const Vector3d& dX, int n)
+{
+    const Vector3d d[3] = { dX, Vector3d::Zero(), Vector3d::Zero() };
+    const int count[3] = { n, 1, 1 };
+    return Grid(X0, d, count);
+}
+
+int ModelGenerator::Grid(const Vector3d& X0, const Vector3d d[3], const int count[3])
+{
+    if (0 == CheckCount(count, m_Data.m_Nodes.size(), QStringLiteral("节点"))) return 0;
+
+    const int idFirst = static_cast<int>(m_Data.m_Nodes.size()) + 1;
+    int id = idFirst;
+    for (int k = 0; k < count[2]; ++k)
+    {
+        for (int j = 0; j < count[1]; ++j)
+        {
+            for (int i = 0; i < count[0]; ++i)
+            {
+                const Vector3d X = X0 + i * d[0] + j * d[1] + k * d[2];
+
+                auto pNode = m_Data.Create_Object<Node>();
+                pNode->m_Id = id;
+                pNode->m_X = X[0];
+                pNode->m_Y = X[1];
+                pNode->m_Z = X[2];
+
+                // ID 递增，总是插在末尾
+                m_Data.m_Nodes.emplace_hint(m_Data.m_Nodes.end(), id, pNode);
+                ++id;
+            }
+        }
+    }
+    m_Data.TopologyChanged();
+    return idFirst;
+}
+
+bool ModelGenerator::Elements(EnumKeyword::ElementType type, int idNode1, int idNode2, int idMaterial, int idSection,
+    const int count[3], const int inc[3])
+{
+    switch (type)
+    {
+    case EnumKeyword::ElementType::T3D2:
+        return CreateElements<ElementTruss>(idNode1, idNode2, idMaterial, idSection, count, inc);
+    case EnumKeyword::ElementType::CABLE:
+        return CreateElements<ElementCable>(idNode1, idNode2, idMaterial, idSection, count, inc);
+    default:
+        qDebug().noquote() << QStringLiteral("Error: 单元阵列不支持该单元类型");
+        return false;
+    }
+}
+
+template <class T>
+bool ModelGenerator::CreateElements(int idNode1, int idNode2, int idMaterial, int idSection, const int count[3], const int inc[3])
+{
+    if (0 == CheckCount(count, m_Data.m_Elements.size(), QStringLiteral("单元"))) return false;
+
+    // 同一阵列的单元共用一个属性
+    auto pProperty = m_Data.Create_Property(idMaterial, idSection);
+    if (!pProperty)
+    {
+        qDebug().noquote() << QStringLiteral("Error: 单元阵列没有属性，材料 %1").arg(idMaterial) << QStringLiteral("截面") << idSection;
+    }
+
+    int64_t nMissing = 0;
+    int id = static_cast<int>(m_Data.m_Elements.size()) + 1;
+    for (int k = 0; k < count[2]; ++k)
+    {
+        for (int j = 0; j < count[1]; ++j)
+        {
+            for (int i = 0; i < count[0]; ++i)
+            {
+                const int offset = i * inc[0] + j * inc[1] + k * inc[2];
+
+                auto pElement = m_Data.Create_Object<T>();
+                pElement->m_Id = id;
+                auto pNode1 = m_Data.FindNode(idNode1 + offset);
+                auto pNode2 = m_Data.FindNode(idNode2 + offset);
+                if (!pNode1 || !pNode2) ++nMissing;
+                pElement->m_pNode[0] = pNode1;
+                pElement->m_pNode[1] = pNode2;
+                pElement->m_pProperty = pProperty;
+
+                m_Data.m_Elements.emplace_hint(m_Data.m_Elements.end(), id, pElement);
+                ++id;
+            }
+        }
+    }
+    m_Data.TopologyChanged();
+
+    if (nMissing > 0)
+    {
+        qDebug().noquote() << QStringLiteral("Error: 单元阵列引用了不存在的节点，单元数: ") << nMissing;
+    }
+    return pProperty && 0 == nMissing;
+}
+
+bool ModelGenerator::WriteBenchmark(const QString& FileName, const Benchmark& options)
+{
+    const int* n = options.m_nCell;
+    if (n[0] < 1 || n[1] < 1 || n[2] < 1)
+    {
+        qDebug().noquote() << QStringLiteral("Error: 基准模型网格数必须大于 0");
+        return false;
+    }
+
+    QFile file(FileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        qDebug() << "Failed to open file:" << FileName;
+        return false;
+    }
+    QTextStream stream(&file);
+    const QString typeName = EnumKeyword::MapElementType.key(options.m_Type);
+
+    // 节点ID从 1 开始：(i, j, k) -> 1 + i + j * nx + k * nx * ny
+    const int nx = n[0] + 1;
+    const int nxy = nx * (n[1] + 1);
+    const double s = options.m_Spacing;
+
+    char buffer[256];
+    stream << "** Benchmark space truss " << n[0] << " x " << n[1] << " x " << n[2] << "\n";
+    stream << "*MATERIAL, 1\n1   2.06e11   0.3   7850   235e6   1.2e-5\n";
+    snprintf(buffer, sizeof(buffer), "*SECTION, 1\n1   %.17g\n", options.m_Radius);
+    stream << buffer;
+    snprintf(buffer, sizeof(buffer), "*GRID, 1\n1   0 0 0   %.17g 0 0 %d   0 %.17g 0 %d   0 0 %.17g %d\n",
+        s, nx, s, n[1] + 1, s, n[2] + 1);
+    stream << buffer;
+
+    // 杆件：第二个节点相对第一个节点的偏移和各方向的单元数
+    struct Member { int m_Offset; int m_Count[3]; };
+    const Member members[] =
+    {
+        { 1,             { n[0],     n[1] + 1, n[2] + 1 } },  // X 向
+        { nx,            { n[0] + 1, n[1],     n[2] + 1 } },  // Y 向
+        { nxy,           { n[0] + 1, n[1] + 1, n[2]     } },  // Z 向
+        { 1 + nx,        { n[0],     n[1],     n[2] + 1 } },  // XY 面斜杆
+        { 1 + nxy,       { n[0],     n[1] + 1, n[2]     } },  // XZ 面斜杆
+        { nx + nxy,      { n[0] + 1, n[1],     n[2]     } },  // YZ 面斜杆
+    };
+    stream << "*EGEN, " << typeName << ", " << static_cast<int>(std::size(members)) << "\n";
+    for (size_t m = 0; m < std::size(members); ++m)
+    {
+        const Member& member = members[m];
+        snprintf(buffer, sizeof(buffer), "%d   1 %d 1 1   %d 1   %d %d   %d %d\n", static_cast<int>(m) + 1,
+            1 + member.m_Offset, member.m_Count[0], member.m_Count[1], nx, member.m_Count[2], nxy);
+        stream << buffer;
+    }
+
+    // 底面节点三向固定
+    const int nBase = nx * (n[1] + 1);
+    stream << "*CONSTRAINT, " << 3 * nBase << "\n";
+    for (int i = 0; i < nBase; ++i)
+    {
+        for (int direction = 0; direction < 3; ++direction)
+        {
+            stream << 3 * i + direction + 1 << " " << i + 1 << " " << direction << " 0\n";
+        }
+    }
+
+    // 静力分析的收敛容差是残差范数的绝对值，按结构总重取相对值（舍入误差随模型规模增长，固定值在大模型上达不到）
+    double length = 0.0;
+    for (size_t m = 0; m < std::size(members); ++m)
+    {
+        const Member& member = members[m];
+        const double count = static_cast<double>(member.m_Count[0]) * member.m_Count[1] * member.m_Count[2];
+        length += count * s * (m < 3 ? 1.0 : std::sqrt(2.0));
+    }
+    const double weight = 7850.0 * 9.80665 * PI * options.m_Radius * options.m_Radius * length;
+
+    stream << "*LOAD, FORCE_GRAVITY, 1\n1   2   -9.80665   1\n";
+    snprintf(buffer, sizeof(buffer), "*ANALYSIS_STEP, 1\n1   STATIC   1.0   1.0   %.3g   30\n", 1e-8 * weight);
+    stream << buffer;
+    file.close();
+    return true;
+}
@@ -0,0 +1,92 @@
+﻿#pragma once
+#include "Base/Base.h"
+
+class StructureData;
+
+/**
+ * @brief 模型生成类 - 按规则直接在结构数据中生成节点和单元（*NGEN、*GRID、*EGEN 的实现）
+ *
+ * 节点与 *NODE 相同按读取顺序自动编号（已有节点数 + 1 起），单元与 *ELEMENT 相同自动编号；
+ * 生成的对象直接入库，不经过文本展开。同一套函数也用于生成规则空间网架的基准模型。
+ */
+class ModelGenerator : public Base
+{
+public:
+    explicit ModelGenerator(StructureData& data) : m_Data(data) {}
+
+    /**
+     * @brief 生成一行等间距节点：X0 + k * dX，k = 0 ~ n-1
+     * @param [in] X0 第一个节点坐标
+     * @param [in] dX 节点间距向量
+     * @param [in] n 节点数
+     * @return 第一个节点的ID，n 不合法时输出错误信息并返回 0
+     */
+    int NodeLine(const Vector3d& X0, const Vector3d& dX, int n);
+
+    /**
+     * @brief 生成二维或三维节点网格：X0 + i * d[0] + j * d[1] + k * d[2]，i 变化最快
+     * @param [in] X0 第一个节点坐标
+     * @param [in] d 三个方向的节点间距向量
+     * @param [in] count 三个方向的节点数（二维网格 count[2] = 1）
+     * @return 第一个节点的ID，节点数不合法时输出错误信息并返回 0
+     *
+     * 第 (i, j, k) 个节点的ID为 返回值 + i + j * count[0] + k * count[0] * count[1]。
+     */
+    int Grid(const Vector3d& X0, const Vector3d d[3], const int count[3]);
+
+    /**
+     * @brief 生成两节点单元阵列：第 (i, j, k) 个单元的节点为 Node + i * inc[0] + j * inc[1] + k * inc[2]
+     * @param [in] type 单元类型（T3D2、CABLE）
+     * @param [in] idNode1 第一个单元的节点1
+     * @param [in] idNode2 第一个单元的节点2
+     * @param [in] idMaterial 材料ID
+     * @param [in] idSection 截面ID
+     * @param [in] count 三个方向的单元数（不用的方向为 1）
+     * @param [in] inc 三个方向的节点ID增量
+     * @return 单元全部生成、节点和属性都存在返回 true
+     *
+     * 节点或属性不存在时单元仍然入库以保持编号，与 *ELEMENT 相同。
+     */
+    bool Elements(EnumKeyword::ElementType type, int idNode1, int idNode2, int idMaterial, int idSection,
+        const int count[3], const int inc[3]);
+
+    /**
+     * @brief 基准模型参数 - 底面固定、受自重作用的立方体空间网架
+     */
+    struct Benchmark
+    {
+        int    m_nCell[3] = { 10, 10, 10 };  ///< X、Y、Z 方向的网格数
+        double m_Spacing = 1.0;              ///< 网格间距
+        double m_Radius = 0.02;              ///< 杆件截面半径
+        EnumKeyword::ElementType m_Type = EnumKeyword::ElementType::T3D2;  ///< 杆件单元类型
+    };
+
+    /**
+     * @brief 写出基准模型的输入文件（*GRID、*EGEN 描述网格和杆件）
+     * @param [in] FileName 输入文件路径
+     * @param [in] options 模型参数
+     * @return 写出成功返回 true
+     *
+     * 每个网格含 X、Y、Z 向杆件和三个坐标面内各一根斜杆，底面节点三向固定，
+     * 材料为钢材，荷载为 -Z 向重力，一个静力分析步（收敛容差为结构总重的 1e-8 倍）。
+     * 用 Input_Model::InputData 读取，节点和单元由本类生成。
+     * 节点和杆件只占固定的几行，底面约束逐个节点写出（3 * (nx+1) * (ny+1) 行），
+     * 因此文件大小与底面节点数成正比，不随 Z 向网格数和杆件数增长。
+     */
+    static bool WriteBenchmark(const QString& FileName, const Benchmark& options);
+
+private:
+    StructureData& m_Data;  ///< 结构数据
+
+    /**
+     * @brief 检查并计算对象总数
+     * @return 总数；任一方向数量小于 1 或总数超出ID范围时输出错误信息并返回 0
+     */
+    int64_t CheckCount(const int count[3], size_t existing, const QString& name) const;
+
+    /**
+     * @brief 生成 T 类型的单元阵列（参数同 Elements）
+     */
+    template <class T>
+    bool CreateElements(int idNode1, int idNode2, int idMaterial, int idSection, const int count[3], const int inc[3]);
+};
@@ -0,0 +1,193 @@
+﻿#include "TextScanner.h"
+#include <QDebug>
+#include <charconv>
+#include <cstring>
+
+namespace
+{
+    inline bool IsSeparator(char c) { return ' ' == c || '\t' == c || ',' == c; }
+
+    // 与 QString::trimmed 相同的空白字符
+    inline bool IsSpace(char c) { return ' ' == c || ('\t' <= c && c <= '\r'); }
+
+    // std::from_chars 不接受前导 +，QString 的数值转换接受
+    inline std::string_view SkipPlus(std::string_view text)
+    {
+        if (text.size() > 1 && '+' == text[0] && '-' != text[1] && '+' != text[1]) text.remove_prefix(1);
+        return text;
+    }
+}
+
+void TextLine::Assign(const char* begin, const char* end)
+{
+    m_Begin = begin;
+    m_End = end;
+    m_Fields.clear();
+
+    const char* p = begin;
+    while (p < end)
+    {
+        while (p < end && IsSeparator(*p)) ++p;
+        if (p == end) break;
+
+        const char* field = p;
+        while (p < end && !IsSeparator(*p)) ++p;
+        m_Fields.emplace_back(field, static_cast<size_t>(p - field));
+    }
+}
+
+QString TextLine::ToText(int i) const
+{
+    std::string_view field = Field(i);
+    return QString::fromUtf8(field.data(), static_cast<qsizetype>(field.size()));
+}
+
+QString TextLine::ToString() const
+{
+    return QString::fromUtf8(m_Begin, static_cast<qsizetype>(m_End - m_Begin));
+}
+
+QStringList TextLine::KeywordFields() const
+{
+    TextLine keyword;
+    keyword.Assign(IsKeyword() ? m_Begin + 1 : m_Begin, m_End);
+
+    QStringList list_str;
+    for (int i = 0; i < keyword.Count(); ++i) list_str.append(keyword.ToText(i));
+    return list_str;
+}
+
+int TextLine::ParseInt(std::string_view text)
+{
+    text = SkipPlus(text);
+    int value = 0;
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (result.ec != std::errc() || result.ptr != text.data() + text.size()) return 0;
+    return value;
+}
+
+double TextLine::ParseDouble(std::string_view text)
+{
+    text = SkipPlus(text);
+    double value = 0.0;
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (result.ec != std::errc() || result.ptr != text.data() + text.size()) return 0.0;
+    return value;
+}
+
+bool TextScanner::Open(const QString& FileName)
+{
+    Close();
+
+    m_pFile = std::make_unique<QFile>(FileName);
+    if (!m_pFile->open(QIODevice::ReadOnly))
+    {
+        m_pFile.reset();
+        return false;
+    }
+
+    const qint64 size = m_pFile->size();
+    if (size > 0)
+    {
+        m_pMap = m_pFile->map(0, size);
+        if (!m_pMap)
+        {
+            qDebug().noquote() << QStringLiteral("Error: 文件映射失败: ") << FileName;
+            Close();
+            return false;
+        }
+    }
+
+    m_pBegin = reinterpret_cast<const char*>(m_pMap);
+    m_pEnd = m_pBegin + size;
+    if (size >= 3 && 0 == std::memcmp(m_pBegin, "\xEF\xBB\xBF", 3)) m_pBegin += 3;
+    m_pCur = m_pBegin;
+    return true;
+}
+
+void TextScanner::Close()
+{
+    if (m_pFile)
+    {
+        if (m_pMap) m_pFile->unmap(m_pMap);
+        m_pFile->close();
+        m_pFile.reset();
+    }
+    m_pMap = nullptr;
+    m_pBegin = m_pEnd = m_pCur = nullptr;
+}
+
+const char* TextScanner::NextLine(const char* pos, const char* end, const char*& lineEnd)
+{
+    const char* nl = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+    if (!nl) nl = end;
+
+    // 单独的 \r 也作为行结束符
+    const char* cr = static_cast<const char*>(std::memchr(pos, '\r', nl - pos));
+    if (cr && cr + 1 != nl)
+    {
+        lineEnd = cr;
+        return cr + 1;
+    }
+
+    lineEnd = cr ? cr : nl;
+    return nl < end ? nl + 1 : end;
+}
+
+bool TextScanner::IsComment(const char* begin, const char* end)
+{
+    return end - begin >= 2 && (('*' == begin[0] && '*' == begin[1]) || ('/' == begin[0] && '/' == begin[1]));
+}
+
+bool TextScanner::TrimLine(const char*& begin, const char*& end)
+{
+    if (IsComment(begin, end)) return false;
+
+    while (begin < end && IsSpace(*begin)) ++begin;
+    while (end > begin && IsSpace(end[-1])) --end;
+    return begin != end;
+}
+
+bool TextScanner::ReadLine(TextLine& line)
+{
+    return ReadLine(m_pCur, m_pEnd, line);
+}
+
+bool TextScanner::ReadLine(const char*& pos, const char* end, TextLine& line)
+{
+    while (pos < end)
+    {
+        const char* begin = pos;
+        const char* lineEnd = nullptr;
+        pos = NextLine(pos, end, lineEnd);
+
+        if (!TrimLine(begin, lineEnd)) continue; //注释行或空行，继续读取下一行
+
+        line.Assign(begin, lineEnd);
+        return true;                             //读取到有效数据，完成一行读取
+    }
+
+    return false;                                //文件读完，没有得到有效的数据行
+}
+
+int TextScanner::SkipLines(int nLine, int step, std::vector<const char*>& marks)
+{
+    marks.clear();
+    int count = 0;
+    while (count < nLine && m_pCur < m_pEnd)
+    {
+        const char* begin = m_pCur;
+        const char* end = nullptr;
+        const char* next = NextLine(m_pCur, m_pEnd, end);
+
+        const char* first = begin;
+        if (TrimLine(first, end))
+        {
+            if ('*' == *first) break;            //遇到关键字行，停在该行之前
+            if (0 == count % step) marks.push_back(begin);
+            ++count;
+        }
+        m_pCur = next;
+    }
+    return count;
+}
@@ -0,0 +1,250 @@
+﻿#pragma once
+#include <QString>
+#include <QStringList>
+#include <QFile>
+#include <algorithm>
+#include <climits>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 输入行 - 一行有效数据（已去除首尾空白）及按空格、Tab、逗号切分出的字段
+ *
+ * 字段直接指向映射的文件内容，不复制；读取下一行后失效。
+ */
+class TextLine
+{
+public:
+    /**
+     * @brief 按分隔符切分 [begin, end)，覆盖原有内容
+     */
+    void Assign(const char* begin, const char* end);
+
+    /**
+     * @brief 清空（置为空行）
+     */
+    void Clear() { m_Begin = m_End = nullptr; m_Fields.clear(); }
+
+    /**
+     * @brief 是否为空行
+     */
+    bool IsEmpty() const { return m_Begin == m_End; }
+
+    /**
+     * @brief 是否为关键字行（以 * 开头）
+     */
+    bool IsKeyword() const { return m_Begin != m_End && '*' == *m_Begin; }
+
+    /**
+     * @brief 字段个数
+     */
+    int Count() const { return static_cast<int>(m_Fields.size()); }
+
+    /**
+     * @brief 第 i 个字段，越界返回空字段
+     */
+    std::string_view Field(int i) const { return i >= 0 && i < Count() ? m_Fields[i] : std::string_view(); }
+
+    /**
+     * @brief 第 i 个字段转为整数，与 QString::toInt 相同：不能完整转换时返回 0
+     */
+    int ToInt(int i) const { return ParseInt(Field(i)); }
+
+    /**
+     * @brief 第 i 个字段转为浮点数，与 QString::toDouble 相同：不能完整转换时返回 0
+     */
+    double ToDouble(int i) const { return ParseDouble(Field(i)); }
+
+    /**
+     * @brief 第 i 个字段转为 QString
+     */
+    QString ToText(int i) const;
+
+    /**
+     * @brief 整行文本（用于错误信息）
+     */
+    QString ToString() const;
+
+    /**
+     * @brief 关键字行去掉开头的 * 后切分出的字段
+     */
+    QStringList KeywordFields() const;
+
+    static int ParseInt(std::string_view text);
+    static double ParseDouble(std::string_view text);
+
+private:
+    const char* m_Begin = nullptr;           ///< 行首（已去除空白）
+    const char* m_End = nullptr;             ///< 行尾（不含）
+    std::vector<std::string_view> m_Fields;  ///< 字段
+};
+
+/**
+ * @brief 文本扫描器 - 将输入文件映射到内存，按行读取有效数据
+ *
+ * 以 ** 或 // 开头的行为注释行，空白行跳过；行结束符为 \n、\r\n 或 \r，文件开头的 UTF-8 BOM 忽略。
+ * 行和字段都是映射内容的视图，不经过 QString 转换。
+ */
+class TextScanner
+{
+public:
+    static constexpr int MinChunkLines = 16384;  ///< ParseLines 每块最少行数，数据块较小时串行读取
+
+    ~TextScanner() { Close(); }
+
+    /**
+     * @brief 打开并映射文件
+     * @param [in] FileName 文件路径
+     * @return 成功返回 true
+     */
+    bool Open(const QString& FileName);
+
+    /**
+     * @brief 解除映射并关闭文件
+     */
+    void Close();
+
+    /**
+     * @brief 读取一行有效数据（跳过注释和空行）
+     * @param [out] line 读取到的行
+     * @return 成功返回 true，到达文件末尾返回 false
+     */
+    bool ReadLine(TextLine& line);
+
+    /**
+     * @brief 从 pos 读取一行有效数据，pos 移到该行之后
+     * @param [in,out] pos 读取位置
+     * @param [in] end 内容终点
+     * @param [out] line 读取到的行
+     * @return 成功返回 true，到达 end 返回 false
+     */
+    static bool ReadLine(const char*& pos, const char* end, TextLine& line);
+
+    /**
+     * @brief 只定位、不切分地跳过 nLine 行有效数据
+     * @param [in] nLine 行数
+     * @param [in] step 每隔 step 行记录一次行起点
+     * @param [out] marks 第 0、step、2*step ... 行的起点
+     * @return 跳过的行数；遇到关键字行或文件末尾时提前停止，读取位置停在关键字行之前
+     */
+    int SkipLines(int nLine, int step, std::vector<const char*>& marks);
+
+    /**
+     * @brief 读取 nLine 行数据，对第 i 行调用 parse(line, i)，parse 返回 false 表示格式错误
+     * @param [in] nLine 行数
+     * @param [in] nThreads 线程数（0 为硬件线程数）
+     * @param [out] stop 出错的行（格式错误的行或关键字行），数据不够时为空行
+     * @param [in] parse 行解析函数，写入第 i 个预分配位置
+     * @param [in] minChunkLines 每块最少行数
+     * @return 从第 0 行起连续解析成功的行数
+     *
+     * 行数足够多时先只找行边界、记录每块的起点，再由多个线程并行解析各块；
+     * 第 i 行总是写入第 i 个位置，出错时读取位置停在出错行之后，与逐行读取的结果相同。
+     */
+    template <class Parse>
+    int ParseLines(int nLine, int nThreads, TextLine& stop, Parse parse, int minChunkLines = MinChunkLines);
+
+    /**
+     * @brief 是否到达文件末尾
+     */
+    bool AtEnd() const { return m_pCur >= m_pEnd; }
+
+    /// @name 映射内容与当前读取位置
+    /// @{
+    const char* Begin() const { return m_pBegin; }
+    const char* End() const { return m_pEnd; }
+    const char* Position() const { return m_pCur; }
+    void Seek(const char* pos) { m_pCur = pos; }
+    /// @}
+
+    /**
+     * @brief 从 pos 读取一行原始内容（含空白），返回下一行起点
+     * @param [in] pos 行起点
+     * @param [in] end 内容终点
+     * @param [out] lineEnd 行终点（不含行结束符）
+     */
+    static const char* NextLine(const char* pos, const char* end, const char*& lineEnd);
+
+    /**
+     * @brief 原始行是否为注释行（以 ** 或 // 开头）
+     */
+    static bool IsComment(const char* begin, const char* end);
+
+    /**
+     * @brief 原始行是否为有效数据行，是则返回去除首尾空白后的范围
+     */
+    static bool TrimLine(const char*& begin, const char*& end);
+
+private:
+    std::unique_ptr<QFile> m_pFile;     ///< 映射的文件
+    uchar* m_pMap = nullptr;            ///< 映射地址
+    const char* m_pBegin = nullptr;     ///< 内容起点（跳过 BOM）
+    const char* m_pEnd = nullptr;       ///< 内容终点
+    const char* m_pCur = nullptr;       ///< 当前读取位置
+};
+
+template <class Parse>
+int TextScanner::ParseLines(int nLine, int nThreads, TextLine& stop, Parse parse, int minChunkLines)
+{
+    if (nThreads <= 0) nThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    const int nChunks = std::max(1, std::min(nThreads, nLine / std::max(1, minChunkLines)));
+    if (nChunks <= 1)
+    {
+        for (int i = 0; i < nLine; ++i)
+        {
+            if (!ReadLine(stop))
+            {
+                stop.Clear();
+                return i;
+            }
+            if (stop.IsKeyword() || !parse(stop, i)) return i;
+        }
+        return nLine;
+    }
+
+    // 1. 定位行边界，记录每块第一行的位置
+    const int step = (nLine + nChunks - 1) / nChunks;
+    std::vector<const char*> marks;
+    const int nFound = SkipLines(nLine, step, marks);
+    const char* blockEnd = m_pCur;
+
+    // 2. 各块并行解析，记录块内第一个出错的行
+    const int nUsed = static_cast<int>(marks.size());
+    std::vector<int> firstBad(nUsed, INT_MAX);
+    std::vector<TextLine> badLine(nUsed);
+    std::vector<const char*> badNext(nUsed, nullptr);
+    auto work = [&](int c)
+        {
+            const char* pos = marks[c];
+            const int end = std::min(nFound, (c + 1) * step);
+            TextLine line;
+            for (int i = c * step; i < end; ++i)
+            {
+                ReadLine(pos, blockEnd, line);
+                if (parse(line, i)) continue;
+
+                firstBad[c] = i;
+                badLine[c] = line;
+                badNext[c] = pos;
+                return;
+            }
+        };
+    std::vector<std::thread> workers;
+    workers.reserve(nUsed);
+    for (int c = 1; c < nUsed; ++c) workers.emplace_back(work, c);
+    if (nUsed > 0) work(0);
+    for (auto& worker : workers) worker.join();
+
+    // 3. 第一个出错行之前的行有效
+    for (int c = 0; c < nUsed; ++c)
+    {
+        if (INT_MAX == firstBad[c]) continue;
+        m_pCur = badNext[c];
+        stop = badLine[c];
+        return firstBad[c];
+    }
+    if (nFound < nLine && !ReadLine(stop)) stop.Clear();
+    return nFound;
+}
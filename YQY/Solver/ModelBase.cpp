@@ -1,10 +1,107 @@
 // ModelBase.cpp
 #include "ModelBase.h"
 #include <iostream>
+#include <algorithm>
 
 namespace Dynamics
 {//动力学名字空间
 
+	// ==========================================
+	// K_eff 并集模式
+	// ==========================================
+	void KeffPattern::Combine(double kCoeff, const SpMat& K,
+		double cCoeff, const SpMat& C,
+		double mCoeff, const SpMat& M,
+		SpMat& outKeff)
+	{
+		if (!K.isCompressed() || !C.isCompressed() || !M.isCompressed())
+		{// 非压缩存储无法按值数组映射，退回表达式组装
+			m_bValid = false;
+			outKeff = kCoeff * K;
+			if (C.nonZeros() > 0) outKeff += cCoeff * C;
+			outKeff += mCoeff * M;
+			return;
+		}
+
+		if (!m_bValid || outKeff.rows() != K.rows() || outKeff.cols() != K.cols())
+			Build(K, C, M, outKeff);
+
+		double* values = outKeff.valuePtr();
+		std::fill(values, values + outKeff.nonZeros(), 0.0);
+
+		if (Scatter(kCoeff, K, m_MapK, outKeff) &&
+			Scatter(cCoeff, C, m_MapC, outKeff) &&
+			Scatter(mCoeff, M, m_MapM, outKeff))
+			return;
+
+		// 模式发生变化（非线性过程中切线矩阵结构改变），重建后再组装一次
+		Build(K, C, M, outKeff);
+		values = outKeff.valuePtr();
+		std::fill(values, values + outKeff.nonZeros(), 0.0);
+		Scatter(kCoeff, K, m_MapK, outKeff);
+		Scatter(cCoeff, C, m_MapC, outKeff);
+		Scatter(mCoeff, M, m_MapM, outKeff);
+	}
+
+	void KeffPattern::Build(const SpMat& K, const SpMat& C, const SpMat& M, SpMat& outKeff)
+	{// 建立并集模式（只在首次或结构变化时调用，允许分配）
+		// 没有非零元的 C 可以是 0×0（表示无阻尼），与原来的组装方式一致，不参与并集
+		assert(C.nonZeros() == 0 || (C.rows() == K.rows() && C.cols() == K.cols()));
+		assert(M.rows() == K.rows() && M.cols() == K.cols());
+
+		outKeff = K;
+		if (C.nonZeros() > 0) outKeff += C;
+		outKeff += M;
+		outKeff.makeCompressed();
+
+		BuildMap(K, outKeff, m_MapK);
+		BuildMap(C, outKeff, m_MapC);
+		BuildMap(M, outKeff, m_MapM);
+
+		m_bValid = true;
+		++m_nBuild;
+	}
+
+	void KeffPattern::BuildMap(const SpMat& A, const SpMat& outKeff, std::vector<int>& map)
+	{
+		map.resize(A.nonZeros());
+		const int* outer = outKeff.outerIndexPtr();
+		const int* inner = outKeff.innerIndexPtr();
+		for (Eigen::Index j = 0; j < A.outerSize(); ++j)
+		{
+			for (int p = A.outerIndexPtr()[j]; p < A.outerIndexPtr()[j + 1]; ++p)
+			{// 列内行号有序，二分查找目标位置
+				const int* pos = std::lower_bound(inner + outer[j], inner + outer[j + 1], A.innerIndexPtr()[p]);
+				map[p] = static_cast<int>(pos - inner);
+			}
+		}
+	}
+
+	bool KeffPattern::Scatter(double coeff, const SpMat& A, const std::vector<int>& map, SpMat& outKeff)
+	{
+		if (static_cast<Eigen::Index>(map.size()) != A.nonZeros()) return false;
+
+		const int* outer = outKeff.outerIndexPtr();
+		const int* inner = outKeff.innerIndexPtr();
+		double* values = outKeff.valuePtr();
+		const int* aOuter = A.outerIndexPtr();
+		const int* aInner = A.innerIndexPtr();
+		const double* aValues = A.valuePtr();
+
+		for (Eigen::Index j = 0; j < A.outerSize(); ++j)
+		{
+			const int begin = outer[j], end = outer[j + 1];
+			for (int p = aOuter[j]; p < aOuter[j + 1]; ++p)
+			{
+				const int q = map[p];
+				// 顺带校验映射仍然有效（目标位于同一列且行号一致）
+				if (q < begin || q >= end || inner[q] != aInner[p]) return false;
+				values[q] += coeff * aValues[p];
+			}
+		}
+		return true;
+	}
+
 	void ModelBase::ComputeKeff(const State& s, 
 		double kCoeff, double cCoeff, double mCoeff,
 		SpMat& outKeff, SpMat& kBuf, SpMat& cBuf, SpMat& mBuf) const
@@ -14,25 +111,8 @@ namespace Dynamics
 		const SpMat& C = GetC(s, cBuf);
 		const SpMat& M = GetM(s, mBuf);
 
-		// 1. 初始化第一项
-		if (std::abs(kCoeff - 1.0) < EPSILON_ZERO) 
-			outKeff = K;
-		else 
-			outKeff = kCoeff * K;
-
-		// 2. 累加后续项（Eigen 稀疏矩阵的 += 会处理好内存，无需 noalias）
-		if (C.nonZeros() > 0) 
-		{
-			if (std::abs(cCoeff - 1.0) < EPSILON_ZERO) 
-				outKeff += C;
-			else
-				outKeff += cCoeff * C;
-		}
-
-		if (std::abs(mCoeff - 1.0) < EPSILON_ZERO)
-			outKeff += M;
-		else
-			outKeff += mCoeff * M;
+		// 通过预先建立的并集模式直接累加值数组
+		m_KeffPattern.Combine(kCoeff, K, cCoeff, C, mCoeff, M, outKeff);
 	}
 
 	// 给定(x,v,t), 求解满足 Φ(x, v, a, t) = 0 的加速度 a
@@ -99,9 +179,9 @@ namespace Dynamics
 		const SpMat& k) :
 		ModelBase(m.rows()), m_M(m), m_C(c), m_K(k)
 	{
-		assert(m_M.cols() == m_Dofs);
-		assert(m_C.cols() == m_Dofs && m_C.rows() == m_Dofs);
-		assert(m_K.cols() == m_Dofs && m_K.rows() == m_Dofs);
+		assert(m_M.cols() == static_cast<Eigen::Index>(m_Dofs));
+		assert(m_C.cols() == static_cast<Eigen::Index>(m_Dofs) && m_C.rows() == static_cast<Eigen::Index>(m_Dofs));
+		assert(m_K.cols() == static_cast<Eigen::Index>(m_Dofs) && m_K.rows() == static_cast<Eigen::Index>(m_Dofs));
 
 		m_solverM.compute(m_M);
 		if (m_solverM.info() != Eigen::Success)
@@ -110,26 +190,22 @@ namespace Dynamics
 		}
 	}
 
-	void ModelLinear::ComputeKeff(const State& s, double kCoeff, double cCoeff, double mCoeff, SpMat& outKeff, SpMat& kBuf, SpMat& cBuf, SpMat& mBuf) const
-	{// 计算切线矩阵
-		// 1. 初始化第一项
-		outKeff = m_K;
-		if (std::abs(kCoeff - 1.0) > EPSILON_ZERO)
-			outKeff *= kCoeff; // 原地乘法，不改变结构
-
-		// 2. 累加后续项（Eigen 稀疏矩阵的 += 会处理好内存，无需 noalias）
-		if (m_C.nonZeros() > 0)
+	bool ModelLinear::EvalForce(double t) const
+	{// 计算外力，优先使用写入缓存的形式
+		if (m_func_force_inplace)
 		{
-			if (std::abs(cCoeff - 1.0) < EPSILON_ZERO)
-				outKeff += m_C;
-			else
-				outKeff += cCoeff * m_C;
+			if (m_ForceBuffer.size() != static_cast<Eigen::Index>(m_Dofs))
+				m_ForceBuffer.setZero(m_Dofs);
+			m_func_force_inplace(t, m_ForceBuffer);
+			return true;
 		}
-
-		if (std::abs(mCoeff - 1.0) < EPSILON_ZERO)
-			outKeff += m_M;
-		else
-			outKeff += mCoeff * m_M;
+		if (m_func_force)
+		{
+			m_ForceBuffer = m_func_force(t);
+			assert(m_ForceBuffer.size() == static_cast<Eigen::Index>(m_Dofs) && "Force vector size mismatch!");
+			return true;
+		}
+		return false;
 	}
 
 	void ModelLinear::SolveAcceleration(State& state) const
@@ -142,12 +218,9 @@ namespace Dynamics
 		RHS.noalias() -= m_C * state.v;
 
 		// 3. 处理外力
-		if (m_func_force != nullptr)
+		if (EvalForce(state.t))
 		{
-			// 建议在这里也加一个断言，防止 lambda 返回错误维度的向量
-			Vec force = m_func_force(state.t);
-			assert(force.size() == m_Dofs && "Force vector size mismatch!");
-			RHS.noalias() += force;
+			RHS += m_ForceBuffer;
 		}
 
 		// 4. 求解
@@ -159,7 +232,7 @@ namespace Dynamics
 		R_out.noalias() = m_M * s.a;
 		R_out.noalias() += m_C * s.v;
 		R_out.noalias() += m_K * s.x;
-		if (m_func_force) R_out.noalias() -= m_func_force(s.t);
+		if (EvalForce(s.t)) R_out -= m_ForceBuffer;
 	}
 
 }// namespace Dynamics
@@ -2,6 +2,7 @@
 #pragma once
 #include <Eigen/Sparse>
 #include <functional>
+#include <vector>
 
 namespace Dynamics
 {//动力学名字空间
@@ -27,10 +28,36 @@ namespace Dynamics
     // 定义观察者函数类型
     using Observer = std::function<void(const State&)>;
 
+    class KeffPattern
+    {// K_eff = kCoeff*K + cCoeff*C + mCoeff*M 的并集稀疏模式缓存
+     // 首次组装时建立 K、C、M 的并集模式，并记录各矩阵每个非零元在 K_eff 值数组中的位置；
+     // 之后每次组装只对值数组做 AXPY，不再产生稀疏矩阵的临时量和内存分配
+    public:
+        // 组装 outKeff（模式不匹配时自动重建）
+        void Combine(double kCoeff, const SpMat& K,
+            double cCoeff, const SpMat& C,
+            double mCoeff, const SpMat& M,
+            SpMat& outKeff);
+
+        void Reset() { m_bValid = false; }
+        size_t GetBuildCount() const { return m_nBuild; }// 模式重建次数
+
+    private:
+        void Build(const SpMat& K, const SpMat& C, const SpMat& M, SpMat& outKeff);
+        // 按映射把 coeff*A 累加到 outKeff 的值数组，映射失效时返回 false
+        static bool Scatter(double coeff, const SpMat& A, const std::vector<int>& map, SpMat& outKeff);
+        static void BuildMap(const SpMat& A, const SpMat& outKeff, std::vector<int>& map);
+
+        std::vector<int> m_MapK, m_MapC, m_MapM;// 各矩阵非零元 -> K_eff 值数组下标
+        bool m_bValid = false;
+        size_t m_nBuild = 0;
+    };
+
     class ModelBase 
     {//模型基类，通用模型：Φ(x,v,a,t) = 0
     protected:
         size_t m_Dofs;//自由度
+        mutable KeffPattern m_KeffPattern;//切线矩阵并集模式缓存
 
     public:// 构造与析构
         ModelBase(size_t Dofs) : m_Dofs(Dofs) {}
@@ -62,6 +89,8 @@ namespace Dynamics
         Eigen::SimplicialLDLT<SpMat> m_solverM;//质量矩阵的Cholesky分解
         const SpMat &m_M, &m_C, &m_K;//质量矩阵、阻尼矩阵、刚度矩阵
         std::function<Vec(double)> m_func_force = nullptr;//外力函数
+        std::function<void(double, Vec&)> m_func_force_inplace = nullptr;//外力函数（写入缓存，无分配）
+        mutable Vec m_ForceBuffer;//外力缓存
 
     public://构造函数（要求外部的m,c,k在求解过程中一直存在）
         ModelLinear(const SpMat& m,//质量矩阵
@@ -70,6 +99,12 @@ namespace Dynamics
 
     public:// 成员函数（设置外力）
         void SetForceFunc(std::function<Vec(double)> f) { m_func_force = std::move(f); }
+        // 设置外力（直接写入传入的向量，积分循环内不分配内存）
+        void SetForceFuncInPlace(std::function<void(double, Vec&)> f) { m_func_force_inplace = std::move(f); }
+
+    protected:
+        // 计算 t 时刻外力并存入 m_ForceBuffer，未设置外力时返回 false
+        bool EvalForce(double t) const;
 
     protected:
         // 取得切线质量矩阵（忽略缓存）
@@ -81,10 +116,6 @@ namespace Dynamics
 
     public://基类接口实现
          bool IsLinear() const override { return true; }//线性模型
-         // 计算切线矩阵
-         virtual void ComputeKeff(const State& s,
-             double kCoeff, double cCoeff, double mCoeff,
-             SpMat& outKeff, SpMat& kBuf, SpMat& cBuf, SpMat& mBuf) const override;
        // 求解满足 Φ(x, v, a, t) = 0 的加速度 a
         void SolveAcceleration(State& s) const override;
         // 计算总残差 Φ(x,v,a,t)
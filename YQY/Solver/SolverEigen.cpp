@@ -0,0 +1,163 @@
+#include "SolverEigen.h"
+#include <Eigen/Eigenvalues>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace Dynamics
+{
+    bool SolverEigen::solve(const SpMat& A, const SpMat& B, Result& result)
+    {
+        if (A.rows() != A.cols() || B.rows() != A.rows() || B.cols() != A.cols()) return false;
+
+        Eigen::SimplicialLDLT<SpMat> factor;
+        if (param.shift != 0.0)
+        {// 移位矩阵 A - σB
+            SpMat shifted = A - param.shift * B;
+            factor.compute(shifted);
+        }
+        else
+        {
+            factor.compute(A);
+        }
+        if (factor.info() != Eigen::Success) return false;
+
+        return solve(factor, A, B, result);
+    }
+
+    bool SolverEigen::solve(const Eigen::SimplicialLDLT<SpMat>& factor, const SpMat& A, const SpMat& B, Result& result)
+    {
+        const Eigen::Index n = A.rows();
+        const Eigen::Index nModes = std::min<Eigen::Index>(param.n_modes, n);
+        if (nModes <= 0) return false;
+
+        Eigen::Index p = param.n_subspace > 0 ? param.n_subspace : std::max<Eigen::Index>(2 * nModes, nModes + 8);
+        p = std::max(nModes, std::min(p, n));
+
+        Eigen::MatrixXd X(n, p), Y(n, p), Xbar(n, p), BXbar(n, p);
+        Eigen::MatrixXd Ar(p, p), Br(p, p), Q(p, p);
+        init_subspace(B, X);
+
+        Vec lambda = Vec::Zero(p), lambda_old = Vec::Zero(p);
+        std::vector<Eigen::Index> order(p);
+
+        result.converged = false;
+        result.iterations = 0;
+
+        for (int iter = 1; iter <= param.max_iter; ++iter)
+        {
+            // 1. 逆迭代：X' = (A - σB)^{-1} B X
+            Y.noalias() = B * X;
+            block_solve(factor, Y, Xbar);
+
+            // 2. 投影：Ar = X'ᵀ(A-σB)X' = X'ᵀY，Br = X'ᵀBX'
+            BXbar.noalias() = B * Xbar;
+            Ar.noalias() = Xbar.transpose() * Y;
+            Br.noalias() = Xbar.transpose() * BXbar;
+            Ar = 0.5 * (Ar + Ar.transpose()).eval();
+            Br = 0.5 * (Br + Br.transpose()).eval();
+
+            // 3. 子空间内求解 Br q = ν Ar q
+            Eigen::GeneralizedSelfAdjointEigenSolver<Eigen::MatrixXd> ges(Br, Ar);
+            if (ges.info() != Eigen::Success) return false;
+
+            // ν 降序排列 => λ = σ + 1/ν 在 σ 以上升序
+            const Vec& nu = ges.eigenvalues();
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&nu](Eigen::Index a, Eigen::Index b) { return nu[a] > nu[b]; });
+
+            for (Eigen::Index j = 0; j < p; ++j)
+            {
+                const double v = nu[order[j]];
+                lambda[j] = std::abs(v) > EPSILON_ZERO ? param.shift + 1.0 / v : std::numeric_limits<double>::infinity();
+                Q.col(j) = ges.eigenvectors().col(order[j]);
+            }
+
+            // 4. 更新 Ritz 向量
+            X.noalias() = Xbar * Q;
+            result.iterations = iter;
+
+            // 5. 收敛判断（只检查所需的前 nModes 个）
+            if (iter > 1)
+            {
+                bool bConverged = true;
+                for (Eigen::Index j = 0; j < nModes && bConverged; ++j)
+                {
+                    const double scale = std::max(std::abs(lambda[j]), EPSILON_ZERO);
+                    bConverged = std::abs(lambda[j] - lambda_old[j]) <= param.tol * scale;
+                }
+                if (bConverged)
+                {
+                    result.converged = true;
+                    break;
+                }
+            }
+            lambda_old = lambda;
+        }
+
+        result.values = lambda.head(nModes);
+        result.vectors = X.leftCols(nModes);
+        normalize(B, result.vectors);
+        return true;
+    }
+
+    void SolverEigen::init_subspace(const SpMat& B, Eigen::MatrixXd& X) const
+    {
+        std::mt19937 gen(5489u);// 固定种子，保证结果可重复
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        for (Eigen::Index j = 0; j < X.cols(); ++j)
+        {
+            for (Eigen::Index i = 0; i < X.rows(); ++i) X(i, j) = dist(gen);
+        }
+
+        Vec diag = B.diagonal().cwiseAbs();
+        if (diag.maxCoeff() > EPSILON_ZERO) X.col(0) = diag;
+    }
+
+    void SolverEigen::block_solve(const Eigen::SimplicialLDLT<SpMat>& factor, const Eigen::MatrixXd& Y, Eigen::MatrixXd& X) const
+    {
+        const Eigen::Index nCols = Y.cols();
+        const Eigen::Index nThreads = std::min<Eigen::Index>(std::max(param.n_threads, 1), nCols);
+        if (nThreads <= 1)
+        {
+            X = factor.solve(Y);
+            return;
+        }
+
+        // 分解只读，各线程回代互不相同的列块，写入 X 的不同列，无需加锁
+        X.resize(Y.rows(), nCols);
+        std::vector<std::thread> workers;
+        workers.reserve(nThreads);
+        const Eigen::Index chunk = (nCols + nThreads - 1) / nThreads;
+        for (Eigen::Index begin = 0; begin < nCols; begin += chunk)
+        {
+            const Eigen::Index count = std::min(chunk, nCols - begin);
+            workers.emplace_back([&factor, &Y, &X, begin, count]()
+                {
+                    X.middleCols(begin, count) = factor.solve(Y.middleCols(begin, count));
+                });
+        }
+        for (auto& worker : workers) worker.join();
+    }
+
+    void SolverEigen::normalize(const SpMat& B, Eigen::MatrixXd& vectors)
+    {
+        for (Eigen::Index j = 0; j < vectors.cols(); ++j)
+        {
+            auto phi = vectors.col(j);
+
+            Eigen::Index iMax = 0;
+            const double maxAbs = phi.cwiseAbs().maxCoeff(&iMax);
+            if (maxAbs <= 0.0) continue;
+
+            const double m = phi.dot(B * phi);
+            double scale = m > EPSILON_ZERO * maxAbs * maxAbs ? 1.0 / std::sqrt(m) : 1.0 / maxAbs;
+            if (phi[iMax] < 0.0) scale = -scale;// 最大分量取正，保证符号确定
+            phi *= scale;
+        }
+    }
+}
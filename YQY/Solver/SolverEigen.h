@@ -0,0 +1,50 @@
+#pragma once
+#include "ModelBase.h"
+#include <Eigen/Dense>
+#include <Eigen/SparseCholesky>
+
+namespace Dynamics
+{
+    class SolverEigen
+    {// 稀疏广义特征值求解：A φ = λ B φ，求 σ 附近（σ 以上）最小的若干个 λ
+     // 采用移位求逆子空间迭代：(A - σB) 只分解一次，每轮迭代仅做回代
+     // 投影问题写成 Br q = ν Ar q（Ar = X'ᵀ(A-σB)X' 对称正定），λ = σ + 1/ν，
+     // 因此 B 可以是半正定（质量矩阵含无质量自由度）或不定（屈曲的 -Kg）
+    public:
+        struct Parameters
+        {
+            int n_modes = 10;        // 所需特征对个数
+            int n_subspace = 0;      // 子空间维数，<= 0 时取 max(2n, n+8)
+            double shift = 0.0;      // 移位 σ
+            int max_iter = 100;      // 最大迭代次数
+            double tol = 1e-8;       // 特征值相对变化收敛容差
+            int n_threads = 1;       // 块回代线程数（各线程共享同一分解，按列分块回代）
+        } param;
+
+        struct Result
+        {
+            Vec values;              // 特征值 λ（升序）
+            Eigen::MatrixXd vectors; // 特征向量（按列，B 正定方向上按 φᵀBφ = 1 归一化，否则按最大分量归一化）
+            int iterations = 0;      // 实际迭代次数
+            bool converged = false;  // 是否收敛
+        };
+
+    public:
+        SolverEigen() {}
+        SolverEigen(Parameters p) : param(p) {}
+
+        // 求解 A φ = λ B φ，A、B 为对称矩阵；失败（分解失败或维数不足）返回 false
+        bool solve(const SpMat& A, const SpMat& B, Result& result);
+
+        // 使用已分解的 (A - σB) 求解（可在多个求解之间复用同一分解）
+        bool solve(const Eigen::SimplicialLDLT<SpMat>& factor, const SpMat& A, const SpMat& B, Result& result);
+
+    private:
+        // 初始子空间：第一列取 B 的对角（有质量的自由度），其余为固定种子的伪随机向量
+        void init_subspace(const SpMat& B, Eigen::MatrixXd& X) const;
+        // 按列回代 X = (A - σB)^{-1} Y（n_threads > 1 时按列分块并行）
+        void block_solve(const Eigen::SimplicialLDLT<SpMat>& factor, const Eigen::MatrixXd& Y, Eigen::MatrixXd& X) const;
+        // 结果向量归一化
+        static void normalize(const SpMat& B, Eigen::MatrixXd& vectors);
+    };
+}
@@ -0,0 +1,122 @@
+#include "SolverHarmonic.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Dynamics
+{
+    bool SolverHarmonic::solve_one(Worker& worker, const SpMat& K, const SpMat& C, const SpMat& M,
+        const CVec& F, double omega, CVec& u)
+    {
+        // 实部 K - ω²M 与虚部 ωC 共用同一并集模式（系数为 0 时仍按模式散布）
+        worker.patternRe.Combine(1.0, K, 0.0, C, -omega * omega, M, worker.re);
+        worker.patternIm.Combine(0.0, K, omega, C, 0.0, M, worker.im);
+
+        if (!worker.analyzed || worker.A.nonZeros() != worker.re.nonZeros())
+        {// 首次（或模式重建后）建立复矩阵结构并做符号分析
+            worker.A = worker.re.cast<std::complex<double>>();
+            worker.A.makeCompressed();
+            worker.lu.analyzePattern(worker.A);
+            worker.analyzed = true;
+        }
+
+        const double* pRe = worker.re.valuePtr();
+        const double* pIm = worker.im.valuePtr();
+        std::complex<double>* pA = worker.A.valuePtr();
+        for (Eigen::Index k = 0; k < worker.A.nonZeros(); ++k)
+        {
+            pA[k] = std::complex<double>(pRe[k], pIm[k]);
+        }
+
+        worker.lu.factorize(worker.A);
+        if (worker.lu.info() != Eigen::Success) return false;
+
+        u = worker.lu.solve(F);
+        return worker.lu.info() == Eigen::Success;
+    }
+
+    bool SolverHarmonic::solve(const SpMat& K, const SpMat& C, const SpMat& M, const Vec& F,
+        const std::vector<double>& omegas, const FrequencyObserver& observer)
+    {
+        const size_t nFreq = omegas.size();
+        if (0 == nFreq) return true;
+
+        // 保证输入为压缩格式，使并集模式缓存生效
+        SpMat Kc = K, Cc = C, Mc = M;
+        Kc.makeCompressed();
+        Cc.makeCompressed();
+        Mc.makeCompressed();
+        const CVec Fc = F.cast<std::complex<double>>();
+
+        const size_t nThreads = std::min<size_t>(std::max(param.n_threads, 1), nFreq);
+        bool bAllSucceeded = true;
+
+        if (nThreads <= 1)
+        {// 串行：一个工作区，逐频率求解并立即回调
+            Worker worker;
+            CVec u;
+            for (size_t i = 0; i < nFreq; ++i)
+            {
+                if (!solve_one(worker, Kc, Cc, Mc, Fc, omegas[i], u))
+                {
+                    bAllSucceeded = false;
+                    continue;
+                }
+                if (observer) observer(i, omegas[i], u);
+            }
+            return bAllSucceeded;
+        }
+
+        // 并行：工作线程按原子计数领取频率，结果放入对应槽位；调用线程按顺序取出回调
+        std::vector<CVec> results(nFreq);
+        std::vector<char> status(nFreq, 0);// 0 = 未完成，1 = 成功，2 = 失败
+        std::mutex mtx;
+        std::condition_variable cv;
+        std::atomic<size_t> next(0);
+
+        auto work = [&]()
+            {
+                auto pWorker = std::make_unique<Worker>();
+                CVec u;
+                for (size_t i = next.fetch_add(1); i < nFreq; i = next.fetch_add(1))
+                {
+                    bool ok = solve_one(*pWorker, Kc, Cc, Mc, Fc, omegas[i], u);
+                    {
+                        std::lock_guard<std::mutex> lock(mtx);
+                        if (ok) results[i].swap(u);
+                        status[i] = ok ? 1 : 2;
+                    }
+                    cv.notify_one();
+                }
+            };
+
+        std::vector<std::thread> workers;
+        workers.reserve(nThreads);
+        for (size_t t = 0; t < nThreads; ++t) workers.emplace_back(work);
+
+        for (size_t i = 0; i < nFreq; ++i)
+        {
+            CVec u;
+            bool ok = false;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv.wait(lock, [&]() { return 0 != status[i]; });
+                ok = (1 == status[i]);
+                if (ok) u.swap(results[i]);// 取出后释放槽位
+            }
+
+            if (!ok)
+            {
+                bAllSucceeded = false;
+                continue;
+            }
+            if (observer) observer(i, omegas[i], u);
+        }
+
+        for (auto& worker : workers) worker.join();
+        return bAllSucceeded;
+    }
+}
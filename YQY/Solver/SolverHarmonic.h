@@ -0,0 +1,48 @@
+#pragma once
+#include "ModelBase.h"
+#include <Eigen/SparseLU>
+#include <complex>
+#include <vector>
+
+namespace Dynamics
+{
+    using CVec = Eigen::VectorXcd;
+    using CSpMat = Eigen::SparseMatrix<std::complex<double>>;
+
+    class SolverHarmonic
+    {// 频域简谐响应：逐频率求解 (K + iωC - ω²M) u = F
+     // 复对称矩阵不能用 Hermitian 的 LDLT，采用复数 SparseLU；
+     // K、C、M 的并集模式只建立一次，每个工作线程对该模式只做一次符号分析，之后每个频率只做数值分解；
+     // 频率在工作线程间动态分配，结果在调用线程上按频率顺序依次回调
+    public:
+        struct Parameters
+        {
+            int n_threads = 1; // 工作线程数（<= 1 时在调用线程上串行求解）
+        } param;
+
+        // 结果回调：第 index 个频率 omega (rad/s) 的复位移幅值 u，按 index 升序在调用线程上调用
+        using FrequencyObserver = std::function<void(size_t index, double omega, const CVec& u)>;
+
+    public:
+        SolverHarmonic() {}
+        SolverHarmonic(Parameters p) : param(p) {}
+
+        // 对每个圆频率求解，某个频率分解失败时跳过该频率并返回 false
+        bool solve(const SpMat& K, const SpMat& C, const SpMat& M, const Vec& F,
+            const std::vector<double>& omegas, const FrequencyObserver& observer);
+
+    private:
+        struct Worker
+        {// 每个线程独立的工作区：模式缓存、实部/虚部、复矩阵与分解
+            KeffPattern patternRe, patternIm;
+            SpMat re, im;
+            CSpMat A;
+            Eigen::SparseLU<CSpMat> lu;
+            bool analyzed = false;
+        };
+
+        // 在 worker 上求解一个频率，成功返回 true
+        static bool solve_one(Worker& worker, const SpMat& K, const SpMat& C, const SpMat& M,
+            const CVec& F, double omega, CVec& u);
+    };
+}
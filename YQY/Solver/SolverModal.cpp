@@ -0,0 +1,111 @@
+#include "SolverModal.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace Dynamics
+{
+    SolverModal::Coeffs SolverModal::calc_coeffs(double omega, double zeta, double dt, double omega_rigid)
+    {
+        Coeffs c;
+        if (omega <= omega_rigid)
+        {// 刚体模态：q̈ = p(t) 直接积分
+            c.A = 1.0;  c.B = dt;  c.C = dt * dt / 3.0; c.D = dt * dt / 6.0;
+            c.Ad = 0.0; c.Bd = 1.0; c.Cd = dt / 2.0;     c.Dd = dt / 2.0;
+            return c;
+        }
+
+        const double k = omega * omega;// 单位模态质量下的模态刚度
+        const double r = std::sqrt(1.0 - zeta * zeta);
+        const double wD = omega * r;   // 有阻尼圆频率
+        const double e = std::exp(-zeta * omega * dt);
+        const double s = std::sin(wD * dt);
+        const double co = std::cos(wD * dt);
+        const double zr = zeta / r;
+        const double wdt = omega * dt;
+
+        c.A = e * (zr * s + co);
+        c.B = e * (s / wD);
+        c.C = (2.0 * zeta / wdt + e * (((1.0 - 2.0 * zeta * zeta) / (wD * dt) - zr) * s - (1.0 + 2.0 * zeta / wdt) * co)) / k;
+        c.D = (1.0 - 2.0 * zeta / wdt + e * ((2.0 * zeta * zeta - 1.0) / (wD * dt) * s + 2.0 * zeta / wdt * co)) / k;
+
+        c.Ad = -e * (omega / r * s);
+        c.Bd = e * (co - zr * s);
+        c.Cd = (-1.0 / dt + e * ((omega / r + zr / dt) * s + co / dt)) / k;
+        c.Dd = (1.0 - e * (zr * s + co)) / (k * dt);
+        return c;
+    }
+
+    void SolverModal::build_coeffs(const Vec& omega, double dt, std::vector<Coeffs>& coeffs) const
+    {
+        const double zeta = std::clamp(param.damping_ratio, 0.0, 0.999999);// 递推公式只适用于欠阻尼
+        // 刚体模态的 ω 只是舍入误差（量级随模型刚度变化），按谱中最大频率的相对值判断；
+        // 误当作弹性模态时递推系数中的 1/(ωΔt)、1/ω² 项严重相消
+        const double omega_rigid = omega.size() > 0 ? param.rigid_ratio * omega.maxCoeff() : 0.0;
+        coeffs.resize(omega.size());
+        for (Eigen::Index j = 0; j < omega.size(); ++j)
+        {
+            coeffs[j] = calc_coeffs(omega[j], zeta, dt, omega_rigid);
+        }
+    }
+
+    void SolverModal::step(const std::vector<Coeffs>& coeffs, const Vec& p0, const Vec& p1)
+    {
+        const Eigen::Index n = m_q.size();
+        for (Eigen::Index j = 0; j < n; ++j)
+        {
+            const Coeffs& c = coeffs[j];
+            const double q = m_q[j];
+            const double qd = m_qd[j];
+            m_q[j] = c.A * q + c.B * qd + c.C * p0[j] + c.D * p1[j];
+            m_qd[j] = c.Ad * q + c.Bd * qd + c.Cd * p0[j] + c.Dd * p1[j];
+        }
+    }
+
+    void SolverModal::compute_acceleration(const Vec& omega, const Vec& p)
+    {// q̈ = p - 2ζω q̇ - ω² q
+        const double zeta = std::clamp(param.damping_ratio, 0.0, 0.999999);
+        m_qdd = p.array() - 2.0 * zeta * omega.array() * m_qd.array() - omega.array().square() * m_q.array();
+    }
+
+    void SolverModal::solve(const Vec& omega, Vec& q, Vec& qd, double duration,
+        const ModalForce& force, const ModalObserver& observer)
+    {
+        const double dt = param.dt;
+        if (dt <= 0) throw std::runtime_error("dt must be > 0");
+
+        const Eigen::Index nModes = omega.size();
+        m_q = q;
+        m_qd = qd;
+        m_p0.setZero(nModes);
+        m_p1.setZero(nModes);
+
+        // 步数（最后一步可能不足整步）
+        const long nSteps = std::max(0L, static_cast<long>(std::ceil(duration / dt - 1e-9)));
+        const double lastDt = duration - (nSteps - 1) * dt;
+
+        build_coeffs(omega, dt, m_Coeffs);
+        const bool bShortLast = nSteps > 0 && std::abs(lastDt - dt) > 1e-12 * dt;
+        if (bShortLast) build_coeffs(omega, lastDt, m_CoeffsLast);
+
+        force(0.0, m_p0);
+        compute_acceleration(omega, m_p0);
+        if (observer) observer(0.0, m_q, m_qd, m_qdd);
+
+        for (long i = 1; i <= nSteps; ++i)
+        {
+            const bool bLast = (i == nSteps);
+            const double t = bLast ? duration : i * dt;
+
+            force(t, m_p1);
+            step(bLast && bShortLast ? m_CoeffsLast : m_Coeffs, m_p0, m_p1);
+            compute_acceleration(omega, m_p1);
+            if (observer) observer(t, m_q, m_qd, m_qdd);
+
+            m_p0.swap(m_p1);
+        }
+
+        q = m_q;
+        qd = m_qd;
+    }
+}
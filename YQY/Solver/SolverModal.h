@@ -0,0 +1,47 @@
+#pragma once
+#include "ModelBase.h"
+#include <vector>
+
+namespace Dynamics
+{
+    class SolverModal
+    {// 模态叠加：对解耦后的模态方程 q̈ + 2ζω q̇ + ω² q = p(t)（振型按质量归一化）
+     // 采用分段线性荷载的精确递推（Nigam–Jennings），结果与步长无关地精确，无数值阻尼和周期延长
+    public:
+        struct Parameters
+        {
+            double dt = 0.01;            // 荷载采样步长
+            double damping_ratio = 0.0;  // 各阶统一的模态阻尼比 ζ（取值 [0, 1)）
+            double rigid_ratio = 1e-6;   // ω <= rigid_ratio·max(ω) 的模态按刚体模态积分（唯一的刚体模态判据）
+        } param;
+
+        // 模态力回调：写入 t 时刻的模态力 p(t) = Φᵀ F(t)
+        using ModalForce = std::function<void(double t, Vec& p)>;
+        // 观察者回调：t 时刻的模态坐标、模态速度、模态加速度
+        using ModalObserver = std::function<void(double t, const Vec& q, const Vec& qd, const Vec& qdd)>;
+
+    private:
+        // 单个模态的递推系数：
+        // q(i+1)  = A  q + B  q̇ + C  p(i) + D  p(i+1)
+        // q̇(i+1) = Ad q + Bd q̇ + Cd p(i) + Dd p(i+1)
+        struct Coeffs { double A, B, C, D, Ad, Bd, Cd, Dd; };
+
+        static Coeffs calc_coeffs(double omega, double zeta, double dt, double omega_rigid);
+        void build_coeffs(const Vec& omega, double dt, std::vector<Coeffs>& coeffs) const;
+        void step(const std::vector<Coeffs>& coeffs, const Vec& p0, const Vec& p1);
+        void compute_acceleration(const Vec& omega, const Vec& p);
+
+    public:
+        SolverModal() {}
+        SolverModal(Parameters p) : param(p) {}
+
+        // 从 (q, qd) 开始积分 duration 时长，每个采样点调用一次 observer（含起始时刻）
+        void solve(const Vec& omega, Vec& q, Vec& qd, double duration,
+            const ModalForce& force, const ModalObserver& observer = nullptr);
+
+    private:
+        std::vector<Coeffs> m_Coeffs, m_CoeffsLast;// 常规步与最后一个不足整步的步
+        Vec m_q, m_qd, m_qdd;// 模态坐标工作区
+        Vec m_p0, m_p1;      // 相邻两个采样点的模态力
+    };
+}
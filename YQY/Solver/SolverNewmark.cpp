@@ -22,10 +22,89 @@ namespace Dynamics
         return c;
     }
 
-    void SolverNewmark::update_kinematics(State& s, const State& s_prev, const Coeffs& c) const
+    void SolverNewmark::predict(State& next, const State& curr, double dt, const Coeffs& c) const
     {
-        s.a = c.a0 * (s.x - s_prev.x) - c.a2 * s_prev.v - c.a3 * s_prev.a;
-        s.v = s_prev.v + c.a6 * s_prev.a + c.a7 * s.a;
+        const Eigen::Index n = curr.x.size();
+        const double* x0 = curr.x.data();
+        const double* v0 = curr.v.data();
+        const double* a0 = curr.a.data();
+        double* x = next.x.data();
+        double* v = next.v.data();
+        double* a = next.a.data();
+        const double half_dt2 = 0.5 * dt * dt;
+
+        for (Eigen::Index i = 0; i < n; ++i)
+        {// x = x0 + dt*v0 + 0.5*dt^2*a0，随后更新 a、v
+            const double xi = x0[i] + dt * v0[i] + half_dt2 * a0[i];
+            const double ai = c.a0 * (xi - x0[i]) - c.a2 * v0[i] - c.a3 * a0[i];
+            x[i] = xi;
+            a[i] = ai;
+            v[i] = v0[i] + c.a6 * a0[i] + c.a7 * ai;
+        }
+    }
+
+    void SolverNewmark::correct(State& next, const State& curr, const Vec& dx, const Coeffs& c) const
+    {
+        const Eigen::Index n = curr.x.size();
+        const double* x0 = curr.x.data();
+        const double* v0 = curr.v.data();
+        const double* a0 = curr.a.data();
+        const double* d = dx.data();
+        double* x = next.x.data();
+        double* v = next.v.data();
+        double* a = next.a.data();
+
+        for (Eigen::Index i = 0; i < n; ++i)
+        {// dx 为 Keff*dx = R 的解，增量取负号
+            const double xi = x[i] - d[i];
+            const double ai = c.a0 * (xi - x0[i]) - c.a2 * v0[i] - c.a3 * a0[i];
+            x[i] = xi;
+            a[i] = ai;
+            v[i] = v0[i] + c.a6 * a0[i] + c.a7 * ai;
+        }
+    }
+
+    void SolverNewmark::solve_in_place(LinearSolverCache& cache, Vec& rhs) const
+    {
+        if (!cache.use_ldlt)
+        {// SparseLU 的求解内部会申请工作区，无法避免
+            m_dx_workspace = cache.lu.solve(rhs);
+            rhs.swap(m_dx_workspace);
+            return;
+        }
+
+        // 展开 SimplicialLDLT::solve：Eigen 的 dest = Pinv*dest 为原地置换，会临时分配标记数组，
+        // 这里按置换下标在 rhs 与 m_dx_workspace 之间交替写入
+        const auto& ldlt = cache.ldlt;
+        const auto& perm = ldlt.permutationP().indices();
+        const Eigen::Index n = rhs.size();
+        if (perm.size() > 0) for (Eigen::Index i = 0; i < n; ++i) m_dx_workspace[perm[i]] = rhs[i];
+        else                 m_dx_workspace = rhs;
+
+        ldlt.matrixL().solveInPlace(m_dx_workspace);
+        m_dx_workspace.array() /= ldlt.diagonal().array();
+        ldlt.matrixU().solveInPlace(m_dx_workspace);
+
+        if (perm.size() > 0) for (Eigen::Index i = 0; i < n; ++i) rhs[i] = m_dx_workspace[perm[i]];
+        else                 rhs = m_dx_workspace;
+    }
+
+    void SolverNewmark::prepare_workspace(const State& state)
+    {
+        const Eigen::Index dofs = state.x.size();
+        auto ensure = [&](Vec& v)
+        {
+            if (v.size() != dofs) v.setZero(dofs);
+        };
+
+        ensure(m_R_workspace);
+        ensure(m_dx_workspace);
+        for (State* s : { &m_next, &m_coarse, &m_mid, &m_fine })
+        {
+            ensure(s->x);
+            ensure(s->v);
+            ensure(s->a);
+        }
     }
 
     // ==========================================
@@ -35,10 +114,11 @@ namespace Dynamics
         const State& curr, State& next,
         double dt, const Coeffs& c, LinearSolverCache* cache)
     {
+        ++m_stats.n_steps;
+
         // 1. 预测
         next.t = curr.t + dt;
-        next.x = curr.x + dt * curr.v + 0.5 * dt * dt * curr.a;
-        update_kinematics(next, curr, c);
+        predict(next, curr, dt, c);
 
         bool is_linear = model.IsLinear();
         int max_iters = is_linear ? 1 : param.max_iter;
@@ -88,9 +168,11 @@ namespace Dynamics
                         pCache->use_ldlt = true;
                     }
                     pCache->pattern_analyzed = true;
+                    ++m_stats.n_pattern_analyses;
                 }
 
                 // --- 数值分解 (Factorize) ---
+                ++m_stats.n_factorizations;
                 if (pCache->use_ldlt)
                 {
                     pCache->ldlt.factorize(m_K_eff_workspace);
@@ -132,16 +214,13 @@ namespace Dynamics
                 if (is_linear) matrix_needs_update = false;
             }
 
-            // C. 求解增量
+            // C. 求解增量 (Keff * dx = R，结果原地写回残差工作区，符号在校正中处理)
             // === 修改点：同样使用 Slot_A 作为回退 ===
             LinearSolverCache* pCache = cache ? cache : &m_cache_slot_A;
-
-            if (pCache->use_ldlt) m_dx_workspace = pCache->ldlt.solve(-m_R_workspace);
-            else                  m_dx_workspace = pCache->lu.solve(-m_R_workspace);
+            solve_in_place(*pCache, m_R_workspace);
 
             // D. 更新状态
-            next.x += m_dx_workspace;
-            update_kinematics(next, curr, c);
+            correct(next, curr, m_R_workspace, c);
         }
 
         return true;
@@ -156,13 +235,8 @@ namespace Dynamics
         if (duration <= 0) throw std::runtime_error("Duration must be > 0");
 
         // 工作区预分配
-        size_t dofs = model.GetDofs();
-        if (m_R_workspace.size() != dofs)
-        {
-            m_R_workspace.resize(dofs);
-            m_dx_workspace.resize(dofs);
-            m_K_eff_workspace.resize(dofs, dofs);
-        }
+        m_stats.reset();
+        prepare_workspace(state);
 
         reset_caches();
 
@@ -175,34 +249,34 @@ namespace Dynamics
             solve_fixed(model, state, duration, observer);
     }
 
-    void SolverNewmark::solve_fixed(const ModelBase& model, State& state, double duration, Observer observer)
+    void SolverNewmark::solve_fixed(const ModelBase& model, State& state, double duration, const Observer& observer)
     {
         auto c = calc_coeffs_for_dt(param.dt);
         int n_steps = (int)std::ceil(duration / param.dt);
-        State next = state;
 
         for (int step = 0; step < n_steps; ++step)
         {
             // 固定步长只使用 slot_A 即可
-            if (!step_integrate(model, state, next, param.dt, c, &m_cache_slot_A))
+            if (!step_integrate(model, state, m_next, param.dt, c, &m_cache_slot_A))
             {
                 throw std::runtime_error("Fixed step solver failed.");
             }
-            state = next;
+            std::swap(state, m_next);// 交换缓冲区，不拷贝数据
             if (observer) observer(state);
         }
     }
 
     // SolverNewmark.cpp
 
-    void SolverNewmark::solve_adaptive(const ModelBase& model, State& state, double duration, Observer observer)
+    void SolverNewmark::solve_adaptive(const ModelBase& model, State& state, double duration, const Observer& observer)
     {
         double t_current = 0.0;
         double dt = param.dt;
 
-        State s_coarse = state;
-        State s_mid = state;
-        State s_fine = state;
+        // 预分配的状态缓冲：step_integrate 会完整写入 next 的 t/x/v/a，因此试算前无需拷贝
+        State& s_coarse = m_coarse;
+        State& s_mid = m_mid;
+        State& s_fine = m_fine;
         int retry_count = 0;
 
         // --- 定义逻辑指针 ---
@@ -227,29 +301,33 @@ namespace Dynamics
                 try
                 {
                     // 1. 粗糙步 (dt) -> 使用 p_coarse
-                    s_coarse = state;
                     if (!step_integrate(model, state, s_coarse, dt, c_full, p_coarse))
                         throw std::runtime_error("Coarse step failed");
 
                     // 2. 精细步 1 (dt/2) -> 使用 p_fine_1 (保护这个缓存！)
-                    s_mid = state;
                     if (!step_integrate(model, state, s_mid, dt / 2.0, c_half, p_fine_1))
                         throw std::runtime_error("Fine step 1 failed");
 
                     // 3. 精细步 2 (dt/2) -> 使用 p_fine_2 (独立槽位，不覆盖 p_fine_1)
-                    s_fine = s_mid;
                     if (!step_integrate(model, s_mid, s_fine, dt / 2.0, c_half, p_fine_2))
                         throw std::runtime_error("Fine step 2 failed");
 
-                    // 4. 误差评估
-                    double diff = (s_fine.x - s_coarse.x).norm();
-                    double ref = s_fine.x.norm();
-                    double error = diff / (ref + 1e-10);
+                    // 4. 误差评估 (差值范数与参考范数一次遍历求出)
+                    double diff_sq = 0.0, ref_sq = 0.0;
+                    const double* xf = s_fine.x.data();
+                    const double* xc = s_coarse.x.data();
+                    for (Eigen::Index i = 0; i < s_fine.x.size(); ++i)
+                    {
+                        const double d = xf[i] - xc[i];
+                        diff_sq += d * d;
+                        ref_sq += xf[i] * xf[i];
+                    }
+                    double error = std::sqrt(diff_sq) / (std::sqrt(ref_sq) + 1e-10);
 
                     if (error < param.tol_adaptive)
                     {
                         step_accepted = true;
-                        state = s_fine;
+                        std::swap(state, s_fine);// 交换缓冲区，s_fine 下次会被完整覆盖
                         t_current += dt;
                         if (observer) observer(state);
 
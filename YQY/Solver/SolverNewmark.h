@@ -30,10 +30,29 @@ namespace Dynamics
     private:
         struct Coeffs { double a0, a1, a2, a3, a4, a5, a6, a7; };
 
+    public:
+        // --- 运行统计（堆分配次数由 Test/Test_SolverNewmark.cpp 用全局 operator new 计数检查） ---
+        struct Statistics
+        {
+            size_t n_steps = 0;                 // 积分步数（含被拒绝的试算步）
+            size_t n_factorizations = 0;        // 数值分解次数
+            size_t n_pattern_analyses = 0;      // 符号分析次数
+
+            void reset() { *this = Statistics(); }
+        };
+
+    private:
+        // SimplicialLDLT::vectorD() 按值返回（每次分解后都要复制一次），这里直接引用内部的 D 对角
+        class LDLT : public Eigen::SimplicialLDLT<SpMat>
+        {
+        public:
+            const Vec& diagonal() const { return m_diag; }
+        };
+
         // --- 增强型求解器缓存 (支持 LDLT/LU 自动切换) ---
         struct LinearSolverCache
         {
-            Eigen::SimplicialLDLT<SpMat> ldlt; // 首选 (快)
+            LDLT ldlt;                         // 首选 (快)
             Eigen::SparseLU<SpMat> lu;         // 备选 (通用)
 
             double cached_dt = -1.0;
@@ -50,15 +69,22 @@ namespace Dynamics
 
         // --- 内部辅助函数 ---
         Coeffs calc_coeffs_for_dt(double dt) const;
-        void update_kinematics(State& s, const State& s_prev, const Coeffs& c) const;
+        // 预测：位移预测与加速度、速度更新合并为一次遍历
+        void predict(State& next, const State& curr, double dt, const Coeffs& c) const;
+        // 校正：x -= dx 与加速度、速度更新合并为一次遍历
+        void correct(State& next, const State& curr, const Vec& dx, const Coeffs& c) const;
+        // 原地求解 Keff * y = rhs，结果写回 rhs（LDLT 路径不分配内存）
+        void solve_in_place(LinearSolverCache& cache, Vec& rhs) const;
+        // 工作区预分配（尺寸不变时不做任何分配）
+        void prepare_workspace(const State& state);
 
         // --- 统一的核心积分步 (Kernel) ---
         // 关键优化：传入指定的 Cache 指针，实现粗细步长的独立缓存
         bool step_integrate(const ModelBase& model, const State& curr, State& next,
             double dt, const Coeffs& c, LinearSolverCache* cache);
 
-        void solve_fixed(const ModelBase& model, State& state, double duration, Observer observer);
-        void solve_adaptive(const ModelBase& model, State& state, double duration, Observer observer);
+        void solve_fixed(const ModelBase& model, State& state, double duration, const Observer& observer);
+        void solve_adaptive(const ModelBase& model, State& state, double duration, const Observer& observer);
 
         void reset_caches() const
         {
@@ -68,10 +94,13 @@ namespace Dynamics
         }
 
     public:
-        SolverNewmark(Parameters p = Parameters()) : param(p) {}
+        SolverNewmark() {}
+        SolverNewmark(Parameters p) : param(p) {}
         void solve(const ModelBase& model, State& state, double duration,
             Observer observer = nullptr);
 
+        const Statistics& GetStatistics() const { return m_stats; }
+
     private:
         // --- 矩阵构建缓存 ---
         mutable SpMat m_KBuf, m_MBuf, m_CBuf;
@@ -81,6 +110,12 @@ namespace Dynamics
         mutable Vec m_R_workspace;
         mutable Vec m_dx_workspace;
 
+        // --- 状态缓冲 (预分配，通过 swap 轮换，不做整体拷贝) ---
+        State m_next;                // 固定步长：下一步
+        State m_coarse, m_mid, m_fine; // 自适应：粗糙步、半步、精细步
+
+        Statistics m_stats;
+
         mutable LinearSolverCache m_cache_slot_A;
         mutable LinearSolverCache m_cache_slot_B;
         mutable LinearSolverCache m_cache_slot_C; // 新增：用于保护 Fine 1 不被 Fine 2 覆盖
@@ -0,0 +1,109 @@
+﻿#pragma once
+/**
+ * @file TestFramework.h
+ * @brief 单元测试与基准测试的最小框架（YQY_Test 工程使用）
+ *
+ * TEST_CASE 定义的测试默认全部运行；BENCHMARK_CASE 定义的基准测试只在命令行带 --benchmark 时运行。
+ * 检查失败时抛出 Test::Failure，当前测试终止并记为失败，其余测试继续运行。
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Test
+{
+    /**
+     * @brief 检查失败
+     */
+    class Failure : public std::runtime_error
+    {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    /**
+     * @brief 一个测试
+     */
+    struct Case
+    {
+        std::string m_Name;            ///< 名称
+        std::function<void()> m_Func;  ///< 测试函数
+        bool m_bBenchmark = false;     ///< 是否为基准测试
+    };
+
+    /**
+     * @brief 全部测试（按注册顺序）
+     */
+    std::vector<Case>& Registry();
+
+    /**
+     * @brief 静态注册器
+     */
+    struct Registrar
+    {
+        Registrar(const char* name, void (*func)(), bool bBenchmark) { Registry().push_back({ name, func, bBenchmark }); }
+    };
+
+    /**
+     * @brief 抛出 Failure
+     */
+    [[noreturn]] void Fail(const char* file, int line, const std::string& message);
+
+    /**
+     * @brief 进程启动以来的堆分配次数（全局 operator new 计数）
+     */
+    size_t AllocationCount();
+
+    /**
+     * @brief 临时目录下的文件路径（测试结束后由调用者删除）
+     */
+    std::string TempPath(const std::string& name);
+
+    /**
+     * @brief 把文本写入文件
+     */
+    void WriteText(const std::string& path, const std::string& text);
+
+    /**
+     * @brief 读取文件全部内容
+     */
+    std::string ReadText(const std::string& path);
+}
+
+#define TEST_CONCAT_IMPL(a, b) a##b
+#define TEST_CONCAT(a, b) TEST_CONCAT_IMPL(a, b)
+
+/// 定义测试
+#define TEST_CASE(name) \
+    static void name(); \
+    static Test::Registrar TEST_CONCAT(s_Registrar_, name)(#name, &name, false); \
+    static void name()
+
+/// 定义基准测试
+#define BENCHMARK_CASE(name) \
+    static void name(); \
+    static Test::Registrar TEST_CONCAT(s_Registrar_, name)(#name, &name, true); \
+    static void name()
+
+/// 条件为假时失败
+#define CHECK(cond) \
+    do { if (!(cond)) Test::Fail(__FILE__, __LINE__, "CHECK(" #cond ")"); } while (0)
+
+/// 两值不等时失败
+#define CHECK_EQUAL(a, b) \
+    do { \
+        const auto& _a = (a); const auto& _b = (b); \
+        if (!(_a == _b)) { std::ostringstream _o; _o << "CHECK_EQUAL(" #a ", " #b "): " << _a << " != " << _b; Test::Fail(__FILE__, __LINE__, _o.str()); } \
+    } while (0)
+
+/// 两值之差超过 tol 时失败
+#define CHECK_NEAR(a, b, tol) \
+    do { \
+        const double _a = (a), _b = (b); \
+        if (!(std::abs(_a - _b) <= (tol))) { std::ostringstream _o; _o << "CHECK_NEAR(" #a ", " #b "): " << _a << " vs " << _b; Test::Fail(__FILE__, __LINE__, _o.str()); } \
+    } while (0)
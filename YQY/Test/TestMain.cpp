@@ -0,0 +1,107 @@
+﻿#include "TestFramework.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <new>
+
+// 全局 operator new 计数，用于检查热循环中没有堆分配
+static std::atomic<size_t> s_nAllocation{0};
+
+void* operator new(std::size_t size)
+{
+    s_nAllocation.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace Test
+{
+    std::vector<Case>& Registry()
+    {
+        static std::vector<Case> s_Cases;
+        return s_Cases;
+    }
+
+    void Fail(const char* file, int line, const std::string& message)
+    {
+        std::ostringstream o;
+        o << file << ":" << line << ": " << message;
+        throw Failure(o.str());
+    }
+
+    size_t AllocationCount()
+    {
+        return s_nAllocation.load(std::memory_order_relaxed);
+    }
+
+    std::string TempPath(const std::string& name)
+    {
+        return (std::filesystem::temp_directory_path() / ("yqy_test_" + name)).string();
+    }
+
+    void WriteText(const std::string& path, const std::string& text)
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << text;
+    }
+
+    std::string ReadText(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::ostringstream o;
+        o << file.rdbuf();
+        return o.str();
+    }
+}
+
+/**
+ * @brief 用法：YQY_Test [--benchmark] [名称过滤]
+ *
+ * 不带 --benchmark 时运行全部单元测试；带 --benchmark 时只运行基准测试。名称过滤为子串匹配。
+ * 返回失败的测试个数。
+ */
+int main(int argc, char* argv[])
+{
+    bool bBenchmark = false;
+    std::string filter;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if ("--benchmark" == arg) bBenchmark = true;
+        else filter = arg;
+    }
+
+    int nRun = 0, nFailed = 0;
+    for (const Test::Case& test : Test::Registry())
+    {
+        if (test.m_bBenchmark != bBenchmark) continue;
+        if (!filter.empty() && test.m_Name.find(filter) == std::string::npos) continue;
+
+        ++nRun;
+        const auto start = std::chrono::steady_clock::now();
+        try
+        {
+            test.m_Func();
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            std::printf("[  OK  ] %s (%.0f ms)\n", test.m_Name.c_str(), ms);
+        }
+        catch (const std::exception& e)
+        {
+            ++nFailed;
+            std::printf("[FAILED] %s\n         %s\n", test.m_Name.c_str(), e.what());
+        }
+        std::fflush(stdout);
+    }
+
+    std::printf("\n%d run, %d failed\n", nRun, nFailed);
+    return nFailed;
+}
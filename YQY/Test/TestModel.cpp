@@ -0,0 +1,45 @@
+﻿#include "TestModel.h"
+#include "TestFramework.h"
+#include "DataStructure/Structure/StructureData.h"
+#include "Import/Input_Model.h"
+#include <cstdio>
+
+namespace Test
+{
+    std::shared_ptr<StructureData> LoadModel(const std::string& text, const std::string& name)
+    {
+        const std::string path = TempPath(name);
+        WriteText(path, text);
+
+        auto pStructure = std::make_shared<StructureData>();
+        Input_Model input;
+        const bool bRead = input.InputData(QString::fromStdString(path), pStructure);
+        std::remove(path.c_str());
+        return bRead ? pStructure : nullptr;
+    }
+
+    const char* const TwoBarModel =
+        "*Material,1\n"
+        "1  2e11  0.3  7800  200  0.1\n"
+        "*Section,1\n"
+        "1  0.02\n"
+        "*Node,3\n"
+        "1  0.0  0.0  0.0\n"
+        "2  5.0  -5.5  0.0\n"
+        "3  10.0  0.0  0.0\n"
+        "*Element T3D2 2\n"
+        "1  1  2  1  1\n"
+        "2  2  3  1  1\n"
+        "*Constraint,7\n"
+        "1  1  0  0\n"
+        "2  1  1  0\n"
+        "3  1  2  0\n"
+        "4  3  0  0\n"
+        "5  3  1  0\n"
+        "6  3  2  0\n"
+        "7  2  2  0\n"
+        "*Load FORCE_NODE 1\n"
+        "1  2  1  -1e5  1\n"
+        "*Analysis_Step,1\n"
+        "1  Static  1  0.5  1e-5  1000\n";
+}
@@ -0,0 +1,26 @@
+﻿#pragma once
+/**
+ * @file TestModel.h
+ * @brief 测试用模型：由关键字格式文本建立结构数据
+ */
+
+#include <memory>
+#include <string>
+
+class StructureData;
+
+namespace Test
+{
+    /**
+     * @brief 把文本写入临时文件并用 Input_Model 读取（读取后删除临时文件）
+     * @param [in] text 关键字格式模型文本
+     * @param [in] name 临时文件名
+     * @return 结构数据，读取失败返回空指针
+     */
+    std::shared_ptr<StructureData> LoadModel(const std::string& text, const std::string& name);
+
+    /**
+     * @brief 两杆三铰模型（节点 2 在 X、Y 方向自由，竖向荷载），含一个静力分析步
+     */
+    extern const char* const TwoBarModel;
+}
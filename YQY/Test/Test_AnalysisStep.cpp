@@ -0,0 +1,465 @@
+﻿#include "TestFramework.h"
+#include "TestModel.h"
+#include "DataStructure/Structure/StructureData.h"
+#include "DataStructure/AnalysisStep/AnalysisStep.h"
+#include "DataStructure/Element/ElementBase.h"
+#include "DataStructure/Element/ElementBatch.h"
+#include "DataStructure/Element/ElementCable.h"
+#include "Import/ModelGenerator.h"
+#include "Export/OutputRequest.h"
+#include "DataStructure/Element/ElementBeam.h"
+#include "Solver/Solver.h"
+
+namespace
+{
+    /**
+     * @brief 用各项互不相同的合成单元矩阵核对组装模式：Scatter 的结果与按单元自由度直接叠加的参考矩阵相同
+     */
+    void CheckSyntheticScatter(const CompactModel& model, int nFixed, int nFree)
+    {
+        AssemblyPattern pattern;
+        pattern.Build(model, nFixed, nFree);
+
+        SpMat K11, K21, K22;
+        pattern.Reset(AssemblyPattern::Part::K11, K11);
+        pattern.Reset(AssemblyPattern::Part::K21, K21);
+        pattern.Reset(AssemblyPattern::Part::K22, K22);
+
+        MatrixXd reference = MatrixXd::Zero(nFixed + nFree, nFixed + nFree);
+        std::vector<double> buffer;
+        for (const ElementBlock& block : model.m_Blocks)
+        {
+            buffer.clear();
+            for (int e = block.m_Begin; e < block.m_End; ++e)
+            {
+                const int nDOF = model.m_ElemDofPtr[e + 1] - model.m_ElemDofPtr[e];
+                const int* DOFs = model.m_ElemDof.data() + model.m_ElemDofPtr[e];
+                for (int j = 0; j < nDOF; ++j)
+                {
+                    for (int i = 0; i < nDOF; ++i)
+                    {
+                        const double value = 1.0 + e + 0.01 * (i + nDOF * j);
+                        buffer.push_back(value);
+                        reference(DOFs[i], DOFs[j]) += value;
+                    }
+                }
+            }
+            pattern.Scatter(block.m_Begin, block.m_End, buffer, &K11, &K21, K22);
+        }
+
+        CHECK_NEAR((MatrixXd(K11) - reference.topLeftCorner(nFixed, nFixed)).norm(), 0.0, 1e-12);
+        CHECK_NEAR((MatrixXd(K21) - reference.bottomLeftCorner(nFree, nFixed)).norm(), 0.0, 1e-12);
+        CHECK_NEAR((MatrixXd(K22) - reference.bottomRightCorner(nFree, nFree)).norm(), 0.0, 1e-12);
+    }
+}
+
+TEST_CASE(AnalysisStep_BuckleSpringBracedColumn)
+{
+    // 竖杆 1-2 受压，顶端由水平杆 2-3 侧向支撑（相当于弹簧 k = EA₂/L₂）；
+    // 刚性压杆的临界荷载为 P_cr = k·L，竖向的临界系数为 EA₁/P 量级，远大于侧向
+    const char* const model =
+        "*Material,1\n"
+        "1  2e11  0.3  7800  200  0.1\n"
+        "*Section,2\n"
+        "1  0.05\n"
+        "2  0.01\n"
+        "*Node,3\n"
+        "1  0.0  0.0  0.0\n"
+        "2  0.0  4.0  0.0\n"
+        "3  2.0  4.0  0.0\n"
+        "*Element T3D2 2\n"
+        "1  1  2  1  1\n"
+        "2  2  3  1  2\n"
+        "*Constraint,7\n"
+        "1  1  0  0\n"
+        "2  1  1  0\n"
+        "3  1  2  0\n"
+        "4  3  0  0\n"
+        "5  3  1  0\n"
+        "6  3  2  0\n"
+        "7  2  2  0\n"
+        "*Load FORCE_NODE 1\n"
+        "1  2  1  -1e5  1\n"
+        "*Analysis_Step,1\n"
+        "1  Buckle  1  1  1e-5  100  2\n";
+
+    auto pStructure = Test::LoadModel(model, "buckle_column.txt");
+    CHECK(pStructure);
+
+    Solver solver;
+    solver.SetStructure(pStructure);
+    solver.RunAll();
+
+    const double k = 2e11 * std::acos(-1.0) * 0.01 * 0.01 / 2.0;  // 截面按半径输入
+    const double lambda = k * 4.0 / 1e5;
+
+    const ResultStore& store = pStructure->GetOutputter().GetStore();
+    CHECK_EQUAL(store.FrameCount(), size_t(2));
+    CHECK_NEAR(store.GetTime(0) / lambda, 1.0, 1e-6);
+    CHECK(store.GetTime(1) > 100.0 * lambda);
+
+    // 第一阶屈曲模态为顶端侧移（按最大分量归一化）
+    CHECK_NEAR(std::abs(store.GetValue(0, 2, DataType::U1)), 1.0, 1e-9);
+    CHECK_NEAR(store.GetValue(0, 2, DataType::U2), 0.0, 1e-9);
+}
+
+TEST_CASE(AnalysisStep_FrequencyAxialChain)
+{
+    // 两根等长杆沿斜向 (2,1,2)/3 串联 1-2-3，节点 1 固定，节点 2、3 三个方向都自由：
+    // 轴向为两自由度链，两个横向没有刚度（四个零频模态，刚度矩阵奇异，分解需要负移位）。
+    // 集中质量 M = ρAL·diag(1, 1/2)，K = (EA/L)[[2,-1],[-1,1]]，故 ω² = (E/(ρL²))·(2 ∓ √2)
+    const char* const model =
+        "*Material,1\n"
+        "1  2e11  0.3  7800  200  0.1\n"
+        "*Section,1\n"
+        "1  0.02\n"
+        "*Node,3\n"
+        "1  0.0  0.0  0.0\n"
+        "2  2.0  1.0  2.0\n"
+        "3  4.0  2.0  4.0\n"
+        "*Element T3D2 2\n"
+        "1  1  2  1  1\n"
+        "2  2  3  1  1\n"
+        "*Constraint,3\n"
+        "1  1  0  0\n"
+        "2  1  1  0\n"
+        "3  1  2  0\n"
+        "*Analysis_Step,1\n"
+        "1  Frequency  1  1  1e-5  100  6  0  1e-12  200\n";
+
+    auto pStructure = Test::LoadModel(model, "frequency_chain.txt");
+    CHECK(pStructure);
+
+    Solver solver;
+    solver.SetStructure(pStructure);
+    solver.RunAll();
+
+    const double L = 3.0;
+    const double base = 2e11 / (7800 * L * L);
+    const double f1 = std::sqrt(base * (2.0 - std::sqrt(2.0))) / (2.0 * PI);
+    const double f2 = std::sqrt(base * (2.0 + std::sqrt(2.0))) / (2.0 * PI);
+
+    // 帧时间为频率（Hz），升序：四个零频的横向模态，然后是两个轴向模态
+    const ResultStore& store = pStructure->GetOutputter().GetStore();
+    CHECK_EQUAL(store.FrameCount(), size_t(6));
+    for (size_t frame = 0; frame < 4; ++frame) CHECK(store.GetTime(frame) < 1e-3 * f1);
+    CHECK_NEAR(store.GetTime(4) / f1, 1.0, 1e-8);
+    CHECK_NEAR(store.GetTime(5) / f2, 1.0, 1e-8);
+
+    // 第一阶轴向振型沿杆轴，u3/u2 = √2（由 (K - ω₁²M)φ = 0 的第一行）
+    const double u2 = store.GetValue(4, 2, DataType::U1);
+    CHECK_NEAR(store.GetValue(4, 3, DataType::U1) / u2, std::sqrt(2.0), 1e-6);
+    CHECK_NEAR(store.GetValue(4, 2, DataType::U2) / u2, 0.5, 1e-6);
+    CHECK_NEAR(store.GetValue(4, 2, DataType::U3) / u2, 1.0, 1e-6);
+}
+
+TEST_CASE(AnalysisStep_HarmonicSingleDof)
+{
+    // 单杆只保留节点 2 的轴向自由度：k = EA/L，m = ρAL/2，无阻尼幅值 |u| = F / |k - ω²m|
+    const char* const model =
+        "*Material,1\n"
+        "1  2e11  0.3  7800  200  0.1\n"
+        "*Section,1\n"
+        "1  0.02\n"
+        "*Node,2\n"
+        "1  0.0  0.0  0.0\n"
+        "2  1.0  0.0  0.0\n"
+        "*Element T3D2 1\n"
+        "1  1  2  1  1\n"
+        "*Constraint,5\n"
+        "1  1  0  0\n"
+        "2  1  1  0\n"
+        "3  1  2  0\n"
+        "4  2  1  0\n"
+        "5  2  2  0\n"
+        "*Load FORCE_NODE 1\n"
+        "1  2  0  1e3  1\n"
+        "*Analysis_Step,1\n"
+        "1  Harmonic  2000  250  1e-5  100\n";
+
+    auto pStructure = Test::LoadModel(model, "harmonic_sdof.txt");
+    CHECK(pStructure);
+
+    Solver solver;
+    solver.SetStructure(pStructure);
+    solver.RunAll();
+
+    const double A = std::acos(-1.0) * 0.02 * 0.02;  // 截面按半径输入
+    const double k = 2e11 * A / 1.0;
+    const double m = 7800 * A * 1.0 / 2.0;
+
+    // 激励频率 250, 500, ..., 2000 Hz，跨过约 1140 Hz 的固有频率
+    const ResultStore& store = pStructure->GetOutputter().GetStore();
+    CHECK_EQUAL(store.FrameCount(), size_t(8));
+    for (size_t frame = 0; frame < store.FrameCount(); ++frame)
+    {
+        const double f = 250.0 * static_cast<double>(frame + 1);
+        const double omega = 2.0 * std::acos(-1.0) * f;
+        const double amplitude = 1e3 / std::abs(k - omega * omega * m);
+        CHECK_NEAR(store.GetTime(frame), f, 1e-9);
+        CHECK_NEAR(store.GetValue(frame, 2, DataType::U1) / amplitude, 1.0, 1e-9);
+        CHECK_NEAR(store.GetValue(frame, 2, DataType::A1) / (omega * omega * amplitude), 1.0, 1e-9);
+    }
+}
+
+TEST_CASE(AnalysisStep_AssemblyPatternMatchesElementMatrices)
+{
+    // 两杆模型另加连接两个支座的杆 3：K11、K21、K22 都有单元贡献，节点 2 处两个单元的项相互叠加
+    auto pStructure = Test::LoadModel(std::string(Test::TwoBarModel) +
+        "*Element T3D2 1\n"
+        "3  1  3  1  1\n", "assembly_pattern.txt");
+    CHECK(pStructure);
+    auto pStep = pStructure->m_AnalysisStep.begin()->second;
+    pStep->SetStructure(pStructure);
+    pStep->Init();
+
+    CompactModel& model = pStructure->GetCompactModel();
+    const int nFixed = pStep->m_nFixed, nFree = pStep->m_nFree;
+    for (Eigen::Index i = nFixed; i < model.m_U.size(); ++i) model.m_U[i] = 0.01 * static_cast<double>(i);
+
+    AssemblyPattern pattern;
+    CHECK(!pattern.IsValid(model, nFixed, nFree));
+    pattern.Build(model, nFixed, nFree);
+    CHECK(pattern.IsValid(model, nFixed, nFree));
+
+    // 逐单元对象计算后按全局自由度叠加的参考矩阵
+    MatrixXd reference = MatrixXd::Zero(nFixed + nFree, nFixed + nFree);
+    for (ElementBase* pElement : model.m_ElementView)
+    {
+        MatrixXd ke;
+        std::vector<int> DOFs;
+        pElement->Get_ke_non(ke);
+        pElement->GetDOFs(DOFs);
+        for (size_t i = 0; i < DOFs.size(); ++i)
+        {
+            for (size_t j = 0; j < DOFs.size(); ++j) reference(DOFs[i], DOFs[j]) += ke(i, j);
+        }
+    }
+
+    // 重复组装结果不变（每次从零值结构开始）
+    SpMat K11, K21, K22;
+    std::vector<double> buffer;
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        pattern.Reset(AssemblyPattern::Part::K11, K11);
+        pattern.Reset(AssemblyPattern::Part::K21, K21);
+        pattern.Reset(AssemblyPattern::Part::K22, K22);
+        for (const ElementBlock& block : model.m_Blocks)
+        {
+            ElementBatch::Tangent(model, block, block.m_Begin, block.m_End, buffer);
+            pattern.Scatter(block.m_Begin, block.m_End, buffer, &K11, &K21, K22);
+        }
+        const double scale = reference.norm();
+        CHECK_NEAR((MatrixXd(K11) - reference.topLeftCorner(nFixed, nFixed)).norm() / scale, 0.0, 1e-14);
+        CHECK_NEAR((MatrixXd(K21) - reference.bottomLeftCorner(nFree, nFixed)).norm() / scale, 0.0, 1e-14);
+        CHECK_NEAR((MatrixXd(K22) - reference.bottomRightCorner(nFree, nFree)).norm() / scale, 0.0, 1e-14);
+    }
+    CHECK(K22.isCompressed());
+    CHECK_EQUAL(K22.nonZeros(), Eigen::Index(nFree * nFree));  // 唯一的自由节点 2：3×3 满块
+
+    // 约束改变后重新编号，组装模式随之失效
+    auto pConstraint = pStructure->Create_Object<Constraint>();
+    pConstraint->m_Id = 8;
+    pConstraint->m_pNode = pStructure->FindNode(2);
+    pConstraint->m_Direction = EnumKeyword::Direction::X;
+    pStructure->m_Constraint.insert(std::make_pair(8, pConstraint));
+    pStep->Init();
+    CHECK(!pattern.IsValid(model, pStep->m_nFixed, pStep->m_nFree));
+}
+
+TEST_CASE(AnalysisStep_InitRebuildsStaleAdjacency)
+{
+    auto pStructure = Test::LoadModel(Test::TwoBarModel, "stale_adjacency.txt");
+    CHECK(pStructure);
+    auto pStep = pStructure->m_AnalysisStep.begin()->second;
+    pStep->SetStructure(pStructure);
+    pStep->Init();
+    CHECK_EQUAL(pStructure->GetAdjacency().NodeCount(), 3);
+
+    // 生成器新增节点后邻接关系失效
+    const uint64_t version = pStructure->GetTopologyVersion();
+    ModelGenerator generator(*pStructure);
+    const int idNode = generator.NodeLine(Eigen::Vector3d(5.0, 2.0, 0.0), Eigen::Vector3d(1.0, 0.0, 0.0), 1);
+    CHECK_EQUAL(idNode, 4);
+    CHECK(pStructure->GetTopologyVersion() != version);
+    CHECK_EQUAL(pStructure->GetAdjacency().NodeCount(), 4);
+
+    // 直接写入单元表（不通知拓扑改变）后，分析步初始化仍按当前的节点和单元分配自由度：
+    // 索单元每个节点 4 个自由度，按过期的邻接关系节点 2、4 只有 3 个
+    auto pElement = pStructure->Create_Object<ElementCable>();
+    pElement->m_Id = 3;
+    pElement->m_pNode[0] = pStructure->FindNode(2);
+    pElement->m_pNode[1] = pStructure->FindNode(4);
+    pElement->m_pProperty = pStructure->FindProperty(1);
+    pStructure->m_Elements.insert(std::make_pair(3, pElement));
+
+    pStep->Init();
+    auto pNode4 = pStructure->FindNode(4);
+    CHECK_EQUAL(pNode4->m_DOF.size(), 4);
+    CHECK_EQUAL(pStructure->FindNode(2)->m_DOF.size(), 4);
+    for (int dof : pNode4->m_DOF) CHECK(dof >= pStep->m_nFixed);
+    CHECK_EQUAL(pStep->m_nFree, 7);  // 节点 2 除 Z 以外的 3 个和节点 4 的 4 个
+    CHECK_EQUAL(pStructure->GetCompactModel().ElementCount(), 3);
+}
+
+TEST_CASE(AnalysisStep_OutputRequestTimeTolerance)
+{
+    OutputRequest request;
+    request.m_Frequency = OutputRequest::Frequency::TIME;
+    request.m_TimeInterval = 0.1;
+    request.BeginStep(1);
+    CHECK(!request.ShouldSave(0.05, false));
+    CHECK(request.ShouldSave(0.1 - 1e-13, false));  // 舍入误差以内按到达输出时刻处理
+    CHECK(!request.ShouldSave(0.15, false));
+    CHECK(!request.ShouldSave(0.2 - 1e-6, false));
+    CHECK(request.ShouldSave(0.2, false));
+    CHECK(request.ShouldSave(0.25, true));           // 最后一个增量步总是保存
+
+    // 只输出指定的分析步
+    request.m_StepId = 1;
+    request.BeginStep(2);
+    CHECK(!request.ShouldSave(1.0, true));
+}
+
+TEST_CASE(AnalysisStep_OutputRequestFrequencyAndSets)
+{
+    // 静力分析步分 10 个增量步（时间 0.1, 0.2, ..., 1.0）
+    std::string text = Test::TwoBarModel;
+    const std::string step = "1  Static  1  0.5  1e-5  1000\n";
+    text.replace(text.find(step), step.size(), "1  Static  1  0.1  1e-5  1000\n");
+    text +=
+        "*NSET, Mid, 1\n"
+        "1  2\n"
+        "*ELSET, Right, 1\n"
+        "1  2\n"
+        "*OUTPUT, HISTORY, 5\n"
+        "1  0  MID    INC   3    U\n"
+        "2  0  MID    TIME  0.2  U2\n"
+        "3  1  ALL    LAST  0    RF\n"
+        "4  1  RIGHT  LAST  0    S  NF\n"
+        "5  2  ALL    INC   1    U\n";
+
+    auto pStructure = Test::LoadModel(text, "output_requests.txt");
+    CHECK(pStructure);
+    Solver solver;
+    solver.SetStructure(pStructure);
+    solver.RunAll();
+
+    const auto& requests = pStructure->GetOutputter().GetRequests();
+    CHECK_EQUAL(requests.size(), size_t(5));
+
+    // INC：每 3 个增量步及最后一个增量步
+    const ResultStore& inc = requests[0].m_Store;
+    CHECK_EQUAL(inc.FrameCount(), size_t(4));
+    const double incTimes[] = { 0.3, 0.6, 0.9, 1.0 };
+    for (size_t i = 0; i < inc.FrameCount(); ++i) CHECK_NEAR(inc.GetTime(i), incTimes[i], 1e-12);
+
+    // 节点集合只含节点 2
+    CHECK_EQUAL(inc.GetNodeIds().size(), size_t(1));
+    CHECK_EQUAL(inc.GetNodeIds()[0], 2);
+    CHECK_EQUAL(inc.GetTypes().size(), size_t(3));
+
+    // TIME：0.6 = 6/10 比 3×0.2 小一个舍入误差，仍需输出
+    const ResultStore& time = requests[1].m_Store;
+    CHECK_EQUAL(time.FrameCount(), size_t(5));
+    for (size_t i = 0; i < time.FrameCount(); ++i) CHECK_NEAR(time.GetTime(i), 0.2 * (i + 1), 1e-12);
+    CHECK_NEAR(time.GetValue(4, 2, DataType::U2), inc.GetValue(3, 2, DataType::U2), 0.0);
+
+    // LAST：全部节点，只有最后一个增量步
+    const ResultStore& last = requests[2].m_Store;
+    CHECK_EQUAL(last.FrameCount(), size_t(1));
+    CHECK_NEAR(last.GetTime(0), 1.0, 1e-12);
+    CHECK_EQUAL(last.GetNodeIds().size(), size_t(3));
+    CHECK_NEAR(last.GetValue(0, 1, DataType::F2) + last.GetValue(0, 3, DataType::F2), 1e5, 1e-3);
+
+    // 单元集合只含单元 2：S 为应力，NF 为轴力 = 应力 × 面积，与两杆桁架的解析轴力比较
+    const ResultStore& element = requests[3].m_Store;
+    CHECK_EQUAL(element.FrameCount(), size_t(1));
+    CHECK_EQUAL(element.GetNodeIds().size(), size_t(1));
+    CHECK_EQUAL(element.GetNodeIds()[0], 2);
+    const double stress = element.GetValue(0, 2, DataType::S);
+    const double force = element.GetValue(0, 2, DataType::NF);
+    CHECK_NEAR(stress, pStructure->FindElement(2)->m_Stress, 0.0);
+    const double area = PI * 0.02 * 0.02;
+    CHECK_NEAR(force / (stress * area), 1.0, 1e-12);
+    const double sinTheta = 5.5 / std::sqrt(5.0 * 5.0 + 5.5 * 5.5);
+    CHECK_NEAR(force / (1e5 / (2.0 * sinTheta)), 1.0, 1e-2);
+
+    // 指定的分析步不存在时不输出
+    CHECK_EQUAL(requests[4].m_Store.FrameCount(), size_t(0));
+}
+
+TEST_CASE(AnalysisStep_UniformLayoutPaths)
+{
+    // 纯桁架：每节点 3 个自由度，走固定步长的实现
+    auto pTruss = Test::LoadModel(Test::TwoBarModel, "uniform_truss.txt");
+    CHECK(pTruss);
+    auto pStep = pTruss->m_AnalysisStep.begin()->second;
+    pStep->SetStructure(pTruss);
+    pStep->Init();
+    CHECK_EQUAL(pTruss->GetCompactModel().UniformNodeDOF(), 3);
+    CheckSyntheticScatter(pTruss->GetCompactModel(), pStep->m_nFixed, pStep->m_nFree);
+
+    // 纯梁：每节点 6 个自由度（梁单元尚未实现刚度，只核对布局和组装）
+    std::string text = Test::TwoBarModel;
+    const std::string elements = "*Element T3D2 2\n1  1  2  1  1\n2  2  3  1  1\n";
+    text.erase(text.find(elements), elements.size());
+    auto pBeam = Test::LoadModel(text, "uniform_beam.txt");
+    CHECK(pBeam);
+    for (int id = 1; id <= 2; ++id)
+    {
+        auto pElement = pBeam->Create_Object<ElementBeam>();
+        pElement->m_Id = id;
+        pElement->m_pNode[0] = pBeam->FindNode(id);
+        pElement->m_pNode[1] = pBeam->FindNode(id + 1);
+        pElement->m_pProperty = pBeam->FindProperty(1);
+        pBeam->m_Elements.insert(std::make_pair(id, pElement));
+    }
+    pStep = pBeam->m_AnalysisStep.begin()->second;
+    pStep->SetStructure(pBeam);
+    pStep->Init();
+    CHECK_EQUAL(pBeam->GetCompactModel().UniformNodeDOF(), 6);
+    CheckSyntheticScatter(pBeam->GetCompactModel(), pStep->m_nFixed, pStep->m_nFree);
+
+    // 桁架与索混合：节点自由度数不同，走通用实现。索连接节点 3 和全约束的节点 4，
+    // 另约束两端的扭转自由度，自由自由度与纯桁架相同，结果应一致
+    auto pMixed = Test::LoadModel(std::string(Test::TwoBarModel) +
+        "*Node,1\n"
+        "4  5.0  3.0  0.0\n"
+        "*Element CABLE 1\n"
+        "3  3  4  1  1\n"
+        "*Constraint,5\n"
+        "8  4  0  0\n"
+        "9  4  1  0\n"
+        "10  4  2  0\n"
+        "11  4  3  0\n"
+        "12  3  3  0\n", "uniform_mixed.txt");
+    CHECK(pMixed);
+    pStep = pMixed->m_AnalysisStep.begin()->second;
+    pStep->SetStructure(pMixed);
+    pStep->Init();
+    CHECK_EQUAL(pMixed->GetCompactModel().UniformNodeDOF(), 0);
+    CheckSyntheticScatter(pMixed->GetCompactModel(), pStep->m_nFixed, pStep->m_nFree);
+
+    // 两条路径的求解结果（组装和单元内力累加）相同
+    for (auto& pStructure : { pTruss, pMixed })
+    {
+        Solver solver;
+        solver.SetStructure(pStructure);
+        solver.RunAll();
+    }
+    const ResultStore& uniform = pTruss->GetOutputter().GetStore();
+    const ResultStore& mixed = pMixed->GetOutputter().GetStore();
+    CHECK_EQUAL(uniform.FrameCount(), size_t(1));
+    CHECK_EQUAL(mixed.FrameCount(), size_t(1));
+    CHECK(std::abs(uniform.GetValue(0, 2, DataType::U2)) > 1e-6);
+    for (DataType type : { DataType::U1, DataType::U2, DataType::F1, DataType::F2 })
+    {
+        for (int idNode = 1; idNode <= 3; ++idNode)
+        {
+            const double a = uniform.GetValue(0, idNode, type);
+            const double b = mixed.GetValue(0, idNode, type);
+            CHECK_NEAR(a, b, 1e-12 * (1.0 + std::abs(a)));
+        }
+    }
+}
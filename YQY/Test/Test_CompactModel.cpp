@@ -0,0 +1,206 @@
+﻿#include "TestFramework.h"
+#include "TestModel.h"
+#include "DataStructure/Structure/StructureData.h"
+#include "DataStructure/AnalysisStep/AnalysisStep.h"
+#include "DataStructure/Element/ElementBase.h"
+#include "DataStructure/Element/ElementBatch.h"
+#include "Solver/Solver.h"
+
+TEST_CASE(CompactModel_StateFollowsNodesWhenDofsRenumbered)
+{
+    auto pStructure = Test::LoadModel(Test::TwoBarModel, "state_remap.txt");
+    CHECK(pStructure);
+
+    Solver solver;
+    solver.SetStructure(pStructure);
+    solver.RunAll();
+
+    auto pNode = pStructure->FindNode(2);
+    const double ux = pNode->m_Displacement[0];
+    const double uy = pNode->m_Displacement[1];
+    const int dofY = pNode->m_DOF[1];
+    CHECK(std::abs(uy) > 1e-6);
+
+    // 把节点 2 的 Y 方向约束在当前位移处：该自由度移到约束块，X 方向的编号随之改变
+    auto pConstraint = pStructure->Create_Object<Constraint>();
+    pConstraint->m_Id = 8;
+    pConstraint->m_pNode = pNode;
+    pConstraint->m_Direction = EnumKeyword::Direction::Y;
+    pConstraint->m_Value = uy;
+    pStructure->m_Constraint.insert(std::make_pair(8, pConstraint));
+
+    auto pStep = pStructure->m_AnalysisStep.begin()->second;
+    pStep->Init();
+    CHECK(pNode->m_DOF[1] != dofY);
+    CHECK_NEAR(pNode->m_Displacement[0], ux, 1e-15);
+    CHECK_NEAR(pNode->m_Displacement[1], uy, 1e-15);
+
+    // 节点重新排序（紧凑数组清空后重建）同样保留状态
+    pStructure->SetSpatialOrder(SpaceFillingCurve::Curve::HILBERT);
+    pStep->Init();
+    CHECK_NEAR(pNode->m_Displacement[0], ux, 1e-15);
+    CHECK_NEAR(pNode->m_Displacement[1], uy, 1e-15);
+}
+
+TEST_CASE(CompactModel_TrussReadsElementConstants)
+{
+    auto pStructure = Test::LoadModel(Test::TwoBarModel, "truss_constants.txt");
+    CHECK(pStructure);
+    auto pStep = pStructure->m_AnalysisStep.begin()->second;
+    pStep->SetStructure(pStructure);
+    pStep->Init();
+
+    // 单元计算只读单元常量：属性引用失效后仍可计算
+    auto pElement = pStructure->m_Elements.begin()->second;
+    const double A = std::acos(-1.0) * 0.02 * 0.02;  // 截面按半径输入
+    const double EA = 2e11 * A;
+    CHECK_NEAR(pElement->m_Const.EA, EA, 1e-3);
+    pElement->m_pProperty.reset();
+
+    MatrixXd km, kg, me;
+    pElement->Get_ke_split(km, kg);
+    CHECK_NEAR(km.trace(), 2.0 * EA / pElement->L0, 1e-3);
+    pElement->Get_me(me);
+    CHECK_NEAR(me(0, 0), 7800 * A * pElement->L0 / 2.0, 1e-9);
+}
+
+TEST_CASE(CompactModel_UnboundNodeReadsUndeformed)
+{
+    auto pStructure = Test::LoadModel(Test::TwoBarModel, "unbound_state.txt");
+    CHECK(pStructure);
+
+    // 求解之前节点状态未绑定：只读访问按未变形状态返回 0
+    auto pNode = pStructure->FindNode(2);
+    const Node& node = *pNode;
+    CHECK(!node.m_Displacement.IsBound());
+    CHECK_EQUAL(node.m_Displacement.size(), 0);
+    CHECK_EQUAL(node.m_Displacement[1], 0.0);
+
+    auto pStep = pStructure->m_AnalysisStep.begin()->second;
+    pStep->SetStructure(pStructure);
+    pStep->Init();
+    CHECK(node.m_Displacement.IsBound());
+    CHECK_EQUAL(node.m_Displacement.size(), 3);
+
+    // 模型清空后解除绑定，不再指向已释放的状态向量
+    pStructure->GetCompactModel().Clear();
+    CHECK(!node.m_Displacement.IsBound());
+    CHECK_EQUAL(node.m_Velocity[0], 0.0);
+}
+
+TEST_CASE(CompactModel_ElementConstantsFollowMaterialEdits)
+{
+    auto pStructure = Test::LoadModel(Test::TwoBarModel, "constants_edit.txt");
+    CHECK(pStructure);
+    auto pElement = pStructure->m_Elements.begin()->second;
+    const double A = std::acos(-1.0) * 0.02 * 0.02;  // 截面按半径输入
+
+    // 紧凑模型建立之前，单元常量由属性和节点坐标现场计算
+    CHECK(!pElement->m_Const.valid);
+    MatrixXd km, kg;
+    pElement->Get_ke_split(km, kg);
+    CHECK_NEAR(pElement->m_Const.EA, 2e11 * A, 1e-3);
+    CHECK_NEAR(km.trace(), 2.0 * 2e11 * A / pElement->L0, 1e-3);
+
+    auto pStep = pStructure->m_AnalysisStep.begin()->second;
+    pStep->SetStructure(pStructure);
+    pStep->Init();
+    CompactModel& model = pStructure->GetCompactModel();
+    CHECK(model.ConstantsValid());
+
+    // 修改材料：单元对象和常量表都失效，分别在单元计算和求解前重新计算
+    CHECK(pStructure->SetMaterial(1, 1e11, 0.3, 7800, 200, 0.1));
+    CHECK(!model.ConstantsValid());
+    pElement->Get_ke_split(km, kg);
+    CHECK_NEAR(pElement->m_Const.EA, 1e11 * A, 1e-3);
+    model.UpdateConstants();
+    CHECK_NEAR(model.m_ElemConst[model.FindElementIndex(pElement->m_Id)].EA, 1e11 * A, 1e-3);
+
+    // 修改截面半径
+    CHECK(pStructure->SetSectionRadius(1, 0.01));
+    CHECK_NEAR(pElement->Get_Const().EA, 1e11 * std::acos(-1.0) * 0.01 * 0.01, 1e-3);
+    CHECK(!pStructure->SetSectionRadius(2, 0.01));
+}
+
+TEST_CASE(CompactModel_ElementBlocksGroupedByType)
+{
+    const char* const model =
+        "*Material,1\n"
+        "1  2e11  0.3  7800  200  0.1\n"
+        "*Section,1\n"
+        "1  0.02\n"
+        "*Node,4\n"
+        "1  0.0  0.0  0.0\n"
+        "2  3.0  1.0  0.0\n"
+        "3  4.0  4.0  1.0\n"
+        "4  0.0  5.0  2.0\n"
+        "*Element T3D2 1\n"
+        "1  3  4  1  1\n"
+        "*Element CABLE 1\n"
+        "2  2  3  1  1\n"
+        "*Element T3D2 1\n"
+        "3  1  2  1  1\n"
+        "*Element CABLE 1\n"
+        "4  4  1  1  1\n"
+        "*Analysis_Step,1\n"
+        "1  Static  1  1  1e-5  100\n";
+
+    // 索单元与桁架单元按ID交错
+    auto pStructure = Test::LoadModel(model, "element_blocks.txt");
+    CHECK(pStructure);
+    CHECK_EQUAL(pStructure->m_Elements.size(), size_t(4));
+
+    auto pStep = pStructure->m_AnalysisStep.begin()->second;
+    pStep->SetStructure(pStructure);
+    pStep->Init();
+    CompactModel& compact = pStructure->GetCompactModel();
+
+    // 每种类型一个连续块，块内按最小节点下标排序
+    CHECK_EQUAL(compact.m_Blocks.size(), size_t(2));
+    const ElementBlock& truss = compact.m_Blocks[0];
+    const ElementBlock& cable = compact.m_Blocks[1];
+    CHECK(truss.m_Type == EnumKeyword::ElementType::T3D2);
+    CHECK(cable.m_Type == EnumKeyword::ElementType::CABLE);
+    CHECK_EQUAL(truss.m_Begin, 0);
+    CHECK_EQUAL(truss.m_End, 2);
+    CHECK_EQUAL(cable.m_Begin, 2);
+    CHECK_EQUAL(cable.m_End, 4);
+    const int expectedId[] = { 3, 1, 4, 2 };
+    for (int e = 0; e < compact.ElementCount(); ++e)
+    {
+        const ElementBlock& block = e < truss.m_End ? truss : cable;
+        CHECK_EQUAL(compact.m_ElementId[e], expectedId[e]);
+        CHECK(compact.m_ElementType[e] == block.m_Type);
+        CHECK_EQUAL(compact.m_ElemDofPtr[e + 1] - compact.m_ElemDofPtr[e], block.m_Type == EnumKeyword::ElementType::T3D2 ? 6 : 8);
+        CHECK_EQUAL(compact.FindElementIndex(expectedId[e]), e);
+    }
+
+    // 桁架块的批量计算与单元对象的计算一致（给定一个非零位移状态）
+    for (int i = 0; i < compact.m_U.size(); ++i) compact.m_U[i] = 1e-3 * (i % 5) - 2e-3;
+    std::vector<double> ke, me;
+    ElementBatch::Tangent(compact, truss, truss.m_Begin, truss.m_End, ke);
+    ElementBatch::Mass(compact, truss, truss.m_Begin, truss.m_End, me);
+    CHECK_EQUAL(ke.size(), size_t(2 * 36));
+    CHECK_EQUAL(me.size(), size_t(2 * 36));
+    for (int e = truss.m_Begin; e < truss.m_End; ++e)
+    {
+        ElementBase* pElement = compact.m_ElementView[e];
+        MatrixXd keObject, meObject;
+        pElement->Get_ke_non(keObject);
+        pElement->Get_me(meObject);
+        const Eigen::Map<const MatrixXd> keBatch(ke.data() + 36 * (e - truss.m_Begin), 6, 6);
+        const Eigen::Map<const MatrixXd> meBatch(me.data() + 36 * (e - truss.m_Begin), 6, 6);
+        CHECK_NEAR((keBatch - keObject).norm() / keObject.norm(), 0.0, 1e-12);
+        CHECK_NEAR((meBatch - meObject).norm(), 0.0, 1e-9);
+        CHECK_NEAR(compact.m_ElemStress[e], pElement->m_Stress, 1e-6 * std::abs(pElement->m_Stress));
+        for (int i = 0; i < 6; ++i)
+        {
+            CHECK_NEAR(compact.m_ElemForce[compact.m_ElemDofPtr[e] + i], pElement->m_inforce[i], 1e-6);
+        }
+    }
+
+    // 索单元块：缓冲区按 8 个自由度分配，未实现的单元矩阵写入零
+    ElementBatch::Mass(compact, cable, cable.m_Begin, cable.m_End, me);
+    CHECK_EQUAL(me.size(), size_t(2 * 64));
+    CHECK_NEAR(Eigen::Map<const VectorXd>(me.data(), me.size()).norm(), 0.0, 0.0);
+}
@@ -0,0 +1,94 @@
+﻿#include "TestFramework.h"
+#include "TestModel.h"
+#include "DataStructure/Structure/StructureData.h"
+#include "Import/ImportTask.h"
+#include "Utility/ModelManager.h"
+#include <cstdio>
+#include <string>
+
+namespace
+{
+    const char* const Header =
+        "*Material,1\n"
+        "1  2e11  0.3  7800  200  0.1\n";
+}
+
+TEST_CASE(InputModel_MissingDataFailsImport)
+{
+    // 数据不够或格式错误时读取失败，而不是结束进程
+    CHECK(!Test::LoadModel(std::string(Header) + "*Section,2\n1  0.02\n", "missing_section.txt"));
+    CHECK(!Test::LoadModel(std::string(Header) + "*Section,1\n1  0.02\n*Node,3\n1 0 0 0\n2 1 0 0\n*Element T3D2 1\n1 1 2 1 1\n",
+        "missing_node.txt"));
+    CHECK(!Test::LoadModel(std::string(Header) + "*Analysis_Step,1\n1  Static  1\n", "bad_step.txt"));
+    CHECK(!Test::LoadModel(std::string(Header) + "*Analysis_Step,2\n1  Static  1  0.5  1e-5  1000\n*Node,1\n",
+        "step_keyword.txt"));
+}
+
+TEST_CASE(InputModel_ImportTaskReportsFailure)
+{
+    const std::string path = Test::TempPath("import_task_failed.txt");
+    Test::WriteText(path, std::string(Header) + "*Constraint,2\n1  1  0  0\n");
+
+    ImportTask task;
+    CHECK(task.Start(QString::fromStdString(path)));
+    task.Wait();
+    CHECK(ImportTask::State::FAILED == task.GetState());
+    std::remove(path.c_str());
+}
+
+TEST_CASE(InputModel_ImportTaskCancel)
+{
+    // 取消后模型不加入 ModelManager，最终进度为 CANCELLED
+    const std::string path = Test::TempPath("import_task_cancel.txt");
+    Test::WriteText(path, Test::TwoBarModel);
+    const int nModel = ModelManager::Instance().GetModelCount();
+
+    ImportTask task;
+    CHECK(task.Start(QString::fromStdString(path)));
+    task.Cancel();
+    task.Wait();
+    CHECK(ImportTask::State::CANCELLED == task.GetState());
+    CHECK_EQUAL(0, task.GetModelId());
+    CHECK_EQUAL(nModel, ModelManager::Instance().GetModelCount());
+
+    ImportTask::Progress progress;
+    CHECK(task.PollProgress(progress));
+    CHECK(ImportTask::State::CANCELLED == progress.m_State);
+    std::remove(path.c_str());
+}
+
+TEST_CASE(InputModel_NodeForceStepOptional)
+{
+    // FORCE_NODE 可省略 StepID（缺省为第 1 个分析步）
+    std::string text = Test::TwoBarModel;
+    const std::string load = "1  2  1  -1e5  1\n";
+    text.replace(text.find(load), load.size(), "1  2  1  -1e5\n");
+
+    auto pStructure = Test::LoadModel(text, "force_node_no_step.txt");
+    CHECK(pStructure);
+    CHECK_EQUAL(pStructure->m_Load.size(), size_t(1));
+    CHECK_EQUAL(pStructure->m_Load.at(1)->m_StepId, 1);
+}
+
+TEST_CASE(InputModel_OutputRequestRejectsBadFields)
+{
+    const std::string sets = "*NSET, Mid, 1\n1  2\n";
+    auto pStructure = Test::LoadModel(std::string(Header) + sets + "*OUTPUT, FIELD, 1\n1  0  mid  inc  2  u  rf2\n",
+        "output_ok.txt");
+    CHECK(pStructure);
+    const auto& requests = pStructure->GetOutputter().GetRequests();
+    CHECK_EQUAL(requests.size(), size_t(1));
+    CHECK(requests[0].m_SetName == "MID");
+    CHECK(OutputRequest::Frequency::INCREMENT == requests[0].m_Frequency);
+    CHECK_EQUAL(requests[0].m_Interval, 2);
+    CHECK_EQUAL(requests[0].m_Types.size(), size_t(4));
+    CHECK(!requests[0].m_bElement);
+
+    // 未知的输出量、输出频率、输出类别，间隔不大于 0，节点量与单元量混合
+    CHECK(!Test::LoadModel(std::string(Header) + "*OUTPUT, FIELD, 1\n1  0  ALL  LAST  0  U  XYZ\n", "output_variable.txt"));
+    CHECK(!Test::LoadModel(std::string(Header) + "*OUTPUT, FIELD, 1\n1  0  ALL  STEP  1  U\n", "output_frequency.txt"));
+    CHECK(!Test::LoadModel(std::string(Header) + "*OUTPUT, ENERGY, 1\n1  0  ALL  LAST  0  U\n", "output_kind.txt"));
+    CHECK(!Test::LoadModel(std::string(Header) + "*OUTPUT, HISTORY, 1\n1  0  ALL  TIME  0  U\n", "output_interval.txt"));
+    CHECK(!Test::LoadModel(std::string(Header) + "*OUTPUT, HISTORY, 1\n1  0  ALL  LAST  0  U  S\n", "output_mixed.txt"));
+    CHECK(!Test::LoadModel(std::string(Header) + "*NSET, Mid, 1\n1  3  2\n", "set_range.txt"));
+}
@@ -0,0 +1,221 @@
+﻿#include "TestFramework.h"
+#include "TestModel.h"
+#include "DataStructure/Structure/StructureData.h"
+#include <chrono>
+#include <initializer_list>
+#include <string>
+
+namespace
+{
+    /**
+     * @brief 固定字段格式的一行：卡片名占第 1~8 列，其后每个字段占 width 列（右对齐）
+     */
+    std::string FixedLine(std::initializer_list<const char*> fields, int width = 8)
+    {
+        std::string line;
+        bool bName = true;
+        for (const char* field : fields)
+        {
+            const std::string text(field);
+            const size_t w = bName ? 8 : static_cast<size_t>(width);
+            if (bName) line += text + std::string(w - text.size(), ' ');
+            else line += std::string(w - text.size(), ' ') + text;
+            bName = false;
+        }
+        return line + "\n";
+    }
+
+    double Area(const std::shared_ptr<ElementBase>& pElement)
+    {
+        return pElement->m_pProperty.lock()->m_pSection.lock()->m_Area;
+    }
+
+    std::shared_ptr<Force_Node> NodeForce(StructureData& structure, int id)
+    {
+        return std::dynamic_pointer_cast<Force_Node>(structure.m_Load.at(id));
+    }
+}
+
+TEST_CASE(Nastran_SmallFieldCards)
+{
+    const std::string text =
+        "$ 小字段格式\n"
+        "BEGIN BULK\n" +
+        FixedLine({ "GRID", "1", "", "0.", "0.", "0." }) +
+        FixedLine({ "GRID", "2", "", "1.5+1", "-2.5-1", "1.D0" }) +
+        FixedLine({ "GRID", "3", "", "30.", "0.", "0.", "", "123456" }) +
+        FixedLine({ "CROD", "10", "1", "1", "2" }) +
+        FixedLine({ "CROD", "11", "1", "2", "3" }) +
+        FixedLine({ "PROD", "1", "7", "2.0-3" }) +
+        FixedLine({ "MAT1", "7", "2.1+11", "", "0.3", "7850." }) +
+        FixedLine({ "SPC1", "1", "123", "1" }) +
+        FixedLine({ "FORCE", "1", "2", "0", "1.0+3", "0.", "-1.", "0." }) +
+        "ENDDATA\n";
+    auto pStructure = Test::LoadModel(text, "nastran_small.bdf");
+    CHECK(pStructure);
+
+    CHECK_EQUAL(pStructure->m_Nodes.size(), size_t(3));
+    auto pNode = pStructure->FindNode(2);
+    CHECK_NEAR(pNode->m_X, 15.0, 1e-12);
+    CHECK_NEAR(pNode->m_Y, -0.25, 1e-12);
+    CHECK_NEAR(pNode->m_Z, 1.0, 1e-12);
+
+    CHECK_EQUAL(pStructure->m_Elements.size(), size_t(2));
+    CHECK_NEAR(Area(pStructure->FindElement(1)), 2.0e-3, 1e-15);
+    CHECK_NEAR(pStructure->FindMaterial(1)->m_Young, 2.1e11, 1.0);
+    CHECK_NEAR(pStructure->FindMaterial(1)->m_Poisson, 0.3, 1e-12);
+
+    // SPC1 约束节点 1 的 3 个方向，GRID 3 的永久约束 6 个方向
+    CHECK_EQUAL(pStructure->m_Constraint.size(), size_t(9));
+    CHECK_EQUAL(pStructure->m_Load.size(), size_t(1));
+    auto pForce = NodeForce(*pStructure, 1);
+    CHECK(pForce && pForce->m_pNode.lock() == pNode);
+    CHECK(EnumKeyword::Direction::Y == pForce->m_Direction);
+    CHECK_NEAR(pForce->m_Value, -1000.0, 1e-9);
+}
+
+TEST_CASE(Nastran_LargeFieldContinuation)
+{
+    // GRID* 每行 4 个 16 列字段，第二行以 * 开头续接
+    const std::string text =
+        "BEGIN BULK\n" +
+        FixedLine({ "GRID*", "1", "0", "1.0-3", "2.0" }, 16) +
+        FixedLine({ "*", "3.0", "0" }, 16) +
+        FixedLine({ "GRID*", "2", "0", "4.0", "2.0" }, 16) +
+        FixedLine({ "*", "3.0" }, 16) +
+        FixedLine({ "CROD", "1", "1", "1", "2" }) +
+        FixedLine({ "PROD", "1", "1", "1.0-4" }) +
+        FixedLine({ "MAT1", "1", "2.0+11", "", "0.3" }) +
+        "ENDDATA\n";
+    auto pStructure = Test::LoadModel(text, "nastran_large.bdf");
+    CHECK(pStructure);
+
+    CHECK_EQUAL(pStructure->m_Nodes.size(), size_t(2));
+    auto pNode = pStructure->FindNode(1);
+    CHECK_NEAR(pNode->m_X, 1.0e-3, 1e-15);
+    CHECK_NEAR(pNode->m_Y, 2.0, 0.0);
+    CHECK_NEAR(pNode->m_Z, 3.0, 0.0);
+    CHECK_NEAR(pStructure->FindNode(2)->m_Z, 3.0, 0.0);
+    CHECK_EQUAL(pStructure->m_Elements.size(), size_t(1));
+}
+
+TEST_CASE(Nastran_FreeFieldContinuation)
+{
+    // 自由字段：MAT1 的 ST（第 9 个字段）在 +M1 续行中；CONROD 带空续行；Tab 和空格只是空白
+    const std::string text =
+        "SOL 101\n"
+        "CEND\n"
+        "BEGIN BULK\n"
+        "GRID,1,,0.,0.,0.\n"
+        "GRID, 2 ,,1.,\t0.,0.\n"
+        "GRID,3,,2.,0.,0.\n"
+        "CONROD,1,1,2,1,1.0-3,,,,+C1\n"
+        "+C1\n"
+        "CONROD,2,2,3,1,3.0-3 $ 注释\n"
+        "MAT1,1,2.1+11,,0.3,7850.,,,,+M1\n"
+        "+M1,2.5+8\n"
+        "SPC,1,1,12,0.,3,3,-1.0-2\n"
+        "ENDDATA\n";
+    auto pStructure = Test::LoadModel(text, "nastran_free.bdf");
+    CHECK(pStructure);
+
+    CHECK_EQUAL(pStructure->m_Nodes.size(), size_t(3));
+    CHECK_NEAR(pStructure->FindNode(2)->m_X, 1.0, 0.0);
+    CHECK_EQUAL(pStructure->m_Elements.size(), size_t(2));
+    CHECK_NEAR(Area(pStructure->FindElement(1)), 1.0e-3, 1e-15);
+    CHECK_NEAR(Area(pStructure->FindElement(2)), 3.0e-3, 1e-15);
+    CHECK_NEAR(pStructure->FindMaterial(1)->m_MaxStress, 2.5e8, 1e-6);
+
+    CHECK_EQUAL(pStructure->m_Constraint.size(), size_t(3));
+    auto pConstraint = pStructure->m_Constraint.at(3);
+    CHECK(pConstraint->m_pNode.lock() == pStructure->FindNode(3));
+    CHECK(EnumKeyword::Direction::Z == pConstraint->m_Direction);
+    CHECK_NEAR(pConstraint->m_Value, -0.01, 1e-15);
+}
+
+TEST_CASE(Nastran_Spc1ThruSkipsMissingGrids)
+{
+    // 节点 3、4 不存在；第二张 SPC1 的范围远大于模型，只约束范围内存在的节点
+    const std::string text =
+        "GRID,1,,0.,0.,0.\n"
+        "GRID,2,,1.,0.,0.\n"
+        "GRID,5,,2.,0.,0.\n"
+        "CROD,1,1,1,2\n"
+        "CROD,2,1,2,5\n"
+        "PROD,1,1,1.0-3\n"
+        "MAT1,1,2.1+11,,0.3\n"
+        "SPC1,1,123,1,THRU,5\n"
+        "SPC1,1,456,2,THRU,2000000000\n";
+
+    const auto start = std::chrono::steady_clock::now();
+    auto pStructure = Test::LoadModel(text, "nastran_thru.bdf");
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    CHECK(pStructure);
+    CHECK(seconds < 1.0);
+
+    CHECK_EQUAL(pStructure->m_Constraint.size(), size_t(9 + 6));
+    int nOnNode1 = 0;
+    for (auto& pair : pStructure->m_Constraint)
+    {
+        if (pair.second->m_pNode.lock() == pStructure->FindNode(1)) ++nOnNode1;
+    }
+    CHECK_EQUAL(nOnNode1, 3);
+}
+
+TEST_CASE(Nastran_BeamCardsRejected)
+{
+    // 梁单元尚未实现刚度，CBAR/CBEAM 不能静默读入
+    const std::string text =
+        "GRID,1,,0.,0.,0.\n"
+        "GRID,2,,1.,0.,0.\n"
+        "CBAR,1,1,1,2,0.,1.,0.\n"
+        "PBAR,1,1,1.0-3\n"
+        "MAT1,1,2.1+11,,0.3\n";
+    CHECK(!Test::LoadModel(text, "nastran_cbar.bdf"));
+}
+
+TEST_CASE(Nastran_CaseControlSelectsSets)
+{
+    // 两个荷载集、两个约束集，按工况控制选用荷载集 2 和约束集 1；GRID 的永久约束总是保留
+    const std::string bulk =
+        "BEGIN BULK\n"
+        "GRID,1,,0.,0.,0.\n"
+        "GRID,2,,1.,0.,0.\n"
+        "GRID,3,,2.,0.,0.,,456\n"
+        "CROD,1,1,1,2\n"
+        "CROD,2,1,2,3\n"
+        "PROD,1,1,1.0-3\n"
+        "MAT1,1,2.1+11,,0.3,7850.\n"
+        "SPC1,1,123,1\n"
+        "SPC1,3,123,3\n"
+        "FORCE,1,2,0,1.0+3,1.,0.,0.\n"
+        "FORCE,2,2,0,5.0+2,0.,-1.,0.\n"
+        "GRAV,2,0,9.81,0.,0.,-1.\n"
+        "GRAV,1,0,9.81,1.,0.,0.\n"
+        "ENDDATA\n";
+    const std::string head = "SOL 101\nCEND\n";
+
+    auto pStructure = Test::LoadModel(head + "SPC = 1\nSUBCASE 1\n  LOAD = 2\n" + bulk, "nastran_case_control.bdf");
+    CHECK(pStructure);
+    CHECK_EQUAL(pStructure->m_Constraint.size(), size_t(3 + 3));
+    for (auto& pair : pStructure->m_Constraint)
+    {
+        CHECK(pair.second->m_pNode.lock() != pStructure->FindNode(3) || pair.second->m_Direction >= EnumKeyword::Direction::RX);
+    }
+    CHECK_EQUAL(pStructure->m_Load.size(), size_t(2));
+    auto pForce = NodeForce(*pStructure, 1);
+    CHECK(pForce && EnumKeyword::Direction::Y == pForce->m_Direction);
+    CHECK_NEAR(pForce->m_Value, -500.0, 1e-9);
+    auto pGravity = std::dynamic_pointer_cast<Force_Gravity>(pStructure->m_Load.at(2));
+    CHECK(pGravity && EnumKeyword::Direction::Z == pGravity->m_Direction);
+    CHECK_NEAR(pGravity->m_g, -9.81, 1e-12);
+
+    // 各 SUBCASE 选用相同的集时可以读取
+    CHECK(Test::LoadModel(head + "SUBCASE 1\nLOAD=1\nSPC=3\nSUBCASE 2\nLOAD=1\nSPC=3\n" + bulk, "nastran_same_subcases.bdf"));
+
+    // 各工况的荷载不同、选用的集不存在、没有选择而有多个集：都不能静默合并
+    CHECK(!Test::LoadModel(head + "SPC = 1\nSUBCASE 1\nLOAD = 1\nSUBCASE 2\nLOAD = 2\n" + bulk, "nastran_two_subcases.bdf"));
+    CHECK(!Test::LoadModel(head + "SPC = 1\nLOAD = 4\n" + bulk, "nastran_missing_set.bdf"));
+    CHECK(!Test::LoadModel(head + "SPC = 1\n" + bulk, "nastran_no_load_selection.bdf"));
+    CHECK(!Test::LoadModel(bulk, "nastran_bulk_only.bdf"));
+}
@@ -0,0 +1,276 @@
+﻿#include "TestFramework.h"
+#include "TestModel.h"
+#include "DataStructure/Structure/StructureData.h"
+#include "DataStructure/Structure/ModelBinary.h"
+#include "DataStructure/AnalysisStep/AnalysisStep.h"
+#include "DataStructure/Element/ElementBase.h"
+#include "Solver/Solver.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const char* const Requests =
+        "*NSET, Top, 1\n"
+        "1  2\n"
+        "*ELSET, Bars, 1\n"
+        "1  1  2\n"
+        "*OUTPUT, HISTORY, 2\n"
+        "1  0  TOP   INC   5     U  RF\n"
+        "2  1  BARS  TIME  0.25  S  NF\n"
+        "*OUTPUT, FIELD, 1\n"
+        "3  0  ALL   LAST  0     U1\n";
+}
+
+TEST_CASE(ModelBinary_CoreRoundTrip)
+{
+    // 两种材料、截面组合成不同属性，桁架与索单元混合；分析步给出全部字段（含特征值迭代参数）
+    const char* const model =
+        "*Material,2\n"
+        "1  2e11  0.3  7800  200  0.1\n"
+        "2  1.6e11  0.25  7850  1570  1.2e-5\n"
+        "*Section,2\n"
+        "1  0.02\n"
+        "2  0.008\n"
+        "*Node,4\n"
+        "1  0.0  0.0  0.0\n"
+        "2  5.0  -5.5  0.25\n"
+        "3  10.0  0.0  0.0\n"
+        "4  5.0  3.0  -1.5\n"
+        "*Element T3D2 2\n"
+        "1  1  2  1  1\n"
+        "2  2  3  1  1\n"
+        "*Element CABLE 2\n"
+        "3  2  4  2  2\n"
+        "4  4  3  2  1\n"
+        "*Constraint,7\n"
+        "1  1  0  0\n"
+        "2  1  1  0\n"
+        "3  1  2  0\n"
+        "4  3  0  0\n"
+        "5  3  1  0\n"
+        "6  3  2  0\n"
+        "7  2  2  0\n"
+        "*Load FORCE_NODE 1\n"
+        "1  2  1  -1e5  1\n"
+        "*Analysis_Step,2\n"
+        "1  Static  1  0.5  1e-5  1000\n"
+        "2  Frequency  2  0.25  1e-6  50  4  0.03  1e-9  77\n";
+
+    auto pText = Test::LoadModel(model, "binary_core.txt");
+    CHECK(pText);
+    const std::string path = Test::TempPath("binary_core.yqyb");
+    CHECK(pText->WriteBinary(QString::fromStdString(path)));
+
+    auto pBinary = std::make_shared<StructureData>();
+    CHECK(pBinary->ReadBinary(QString::fromStdString(path)));
+    std::remove(path.c_str());
+
+    CHECK_EQUAL(pBinary->m_Nodes.size(), pText->m_Nodes.size());
+    for (const auto& nodePair : pText->m_Nodes)
+    {
+        auto pNode = pBinary->FindNode(nodePair.first);
+        CHECK(pNode);
+        CHECK_NEAR(pNode->m_X, nodePair.second->m_X, 0.0);
+        CHECK_NEAR(pNode->m_Y, nodePair.second->m_Y, 0.0);
+        CHECK_NEAR(pNode->m_Z, nodePair.second->m_Z, 0.0);
+    }
+
+    CHECK_EQUAL(pBinary->m_Elements.size(), size_t(4));
+    CHECK_EQUAL(pBinary->m_Elements.size(), pText->m_Elements.size());
+    for (const auto& elementPair : pText->m_Elements)
+    {
+        auto pElement = pBinary->FindElement(elementPair.first);
+        CHECK(pElement);
+        const ElementBase& expected = *elementPair.second;
+        CHECK(pElement->Get_ElementType() == expected.Get_ElementType());
+        CHECK_EQUAL(pElement->m_pNode.size(), expected.m_pNode.size());
+        for (int i = 0; i < expected.m_pNode.size(); ++i)
+        {
+            CHECK_EQUAL(pElement->m_pNode[i].lock()->m_Id, expected.m_pNode[i].lock()->m_Id);
+        }
+
+        // 属性按材料和截面对应
+        auto pProperty = pElement->m_pProperty.lock();
+        auto pExpectedProperty = expected.m_pProperty.lock();
+        CHECK(pProperty && pExpectedProperty);
+        CHECK_EQUAL(pProperty->m_Id, pExpectedProperty->m_Id);
+        CHECK_EQUAL(pProperty->m_pMaterial.lock()->m_Id, pExpectedProperty->m_pMaterial.lock()->m_Id);
+        CHECK_EQUAL(pProperty->m_pSection.lock()->m_Id, pExpectedProperty->m_pSection.lock()->m_Id);
+        CHECK_NEAR(pProperty->m_pMaterial.lock()->m_Young, pExpectedProperty->m_pMaterial.lock()->m_Young, 0.0);
+        CHECK_NEAR(pProperty->m_pSection.lock()->m_Area, pExpectedProperty->m_pSection.lock()->m_Area, 0.0);
+    }
+    CHECK_EQUAL(pBinary->m_Property.size(), size_t(3));
+    CHECK_EQUAL(pBinary->m_Property.size(), pText->m_Property.size());
+
+    CHECK_EQUAL(pBinary->m_AnalysisStep.size(), size_t(2));
+    for (const auto& stepPair : pText->m_AnalysisStep)
+    {
+        auto it = pBinary->m_AnalysisStep.find(stepPair.first);
+        CHECK(it != pBinary->m_AnalysisStep.end());
+        const AnalysisStep& a = *stepPair.second;
+        const AnalysisStep& b = *it->second;
+        CHECK_EQUAL(b.m_Id, a.m_Id);
+        CHECK(b.m_Type == a.m_Type);
+        CHECK_NEAR(b.m_Time, a.m_Time, 0.0);
+        CHECK_NEAR(b.m_StepSize, a.m_StepSize, 0.0);
+        CHECK_NEAR(b.m_Tolerance, a.m_Tolerance, 0.0);
+        CHECK_EQUAL(b.m_MaxIterations, a.m_MaxIterations);
+        CHECK_EQUAL(b.m_nModes, a.m_nModes);
+        CHECK_NEAR(b.m_DampingRatio, a.m_DampingRatio, 0.0);
+        CHECK_NEAR(b.m_EigenTolerance, a.m_EigenTolerance, 0.0);
+        CHECK_EQUAL(b.m_EigenMaxIterations, a.m_EigenMaxIterations);
+    }
+
+    // 输入中的非默认特征值参数确实被保留
+    const AnalysisStep& frequency = *pBinary->m_AnalysisStep.at(2);
+    CHECK(frequency.m_Type == EnumKeyword::StepType::FREQUENCY);
+    CHECK_EQUAL(frequency.m_nModes, 4);
+    CHECK_NEAR(frequency.m_DampingRatio, 0.03, 0.0);
+    CHECK_NEAR(frequency.m_EigenTolerance, 1e-9, 0.0);
+    CHECK_EQUAL(frequency.m_EigenMaxIterations, 77);
+}
+
+TEST_CASE(ModelBinary_SetsAndRequestsRoundTrip)
+{
+    auto pText = Test::LoadModel(std::string(Test::TwoBarModel) + Requests, "binary_requests.txt");
+    CHECK(pText);
+
+    const std::string path = Test::TempPath("binary_requests.yqyb");
+    CHECK(pText->WriteBinary(QString::fromStdString(path)));
+
+    // 读入已有请求的模型：先清空，再恢复文件中的集合和请求
+    auto pBinary = Test::LoadModel(std::string(Test::TwoBarModel) + Requests, "binary_target.txt");
+    CHECK(pBinary);
+    CHECK(pBinary->ReadBinary(QString::fromStdString(path)));
+    std::remove(path.c_str());
+
+    const Outputter& expected = pText->m_Outputter;
+    const Outputter& actual = pBinary->m_Outputter;
+    CHECK(expected.GetNodeSets() == actual.GetNodeSets());
+    CHECK(expected.GetElementSets() == actual.GetElementSets());
+    CHECK_EQUAL(actual.GetNodeSets().size(), size_t(1));
+    CHECK(actual.GetNodeSets().begin()->first.toStdString() == "TOP");
+
+    CHECK_EQUAL(actual.GetRequests().size(), size_t(3));
+    for (size_t i = 0; i < expected.GetRequests().size(); ++i)
+    {
+        const OutputRequest& a = expected.GetRequests()[i];
+        const OutputRequest& b = actual.GetRequests()[i];
+        CHECK_EQUAL(a.m_Id, b.m_Id);
+        CHECK(a.m_Kind == b.m_Kind);
+        CHECK_EQUAL(a.m_StepId, b.m_StepId);
+        CHECK(a.m_SetName.toStdString() == b.m_SetName.toStdString());
+        CHECK(a.m_bElement == b.m_bElement);
+        CHECK(a.m_Frequency == b.m_Frequency);
+        CHECK_EQUAL(a.m_Interval, b.m_Interval);
+        CHECK_NEAR(a.m_TimeInterval, b.m_TimeInterval, 0.0);
+        CHECK(a.m_Types == b.m_Types);
+    }
+
+    // 请求在求解时生效
+    Solver solver;
+    solver.SetStructure(pBinary);
+    solver.RunAll();
+    for (const OutputRequest& request : actual.GetRequests()) CHECK(request.m_Store.FrameCount() > 0);
+}
+
+TEST_CASE(ModelBinary_NoRequests)
+{
+    auto pText = Test::LoadModel(Test::TwoBarModel, "binary_plain.txt");
+    CHECK(pText);
+    const std::string path = Test::TempPath("binary_plain.yqyb");
+    CHECK(pText->WriteBinary(QString::fromStdString(path)));
+
+    auto pBinary = Test::LoadModel(std::string(Test::TwoBarModel) + Requests, "binary_plain_target.txt");
+    CHECK(pBinary);
+    CHECK(pBinary->ReadBinary(QString::fromStdString(path)));
+    std::remove(path.c_str());
+
+    CHECK(pBinary->m_Outputter.GetRequests().empty());
+    CHECK(pBinary->m_Outputter.GetNodeSets().empty());
+    CHECK(pBinary->m_Outputter.GetElementSets().empty());
+    CHECK_EQUAL(pBinary->m_Elements.size(), size_t(2));
+}
+
+TEST_CASE(ModelBinary_ReadVersion1)
+{
+    // 把当前版本写出的文件改写为版本 1 的布局：分析步记录去掉特征值迭代参数，集合和输出请求段不存在
+    auto pText = Test::LoadModel(std::string(Test::TwoBarModel) + Requests, "binary_v1.txt");
+    CHECK(pText);
+    const std::string path = Test::TempPath("binary_v1.yqyb");
+    CHECK(pText->WriteBinary(QString::fromStdString(path)));
+
+    std::vector<char> bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    ModelBinary::FileHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    header.m_Version = 1;
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    for (uint32_t i = 0; i < header.m_nSection; ++i)
+    {
+        char* pEntry = bytes.data() + sizeof(header) + i * sizeof(ModelBinary::SectionEntry);
+        ModelBinary::SectionEntry entry;
+        std::memcpy(&entry, pEntry, sizeof(entry));
+        const auto type = static_cast<ModelBinary::SectionType>(entry.m_Type);
+        if (type == ModelBinary::SectionType::ANALYSIS_STEP)
+        {// 原位压缩为旧记录
+            for (uint64_t k = 0; k < entry.m_Count; ++k)
+            {
+                ModelBinary::StepRecord record;
+                std::memcpy(&record, bytes.data() + entry.m_Offset + k * sizeof(record), sizeof(record));
+                ModelBinary::StepRecordV2 legacy = { record.m_Id, record.m_Type, record.m_MaxIterations, record.m_nModes,
+                    record.m_Time, record.m_StepSize, record.m_Tolerance, record.m_DampingRatio };
+                std::memcpy(bytes.data() + entry.m_Offset + k * sizeof(legacy), &legacy, sizeof(legacy));
+            }
+            entry.m_RecordSize = sizeof(ModelBinary::StepRecordV2);
+        }
+        else if (type >= ModelBinary::SectionType::NAME)
+        {// 版本 1 没有的段
+            entry.m_Type = 0;
+        }
+        std::memcpy(pEntry, &entry, sizeof(entry));
+    }
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    auto pBinary = Test::LoadModel(std::string(Test::TwoBarModel) + Requests, "binary_v1_target.txt");
+    CHECK(pBinary);
+    CHECK(pBinary->ReadBinary(QString::fromStdString(path)));
+    std::remove(path.c_str());
+
+    CHECK(pBinary->m_Outputter.GetRequests().empty());
+    CHECK(pBinary->m_Outputter.GetNodeSets().empty());
+    CHECK(pBinary->m_Outputter.GetElementSets().empty());
+    CHECK_EQUAL(pBinary->m_Nodes.size(), size_t(3));
+    CHECK_EQUAL(pBinary->m_Elements.size(), size_t(2));
+
+    CHECK_EQUAL(pBinary->m_AnalysisStep.size(), size_t(1));
+    const AnalysisStep& expected = *pText->m_AnalysisStep.begin()->second;
+    const AnalysisStep& step = *pBinary->m_AnalysisStep.begin()->second;
+    CHECK(step.m_Type == expected.m_Type);
+    CHECK_NEAR(step.m_StepSize, expected.m_StepSize, 0.0);
+    CHECK_EQUAL(step.m_MaxIterations, expected.m_MaxIterations);
+    CHECK_NEAR(step.m_EigenTolerance, AnalysisStep().m_EigenTolerance, 0.0);
+    CHECK_EQUAL(step.m_EigenMaxIterations, AnalysisStep().m_EigenMaxIterations);
+
+    // 不认识的版本仍然拒绝
+    header.m_Version = ModelBinary::Version + 1;
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    auto pRejected = std::make_shared<StructureData>();
+    CHECK(!pRejected->ReadBinary(QString::fromStdString(path)));
+    std::remove(path.c_str());
+}
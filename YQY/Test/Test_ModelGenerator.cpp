@@ -0,0 +1,83 @@
+﻿#include "TestFramework.h"
+#include "DataStructure/Structure/StructureData.h"
+#include "Import/Input_Model.h"
+#include "Import/ModelGenerator.h"
+#include "Solver/Solver.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+namespace
+{
+    /**
+     * @brief 写出并读取基准模型
+     * @param [out] pBytes 输入文件字节数
+     * @param [out] pSeconds 读取（生成和清理）耗时
+     */
+    std::shared_ptr<StructureData> LoadBenchmark(const ModelGenerator::Benchmark& options, const std::string& name,
+        int64_t* pBytes = nullptr, double* pSeconds = nullptr)
+    {
+        const std::string path = Test::TempPath(name);
+        if (!ModelGenerator::WriteBenchmark(QString::fromStdString(path), options)) return nullptr;
+        if (pBytes) *pBytes = static_cast<int64_t>(std::ifstream(path, std::ios::binary | std::ios::ate).tellg());
+
+        auto pStructure = std::make_shared<StructureData>();
+        Input_Model input;
+        const auto start = std::chrono::steady_clock::now();
+        const bool bRead = input.InputData(QString::fromStdString(path), pStructure);
+        if (pSeconds) *pSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::remove(path.c_str());
+        return bRead ? pStructure : nullptr;
+    }
+}
+
+TEST_CASE(ModelGenerator_BenchmarkModel)
+{
+    ModelGenerator::Benchmark options;
+    options.m_nCell[0] = 2;
+    options.m_nCell[1] = 3;
+    options.m_nCell[2] = 4;
+    auto pStructure = LoadBenchmark(options, "benchmark_small.txt");
+    CHECK(pStructure);
+
+    // 节点 3*4*5；杆件 X 40、Y 45、Z 48、XY 30、XZ 32、YZ 36；底面 12 个节点三向固定
+    CHECK_EQUAL(pStructure->m_Nodes.size(), size_t(60));
+    CHECK_EQUAL(pStructure->m_Elements.size(), size_t(231));
+    CHECK_EQUAL(pStructure->m_Constraint.size(), size_t(36));
+    CHECK_EQUAL(pStructure->m_Load.size(), size_t(1));
+    CHECK_EQUAL(pStructure->m_AnalysisStep.size(), size_t(1));
+
+    // 只改变 Z 向网格数时文件大小基本不变（节点和杆件由 *GRID、*EGEN 生成，只有收敛容差的数值不同）
+    int64_t bytes4 = 0, bytes8 = 0;
+    LoadBenchmark(options, "benchmark_z4.txt", &bytes4);
+    options.m_nCell[2] = 8;
+    auto pTaller = LoadBenchmark(options, "benchmark_z8.txt", &bytes8);
+    CHECK(pTaller);
+    CHECK_EQUAL(pTaller->m_Nodes.size(), size_t(3 * 4 * 9));
+    CHECK(bytes4 > 0 && std::abs(bytes8 - bytes4) < 16);
+}
+
+BENCHMARK_CASE(ModelGenerator_BenchmarkImportAndSolve)
+{
+    for (int n : { 10, 20 })
+    {
+        ModelGenerator::Benchmark options;
+        options.m_nCell[0] = options.m_nCell[1] = options.m_nCell[2] = n;
+
+        int64_t bytes = 0;
+        double readSeconds = 0.0;
+        auto pStructure = LoadBenchmark(options, "benchmark_" + std::to_string(n) + ".txt", &bytes, &readSeconds);
+        CHECK(pStructure);
+
+        Solver solver;
+        solver.SetStructure(pStructure);
+        const auto start = std::chrono::steady_clock::now();
+        solver.RunAll();
+        const double solveSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::printf("  cells %2d^3  nodes %7zu  elements %8zu  file %7lld bytes  import %.3f s  static solve %.3f s\n",
+            n, pStructure->m_Nodes.size(), pStructure->m_Elements.size(), static_cast<long long>(bytes),
+            readSeconds, solveSeconds);
+    }
+}
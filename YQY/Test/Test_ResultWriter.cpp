@@ -0,0 +1,181 @@
+﻿#include "TestFramework.h"
+#include "TestModel.h"
+#include "DataStructure/Structure/StructureData.h"
+#include "Export/ResultWriter.h"
+#include "Solver/Solver.h"
+#include <atomic>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief 以换行结束的完整行（最后一个换行之后正在写入的部分不计）
+     */
+    std::vector<std::string> CompleteLines(const std::string& text)
+    {
+        std::vector<std::string> lines;
+        size_t begin = 0;
+        for (size_t end = text.find('\n'); end != std::string::npos; end = text.find('\n', begin))
+        {
+            lines.push_back(text.substr(begin, end - begin));
+            begin = end + 1;
+        }
+        return lines;
+    }
+
+    int FieldCount(const std::string& line)
+    {
+        std::istringstream stream(line);
+        std::string field;
+        int n = 0;
+        while (stream >> field) ++n;
+        return n;
+    }
+
+    /**
+     * @brief 向存储写入第 frame 帧（存储中只保留这一帧，与流式输出相同）
+     */
+    void FillFrame(ResultStore& store, int frame)
+    {
+        store.ClearFrames();
+        const size_t f = store.AppendFrame(0.01 * frame);
+        const size_t nId = store.GetNodeIds().size();
+        for (int t = 0; t < static_cast<int>(store.GetTypes().size()); ++t)
+        {
+            for (size_t i = 0; i < nId; ++i) store.Row(f, t)[i] = frame + 0.1 * t + 0.01 * static_cast<double>(i);
+        }
+    }
+
+    ResultWriter::Layout MakeLayout(const std::string& path, ResultWriter::Style style, const ResultStore& store)
+    {
+        ResultWriter::Layout layout;
+        layout.m_FileName = QString::fromStdString(path);
+        layout.m_Style = style;
+        layout.m_Ids = store.GetNodeIds();
+        layout.m_Types = store.GetTypes();
+        return layout;
+    }
+}
+
+TEST_CASE(ResultWriter_FilesReadableMidRun)
+{
+    const std::string tablePath = Test::TempPath("writer_table.out");
+    const std::string fieldPath = Test::TempPath("writer_field.out");
+    ResultStore store;
+    store.Reset({ 1, 2, 3 }, { DataType::U1, DataType::U2 });
+
+    {
+        ResultWriter writer(2, 2);
+        writer.SetLayout(0, MakeLayout(tablePath, ResultWriter::Style::TABLE, store));
+        writer.SetLayout(1, MakeLayout(fieldPath, ResultWriter::Style::FIELD, store));
+        for (int frame = 0; frame < 5; ++frame)
+        {
+            FillFrame(store, frame);
+            writer.Push(0, 0.01 * frame, store);
+            writer.Push(1, 0.01 * frame, store);
+            writer.Flush();
+
+            // 写出器仍在运行，文件中已有全部推入的帧，且以完整的行结束
+            const std::string table = Test::ReadText(tablePath);
+            CHECK(!table.empty() && '\n' == table.back());
+            const std::vector<std::string> lines = CompleteLines(table);
+            CHECK_EQUAL(lines.size(), size_t(2 + frame + 1));
+            CHECK_EQUAL(FieldCount(lines.back()), 1 + 3 * 2);
+            CHECK_NEAR(std::stod(lines.back().substr(ResultWriter::ColumnWidth, ResultWriter::ColumnWidth)), frame, 1e-12);
+
+            const std::string field = Test::ReadText(fieldPath);
+            size_t nFrame = 0;
+            for (size_t pos = field.find("FRAME "); pos != std::string::npos; pos = field.find("FRAME ", pos + 1)) ++nFrame;
+            CHECK_EQUAL(nFrame, size_t(frame + 1));
+        }
+        CHECK_EQUAL(writer.GetWrittenFrames(), int64_t(10));
+    }
+    std::remove(tablePath.c_str());
+    std::remove(fieldPath.c_str());
+}
+
+TEST_CASE(ResultWriter_ConcurrentReaderSeesCompleteLines)
+{
+    // 缓冲区只有 2 个，求解线程频繁等待写出线程；另一个线程在写出过程中反复读取文件
+    const std::string path = Test::TempPath("writer_concurrent.out");
+    const int nFrame = 3000;
+    ResultStore store;
+    store.Reset({ 1, 2, 3, 4 }, { DataType::U1, DataType::F1 });
+
+    std::atomic<bool> bDone{ false };
+    std::atomic<int> nBadLine{ 0 };
+    std::thread reader([&]
+        {
+            while (!bDone.load())
+            {
+                const std::vector<std::string> lines = CompleteLines(Test::ReadText(path));
+                for (size_t i = 2; i < lines.size(); ++i)
+                {
+                    if (FieldCount(lines[i]) != 1 + 4 * 2) ++nBadLine;
+                }
+            }
+        });
+
+    {
+        ResultWriter writer(1, 2);
+        writer.SetLayout(0, MakeLayout(path, ResultWriter::Style::TABLE, store));
+        for (int frame = 0; frame < nFrame; ++frame)
+        {
+            FillFrame(store, frame);
+            writer.Push(0, 0.01 * frame, store);
+        }
+        writer.Flush();
+        CHECK_EQUAL(writer.GetWrittenFrames(), int64_t(nFrame));
+    }
+    bDone.store(true);
+    reader.join();
+
+    CHECK_EQUAL(nBadLine.load(), 0);
+    CHECK_EQUAL(CompleteLines(Test::ReadText(path)).size(), size_t(2 + nFrame));
+    std::remove(path.c_str());
+}
+
+TEST_CASE(ResultWriter_StreamingMatchesExport)
+{
+    // 流式输出的默认输出文件与分析结束后 ExportNodes 导出的相同
+    const std::vector<int> nodeIds = { 2 };
+    const std::vector<DataType> types = { DataType::U1, DataType::U2, DataType::F1, DataType::F2 };
+    const std::string prefix = Test::TempPath("streaming");
+    const std::string exportPath = Test::TempPath("streaming_export.out");
+
+    auto pStreamed = Test::LoadModel(Test::TwoBarModel, "streaming_model.txt");
+    CHECK(pStreamed);
+    Outputter& outputter = pStreamed->GetOutputter();
+    outputter.SetRequestedNodes(nodeIds);
+    outputter.SetRequestedTypes(types);
+    outputter.StartStreaming(QString::fromStdString(prefix));
+    CHECK(outputter.IsStreaming());
+    {
+        Solver solver;
+        solver.SetStructure(pStreamed);
+        solver.RunAll();
+    }
+    outputter.StopStreaming();
+    CHECK(!outputter.IsStreaming());
+
+    auto pExported = Test::LoadModel(Test::TwoBarModel, "streaming_model.txt");
+    CHECK(pExported);
+    pExported->GetOutputter().SetRequestedNodes(nodeIds);
+    pExported->GetOutputter().SetRequestedTypes(types);
+    {
+        Solver solver;
+        solver.SetStructure(pExported);
+        solver.RunAll();
+    }
+    pExported->GetOutputter().ExportNodes(QString::fromStdString(exportPath), nodeIds, types);
+
+    const std::string streamed = Test::ReadText(prefix + ".out");
+    CHECK_EQUAL(CompleteLines(streamed).size(), size_t(3));
+    CHECK(streamed == Test::ReadText(exportPath));
+    std::remove((prefix + ".out").c_str());
+    std::remove(exportPath.c_str());
+}
@@ -0,0 +1,41 @@
+﻿#include "TestFramework.h"
+#include "Solver/SolverModal.h"
+
+using namespace Dynamics;
+
+TEST_CASE(Modal_RigidModeInStiffModel)
+{
+    // 刚度很大的模型中，刚体模态的 ω 只是舍入误差（这里为 2e-5），应按 q̈ = p 积分
+    Vec omega(2);
+    omega << 2e-5, 1e4;
+
+    SolverModal::Parameters param;
+    param.dt = 1e-3;
+    param.damping_ratio = 0.05;
+    SolverModal solver(param);
+
+    Vec q = Vec::Zero(2), qd = Vec::Zero(2);
+    solver.solve(omega, q, qd, 0.01, [](double, Vec& p) { p.setOnes(); });
+
+    CHECK_NEAR(q[0], 0.5 * 0.01 * 0.01, 1e-12);
+    CHECK_NEAR(qd[0], 0.01, 1e-12);
+    CHECK_NEAR(q[1], 1.0 / (1e4 * 1e4), 1e-9);  // 弹性模态：静位移 p/ω² 附近
+}
+
+TEST_CASE(Modal_LowFrequencyInSoftModel)
+{
+    // 很软的模型中 ω 可以整体低于 1e-8，仍是弹性模态：半个周期后 q 从 1 变为 -1
+    Vec omega(2);
+    omega << 5e-9, 1e-8;
+
+    const double period = 2.0 * std::acos(-1.0) / omega[0];
+    SolverModal::Parameters param;
+    param.dt = period / 100.0;
+    SolverModal solver(param);
+
+    Vec q = Vec::Ones(2), qd = Vec::Zero(2);
+    solver.solve(omega, q, qd, 0.5 * period, [](double, Vec& p) { p.setZero(); });
+
+    CHECK_NEAR(q[0], -1.0, 1e-9);
+    CHECK_NEAR(q[1], 1.0, 1e-9);
+}
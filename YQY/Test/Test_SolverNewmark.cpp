@@ -0,0 +1,99 @@
+﻿#include "TestFramework.h"
+#include "Solver/SolverNewmark.h"
+#include <chrono>
+#include <cstdio>
+
+using namespace Dynamics;
+
+/**
+ * @brief n 个质点的弹簧链（一端固定），左端受正弦力
+ */
+struct SpringChain
+{
+    SpMat M, C, K;
+
+    explicit SpringChain(int n, double damping)
+    {
+        std::vector<Eigen::Triplet<double>> m, k;
+        for (int i = 0; i < n; ++i)
+        {
+            m.emplace_back(i, i, 1.0);
+            k.emplace_back(i, i, (i + 1 < n) ? 2000.0 : 1000.0);
+            if (i + 1 < n)
+            {
+                k.emplace_back(i, i + 1, -1000.0);
+                k.emplace_back(i + 1, i, -1000.0);
+            }
+        }
+        M.resize(n, n); M.setFromTriplets(m.begin(), m.end());
+        K.resize(n, n); K.setFromTriplets(k.begin(), k.end());
+        if (damping > 0.0) C = damping * K;  // 刚度比例阻尼
+        else C.resize(0, 0);                 // 无阻尼：0×0 阻尼矩阵（ModelLinear 不接受，只用于 GeneralModel）
+        M.makeCompressed(); K.makeCompressed(); C.makeCompressed();
+    }
+};
+
+/**
+ * @brief 固定步长线性积分，返回第 2 步之后每步的堆分配次数（第 1 步分解矩阵，允许分配）
+ */
+static size_t RunFixed(int n, double damping, int nStep, double* pSeconds = nullptr)
+{
+    SpringChain chain(n, damping);
+    ModelLinear model(chain.M, chain.C, chain.K);  // 模型只保存矩阵的引用
+    model.SetForceFuncInPlace([](double t, Vec& f) { f.setZero(); f[0] = std::sin(10.0 * t); });
+
+    SolverNewmark::Parameters param;
+    param.bAdaptive = false;
+    param.dt = 1e-3;
+    SolverNewmark solver(param);
+
+    State state(n);
+    size_t nAtStep2 = 0, nLast = 0;
+    int step = 0;
+    auto observer = [&](const State&)
+    {
+        if (2 == step) nAtStep2 = Test::AllocationCount();
+        nLast = Test::AllocationCount();
+        ++step;
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    solver.solve(model, state, nStep * param.dt, observer);
+    if (pSeconds) *pSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    CHECK(step >= nStep);
+    CHECK_EQUAL(solver.GetStatistics().n_factorizations, size_t(1));
+    CHECK(std::isfinite(state.x.norm()));
+    return nLast - nAtStep2;
+}
+
+TEST_CASE(Newmark_FixedStepLoopDoesNotAllocate)
+{
+    CHECK_EQUAL(RunFixed(50, 0.001, 200), size_t(0));
+}
+
+TEST_CASE(Newmark_AcceptsEmptyDampingMatrix)
+{
+    // 0×0 阻尼矩阵表示无阻尼（组装 K_eff 时跳过）
+    SpringChain chain(10, 0.0);
+    SpMat keff, kBuf, cBuf, mBuf;
+    GeneralModel general(10);
+    general.SetFuncM([&](const State&, SpMat&) -> const SpMat& { return chain.M; });
+    general.SetFuncC([&](const State&, SpMat&) -> const SpMat& { return chain.C; });
+    general.SetFuncK([&](const State&, SpMat&) -> const SpMat& { return chain.K; });
+    general.ComputeKeff(State(10), 1.0, 2.0, 3.0, keff, kBuf, cBuf, mBuf);
+    CHECK_NEAR(keff.coeff(0, 0), 2000.0 + 3.0, 1e-12);
+    CHECK_NEAR(keff.coeff(0, 1), -1000.0, 1e-12);
+}
+
+BENCHMARK_CASE(Newmark_FixedStepThroughput)
+{
+    for (int n : { 1000, 10000, 100000 })
+    {
+        const int nStep = 500;
+        double seconds = 0.0;
+        const size_t nAllocation = RunFixed(n, 0.001, nStep, &seconds);
+        std::printf("  dofs %7d  steps %d  %.3f ms/step  heap allocations after step 2: %zu\n",
+            n, nStep, 1e3 * seconds / nStep, nAllocation);
+    }
+}
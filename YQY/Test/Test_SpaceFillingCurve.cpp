@@ -0,0 +1,137 @@
+﻿#include "TestFramework.h"
+#include "DataStructure/Structure/StructureData.h"
+#include "Utility/SpaceFillingCurve.h"
+#include <algorithm>
+#include <cstdlib>
+#include <set>
+
+namespace
+{
+    // n×n×n 网格的点坐标（第 i 个点为 (i % n, i / n % n, i / n²)）
+    std::vector<double> GridCoords(int n)
+    {
+        std::vector<double> coords;
+        for (int i = 0; i < n * n * n; ++i)
+        {
+            coords.push_back(i % n);
+            coords.push_back(i / n % n);
+            coords.push_back(i / (n * n));
+        }
+        return coords;
+    }
+
+    // 按编码排序后的点序号
+    std::vector<int> SortedByKey(const std::vector<uint64_t>& keys)
+    {
+        std::vector<int> order(keys.size());
+        for (size_t i = 0; i < order.size(); ++i) order[i] = static_cast<int>(i);
+        std::sort(order.begin(), order.end(), [&keys](int a, int b) { return keys[a] < keys[b]; });
+        return order;
+    }
+}
+
+TEST_CASE(SpaceFillingCurve_MortonInterleavesBits)
+{
+    CHECK_EQUAL(SpaceFillingCurve::Morton(1, 0, 0), uint64_t(4));
+    CHECK_EQUAL(SpaceFillingCurve::Morton(0, 1, 0), uint64_t(2));
+    CHECK_EQUAL(SpaceFillingCurve::Morton(0, 0, 1), uint64_t(1));
+    CHECK_EQUAL(SpaceFillingCurve::Morton(3, 5, 6), uint64_t(0b011'101'110));  // 每组 3 位依次为 (x,y,z) 的同一位，从高位起
+
+    const uint32_t full = (1u << SpaceFillingCurve::Bits) - 1;
+    CHECK_EQUAL(SpaceFillingCurve::Morton(full, full, full), (uint64_t(1) << 63) - 1);
+    CHECK_EQUAL(SpaceFillingCurve::Morton(full + 1, 0, 0), uint64_t(0));  // 超出 Bits 的位被忽略
+}
+
+TEST_CASE(SpaceFillingCurve_HilbertVisitsNeighbours)
+{
+    // 4×4×4 网格按 Hilbert 编码排序：编码互不相同，且相邻两点只在一个方向上相差一格
+    const int n = 4;
+    const std::vector<double> coords = GridCoords(n);
+    std::vector<uint64_t> keys;
+    SpaceFillingCurve::Compute_Keys(coords, SpaceFillingCurve::Curve::HILBERT, keys);
+    CHECK_EQUAL(keys.size(), size_t(n * n * n));
+    CHECK_EQUAL(std::set<uint64_t>(keys.begin(), keys.end()).size(), keys.size());
+
+    const std::vector<int> order = SortedByKey(keys);
+    CHECK_EQUAL(order.front(), 0);  // 从原点出发
+    for (size_t k = 1; k < order.size(); ++k)
+    {
+        double distance = 0.0;
+        for (int d = 0; d < 3; ++d) distance += std::abs(coords[3 * order[k] + d] - coords[3 * order[k - 1] + d]);
+        CHECK_NEAR(distance, 1.0, 0.0);
+    }
+}
+
+TEST_CASE(SpaceFillingCurve_MortonVisitsOctants)
+{
+    // 4×4×4 网格按 Morton 编码排序：每 8 个点恰好构成一个 2×2×2 子块，块内按 (x,y,z) 位序
+    const int n = 4;
+    const std::vector<double> coords = GridCoords(n);
+    std::vector<uint64_t> keys;
+    SpaceFillingCurve::Compute_Keys(coords, SpaceFillingCurve::Curve::MORTON, keys);
+
+    const std::vector<int> order = SortedByKey(keys);
+    for (size_t k = 0; k < order.size(); ++k)
+    {
+        const double* p = coords.data() + 3 * order[k];
+        const double* first = coords.data() + 3 * order[k - k % 8];
+        const int bits = static_cast<int>(k % 8);
+        CHECK_NEAR(p[0] - first[0], (bits >> 2) & 1, 0.0);
+        CHECK_NEAR(p[1] - first[1], (bits >> 1) & 1, 0.0);
+        CHECK_NEAR(p[2] - first[2], bits & 1, 0.0);
+    }
+
+    // 不排序时编码全为 0
+    SpaceFillingCurve::Compute_Keys(coords, SpaceFillingCurve::Curve::NONE, keys);
+    CHECK(std::all_of(keys.begin(), keys.end(), [](uint64_t key) { return 0 == key; }));
+}
+
+TEST_CASE(SpaceFillingCurve_NodeOrderFollowsCurve)
+{
+    // 3×3×3 网格的节点ID打乱编号，另加一个与节点 1 重合的节点
+    StructureData structure;
+    const int n = 3;
+    const std::vector<double> coords = GridCoords(n);
+    const int count = n * n * n;
+    for (int i = 0; i < count; ++i)
+    {
+        auto pNode = structure.Create_Object<Node>();
+        pNode->m_Id = 1 + (7 * i) % count;
+        pNode->m_X = coords[3 * i];
+        pNode->m_Y = coords[3 * i + 1];
+        pNode->m_Z = coords[3 * i + 2];
+        structure.m_Nodes.insert(std::make_pair(pNode->m_Id, pNode));
+    }
+    auto pDuplicate = structure.Create_Object<Node>();
+    pDuplicate->m_Id = 100;
+    pDuplicate->m_X = pDuplicate->m_Y = pDuplicate->m_Z = 0.0;
+    structure.m_Nodes.insert(std::make_pair(pDuplicate->m_Id, pDuplicate));
+
+    // 默认按ID顺序
+    std::vector<Node*> order;
+    structure.Get_NodeOrder(order);
+    CHECK_EQUAL(order.size(), size_t(count + 1));
+    for (size_t k = 1; k < order.size(); ++k) CHECK(order[k - 1]->m_Id < order[k]->m_Id);
+
+    // 按曲线编码排序：与直接对坐标编码排序的结果一致，编码相同的节点保持ID顺序
+    for (auto curve : { SpaceFillingCurve::Curve::MORTON, SpaceFillingCurve::Curve::HILBERT })
+    {
+        structure.SetSpatialOrder(curve);
+        CHECK(structure.GetSpatialOrder() == curve);
+        structure.Get_NodeOrder(order);
+        CHECK_EQUAL(order.size(), size_t(count + 1));
+
+        std::vector<uint64_t> keys;
+        SpaceFillingCurve::Compute_Keys(coords, curve, keys);
+        for (size_t k = 1; k < order.size(); ++k)
+        {
+            const Node* a = order[k - 1];
+            const Node* b = order[k];
+            const uint64_t keyA = keys[static_cast<size_t>(a->m_X + n * a->m_Y + n * n * a->m_Z)];
+            const uint64_t keyB = keys[static_cast<size_t>(b->m_X + n * b->m_Y + n * n * b->m_Z)];
+            CHECK(keyA < keyB || (keyA == keyB && a->m_Id < b->m_Id));
+        }
+        CHECK_EQUAL(order[0]->m_X, 0.0);
+        CHECK_EQUAL(order[1]->m_Id, 100);  // 与原点的节点（ID 1）重合，排在其后
+    }
+}
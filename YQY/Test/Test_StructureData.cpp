@@ -0,0 +1,401 @@
+﻿#include "TestFramework.h"
+#include "TestModel.h"
+#include "DataStructure/Structure/StructureData.h"
+#include "DataStructure/Section/SectionCircular.h"
+#include <set>
+#include <vector>
+#include <array>
+#include <algorithm>
+
+TEST_CASE(StructureData_ObjectHeldAcrossClear)
+{
+    auto pStructure = Test::LoadModel(Test::TwoBarModel, "held_across_clear.txt");
+    CHECK(pStructure);
+
+    std::shared_ptr<Node> pNode = pStructure->FindNode(2);
+    std::weak_ptr<ElementBase> pElement = pStructure->m_Elements.begin()->second;
+    pStructure->Clear();
+    CHECK(pStructure->m_Nodes.empty());
+    CHECK(pElement.expired());
+
+    // 清空后新建的对象不能覆盖仍被持有的对象
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto pNew = pStructure->Create_Object<Node>();
+        pNew->m_Id = 1000 + i;
+        pNew->m_X = -1.0;
+        pStructure->m_Nodes.insert(std::make_pair(pNew->m_Id, pNew));
+    }
+    CHECK_EQUAL(pNode->m_Id, 2);
+    CHECK_NEAR(pNode->m_X, 5.0, 0.0);
+    CHECK_NEAR(pNode->m_Y, -5.5, 0.0);
+
+    // 模型析构后对象仍然有效，最后由持有者释放
+    pStructure.reset();
+    CHECK_NEAR(pNode->m_X, 5.0, 0.0);
+    pNode.reset();
+}
+
+TEST_CASE(StructureData_RemovedObjectMemoryReused)
+{
+    StructureData structure;
+    std::set<const void*> addresses;
+    for (int i = 0; i < 100; ++i)
+    {
+        auto pNode = structure.Create_Object<Node>();
+        addresses.insert(pNode.get());
+        structure.m_Nodes.insert(std::make_pair(i, pNode));
+    }
+
+    // 反复删除一半节点再新建（合并、增量编辑）：释放的内存被重复使用，占用的地址个数不随轮数增长
+    for (int round = 0; round < 100; ++round)
+    {
+        bool bErase = false;
+        for (auto it = structure.m_Nodes.begin(); it != structure.m_Nodes.end(); bErase = !bErase)
+        {
+            it = bErase ? structure.m_Nodes.erase(it) : std::next(it);
+        }
+        for (int i = 0; i < 50; ++i)
+        {
+            auto pNode = structure.Create_Object<Node>();
+            addresses.insert(pNode.get());
+            structure.m_Nodes.insert(std::make_pair(structure.m_Nodes.rbegin()->first + 1, pNode));
+        }
+    }
+    CHECK(addresses.size() < 300);
+}
+
+namespace
+{
+    const char* const ChainModel =
+        "*Material,1\n"
+        "1  2e11  0.3  7800  200  0.1\n"
+        "*Section,1\n"
+        "1  0.02\n"
+        "*Node,5\n"
+        "1  0.0  0.0  0.0\n"
+        "2  1.0  0.0  0.0\n"
+        "3  2.0  0.0  0.0\n"
+        "4  3.0  0.0  0.0\n"
+        "5  4.0  0.0  0.0\n"
+        "*Element T3D2 7\n"
+        "1  1  2  1  1\n"
+        "2  2  3  1  1\n"
+        "3  3  4  1  1\n"
+        "4  4  5  1  1\n"
+        "5  1  3  1  1\n"
+        "6  2  4  1  1\n"
+        "7  1  4  1  1\n";
+
+    /**
+     * @brief 在已清理的模型上编辑：已有节点被合并、已有单元变为重复、追加新节点和新单元
+     */
+    void EditChainModel(StructureData& structure)
+    {
+        structure.MoveNode(5, 0.0, 0.0, 0.0);         // 并入节点 1，单元 4 变为 (4,1)，与单元 7 重复
+        structure.SetElementNodes(2, { 2, 1 });       // 与单元 1 重复
+
+        auto pProperty = structure.FindElement(1)->m_pProperty;
+        auto appendElement = [&structure, &pProperty](double x, int idOther)
+            {
+                auto pNode = structure.Create_Object<Node>();
+                pNode->m_Id = structure.m_Nodes.rbegin()->first + 1;
+                pNode->m_X = x;
+                structure.m_Nodes.insert(std::make_pair(pNode->m_Id, pNode));
+
+                auto pElement = structure.Create_Object<ElementTruss>();
+                pElement->m_Id = structure.m_Elements.rbegin()->first + 1;
+                pElement->m_pNode[0] = pNode;
+                pElement->m_pNode[1] = structure.FindNode(idOther);
+                pElement->m_pProperty = pProperty;
+                structure.m_Elements.insert(std::make_pair(pElement->m_Id, pElement));
+            };
+        appendElement(4.0, 4);           // 新节点落在节点 5 原来的位置
+        appendElement(2.0 + 1e-9, 2);    // 新节点与节点 3 重合
+    }
+
+    /**
+     * @brief 与编号无关的模型描述：按节点坐标表示的单元（排序后）
+     */
+    std::vector<std::array<double, 6>> Topology(StructureData& structure)
+    {
+        std::vector<std::array<double, 6>> result;
+        for (auto& elemPair : structure.m_Elements)
+        {
+            auto p0 = elemPair.second->m_pNode[0].lock();
+            auto p1 = elemPair.second->m_pNode[1].lock();
+            std::array<double, 3> a = { p0->m_X, p0->m_Y, p0->m_Z };
+            std::array<double, 3> b = { p1->m_X, p1->m_Y, p1->m_Z };
+            if (b < a) std::swap(a, b);
+            result.push_back({ a[0], a[1], a[2], b[0], b[1], b[2] });
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+}
+
+TEST_CASE(StructureData_IncrementalCleanupMatchesFull)
+{
+    auto pIncremental = Test::LoadModel(ChainModel, "cleanup_incremental.txt");
+    auto pFull = Test::LoadModel(ChainModel, "cleanup_full.txt");
+    CHECK(pIncremental && pFull);
+
+    EditChainModel(*pIncremental);
+    EditChainModel(*pFull);
+    std::weak_ptr<ElementBase> pElement4 = pIncremental->FindElement(4);
+    std::weak_ptr<ElementBase> pElement7 = pIncremental->FindElement(7);
+    pIncremental->CleanupModel(1e-6, true);
+    pFull->CleanupModel(1e-6, false);
+
+    CHECK_EQUAL(pIncremental->m_Nodes.size(), size_t(5));
+    CHECK_EQUAL(pIncremental->m_Elements.size(), size_t(7));
+    CHECK_EQUAL(pIncremental->m_Nodes.size(), pFull->m_Nodes.size());
+    CHECK_EQUAL(pIncremental->m_Elements.size(), pFull->m_Elements.size());
+    CHECK(Topology(*pIncremental) == Topology(*pFull));
+    CHECK_EQUAL(pIncremental->m_Nodes.rbegin()->first, 5);
+    CHECK_EQUAL(pIncremental->m_Elements.rbegin()->first, 7);
+
+    // 重复单元保留ID较小者：单元 4（改为 (4,1)）保留，未修改的单元 7 删除
+    CHECK(!pElement4.expired());
+    CHECK(pElement7.expired());
+
+    // 再次增量清理没有改动
+    auto before = Topology(*pIncremental);
+    pIncremental->CleanupModel(1e-6, true);
+    CHECK(Topology(*pIncremental) == before);
+}
+
+TEST_CASE(StructureData_PropertyIndexLookup)
+{
+    auto pStructure = Test::LoadModel(Test::TwoBarModel, "property_index.txt");
+    CHECK(pStructure);
+    CHECK_EQUAL(pStructure->m_Property.size(), size_t(1));
+
+    auto pMaterial2 = pStructure->Create_Object<Material>();
+    pMaterial2->m_Id = 2;
+    pStructure->m_Material.insert(std::make_pair(2, pMaterial2));
+    auto pSection2 = pStructure->Create_Object<SectionCircular>();
+    pSection2->m_Id = 2;
+    pStructure->m_Section.insert(std::make_pair(2, pSection2));
+
+    // 相同组合返回已有属性，(材料, 截面) 顺序不同是不同组合
+    auto pProperty1 = pStructure->Create_Property(1, 1);
+    CHECK(pProperty1 == pStructure->FindProperty(1));
+    auto pProperty21 = pStructure->Create_Property(2, 1);
+    auto pProperty12 = pStructure->Create_Property(1, 2);
+    CHECK(pProperty21 && pProperty12 && pProperty21 != pProperty12);
+    CHECK_EQUAL(pProperty21->m_Id, 2);
+    CHECK_EQUAL(pProperty12->m_Id, 3);
+    CHECK(pStructure->Create_Property(2, 1) == pProperty21);
+    CHECK(pStructure->Create_Property(1, 2) == pProperty12);
+
+    // 材料或截面不存在
+    CHECK(!pStructure->Create_Property(9, 1));
+    CHECK(!pStructure->Create_Property(1, 9));
+    CHECK_EQUAL(pStructure->m_Property.size(), size_t(3));
+
+    // 直接修改属性的材料后索引项失效：(2,1) 重新创建，(1,1) 仍取ID最小的属性
+    pProperty21->m_pMaterial = pStructure->m_Material.at(1);
+    auto pRecreated = pStructure->Create_Property(2, 1);
+    CHECK(pRecreated && pRecreated != pProperty21);
+    CHECK_EQUAL(pRecreated->m_Id, 4);
+    CHECK(pStructure->Create_Property(1, 1) == pProperty1);
+
+    // 在 Create_Property 之外加入的属性（如读取二进制模型文件）同样能找到
+    auto pExternal = pStructure->Create_Object<Property>();
+    pExternal->m_Id = 5;
+    pExternal->m_pMaterial = pMaterial2;
+    pExternal->m_pSection = pSection2;
+    pStructure->m_Property.insert(std::make_pair(5, pExternal));
+    CHECK(pStructure->Create_Property(2, 2) == pExternal);
+    CHECK_EQUAL(pStructure->m_Property.size(), size_t(5));
+}
+
+TEST_CASE(StructureData_AdjacencyRows)
+{
+    // 两个单元共用节点 2：单元 1 = (1,2)，单元 2 = (3,2)
+    const char* const model =
+        "*Material,1\n"
+        "1  2e11  0.3  7800  200  0.1\n"
+        "*Section,1\n"
+        "1  0.02\n"
+        "*Node,3\n"
+        "1  0.0  0.0  0.0\n"
+        "2  1.0  0.0  0.0\n"
+        "3  2.0  0.0  0.0\n"
+        "*Element T3D2 2\n"
+        "1  1  2  1  1\n"
+        "2  3  2  1  1\n";
+
+    auto pStructure = Test::LoadModel(model, "adjacency.txt");
+    CHECK(pStructure);
+
+    auto rowIds = [](IndexRange row, const std::vector<int>& ids)
+        {
+            std::vector<int> result;
+            for (int i : row) result.push_back(ids[i]);
+            return result;
+        };
+
+    const Adjacency& adjacency = pStructure->GetAdjacency();
+    CHECK_EQUAL(adjacency.Version(), pStructure->GetTopologyVersion());
+    CHECK_EQUAL(adjacency.NodeCount(), 3);
+    CHECK_EQUAL(adjacency.ElementCount(), 2);
+    for (int id = 1; id <= 3; ++id) CHECK_EQUAL(adjacency.m_NodeId[adjacency.FindNodeIndex(id)], id);
+    CHECK_EQUAL(adjacency.FindNodeIndex(4), -1);
+    CHECK_EQUAL(adjacency.FindElementIndex(2), 1);
+    CHECK_EQUAL(adjacency.FindElementIndex(3), -1);
+
+    // 单元 -> 节点保持单元内的节点顺序
+    CHECK(rowIds(adjacency.ElementNodes(0), adjacency.m_NodeId) == std::vector<int>({ 1, 2 }));
+    CHECK(rowIds(adjacency.ElementNodes(1), adjacency.m_NodeId) == std::vector<int>({ 3, 2 }));
+
+    // 节点 -> 单元、节点 -> 节点按下标升序，不含自身
+    const int i1 = adjacency.FindNodeIndex(1), i2 = adjacency.FindNodeIndex(2);
+    const int i3 = adjacency.FindNodeIndex(3);
+    CHECK(rowIds(adjacency.NodeElements(i1), adjacency.m_ElementId) == std::vector<int>({ 1 }));
+    CHECK(rowIds(adjacency.NodeElements(i2), adjacency.m_ElementId) == std::vector<int>({ 1, 2 }));
+    CHECK(rowIds(adjacency.NodeElements(i3), adjacency.m_ElementId) == std::vector<int>({ 2 }));
+    CHECK(rowIds(adjacency.NodeNeighbors(i1), adjacency.m_NodeId) == std::vector<int>({ 2 }));
+    CHECK(rowIds(adjacency.NodeNeighbors(i2), adjacency.m_NodeId) == std::vector<int>({ 1, 3 }));
+    CHECK(rowIds(adjacency.NodeNeighbors(i3), adjacency.m_NodeId) == std::vector<int>({ 2 }));
+
+    // 拓扑未变时复用同一份数据；增加孤立节点 4、稀疏ID的节点 1000 和单元 3 = (3,1000) 后重建（节点ID改为二分查找）
+    CHECK(&pStructure->GetAdjacency() == &adjacency);
+    auto appendNode = [&pStructure](int id, double x)
+        {
+            auto pNode = pStructure->Create_Object<Node>();
+            pNode->m_Id = id;
+            pNode->m_X = x;
+            pStructure->m_Nodes.insert(std::make_pair(pNode->m_Id, pNode));
+        };
+    appendNode(4, 3.0);
+    appendNode(1000, 4.0);
+    auto pElement = pStructure->Create_Object<ElementTruss>();
+    pElement->m_Id = 3;
+    pElement->m_pNode[0] = pStructure->FindNode(3);
+    pElement->m_pNode[1] = pStructure->FindNode(1000);
+    pStructure->m_Elements.insert(std::make_pair(pElement->m_Id, pElement));
+    pStructure->TopologyChanged();
+
+    const Adjacency& rebuilt = pStructure->GetAdjacency();
+    CHECK_EQUAL(rebuilt.Version(), pStructure->GetTopologyVersion());
+    CHECK_EQUAL(rebuilt.NodeCount(), 5);
+    CHECK_EQUAL(rebuilt.FindNodeIndex(1000), 4);
+    CHECK_EQUAL(rebuilt.FindNodeIndex(999), -1);
+    CHECK(rebuilt.NodeElements(rebuilt.FindNodeIndex(4)).empty());
+    CHECK(rebuilt.NodeNeighbors(rebuilt.FindNodeIndex(4)).empty());
+    CHECK(rowIds(rebuilt.NodeNeighbors(rebuilt.FindNodeIndex(3)), rebuilt.m_NodeId) == std::vector<int>({ 2, 1000 }));
+    CHECK(rowIds(rebuilt.NodeElements(rebuilt.FindNodeIndex(1000)), rebuilt.m_ElementId) == std::vector<int>({ 3 }));
+}
+
+namespace
+{
+    /**
+     * @brief 合并结果：保留的节点和单元（按创建顺序的下标），以及保留单元引用的节点下标
+     */
+    struct MergeResult
+    {
+        std::vector<int> nodes;
+        std::vector<std::array<int, 3>> elements;
+
+        bool operator==(const MergeResult& other) const { return nodes == other.nodes && elements == other.elements; }
+    };
+
+    /**
+     * @brief 8×8×8 网格的每个节点旁有一个距离小于容差的重复节点，另有一串相邻间距为 0.6 倍容差的节点；
+     *        每个节点都由一根杆连到远处的锚点，用给定线程数完整清理
+     */
+    MergeResult MergeLattice(int nThreads, double tolerance)
+    {
+        StructureData structure;
+        structure.SetThreadCount(nThreads);
+
+        std::vector<std::shared_ptr<Node>> nodes;
+        auto appendNode = [&structure, &nodes](double x, double y, double z)
+            {
+                auto pNode = structure.Create_Object<Node>();
+                pNode->m_Id = static_cast<int>(nodes.size()) + 1;
+                pNode->m_X = x;
+                pNode->m_Y = y;
+                pNode->m_Z = z;
+                structure.m_Nodes.insert(std::make_pair(pNode->m_Id, pNode));
+                nodes.push_back(pNode);
+            };
+        for (int k = 0; k < 8; ++k)
+        {
+            for (int j = 0; j < 8; ++j)
+            {
+                for (int i = 0; i < 8; ++i)
+                {
+                    appendNode(i, j, k);
+                    appendNode(i + 0.3 * tolerance, j - 0.2 * tolerance * (i % 3), k + 0.1 * tolerance);
+                }
+            }
+        }
+        const int chainBegin = static_cast<int>(nodes.size());
+        for (int c = 0; c < 5; ++c) appendNode(100.0 + 0.6 * tolerance * c, 0.0, 0.0);
+        appendNode(1000.0, 0.0, 0.0);
+        auto pAnchor = nodes.back();
+
+        std::vector<std::shared_ptr<ElementBase>> elements;
+        for (size_t n = 0; n + 1 < nodes.size(); ++n)
+        {
+            auto pElement = structure.Create_Object<ElementTruss>();
+            pElement->m_Id = static_cast<int>(n) + 1;
+            pElement->m_pNode[0] = nodes[n];
+            pElement->m_pNode[1] = pAnchor;
+            structure.m_Elements.insert(std::make_pair(pElement->m_Id, pElement));
+            elements.push_back(pElement);
+        }
+
+        structure.CleanupModel(tolerance, false);
+
+        auto indexOf = [&nodes](const std::shared_ptr<Node>& pNode)
+            {
+                return static_cast<int>(std::find(nodes.begin(), nodes.end(), pNode) - nodes.begin());
+            };
+        MergeResult result;
+        for (size_t n = 0; n < nodes.size(); ++n)
+        {
+            auto it = structure.m_Nodes.find(nodes[n]->m_Id);
+            if (it != structure.m_Nodes.end() && it->second == nodes[n]) result.nodes.push_back(static_cast<int>(n));
+        }
+        for (size_t e = 0; e < elements.size(); ++e)
+        {
+            auto it = structure.m_Elements.find(elements[e]->m_Id);
+            if (it == structure.m_Elements.end() || it->second != elements[e]) continue;
+            result.elements.push_back({ static_cast<int>(e),
+                indexOf(elements[e]->m_pNode[0].lock()), indexOf(elements[e]->m_pNode[1].lock()) });
+        }
+
+        // 串上的节点：0 吸收 1，2 吸收 3，4 与保留节点 2 相距 1.2 倍容差，单独保留
+        std::vector<int> chain;
+        for (int n : result.nodes)
+        {
+            if (n >= chainBegin && n < chainBegin + 5) chain.push_back(n - chainBegin);
+        }
+        CHECK(chain == std::vector<int>({ 0, 2, 4 }));
+        return result;
+    }
+}
+
+TEST_CASE(StructureData_MergeNodesIndependentOfThreads)
+{
+    const double tolerance = 1e-3;
+    const MergeResult serial = MergeLattice(1, tolerance);
+
+    // 网格节点保留、重复节点并入；串上保留 3 个；锚点保留
+    CHECK_EQUAL(serial.nodes.size(), size_t(8 * 8 * 8 + 3 + 1));
+    CHECK_EQUAL(serial.elements.size(), size_t(8 * 8 * 8 + 3));
+    for (const auto& element : serial.elements)
+    {
+        CHECK(std::binary_search(serial.nodes.begin(), serial.nodes.end(), element[1]));
+        CHECK(std::binary_search(serial.nodes.begin(), serial.nodes.end(), element[2]));
+    }
+
+    for (int nThreads : { 2, 4, 7 })
+    {
+        CHECK(MergeLattice(nThreads, tolerance) == serial);
+    }
+}
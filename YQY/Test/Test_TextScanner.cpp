@@ -0,0 +1,167 @@
+﻿#include "TestFramework.h"
+#include "Import/TextScanner.h"
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief 节点数据行：4 个字段，坐标写入第 i 个位置
+     */
+    struct NodeLines
+    {
+        std::vector<double> m_Coords;
+
+        explicit NodeLines(int nLine) : m_Coords(3 * static_cast<size_t>(nLine), 0.0) {}
+
+        bool operator()(const TextLine& line, int i)
+        {
+            if (line.Count() != 4) return false;
+            for (int k = 0; k < 3; ++k) m_Coords[3 * static_cast<size_t>(i) + k] = line.ToDouble(k + 1);
+            return true;
+        }
+    };
+
+    /**
+     * @brief 第 i 行节点数据，每隔若干行插入注释行、空行，行结束符轮流使用 \n、\r\n、\r
+     */
+    std::string NodeText(int nLine)
+    {
+        static const char* const endings[] = { "\n", "\r\n", "\r" };
+        std::string text;
+        for (int i = 0; i < nLine; ++i)
+        {
+            if (0 == i % 97) text += "** comment\n";
+            if (0 == i % 89) text += "   \n";
+            text += std::to_string(i + 1) + ", " + std::to_string(i) + ".5\t" + std::to_string(-i) + " 1e-3";
+            text += endings[i % 3];
+        }
+        return text;
+    }
+
+    /**
+     * @brief 分别串行和并行解析同一文件，比较返回值、出错行、解析结果和之后的读取位置
+     * @param [out] pStop 出错行的文本（行视图在关闭文件后失效，这里复制出来）
+     * @return 解析成功的行数
+     */
+    int ParseBoth(const std::string& text, int nLine, const std::string& name, std::string* pStop = nullptr)
+    {
+        const std::string path = Test::TempPath(name);
+        Test::WriteText(path, text);
+
+        TextScanner serial, parallel;
+        CHECK(serial.Open(QString::fromStdString(path)));
+        CHECK(parallel.Open(QString::fromStdString(path)));
+
+        NodeLines serialNodes(nLine), parallelNodes(nLine);
+        TextLine serialStop, parallelStop;
+        const int nSerial = serial.ParseLines(nLine, 1, serialStop, std::ref(serialNodes));
+        const int nParallel = parallel.ParseLines(nLine, 4, parallelStop, std::ref(parallelNodes), 1000);
+
+        CHECK_EQUAL(nSerial, nParallel);
+        // 出错行之后的位置可能已被其他块写入，调用方只使用前 nSerial 行
+        const size_t nValid = 3 * static_cast<size_t>(nSerial);
+        CHECK(std::equal(serialNodes.m_Coords.begin(), serialNodes.m_Coords.begin() + nValid, parallelNodes.m_Coords.begin()));
+        if (nSerial < nLine)
+        {// 出错的行只在未读够时有意义
+            CHECK(serialStop.IsEmpty() == parallelStop.IsEmpty());
+            CHECK(serialStop.ToString().toStdString() == parallelStop.ToString().toStdString());
+        }
+        CHECK(serial.Position() == serial.Begin() + (parallel.Position() - parallel.Begin()));
+
+        if (pStop) *pStop = serialStop.ToString().toStdString();
+        serial.Close();
+        parallel.Close();
+        std::remove(path.c_str());
+        return nSerial;
+    }
+}
+
+TEST_CASE(TextScanner_CommentsBomAndLineEndings)
+{
+    const std::string path = Test::TempPath("scanner_lines.txt");
+    Test::WriteText(path, "\xEF\xBB\xBF" "** comment\r\n// comment\n\n  1, 2.5\t3 \r4 5\r\n\t*Node,2\n6");
+
+    TextScanner flow;
+    CHECK(flow.Open(QString::fromStdString(path)));
+    CHECK(flow.Begin() < flow.End() && '*' == *flow.Begin());  // BOM 已跳过
+
+    TextLine line;
+    CHECK(flow.ReadLine(line));
+    CHECK_EQUAL(line.Count(), 3);
+    CHECK_EQUAL(line.ToInt(0), 1);
+    CHECK_NEAR(line.ToDouble(1), 2.5, 0.0);
+    CHECK_NEAR(line.ToDouble(2), 3.0, 0.0);
+    CHECK(!line.IsKeyword());
+
+    CHECK(flow.ReadLine(line));  // 单独的 \r 结束上一行
+    CHECK(line.ToString().toStdString() == "4 5");
+
+    CHECK(flow.ReadLine(line));
+    CHECK(line.IsKeyword());
+    const QStringList keyword = line.KeywordFields();
+    CHECK_EQUAL(keyword.size(), 2);
+    CHECK(keyword[0].toStdString() == "Node");
+    CHECK(keyword[1].toStdString() == "2");
+
+    CHECK(flow.ReadLine(line));  // 最后一行没有行结束符
+    CHECK_EQUAL(line.ToInt(0), 6);
+    CHECK(!flow.ReadLine(line));
+    CHECK(flow.AtEnd());
+
+    flow.Close();
+    std::remove(path.c_str());
+}
+
+TEST_CASE(TextScanner_NumberConversion)
+{
+    // 与 QString::toInt/toDouble 相同：不能完整转换时为 0
+    CHECK_EQUAL(TextLine::ParseInt("+12"), 12);
+    CHECK_EQUAL(TextLine::ParseInt("-7"), -7);
+    CHECK_EQUAL(TextLine::ParseInt("1.5"), 0);
+    CHECK_EQUAL(TextLine::ParseInt("12a"), 0);
+    CHECK_EQUAL(TextLine::ParseInt(""), 0);
+    CHECK_NEAR(TextLine::ParseDouble("+2.5e3"), 2500.0, 0.0);
+    CHECK_NEAR(TextLine::ParseDouble("-1E-3"), -1e-3, 0.0);
+    CHECK_NEAR(TextLine::ParseDouble(".5"), 0.5, 0.0);
+    CHECK_NEAR(TextLine::ParseDouble("1.0.0"), 0.0, 0.0);
+    CHECK_NEAR(TextLine::ParseDouble("+-1"), 0.0, 0.0);
+}
+
+TEST_CASE(TextScanner_ParallelParseMatchesSerial)
+{
+    const int nLine = 10000;
+    const std::string text = NodeText(nLine) + "*Element T3D2 1\n";
+    CHECK_EQUAL(ParseBoth(text, nLine, "parse_all.txt"), nLine);
+}
+
+TEST_CASE(TextScanner_ParallelParseStopsAtErrorLine)
+{
+    // 第 7000 行只有 3 个字段；之后的行不计入
+    const int nLine = 10000;
+    std::string text = NodeText(7000) + "7001 1.0 2.0\n" + NodeText(nLine - 7001);
+    std::string stop;
+    CHECK_EQUAL(ParseBoth(text, nLine, "parse_error.txt", &stop), 7000);
+    CHECK(stop == "7001 1.0 2.0");
+
+    // 两处错误时返回前一处
+    text = NodeText(2500) + "bad\n" + NodeText(5000) + "bad too\n" + NodeText(2498);
+    CHECK_EQUAL(ParseBoth(text, nLine, "parse_error2.txt", &stop), 2500);
+    CHECK(stop == "bad");
+}
+
+TEST_CASE(TextScanner_ParallelParseStopsAtEarlyKeyword)
+{
+    // 数据行数少于声明的行数，后面紧接下一个关键字
+    const int nLine = 8000;
+    std::string stop;
+    CHECK_EQUAL(ParseBoth(NodeText(5000) + "*Element T3D2 1\n1 1 2 1 1\n", nLine, "parse_keyword.txt", &stop), 5000);
+    CHECK(stop == "*Element T3D2 1");
+
+    // 数据行数不够且文件结束
+    CHECK_EQUAL(ParseBoth(NodeText(6000) + "** trailing comment\n", nLine, "parse_eof.txt", &stop), 6000);
+    CHECK(stop.empty());
+}
@@ -8,7 +8,13 @@ const QMap<QString, EnumKeyword::KeyData> EnumKeyword::MapKeyData =
     {"SECTION",       EnumKeyword::KeyData::SECTION},
     {"CONSTRAINT",    EnumKeyword::KeyData::CONSTRAINT},
     {"LOAD",          EnumKeyword::KeyData::LOAD},
-    {"ANALYSIS_STEP", EnumKeyword::KeyData::ANALYSIS_STEP}
+    {"ANALYSIS_STEP", EnumKeyword::KeyData::ANALYSIS_STEP},
+    {"NGEN",          EnumKeyword::KeyData::NGEN},
+    {"GRID",          EnumKeyword::KeyData::GRID},
+    {"EGEN",          EnumKeyword::KeyData::EGEN},
+    {"NSET",          EnumKeyword::KeyData::NSET},
+    {"ELSET",         EnumKeyword::KeyData::ELSET},
+    {"OUTPUT",        EnumKeyword::KeyData::OUTPUT}
 };
 
 const QMap<QString, EnumKeyword::Direction> EnumKeyword::MapDirection = 
@@ -45,5 +51,9 @@ const QMap<QString, EnumKeyword::LoadType> EnumKeyword::MapLoadType =
 const QMap<QString, EnumKeyword::StepType> EnumKeyword::MapStepType =
 {
     {"STATIC",  EnumKeyword::StepType::STATIC},
-    {"DYNAMIC", EnumKeyword::StepType::DYNAMIC}
+    {"DYNAMIC", EnumKeyword::StepType::DYNAMIC},
+    {"MODAL_DYNAMIC", EnumKeyword::StepType::MODAL_DYNAMIC},
+    {"FREQUENCY", EnumKeyword::StepType::FREQUENCY},
+    {"BUCKLE", EnumKeyword::StepType::BUCKLE},
+    {"HARMONIC", EnumKeyword::StepType::HARMONIC}
 };
@@ -20,7 +20,13 @@ public:
         ELEMENT,        ///< 单元
         CONSTRAINT,     ///< 约束
         LOAD,           ///< 荷载
-        ANALYSIS_STEP   ///< 分析步
+        ANALYSIS_STEP,  ///< 分析步
+        NGEN,           ///< 生成一行节点
+        GRID,           ///< 生成节点网格
+        EGEN,           ///< 生成单元阵列
+        NSET,           ///< 节点集合
+        ELSET,          ///< 单元集合
+        OUTPUT          ///< 输出请求
     };
     static const QMap<QString, KeyData> MapKeyData;  ///< 关键字字符串到枚举的映射
 
@@ -82,6 +88,10 @@ public:
     {
         STATIC,   ///< 静力分析
         DYNAMIC,  ///< 动力分析
+        MODAL_DYNAMIC, ///< 模态叠加动力分析
+        FREQUENCY,     ///< 固有频率提取
+        BUCKLE,        ///< 屈曲特征值分析
+        HARMONIC,      ///< 频域简谐响应分析
         UNKNOWN   ///< 未知
     };
     static const QMap<QString, StepType> MapStepType;  ///< 分析步类型字符串到枚举的映射
@@ -2,6 +2,7 @@
 
 int ModelManager::CreateModel()
 {
+    std::lock_guard<std::mutex> lock(m_Mutex);
     int newId = m_NextId++;
     m_Models[newId] = std::make_shared<StructureData>();
     m_Models[newId]->m_Id = newId;
@@ -10,19 +11,34 @@ int ModelManager::CreateModel()
     return newId;
 }
 
+int ModelManager::AddModel(std::shared_ptr<StructureData> pModel)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    int newId = m_NextId++;
+    pModel->m_Id = newId;
+    m_Models[newId] = std::move(pModel);
+    m_ActiveModelId = newId;
+    qDebug().noquote() << QStringLiteral("加入模型 ID=") << newId;
+    return newId;
+}
+
 std::shared_ptr<StructureData> ModelManager::GetModel(int id)
 {
+    std::lock_guard<std::mutex> lock(m_Mutex);
     auto it = m_Models.find(id);
     return (it != m_Models.end()) ? it->second : nullptr;
 }
 
 std::shared_ptr<StructureData> ModelManager::GetActiveModel()
 {
-    return GetModel(m_ActiveModelId);
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto it = m_Models.find(m_ActiveModelId);
+    return (it != m_Models.end()) ? it->second : nullptr;
 }
 
 bool ModelManager::SetActiveModel(int id)
 {
+    std::lock_guard<std::mutex> lock(m_Mutex);
     if (m_Models.find(id) != m_Models.end())
     {
         m_ActiveModelId = id;
@@ -35,6 +51,7 @@ bool ModelManager::SetActiveModel(int id)
 
 bool ModelManager::DeleteModel(int id)
 {
+    std::lock_guard<std::mutex> lock(m_Mutex);
     auto it = m_Models.find(id);
     if (it == m_Models.end())
     {
@@ -42,6 +59,7 @@ bool ModelManager::DeleteModel(int id)
         return false;
     }
 
+    it->second->Clear();// 即使其他地方仍持有该模型，也立即释放其中的对象
     m_Models.erase(it);
     qDebug().noquote() << QStringLiteral("删除模型 ID=") << id;
 
@@ -55,6 +73,11 @@ bool ModelManager::DeleteModel(int id)
 
 void ModelManager::ClearAllModels()
 {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (auto& pair : m_Models)
+    {
+        pair.second->Clear();
+    }
     m_Models.clear();
     m_ActiveModelId = 0;
     m_NextId = 1;
@@ -63,6 +86,7 @@ void ModelManager::ClearAllModels()
 
 std::vector<int> ModelManager::GetAllModelIds() const
 {
+    std::lock_guard<std::mutex> lock(m_Mutex);
     std::vector<int> ids;
     ids.reserve(m_Models.size());
     for (const auto& pair : m_Models)
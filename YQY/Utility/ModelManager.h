@@ -2,10 +2,13 @@
 #include "DataStructure/Structure/StructureData.h"
 #include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 /**
  * @brief 模型管理器（单例模式）- 管理程序中的多个模型，支持创建、切换、删除模型
+ *
+ * 所有成员函数加锁，可以在后台导入线程中加入模型。
  */
 class ModelManager
 {
@@ -26,6 +29,15 @@ public:
      */
     int CreateModel();
 
+    /**
+     * @brief 加入一个已建立好的模型并设为活动模型
+     * @param [in] pModel 模型
+     * @return 新模型的ID
+     *
+     * 模型在加入前由调用者独占建立，加入后整体一次可见，其他线程不会看到建立了一半的模型。
+     */
+    int AddModel(std::shared_ptr<StructureData> pModel);
+
     /**
      * @brief 获取指定ID的模型
      * @param [in] id 模型ID
@@ -52,11 +64,12 @@ public:
      */
     int GetActiveModelId() const
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         return m_ActiveModelId;
     }
 
     /**
-     * @brief 删除指定模型
+     * @brief 删除指定模型（同时清空模型，其他地方未持有的对象立即释放）
      * @param [in] id 模型ID
      * @return 删除成功返回 true
      */
@@ -79,6 +92,7 @@ public:
      */
     int GetModelCount() const
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         return static_cast<int>(m_Models.size());
     }
 
@@ -90,4 +104,5 @@ private:
     std::map<int, std::shared_ptr<StructureData>> m_Models;  ///< 模型集合
     int m_ActiveModelId = 0;  ///< 当前活动模型ID
     int m_NextId = 1;         ///< 下一个模型ID
+    mutable std::mutex m_Mutex;  ///< 保护以上成员
 };
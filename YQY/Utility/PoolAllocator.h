@@ -0,0 +1,41 @@
+﻿#pragma once
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+
+/**
+ * @brief 共享内存池分配器 - 从内存池分配，并持有内存池的共享指针
+ *
+ * 用于 std::allocate_shared 时分配器保存在控制块中，因此对象（含其弱引用）存在期间内存池一直有效：
+ * 模型清空或析构后仍被外部持有的对象可以安全使用和释放，最后一个对象释放后内存池才析构。
+ * 对象释放时内存归还内存池，由同样大小的新对象重复使用。
+ */
+template <class T>
+class PoolAllocator
+{
+public:
+    using value_type = T;
+
+    /**
+     * @brief 构造
+     * @param [in] pPool 内存池
+     */
+    explicit PoolAllocator(std::shared_ptr<std::pmr::memory_resource> pPool) : m_pPool(std::move(pPool)) {}
+
+    template <class U>
+    PoolAllocator(const PoolAllocator<U>& other) : m_pPool(other.m_pPool) {}
+
+    T* allocate(size_t n) { return static_cast<T*>(m_pPool->allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T* p, size_t n) { m_pPool->deallocate(p, n * sizeof(T), alignof(T)); }
+
+    template <class U>
+    bool operator==(const PoolAllocator<U>& other) const { return m_pPool == other.m_pPool; }
+    template <class U>
+    bool operator!=(const PoolAllocator<U>& other) const { return m_pPool != other.m_pPool; }
+
+private:
+    template <class U> friend class PoolAllocator;
+
+    std::shared_ptr<std::pmr::memory_resource> m_pPool;  ///< 内存池
+};
@@ -0,0 +1,98 @@
+﻿#include "SpaceFillingCurve.h"
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    // 将 21 位整数的各位分散到每 3 位的最低位
+    uint64_t SpreadBits(uint32_t v)
+    {
+        uint64_t x = v & 0x1fffff;
+        x = (x | x << 32) & 0x1f00000000ffffULL;
+        x = (x | x << 16) & 0x1f0000ff0000ffULL;
+        x = (x | x << 8) & 0x100f00f00f00f00fULL;
+        x = (x | x << 4) & 0x10c30c30c30c30c3ULL;
+        x = (x | x << 2) & 0x1249249249249249ULL;
+        return x;
+    }
+}
+
+uint64_t SpaceFillingCurve::Morton(uint32_t x, uint32_t y, uint32_t z)
+{
+    return (SpreadBits(x) << 2) | (SpreadBits(y) << 1) | SpreadBits(z);
+}
+
+uint64_t SpaceFillingCurve::Hilbert(uint32_t x, uint32_t y, uint32_t z)
+{
+    // J. Skilling, "Programming the Hilbert curve" (2004)：坐标 -> 转置形式的 Hilbert 下标
+    uint32_t X[3] = { x, y, z };
+    const uint32_t M = 1u << (Bits - 1);
+
+    // 逆向消去
+    for (uint32_t Q = M; Q > 1; Q >>= 1)
+    {
+        const uint32_t P = Q - 1;
+        for (int i = 0; i < 3; ++i)
+        {
+            if (X[i] & Q)
+            {
+                X[0] ^= P;
+            }
+            else
+            {
+                const uint32_t t = (X[0] ^ X[i]) & P;
+                X[0] ^= t;
+                X[i] ^= t;
+            }
+        }
+    }
+
+    // Gray 编码
+    X[1] ^= X[0];
+    X[2] ^= X[1];
+    uint32_t t = 0;
+    for (uint32_t Q = M; Q > 1; Q >>= 1)
+    {
+        if (X[2] & Q) t ^= Q - 1;
+    }
+    for (int i = 0; i < 3; ++i) X[i] ^= t;
+
+    // 转置形式按位交错即为一维编码（X[0] 为每组的最高位）
+    return Morton(X[0], X[1], X[2]);
+}
+
+void SpaceFillingCurve::Compute_Keys(const std::vector<double>& coords, Curve curve, std::vector<uint64_t>& keys)
+{
+    const size_t n = coords.size() / 3;
+    keys.assign(n, 0);
+    if (Curve::NONE == curve || 0 == n) return;
+
+    double lower[3], upper[3];
+    for (int d = 0; d < 3; ++d)
+    {
+        lower[d] = std::numeric_limits<double>::max();
+        upper[d] = std::numeric_limits<double>::lowest();
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (int d = 0; d < 3; ++d)
+        {
+            lower[d] = std::min(lower[d], coords[3 * i + d]);
+            upper[d] = std::max(upper[d], coords[3 * i + d]);
+        }
+    }
+
+    const double extent = std::max({ upper[0] - lower[0], upper[1] - lower[1], upper[2] - lower[2] });
+    const double maxCell = static_cast<double>((1u << Bits) - 1);
+    const double scale = extent > 0.0 ? maxCell / extent : 0.0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        uint32_t q[3];
+        for (int d = 0; d < 3; ++d)
+        {
+            q[d] = static_cast<uint32_t>(std::clamp((coords[3 * i + d] - lower[d]) * scale, 0.0, maxCell));
+        }
+        keys[i] = (Curve::HILBERT == curve) ? Hilbert(q[0], q[1], q[2]) : Morton(q[0], q[1], q[2]);
+    }
+}
@@ -0,0 +1,44 @@
+﻿#pragma once
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 空间填充曲线 - 将三维坐标映射为一维编码，按编码排序可使空间相邻的对象在内存中相邻
+ */
+class SpaceFillingCurve
+{
+public:
+    /**
+     * @brief 曲线类型
+     */
+    enum class Curve
+    {
+        NONE,     ///< 不排序（保持ID顺序）
+        MORTON,   ///< Morton（Z 序）曲线
+        HILBERT   ///< Hilbert 曲线
+    };
+
+    static const int Bits = 21;  ///< 每个坐标轴的量化位数（3*21 = 63 位编码）
+
+    /**
+     * @brief Morton 编码（三个坐标按位交错）
+     * @param [in] x,y,z 量化后的坐标（低 Bits 位有效）
+     */
+    static uint64_t Morton(uint32_t x, uint32_t y, uint32_t z);
+
+    /**
+     * @brief Hilbert 编码（Skilling 转置算法）
+     * @param [in] x,y,z 量化后的坐标（低 Bits 位有效）
+     */
+    static uint64_t Hilbert(uint32_t x, uint32_t y, uint32_t z);
+
+    /**
+     * @brief 计算一组点的曲线编码
+     * @param [in] coords 点坐标，3*i+0/1/2 为第 i 个点的 X/Y/Z
+     * @param [in] curve 曲线类型
+     * @param [out] keys 各点的编码（curve 为 NONE 时全为 0）
+     *
+     * 坐标在所有点的包围盒内按最大边长等比例量化，保持模型的长宽比。
+     */
+    static void Compute_Keys(const std::vector<double>& coords, Curve curve, std::vector<uint64_t>& keys);
+};
@@ -0,0 +1,80 @@
+﻿#pragma once
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 单生产者单消费者无锁队列 - 定长环形缓冲区
+ *
+ * 只允许一个线程调用 TryPush、另一个线程调用 TryPop。两端各自只写自己的下标，
+ * 用 acquire/release 保证元素内容先于下标可见，不加锁、不分配内存。
+ * 容量向上取为 2 的幂；队列满时 TryPush 返回 false，由生产者决定丢弃或重试。
+ */
+template <class T>
+class SpscQueue
+{
+public:
+    /**
+     * @brief 构造
+     * @param [in] capacity 最少可容纳的元素个数
+     */
+    explicit SpscQueue(size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        m_Buffer.resize(size);
+        m_Mask = size - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * @brief 放入一个元素（生产者线程）
+     * @return 队列已满返回 false，value 不变
+     */
+    template <class U>
+    bool TryPush(U&& value)
+    {
+        const size_t tail = m_Tail.load(std::memory_order_relaxed);
+        if (tail - m_Head.load(std::memory_order_acquire) > m_Mask) return false;
+
+        m_Buffer[tail & m_Mask] = std::forward<U>(value);
+        m_Tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief 取出一个元素（消费者线程）
+     * @return 队列为空返回 false
+     */
+    bool TryPop(T& value)
+    {
+        const size_t head = m_Head.load(std::memory_order_relaxed);
+        if (head == m_Tail.load(std::memory_order_acquire)) return false;
+
+        value = std::move(m_Buffer[head & m_Mask]);
+        m_Head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief 队列是否为空（近似值，仅供消费者判断是否还有数据）
+     */
+    bool Empty() const
+    {
+        return m_Head.load(std::memory_order_acquire) == m_Tail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief 容量
+     */
+    size_t Capacity() const { return m_Buffer.size(); }
+
+private:
+    std::vector<T> m_Buffer;                    ///< 环形缓冲区
+    size_t m_Mask = 0;                          ///< 容量 - 1
+    alignas(64) std::atomic<size_t> m_Head{0};  ///< 下一个取出位置（消费者写）
+    alignas(64) std::atomic<size_t> m_Tail{0};  ///< 下一个放入位置（生产者写）
+};
@@ -1,40 +1,80 @@
 #include "GUI/YQY.h"
 #include <QtWidgets/QApplication>
-#include "Import/Input_Model.h"
+#include <QTimer>
+#include <QFile>
+#include <thread>
+#include "Import/ImportTask.h"
+#include "Utility/ModelManager.h"
 #include "DataStructure/Structure/StructureData.h"
 #include "Solver/Solver.h"
 int main(int argc, char *argv[])
 {
     QApplication app(argc, argv);
-    
-    auto pStructure = std::make_shared<StructureData>();
 
-    Input_Model importer;
+    QString BaseName     = "11";
+    QString InputPath    = QString("Import/ImportFile/%1.txt").arg(BaseName);
+    QString OutputPrefix = QString("Export/ExportFile/%1").arg(BaseName);
+    QString OutputPath   = QString("Export/ExportFile/%1_TEP.bdf").arg(BaseName);
 
-    QString BaseName   = "11";
-    QString InputPath  = QString("Import/ImportFile/%1.txt").arg(BaseName);
-    QString OutputPath = QString("Export/ExportFile/%1_TEP.bdf").arg(BaseName);
+    YQY window;
+    window.show();
 
+    // 后台导入，读取大模型时界面保持响应
+    ImportTask task;
     qDebug().noquote() << QStringLiteral("\n读取文件为:") << InputPath << "\n";
-    if (importer.InputData(InputPath, pStructure))
-    {
-        qDebug() << "\n=====Model loaded successfully!=====";
+    task.Start(InputPath);
 
-        // 使用 Solver 运行分析
-        Solver solver;
-        solver.SetStructure(pStructure);
-        solver.RunAll();  // 运行所有分析步
+    // 求解也在后台线程运行，计时器回调只负责启动，分析过程中界面保持响应
+    std::thread solveThread;
 
-        std::vector<int> nodeIds = { 2 };
-        std::vector<DataType> types = { DataType::U1, DataType::U2, DataType::F1, DataType::F2, DataType::F3 };
+    QTimer timer;
+    QObject::connect(&timer, &QTimer::timeout, [&]()
+        {
+            ImportTask::Progress progress;
+            if (task.PollProgress(progress) && progress.m_TotalBytes > 0)
+            {
+                qDebug().noquote() << QStringLiteral("导入进度:") << 100 * progress.m_Bytes / progress.m_TotalBytes << "%"
+                    << QStringLiteral(" 节点:") << progress.m_nNode << QStringLiteral(" 单元:") << progress.m_nElement;
+            }
+            if (task.IsRunning()) return;
 
-        pStructure->GetOutputter().ExportNodes(OutputPath, nodeIds, types);
-        // 或者运行指定分析步
-        // solver.RunStep(1);
-    }
+            timer.stop();
+            if (ImportTask::State::FINISHED != task.GetState()) return;
 
-    YQY window;
-    window.show();
-    return app.exec();
+            auto pStructure = ModelManager::Instance().GetModel(task.GetModelId());
+            qDebug() << "\n=====Model loaded successfully!=====";
+
+            solveThread = std::thread([pStructure, OutputPrefix, OutputPath]()
+                {
+                    std::vector<int> nodeIds = { 2 };
+                    std::vector<DataType> types = { DataType::U1, DataType::U2, DataType::F1, DataType::F2, DataType::F3 };
+                    Outputter& outputter = pStructure->GetOutputter();
+                    outputter.SetRequestedNodes(nodeIds);  // 只保存需要输出的节点
+                    outputter.SetRequestedTypes(types);    // 只保存需要输出的数据类型
+
+                    // 流式输出：后台逐帧写出，内存只保留最新一帧，分析过程中文件随时可读。
+                    // 默认输出写入 <前缀>.out，*OUTPUT 定义的输出请求写入 <前缀>_FIELD<ID>.out 或 <前缀>_HISTORY<ID>.out
+                    outputter.StartStreaming(OutputPrefix);
+
+                    // 使用 Solver 运行分析
+                    Solver solver;
+                    solver.SetStructure(pStructure);
+                    solver.RunAll();  // 运行所有分析步
+                    // 或者运行指定分析步
+                    // solver.RunStep(1);
+
+                    outputter.StopStreaming();  // 写完排队的帧并关闭文件
+
+                    // 保留原有的节点输出文件：默认流式输出与 ExportNodes 格式相同，复制为原文件名
+                    QFile::remove(OutputPath);
+                    if (!QFile::copy(OutputPrefix + ".out", OutputPath))
+                        qDebug().noquote() << QStringLiteral("无法写出文件:") << OutputPath;
+                });
+        });
+    timer.start(ImportTask::ThrottleMs);
+
+    int result = app.exec();
+    if (solveThread.joinable()) solveThread.join();  // 关闭窗口时等待分析结束
+    return result;
 
 }